@@ -37,6 +37,8 @@ THE SOFTWARE.
 #include "Json.h"
 #include <stdio.h>
 #include <ctype.h>
+#include <limits.h>
+#include <stdint.h>
 #include <stdlib.h> /* strtod (C89), strtof (C99) */
 #include <string.h> /* strcasecmp (4.4BSD - compatibility), _stricmp (_WIN32) */
 #include <spine/extension.h>
@@ -89,72 +91,343 @@ void Json_dispose (Json *c) {
 	}
 }
 
+/* Numbers are parsed to the nearest float independent of the locale, using the Eisel-Lemire algorithm. The table holds
+ * the 128-bit truncated powers of five for the decimal exponents a float can represent, -64 to 38, as 32-bit words. */
+static const unsigned int POWERS_OF_FIVE[103][4] = {
+	{0xa87fea27, 0xa539e9a5, 0x3f2398d7, 0x47b36224}, {0xd29fe4b1, 0x8e88640e, 0x8eec7f0d, 0x19a03aad},
+	{0x83a3eeee, 0xf9153e89, 0x1953cf68, 0x300424ac}, {0xa48ceaaa, 0xb75a8e2b, 0x5fa8c342, 0x3c052dd7},
+	{0xcdb02555, 0x653131b6, 0x3792f412, 0xcb06794d}, {0x808e1755, 0x5f3ebf11, 0xe2bbd88b, 0xbee40bd0},
+	{0xa0b19d2a, 0xb70e6ed6, 0x5b6aceae, 0xae9d0ec4}, {0xc8de0475, 0x64d20a8b, 0xf245825a, 0x5a445275},
+	{0xfb158592, 0xbe068d2e, 0xeed6e2f0, 0xf0d56712}, {0x9ced737b, 0xb6c4183d, 0x55464dd6, 0x9685606b},
+	{0xc428d05a, 0xa4751e4c, 0xaa97e14c, 0x3c26b886}, {0xf5330471, 0x4d9265df, 0xd53dd99f, 0x4b3066a8},
+	{0x993fe2c6, 0xd07b7fab, 0xe546a803, 0x8efe4029}, {0xbf8fdb78, 0x849a5f96, 0xde985204, 0x72bdd033},
+	{0xef73d256, 0xa5c0f77c, 0x963e6685, 0x8f6d4440}, {0x95a86376, 0x27989aad, 0xdde70013, 0x79a44aa8},
+	{0xbb127c53, 0xb17ec159, 0x5560c018, 0x580d5d52}, {0xe9d71b68, 0x9dde71af, 0xaab8f01e, 0x6e10b4a6},
+	{0x92267121, 0x62ab070d, 0xcab39613, 0x04ca70e8}, {0xb6b00d69, 0xbb55c8d1, 0x3d607b97, 0xc5fd0d22},
+	{0xe45c10c4, 0x2a2b3b05, 0x8cb89a7d, 0xb77c506a}, {0x8eb98a7a, 0x9a5b04e3, 0x77f3608e, 0x92adb242},
+	{0xb267ed19, 0x40f1c61c, 0x55f038b2, 0x37591ed3}, {0xdf01e85f, 0x912e37a3, 0x6b6c46de, 0xc52f6688},
+	{0x8b61313b, 0xbabce2c6, 0x2323ac4b, 0x3b3da015}, {0xae397d8a, 0xa96c1b77, 0xabec975e, 0x0a0d081a},
+	{0xd9c7dced, 0x53c72255, 0x96e7bd35, 0x8c904a21}, {0x881cea14, 0x545c7575, 0x7e50d641, 0x77da2e54},
+	{0xaa242499, 0x697392d2, 0xdde50bd1, 0xd5d0b9e9}, {0xd4ad2dbf, 0xc3d07787, 0x955e4ec6, 0x4b44e864},
+	{0x84ec3c97, 0xda624ab4, 0xbd5af13b, 0xef0b113e}, {0xa6274bbd, 0xd0fadd61, 0xecb1ad8a, 0xeacdd58e},
+	{0xcfb11ead, 0x453994ba, 0x67de18ed, 0xa5814af2}, {0x81ceb32c, 0x4b43fcf4, 0x80eacf94, 0x8770ced7},
+	{0xa2425ff7, 0x5e14fc31, 0xa1258379, 0xa94d028d}, {0xcad2f7f5, 0x359a3b3e, 0x096ee458, 0x13a04330},
+	{0xfd87b5f2, 0x8300ca0d, 0x8bca9d6e, 0x188853fc}, {0x9e74d1b7, 0x91e07e48, 0x775ea264, 0xcf55347e},
+	{0xc6120625, 0x76589dda, 0x95364afe, 0x032a819e}, {0xf79687ae, 0xd3eec551, 0x3a83ddbd, 0x83f52205},
+	{0x9abe14cd, 0x44753b52, 0xc4926a96, 0x72793543}, {0xc16d9a00, 0x95928a27, 0x75b7053c, 0x0f178294},
+	{0xf1c90080, 0xbaf72cb1, 0x5324c68b, 0x12dd6339}, {0x971da050, 0x74da7bee, 0xd3f6fc16, 0xebca5e04},
+	{0xbce50864, 0x92111aea, 0x88f4bb1c, 0xa6bcf585}, {0xec1e4a7d, 0xb69561a5, 0x2b31e9e3, 0xd06c32e6},
+	{0x9392ee8e, 0x921d5d07, 0x3aff322e, 0x62439fd0}, {0xb877aa32, 0x36a4b449, 0x09befeb9, 0xfad487c3},
+	{0xe69594be, 0xc44de15b, 0x4c2ebe68, 0x7989a9b4}, {0x901d7cf7, 0x3ab0acd9, 0x0f9d3701, 0x4bf60a11},
+	{0xb424dc35, 0x095cd80f, 0x538484c1, 0x9ef38c95}, {0xe12e1342, 0x4bb40e13, 0x2865a5f2, 0x06b06fba},
+	{0x8cbccc09, 0x6f5088cb, 0xf93f87b7, 0x442e45d4}, {0xafebff0b, 0xcb24aafe, 0xf78f69a5, 0x1539d749},
+	{0xdbe6fece, 0xbdedd5be, 0xb573440e, 0x5a884d1c}, {0x89705f41, 0x36b4a597, 0x31680a88, 0xf8953031},
+	{0xabcc7711, 0x8461cefc, 0xfdc20d2b, 0x36ba7c3e}, {0xd6bf94d5, 0xe57a42bc, 0x3d329076, 0x04691b4d},
+	{0x8637bd05, 0xaf6c69b5, 0xa63f9a49, 0xc2c1b110}, {0xa7c5ac47, 0x1b478423, 0x0fcf80dc, 0x33721d54},
+	{0xd1b71758, 0xe219652b, 0xd3c36113, 0x404ea4a9}, {0x83126e97, 0x8d4fdf3b, 0x645a1cac, 0x083126ea},
+	{0xa3d70a3d, 0x70a3d70a, 0x3d70a3d7, 0x0a3d70a4}, {0xcccccccc, 0xcccccccc, 0xcccccccc, 0xcccccccd},
+	{0x80000000, 0x00000000, 0x00000000, 0x00000000}, {0xa0000000, 0x00000000, 0x00000000, 0x00000000},
+	{0xc8000000, 0x00000000, 0x00000000, 0x00000000}, {0xfa000000, 0x00000000, 0x00000000, 0x00000000},
+	{0x9c400000, 0x00000000, 0x00000000, 0x00000000}, {0xc3500000, 0x00000000, 0x00000000, 0x00000000},
+	{0xf4240000, 0x00000000, 0x00000000, 0x00000000}, {0x98968000, 0x00000000, 0x00000000, 0x00000000},
+	{0xbebc2000, 0x00000000, 0x00000000, 0x00000000}, {0xee6b2800, 0x00000000, 0x00000000, 0x00000000},
+	{0x9502f900, 0x00000000, 0x00000000, 0x00000000}, {0xba43b740, 0x00000000, 0x00000000, 0x00000000},
+	{0xe8d4a510, 0x00000000, 0x00000000, 0x00000000}, {0x9184e72a, 0x00000000, 0x00000000, 0x00000000},
+	{0xb5e620f4, 0x80000000, 0x00000000, 0x00000000}, {0xe35fa931, 0xa0000000, 0x00000000, 0x00000000},
+	{0x8e1bc9bf, 0x04000000, 0x00000000, 0x00000000}, {0xb1a2bc2e, 0xc5000000, 0x00000000, 0x00000000},
+	{0xde0b6b3a, 0x76400000, 0x00000000, 0x00000000}, {0x8ac72304, 0x89e80000, 0x00000000, 0x00000000},
+	{0xad78ebc5, 0xac620000, 0x00000000, 0x00000000}, {0xd8d726b7, 0x177a8000, 0x00000000, 0x00000000},
+	{0x87867832, 0x6eac9000, 0x00000000, 0x00000000}, {0xa968163f, 0x0a57b400, 0x00000000, 0x00000000},
+	{0xd3c21bce, 0xcceda100, 0x00000000, 0x00000000}, {0x84595161, 0x401484a0, 0x00000000, 0x00000000},
+	{0xa56fa5b9, 0x9019a5c8, 0x00000000, 0x00000000}, {0xcecb8f27, 0xf4200f3a, 0x00000000, 0x00000000},
+	{0x813f3978, 0xf8940984, 0x40000000, 0x00000000}, {0xa18f07d7, 0x36b90be5, 0x50000000, 0x00000000},
+	{0xc9f2c9cd, 0x04674ede, 0xa4000000, 0x00000000}, {0xfc6f7c40, 0x45812296, 0x4d000000, 0x00000000},
+	{0x9dc5ada8, 0x2b70b59d, 0xf0200000, 0x00000000}, {0xc5371912, 0x364ce305, 0x6c280000, 0x00000000},
+	{0xf684df56, 0xc3e01bc6, 0xc7320000, 0x00000000}, {0x9a130b96, 0x3a6c115c, 0x3c7f4000, 0x00000000},
+	{0xc097ce7b, 0xc90715b3, 0x4b9f1000, 0x00000000}, {0xf0bdc21a, 0xbb48db20, 0x1e86d400, 0x00000000},
+	{0x96769950, 0xb50d88f4, 0x13144480, 0x00000000}
+};
+
+static const float POWERS_OF_TEN[11] = {1e0f, 1e1f, 1e2f, 1e3f, 1e4f, 1e5f, 1e6f, 1e7f, 1e8f, 1e9f, 1e10f};
+
+static const uint32_t INT_POWERS_OF_TEN[10] = {1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000, 1000000000};
+
+/* Significant digits used when a number has too many to round it from its first 19. Halfway points between floats have
+ * fewer, so the remaining digits only matter as a nonzero tail. */
+#define JSON_EXACT_DIGITS 200
+
+typedef struct {
+	uint32_t words[48];
+	int size;
+} BigNumber;
+
+static void multiply64 (uint64_t a, uint64_t b, uint64_t *high, uint64_t *low) {
+	uint64_t aLow = (uint32_t)a, aHigh = a >> 32, bLow = (uint32_t)b, bHigh = b >> 32;
+	uint64_t lowLow = aLow * bLow, highLow = aHigh * bLow;
+	uint64_t cross = (lowLow >> 32) + (uint32_t)highLow + aLow * bHigh;
+	*high = aHigh * bHigh + (highLow >> 32) + (cross >> 32);
+	*low = (cross << 32) | (uint32_t)lowLow;
+}
+
+static int leading_zeros (uint64_t value) {
+	int n = 0;
+	if (!(value >> 32)) { n += 32; value <<= 32; }
+	if (!(value >> 48)) { n += 16; value <<= 16; }
+	if (!(value >> 56)) { n += 8; value <<= 8; }
+	if (!(value >> 60)) { n += 4; value <<= 4; }
+	if (!(value >> 62)) { n += 2; value <<= 2; }
+	if (!(value >> 63)) n++;
+	return n;
+}
+
+/* Returns the bits of the positive float nearest to w * 10^q. */
+static uint32_t to_float_bits (uint64_t w, int q) {
+	uint64_t high, low, mantissa;
+	const unsigned int *power;
+	int zeros, upper, shift, power2;
+
+	if (w == 0 || q < -64) return 0;
+	if (q > 38) return 0x7F800000;
+
+	zeros = leading_zeros(w);
+	w <<= zeros;
+	power = POWERS_OF_FIVE[q + 64];
+	multiply64(w, ((uint64_t)power[0] << 32) | power[1], &high, &low);
+	if ((high & 0x3FFFFFFFFF) == 0x3FFFFFFFFF) {
+		/* The 26 bits needed may be off by one, so use the low half of the power too. */
+		uint64_t high2, low2;
+		multiply64(w, ((uint64_t)power[2] << 32) | power[3], &high2, &low2);
+		low += high2;
+		if (high2 > low) high++;
+	}
+	upper = (int)(high >> 63);
+	shift = upper + 38;
+	mantissa = high >> shift;
+	power2 = (((152170 + 65536) * q) >> 16) + 63 + upper - zeros + 127;
+
+	if (power2 <= 0) {
+		/* Subnormal. */
+		if (-power2 + 1 >= 64) return 0;
+		mantissa >>= -power2 + 1;
+		mantissa += mantissa & 1;
+		mantissa >>= 1;
+		return (mantissa < (1 << 23) ? 0 : 1 << 23) | (uint32_t)mantissa;
+	}
+
+	/* Exactly halfway between two floats rounds to even. */
+	if (low <= 1 && q >= -17 && q <= 10 && (mantissa & 3) == 1 && (mantissa << shift) == high) mantissa &= ~(uint64_t)1;
+	mantissa += mantissa & 1;
+	mantissa >>= 1;
+	if (mantissa >= (2 << 23)) {
+		mantissa = 1 << 23;
+		power2++;
+	}
+	if (power2 >= 0xFF) return 0x7F800000;
+	return ((uint32_t)power2 << 23) | ((uint32_t)mantissa & 0x7FFFFF);
+}
+
+static void big_multiply (BigNumber *number, uint32_t factor, uint32_t add) {
+	uint64_t carry = add;
+	int i;
+	for (i = 0; i < number->size; i++) {
+		carry += (uint64_t)number->words[i] * factor;
+		number->words[i] = (uint32_t)carry;
+		carry >>= 32;
+	}
+	if (carry) number->words[number->size++] = (uint32_t)carry;
+}
+
+static void big_multiply_power5 (BigNumber *number, int exponent) {
+	uint32_t factor = 1;
+	for (; exponent >= 13; exponent -= 13)
+		big_multiply(number, 1220703125, 0);
+	for (; exponent > 0; exponent--)
+		factor *= 5;
+	big_multiply(number, factor, 0);
+}
+
+static void big_shift_left (BigNumber *number, int bits) {
+	int words = bits >> 5, i;
+	bits &= 31;
+	if (number->size == 0) return;
+	if (bits) {
+		uint32_t carry = 0;
+		for (i = 0; i < number->size; i++) {
+			uint32_t word = number->words[i];
+			number->words[i] = (word << bits) | carry;
+			carry = word >> (32 - bits);
+		}
+		if (carry) number->words[number->size++] = carry;
+	}
+	if (words) {
+		for (i = number->size - 1; i >= 0; i--)
+			number->words[i + words] = number->words[i];
+		for (i = 0; i < words; i++)
+			number->words[i] = 0;
+		number->size += words;
+	}
+}
+
+static int big_compare (const BigNumber *a, const BigNumber *b) {
+	int i;
+	if (a->size != b->size) return a->size < b->size ? -1 : 1;
+	for (i = a->size - 1; i >= 0; i--)
+		if (a->words[i] != b->words[i]) return a->words[i] < b->words[i] ? -1 : 1;
+	return 0;
+}
+
+/* Decides between the float bits and the next float up for the digits between ptr and end, times 10^exponent. */
+static uint32_t round_digits (const char *ptr, const char *end, int exponent, uint32_t bits) {
+	BigNumber digits, halfway;
+	int count = 0, fraction = 0, tail = 0, binaryExponent, difference;
+	uint32_t mantissa = bits & 0x7FFFFF;
+
+	digits.size = 0;
+	for (; ptr != end; ptr++) {
+		if (*ptr == '.') {
+			fraction = 1;
+			continue;
+		}
+		if (count < JSON_EXACT_DIGITS) {
+			if (digits.size || *ptr != '0') {
+				big_multiply(&digits, 10, *ptr - '0');
+				count++;
+			}
+			if (fraction) exponent--;
+		} else {
+			if (!fraction) exponent++;
+			if (*ptr != '0') tail = 1;
+		}
+	}
+	if (tail) {
+		big_multiply(&digits, 10, 1);
+		exponent--;
+	}
+
+	/* The halfway point is (2 * mantissa + 1) * 2^(binaryExponent - 1). */
+	binaryExponent = (int)(bits >> 23);
+	if (binaryExponent) {
+		mantissa |= 1 << 23;
+		binaryExponent -= 150;
+	} else
+		binaryExponent = -149;
+	halfway.size = 0;
+	big_multiply(&halfway, 1, mantissa * 2 + 1);
+	binaryExponent--;
+
+	/* Compare digits * 5^exponent * 2^exponent with halfway * 2^binaryExponent. */
+	if (exponent >= 0)
+		big_multiply_power5(&digits, exponent);
+	else
+		big_multiply_power5(&halfway, -exponent);
+	difference = binaryExponent - exponent;
+	if (difference > 0)
+		big_shift_left(&halfway, difference);
+	else
+		big_shift_left(&digits, -difference);
+
+	difference = big_compare(&digits, &halfway);
+	if (difference > 0 || (difference == 0 && (bits & 1))) return bits + 1;
+	return bits;
+}
+
 /* Parse the input text to generate a number, and populate the result into item. */
 static const char* parse_number (Json *item, const char* num) {
-	double result = 0.0;
-	int negative = 0;
-	char* ptr = (char*)num;
+	const char *ptr = num, *start, *end;
+	uint64_t w = 0, integer;
+	int negative = 0, count = 0, exponent = 0, truncated = 0, found = 0, n;
+	float result;
 
 	if (*ptr == '-') {
-		negative = -1;
+		negative = 1;
 		++ptr;
 	}
-
-	while (*ptr >= '0' && *ptr <= '9') {
-		result = result * 10.0 + (*ptr - '0');
-		++ptr;
+	start = ptr;
+
+	/* Up to 19 significant digits fit in w, the rest only move the exponent. */
+	for (; *ptr >= '0' && *ptr <= '9'; ++ptr) {
+		found = 1;
+		if (count < 19) {
+			w = w * 10 + (*ptr - '0');
+			if (w) count++;
+		} else {
+			exponent++;
+			if (*ptr != '0') truncated = 1;
+		}
 	}
-
 	if (*ptr == '.') {
-		double fraction = 0.0;
-		int n = 0;
-		++ptr;
-
-		while (*ptr >= '0' && *ptr <= '9') {
-			fraction = (fraction * 10.0) + (*ptr - '0');
-			++ptr;
-			++n;
+		for (++ptr; *ptr >= '0' && *ptr <= '9'; ++ptr) {
+			found = 1;
+			if (count < 19) {
+				w = w * 10 + (*ptr - '0');
+				if (w) count++;
+				exponent--;
+			} else if (*ptr != '0')
+				truncated = 1;
 		}
-		result += fraction / POW(10.0, n);
 	}
-	if (negative) result = -result;
+	if (!found) {
+		/* Parse failure, ep is set. */
+		ep = num;
+		return 0;
+	}
+	end = ptr;
 
+	n = 0;
 	if (*ptr == 'e' || *ptr == 'E') {
-		double exponent = 0;
 		int expNegative = 0;
-		int n = 0;
 		++ptr;
-
 		if (*ptr == '-') {
-			expNegative = -1;
+			expNegative = 1;
 			++ptr;
-		} else if (*ptr == '+') {
+		} else if (*ptr == '+')
 			++ptr;
-		}
+		for (; *ptr >= '0' && *ptr <= '9'; ++ptr)
+			if (n < 100000) n = n * 10 + (*ptr - '0');
+		if (expNegative) n = -n;
+		exponent += n;
+	}
 
-		while (*ptr >= '0' && *ptr <= '9') {
-			exponent = (exponent * 10.0) + (*ptr - '0');
-			++ptr;
-			++n;
-		}
+	if (!truncated && exponent == 0)
+		result = (float)w;
+	else if (!truncated && w <= 1 << 24 && exponent >= -10 && exponent <= 10) {
+		/* Both operands are exact, so the result is correctly rounded. */
+		result = (float)w;
+		result = exponent < 0 ? result / POWERS_OF_TEN[-exponent] : result * POWERS_OF_TEN[exponent];
+	} else {
+		uint32_t bits = to_float_bits(w, exponent);
+		/* Dropped digits put the number between w and w + 1, which only matters if they round differently. */
+		if (truncated && bits != to_float_bits(w + 1, exponent)) bits = round_digits(start, end, n, bits);
+		memcpy(&result, &bits, sizeof(float));
+	}
 
-		if (expNegative)
-			result = result / POW(10, exponent);
-		else
-			result = result * POW(10, exponent);
+	/* The integer value truncates toward zero and saturates. */
+	integer = w;
+	if (exponent < 0) {
+		n = -exponent;
+		if (n >= count)
+			integer = 0; /* w has count digits. */
+		else if (integer <= 0xFFFFFFFF && n <= 9)
+			integer = (uint32_t)integer / INT_POWERS_OF_TEN[n];
+		else {
+			for (; n > 9; n -= 9)
+				integer /= 1000000000;
+			integer /= INT_POWERS_OF_TEN[n];
+		}
+	} else {
+		for (n = exponent; n > 0 && integer <= INT_MAX; n--)
+			integer *= 10;
 	}
 
-	if (ptr != num) {
-		/* Parse success, number found. */
-		item->valueFloat = (float)result;
-		item->valueInt = (int)result;
-		item->type = Json_Number;
-		return ptr;
+	if (negative) {
+		item->valueFloat = -result;
+		item->valueInt = integer > INT_MAX ? INT_MIN : -(int)integer;
 	} else {
-		/* Parse failure, ep is set. */
-		ep = num;
-		return 0;
+		item->valueFloat = result;
+		item->valueInt = integer > INT_MAX ? INT_MAX : (int)integer;
 	}
+	item->type = Json_Number;
+	return ptr;
 }
 
 /* Parse the input text into an unescaped cstring, and populate item. */
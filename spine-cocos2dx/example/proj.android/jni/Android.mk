@@ -29,13 +29,17 @@ LOCAL_SRC_FILES := hellocpp/main.cpp \
 ../../../../spine-cpp/spine-cpp//src/spine/Animation.cpp \
 ../../../../spine-cpp/spine-cpp//src/spine/AnimationState.cpp \
 ../../../../spine-cpp/spine-cpp//src/spine/AnimationStateData.cpp \
+../../../../spine-cpp/spine-cpp//src/spine/Arena.cpp \
+../../../../spine-cpp/spine-cpp//src/spine/AsyncLoader.cpp \
 ../../../../spine-cpp/spine-cpp//src/spine/Atlas.cpp \
 ../../../../spine-cpp/spine-cpp//src/spine/AtlasAttachmentLoader.cpp \
 ../../../../spine-cpp/spine-cpp//src/spine/Attachment.cpp \
 ../../../../spine-cpp/spine-cpp//src/spine/AttachmentLoader.cpp \
 ../../../../spine-cpp/spine-cpp//src/spine/AttachmentTimeline.cpp \
+../../../../spine-cpp/spine-cpp//src/spine/BakedAnimation.cpp \
 ../../../../spine-cpp/spine-cpp//src/spine/Bone.cpp \
 ../../../../spine-cpp/spine-cpp//src/spine/BoneData.cpp \
+../../../../spine-cpp/spine-cpp//src/spine/BoneTransforms.cpp \
 ../../../../spine-cpp/spine-cpp//src/spine/BoundingBoxAttachment.cpp \
 ../../../../spine-cpp/spine-cpp//src/spine/ClippingAttachment.cpp \
 ../../../../spine-cpp/spine-cpp//src/spine/ColorTimeline.cpp \
@@ -50,7 +54,9 @@ LOCAL_SRC_FILES := hellocpp/main.cpp \
 ../../../../spine-cpp/spine-cpp//src/spine/IkConstraint.cpp \
 ../../../../spine-cpp/spine-cpp//src/spine/IkConstraintData.cpp \
 ../../../../spine-cpp/spine-cpp//src/spine/IkConstraintTimeline.cpp \
+../../../../spine-cpp/spine-cpp//src/spine/JobRunner.cpp \
 ../../../../spine-cpp/spine-cpp//src/spine/Json.cpp \
+../../../../spine-cpp/spine-cpp//src/spine/JsonReader.cpp \
 ../../../../spine-cpp/spine-cpp//src/spine/LinkedMesh.cpp \
 ../../../../spine-cpp/spine-cpp//src/spine/MathUtil.cpp \
 ../../../../spine-cpp/spine-cpp//src/spine/MeshAttachment.cpp \
@@ -61,6 +67,7 @@ LOCAL_SRC_FILES := hellocpp/main.cpp \
 ../../../../spine-cpp/spine-cpp//src/spine/PathConstraintPositionTimeline.cpp \
 ../../../../spine-cpp/spine-cpp//src/spine/PathConstraintSpacingTimeline.cpp \
 ../../../../spine-cpp/spine-cpp//src/spine/PointAttachment.cpp \
+../../../../spine-cpp/spine-cpp//src/spine/Pose.cpp \
 ../../../../spine-cpp/spine-cpp//src/spine/RegionAttachment.cpp \
 ../../../../spine-cpp/spine-cpp//src/spine/RotateTimeline.cpp \
 ../../../../spine-cpp/spine-cpp//src/spine/RTTI.cpp \
@@ -71,7 +78,9 @@ LOCAL_SRC_FILES := hellocpp/main.cpp \
 ../../../../spine-cpp/spine-cpp//src/spine/SkeletonBounds.cpp \
 ../../../../spine-cpp/spine-cpp//src/spine/SkeletonClipping.cpp \
 ../../../../spine-cpp/spine-cpp//src/spine/SkeletonData.cpp \
+../../../../spine-cpp/spine-cpp//src/spine/SkeletonDataCache.cpp \
 ../../../../spine-cpp/spine-cpp//src/spine/SkeletonJson.cpp \
+../../../../spine-cpp/spine-cpp//src/spine/SkeletonUpdateBatch.cpp \
 ../../../../spine-cpp/spine-cpp//src/spine/Skin.cpp \
 ../../../../spine-cpp/spine-cpp//src/spine/Slot.cpp \
 ../../../../spine-cpp/spine-cpp//src/spine/SlotData.cpp \
@@ -184,6 +184,15 @@ char *Cocos2dExtension::_readFile(const spine::String &path, int *length) {
 #endif
 }
 
+// Files may live in packages that can't be mapped, so they are always read through FileUtils.
+const char *Cocos2dExtension::_mapFile(const spine::String &path, int *length) {
+	return SpineExtension::_mapFile(path, length);
+}
+
+void Cocos2dExtension::_unmapFile(const char *data, int length) {
+	SpineExtension::_unmapFile(data, length);
+}
+
 SpineExtension *spine::getDefaultExtension () {
 	return new Cocos2dExtension();
 }
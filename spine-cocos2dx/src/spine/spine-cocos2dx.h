@@ -72,6 +72,10 @@ namespace spine {
 		
 	protected:
 		virtual char *_readFile(const String &path, int *length);
+
+		virtual const char *_mapFile(const String &path, int *length);
+
+		virtual void _unmapFile(const char *data, int length);
 	};
 }
 
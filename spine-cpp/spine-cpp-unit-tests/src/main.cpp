@@ -1,11 +1,281 @@
 #include <stdio.h>
+#include <time.h>
 #include <spine/spine.h>
 #include <spine/Debug.h>
 
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <pthread.h>
+#include <sched.h>
+#endif
+
 #pragma warning ( disable : 4710 )
 
 using namespace spine;
 
+/// A mutex for the tests that call the runtime from several threads.
+class TestMutex {
+public:
+	TestMutex() {
+#ifdef _WIN32
+		InitializeCriticalSection(&_mutex);
+#else
+		pthread_mutex_init(&_mutex, NULL);
+#endif
+	}
+
+	~TestMutex() {
+#ifdef _WIN32
+		DeleteCriticalSection(&_mutex);
+#else
+		pthread_mutex_destroy(&_mutex);
+#endif
+	}
+
+	void lock() {
+#ifdef _WIN32
+		EnterCriticalSection(&_mutex);
+#else
+		pthread_mutex_lock(&_mutex);
+#endif
+	}
+
+	void unlock() {
+#ifdef _WIN32
+		LeaveCriticalSection(&_mutex);
+#else
+		pthread_mutex_unlock(&_mutex);
+#endif
+	}
+
+private:
+#ifdef _WIN32
+	CRITICAL_SECTION _mutex;
+#else
+	pthread_mutex_t _mutex;
+#endif
+};
+
+/// A thread that calls a function once. join() must be called before the thread is deleted.
+class TestThread {
+public:
+	typedef void (*Function)(void *data);
+
+	void start(Function function, void *data) {
+		_function = function;
+		_data = data;
+#ifdef _WIN32
+		_thread = CreateThread(NULL, 0, threadMain, this, 0, NULL);
+		assert(_thread);
+#else
+		int result = pthread_create(&_thread, NULL, threadMain, this);
+		assert(result == 0);
+		SP_UNUSED(result);
+#endif
+	}
+
+	void join() {
+#ifdef _WIN32
+		WaitForSingleObject(_thread, INFINITE);
+		CloseHandle(_thread);
+#else
+		pthread_join(_thread, NULL);
+#endif
+	}
+
+	static void yield() {
+#ifdef _WIN32
+		SwitchToThread();
+#else
+		sched_yield();
+#endif
+	}
+
+private:
+	Function _function;
+	void *_data;
+#ifdef _WIN32
+	HANDLE _thread;
+
+	static DWORD WINAPI threadMain(LPVOID thread) {
+		((TestThread *) thread)->_function(((TestThread *) thread)->_data);
+		return 0;
+	}
+#else
+	pthread_t _thread;
+
+	static void *threadMain(void *thread) {
+		((TestThread *) thread)->_function(((TestThread *) thread)->_data);
+		return NULL;
+	}
+#endif
+};
+
+/// Serializes calls to the current SpineExtension while in scope, so the DebugExtension keeps tracking leaks while the
+/// runtime allocates from several threads.
+class LockingExtension : public SpineExtension {
+public:
+	LockingExtension() : _extension(SpineExtension::getInstance()) {
+		SpineExtension::setInstance(this);
+	}
+
+	virtual ~LockingExtension() {
+		SpineExtension::setInstance(_extension);
+	}
+
+	virtual void *_alloc(size_t size, const char *file, int line) {
+		_mutex.lock();
+		void *result = _extension->_alloc(size, file, line);
+		_mutex.unlock();
+		return result;
+	}
+
+	virtual void *_calloc(size_t size, const char *file, int line) {
+		_mutex.lock();
+		void *result = _extension->_calloc(size, file, line);
+		_mutex.unlock();
+		return result;
+	}
+
+	virtual void *_realloc(void *ptr, size_t size, const char *file, int line) {
+		_mutex.lock();
+		void *result = _extension->_realloc(ptr, size, file, line);
+		_mutex.unlock();
+		return result;
+	}
+
+	virtual void _free(void *mem, const char *file, int line) {
+		_mutex.lock();
+		_extension->_free(mem, file, line);
+		_mutex.unlock();
+	}
+
+	// Reading files allocates through this extension again, so it is not locked.
+	virtual char *_readFile(const String &path, int *length) {
+		return _extension->_readFile(path, length);
+	}
+
+	virtual const char *_mapFile(const String &path, int *length) {
+		return _extension->_mapFile(path, length);
+	}
+
+	virtual void _unmapFile(const char *data, int length) {
+		_extension->_unmapFile(data, length);
+	}
+
+private:
+	SpineExtension *_extension;
+	TestMutex _mutex;
+};
+
+/// Runs jobs on background threads. run() spreads the indices over several threads and waits for them, start() runs
+/// each started job on its own thread, which wait() joins.
+class ThreadJobRunner : public JobRunner {
+public:
+	static const int MAX_THREADS = 8;
+
+	int _jobs, _waits;
+
+	explicit ThreadJobRunner(int threadCount) : _jobs(0), _waits(0), _threadCount(threadCount) {
+		assert(threadCount > 0 && threadCount <= MAX_THREADS);
+	}
+
+	virtual ~ThreadJobRunner() {
+		for (size_t i = 0; i < _started.size(); i++) {
+			_started[i]->thread.join();
+			delete _started[i];
+		}
+	}
+
+	virtual void run(Job &job, int count) {
+		Work work(job, count);
+		TestThread threads[MAX_THREADS];
+		for (int i = 0; i < _threadCount; i++)
+			threads[i].start(runWork, &work);
+		for (int i = 0; i < _threadCount; i++)
+			threads[i].join();
+		assert(work.next >= count);
+		_jobs += count;
+	}
+
+	virtual void start(Job &job, int count) {
+		Started *started = new(__FILE__, __LINE__) Started(job, count);
+		_started.add(started);
+		started->thread.start(runStarted, started);
+	}
+
+	virtual void wait(Job &job) {
+		for (size_t i = 0; i < _started.size(); i++) {
+			if (&_started[i]->work.job != &job) continue;
+			_started[i]->thread.join();
+			delete _started[i];
+			_started.removeAt(i);
+			_waits++;
+			return;
+		}
+	}
+
+	virtual bool isDone(Job &job) {
+		for (size_t i = 0; i < _started.size(); i++) {
+			Started *started = _started[i];
+			if (&started->work.job != &job) continue;
+			started->work.mutex.lock();
+			bool done = started->done;
+			started->work.mutex.unlock();
+			if (!done) return false;
+			started->thread.join();
+			delete started;
+			_started.removeAt(i);
+			return true;
+		}
+		return true;
+	}
+
+private:
+	struct Work {
+		Job &job;
+		int count, next;
+		TestMutex mutex;
+
+		Work(Job &inJob, int inCount) : job(inJob), count(inCount), next(0) {
+		}
+	};
+
+	struct Started : public SpineObject {
+		Work work;
+		TestThread thread;
+		bool done;
+
+		Started(Job &job, int count) : work(job, count), done(false) {
+		}
+	};
+
+	int _threadCount;
+	Vector<Started *> _started;
+
+	static void runWork(void *data) {
+		Work &work = *(Work *) data;
+		while (true) {
+			work.mutex.lock();
+			int index = work.next++;
+			work.mutex.unlock();
+			if (index >= work.count) break;
+			work.job.run(index);
+		}
+	}
+
+	static void runStarted(void *data) {
+		Started &started = *(Started *) data;
+		runWork(&started.work);
+		started.work.mutex.lock();
+		started.done = true;
+		started.work.mutex.unlock();
+	}
+};
+
 void loadBinary(const String &binaryFile, const String &atlasFile, Atlas *&atlas, SkeletonData *&skeletonData,
 				AnimationStateData *&stateData, Skeleton *&skeleton, AnimationState *&state) {
 	atlas = new(__FILE__, __LINE__) Atlas(atlasFile, NULL);
@@ -93,17 +363,1933 @@ void testLoading() {
 	}
 }
 
+void testBoneTransforms() {
+	Atlas *atlas = NULL;
+	SkeletonData *skeletonData = NULL;
+	AnimationStateData *stateData = NULL;
+	Skeleton *skeleton = NULL;
+	AnimationState *state = NULL;
+
+	printf("Testing bone transforms\n");
+	loadBinary("testdata/spineboy/spineboy-pro.skel", "testdata/spineboy/spineboy.atlas", atlas, skeletonData, stateData, skeleton, state);
+
+	Skeleton *soaSkeleton = new(__FILE__, __LINE__) Skeleton(skeletonData);
+	soaSkeleton->setBoneTransformsEnabled(true);
+	AnimationState *soaState = new(__FILE__, __LINE__) AnimationState(stateData);
+
+	state->setAnimation(0, "run", true);
+	state->addAnimation(1, "aim", true, 0.5f);
+	soaState->setAnimation(0, "run", true);
+	soaState->addAnimation(1, "aim", true, 0.5f);
+
+	for (int frame = 0; frame < 120; frame++) {
+		state->update(1 / 60.0f);
+		state->apply(*skeleton);
+		skeleton->updateWorldTransform();
+		soaState->update(1 / 60.0f);
+		soaState->apply(*soaSkeleton);
+		soaSkeleton->updateWorldTransform();
+
+		for (size_t i = 0; i < skeleton->getBones().size(); i++) {
+			Bone *bone = skeleton->getBones()[i];
+			Bone *soaBone = soaSkeleton->getBones()[i];
+			assert(bone->getA() == soaBone->getA() && bone->getB() == soaBone->getB());
+			assert(bone->getC() == soaBone->getC() && bone->getD() == soaBone->getD());
+			assert(bone->getWorldX() == soaBone->getWorldX() && bone->getWorldY() == soaBone->getWorldY());
+			assert(bone->getAppliedRotation() == soaBone->getAppliedRotation());
+			assert(soaSkeleton->getBoneTransforms()->getWorldX()[i] == soaBone->getWorldX());
+		}
+	}
+
+	delete soaState;
+	delete soaSkeleton;
+	dispose(atlas, skeletonData, stateData, skeleton, state);
+}
+
 namespace spine {
 	SpineExtension* getDefaultExtension() {
 		return new DefaultSpineExtension();
 	}
 }
 
+/// Computes the vertices in [start, start + count) with the scalar and the SIMD path and checks they are identical and that
+/// nothing outside the written vertices is touched.
+void checkSimdVertices(Slot &slot, VertexAttachment &attachment, size_t start, size_t count, size_t offset, size_t stride) {
+	size_t length = offset + (count >> 1) * stride;
+	Vector<float> scalarVertices, simdVertices;
+	scalarVertices.setSize(length + stride, -1);
+	simdVertices.setSize(length + stride, -1);
+	VertexAttachment::setSimdEnabled(false);
+	assert(!VertexAttachment::isSimdEnabled());
+	attachment.computeWorldVertices(slot, start, count, scalarVertices, offset, stride);
+	VertexAttachment::setSimdEnabled(true);
+	attachment.computeWorldVertices(slot, start, count, simdVertices, offset, stride);
+	for (size_t i = 0; i < length + stride; i++) {
+		assert(scalarVertices[i] == simdVertices[i]);
+		bool written = i >= offset && i < length && (i - offset) % stride < 2;
+		if (!written) assert(simdVertices[i] == -1);
+	}
+}
+
+void testSimdVertices() {
+	Atlas *atlas = NULL;
+	SkeletonData *skeletonData = NULL;
+	AnimationStateData *stateData = NULL;
+	Skeleton *skeleton = NULL;
+	AnimationState *state = NULL;
+
+	printf("Testing SIMD vertices\n");
+	loadBinary("testdata/spineboy/spineboy-pro.skel", "testdata/spineboy/spineboy.atlas", atlas, skeletonData, stateData, skeleton, state);
+
+	// Enabling only has an effect when the runtime was compiled with SIMD support.
+	bool simdSupported = VertexAttachment::isSimdEnabled();
+	VertexAttachment::setSimdEnabled(false);
+	assert(!VertexAttachment::isSimdEnabled());
+	VertexAttachment::setSimdEnabled(true);
+	assert(VertexAttachment::isSimdEnabled() == simdSupported);
+
+	state->setAnimation(0, "run", true);
+	int weighted = 0;
+	for (int frame = 0; frame < 60; frame++) {
+		state->update(1 / 60.0f);
+		state->apply(*skeleton);
+		skeleton->updateWorldTransform();
+
+		for (size_t i = 0; i < skeleton->getSlots().size(); i++) {
+			Slot *slot = skeleton->getSlots()[i];
+			Attachment *attachment = slot->getAttachment();
+			if (!attachment || !attachment->getRTTI().instanceOf(VertexAttachment::rtti)) continue;
+			VertexAttachment *vertexAttachment = static_cast<VertexAttachment *>(attachment);
+			size_t length = vertexAttachment->getWorldVerticesLength();
+			checkSimdVertices(*slot, *vertexAttachment, 0, length, 0, 2);
+			if (vertexAttachment->getBones().size() == 0) continue;
+			weighted++;
+
+			// Offsets, strides and vertex counts that are not a multiple of the 4 SIMD lanes, starting after the first
+			// vertex so the bone and weight indices are skipped.
+			size_t vertexCount = length >> 1;
+			checkSimdVertices(*slot, *vertexAttachment, 0, length, 3, 5);
+			checkSimdVertices(*slot, *vertexAttachment, 2, (vertexCount - 1) << 1, 1, 4);
+			if (vertexCount > 7) checkSimdVertices(*slot, *vertexAttachment, 4, 7 << 1, 2, 3);
+			if (vertexCount > 5) checkSimdVertices(*slot, *vertexAttachment, 2, 5 << 1, 0, 2);
+
+			// The same with a deform.
+			Vector<float> &deform = slot->getDeform();
+			size_t deformLength = vertexAttachment->getVertices().size() / 3 * 2;
+			deform.setSize(deformLength, 0);
+			for (size_t ii = 0; ii < deformLength; ii++)
+				deform[ii] = (float) ((ii + frame) % 7) - 3;
+			checkSimdVertices(*slot, *vertexAttachment, 0, length, 0, 2);
+			checkSimdVertices(*slot, *vertexAttachment, 2, (vertexCount - 1) << 1, 3, 5);
+			deform.clear();
+		}
+	}
+	assert(weighted > 0);
+	VertexAttachment::setSimdEnabled(true);
+
+	dispose(atlas, skeletonData, stateData, skeleton, state);
+}
+
+/// Reference map with the linear lookup of the previous linked list HashMap, used to check results and as a benchmark
+/// baseline.
+class LinearMap {
+public:
+	void put(int key, int value) {
+		int index = _keys.indexOf(key);
+		if (index != -1) _values[index] = value;
+		else {
+			_keys.add(key);
+			_values.add(value);
+		}
+	}
+
+	bool containsKey(int key) {
+		return _keys.contains(key);
+	}
+
+	bool remove(int key) {
+		int index = _keys.indexOf(key);
+		if (index == -1) return false;
+		_keys.removeAt(index);
+		_values.removeAt(index);
+		return true;
+	}
+
+	Vector<int> _keys;
+	Vector<int> _values;
+};
+
+void testHashMap() {
+	printf("Testing hash map\n");
+
+	HashMap<int, int> map;
+	LinearMap reference;
+	unsigned int seed = 12345;
+	for (int i = 0; i < 20000; i++) {
+		seed = seed * 1103515245u + 12345u;
+		int key = (int) ((seed >> 8) % 512);
+		if ((seed >> 4) % 4 == 0) assert(map.remove(key) == reference.remove(key));
+		else {
+			map.put(key, i);
+			reference.put(key, i);
+		}
+		assert(map.size() == reference._keys.size());
+		assert(map.containsKey(key) == reference.containsKey(key));
+	}
+	HashMap<int, int>::Entries entries = map.getEntries();
+	for (size_t i = reference._keys.size(); i > 0; i--) {
+		assert(entries.hasNext());
+		HashMap<int, int>::Pair pair = entries.next();
+		assert(pair.key == reference._keys[i - 1] && pair.value == reference._values[i - 1]);
+		assert(map[pair.key] == pair.value);
+	}
+	assert(!entries.hasNext());
+	map.clear();
+	assert(map.size() == 0 && !map.containsKey(reference._keys[0]));
+
+	HashMap<String, int> strings;
+	strings.put("run", 1);
+	strings.put("walk", 2);
+	strings.put("run", 3);
+	assert(strings.size() == 2 && strings["run"] == 3 && strings["walk"] == 2 && !strings.containsKey("jump"));
+
+	// Microbenchmark: lookups of property IDs as done by AnimationState::computeHold.
+	const int keyCount = 256, lookups = 200;
+	HashMap<int, bool> hashMap;
+	LinearMap linearMap;
+	for (int i = 0; i < keyCount; i++) {
+		hashMap.put((i % 16 << 24) + i, true);
+		linearMap.put((i % 16 << 24) + i, 1);
+	}
+	int found = 0;
+	clock_t start = clock();
+	for (int n = 0; n < lookups; n++)
+		for (int i = 0; i < keyCount * 2; i++)
+			found += hashMap.containsKey((i % 16 << 24) + i);
+	clock_t hashTime = clock() - start;
+	start = clock();
+	for (int n = 0; n < lookups; n++)
+		for (int i = 0; i < keyCount * 2; i++)
+			found -= linearMap.containsKey((i % 16 << 24) + i);
+	clock_t linearTime = clock() - start;
+	assert(found == 0);
+	printf("%d keys, %d lookups: hash map %.2f ms, linear %.2f ms\n", keyCount, lookups * keyCount * 2,
+		hashTime * 1000.0 / CLOCKS_PER_SEC, linearTime * 1000.0 / CLOCKS_PER_SEC);
+}
+
+void testArena() {
+	printf("Testing arena\n");
+	Atlas *atlas = new(__FILE__, __LINE__) Atlas("testdata/spineboy/spineboy.atlas", NULL);
+
+	for (int format = 0; format < 2; format++) {
+		SkeletonData *skeletonData[2];
+		clock_t loadTime[2];
+		for (int arena = 0; arena < 2; arena++) {
+			clock_t start = clock();
+			if (format == 0) {
+				SkeletonBinary binary(atlas);
+				binary.setArenaEnabled(arena == 1);
+				skeletonData[arena] = binary.readSkeletonDataFile("testdata/spineboy/spineboy-pro.skel");
+			} else {
+				SkeletonJson json(atlas);
+				json.setArenaEnabled(arena == 1);
+				skeletonData[arena] = json.readSkeletonDataFile("testdata/spineboy/spineboy-pro.json");
+			}
+			loadTime[arena] = clock() - start;
+			assert(skeletonData[arena]);
+		}
+		assert(skeletonData[0]->getArena().getCapacity() == 0);
+		assert(skeletonData[1]->getArena().getUsed() > 0);
+		printf("%s: heap %.2f ms, arena %.2f ms, %lu of %lu bytes in arena used\n", format == 0 ? "binary" : "json",
+			loadTime[0] * 1000.0 / CLOCKS_PER_SEC, loadTime[1] * 1000.0 / CLOCKS_PER_SEC,
+			(unsigned long) skeletonData[1]->getArena().getUsed(), (unsigned long) skeletonData[1]->getArena().getCapacity());
+
+		// Growing arena memory after loading moves it to the heap, which is freed normally.
+		for (int i = 0; i < 100; i++)
+			skeletonData[1]->getEvents().add(new(__FILE__, __LINE__) EventData("added"));
+
+		Skeleton *skeletons[2];
+		AnimationState *states[2];
+		AnimationStateData *stateData[2];
+		for (int i = 0; i < 2; i++) {
+			skeletons[i] = new(__FILE__, __LINE__) Skeleton(skeletonData[i]);
+			stateData[i] = new(__FILE__, __LINE__) AnimationStateData(skeletonData[i]);
+			states[i] = new(__FILE__, __LINE__) AnimationState(stateData[i]);
+			states[i]->setAnimation(0, "run", true);
+		}
+		for (int frame = 0; frame < 30; frame++) {
+			for (int i = 0; i < 2; i++) {
+				states[i]->update(1 / 60.0f);
+				states[i]->apply(*skeletons[i]);
+				skeletons[i]->updateWorldTransform();
+			}
+			for (size_t i = 0; i < skeletons[0]->getBones().size(); i++) {
+				Bone *bone = skeletons[0]->getBones()[i], *arenaBone = skeletons[1]->getBones()[i];
+				assert(bone->getWorldX() == arenaBone->getWorldX() && bone->getWorldY() == arenaBone->getWorldY());
+			}
+		}
+		for (int i = 0; i < 2; i++)
+			dispose(NULL, skeletonData[i], stateData[i], skeletons[i], states[i]);
+	}
+
+	// Arena memory, including large allocations in their own block, is found until the arena is deleted.
+	Arena *arena = new(__FILE__, __LINE__) Arena(1024);
+	char *small = (char *) arena->alloc(16, false), *large = (char *) arena->alloc(4096, true);
+	char *heap = SpineExtension::alloc<char>(16, __FILE__, __LINE__);
+	assert(Arena::contains(small) && Arena::contains(large + 4095) && !Arena::contains(heap));
+	assert(arena->owns(small) && arena->owns(large) && !arena->owns(heap));
+	delete arena;
+	assert(!Arena::contains(small) && !Arena::contains(large));
+	SpineExtension::free(heap, __FILE__, __LINE__);
+
+	delete atlas;
+}
+
+void testArenaStrings() {
+	printf("Testing arena strings\n");
+	Atlas *atlas = new(__FILE__, __LINE__) Atlas("testdata/spineboy/spineboy.atlas", NULL);
+	SkeletonBinary binary(atlas);
+	binary.setArenaEnabled(true);
+	SkeletonData *skeletonData = binary.readSkeletonDataFile("testdata/spineboy/spineboy-pro.skel");
+	assert(skeletonData);
+
+	// Names read from the string table are shared, not copied.
+	SlotData *slotData = skeletonData->findSlot("gun");
+	Attachment *attachment = skeletonData->getDefaultSkin()->getAttachment(slotData->getIndex(), slotData->getAttachmentName());
+	assert(attachment);
+	assert(slotData->getAttachmentName().buffer() == attachment->getName().buffer());
+
+	// Copies outside the arena's scope are independent.
+	String name(attachment->getName());
+	assert(name.buffer() != attachment->getName().buffer());
+	{
+		ArenaScope scope(&skeletonData->getArena());
+		String shared(attachment->getName());
+		assert(shared.buffer() == attachment->getName().buffer());
+		shared.append("-suffix");
+		assert(shared.buffer() != attachment->getName().buffer());
+		assert(attachment->getName() == name);
+
+		// The last allocation of the current arena is not grown in place while it is shared.
+		String last("last");
+		String lastShared(last);
+		assert(last.buffer() == lastShared.buffer());
+		last.append("-suffix");
+		assert(last == "last-suffix" && lastShared == "last" && strlen(lastShared.buffer()) == 4);
+	}
+
+	delete skeletonData;
+	delete atlas;
+}
+
+void testNameLookup() {
+	Atlas *atlas = NULL;
+	SkeletonData *skeletonData = NULL;
+	AnimationStateData *stateData = NULL;
+	Skeleton *skeleton = NULL;
+	AnimationState *state = NULL;
+
+	printf("Testing name lookup\n");
+	loadBinary("testdata/spineboy/spineboy-pro.skel", "testdata/spineboy/spineboy.atlas", atlas, skeletonData, stateData, skeleton, state);
+
+	for (size_t i = 0; i < skeletonData->getBones().size(); i++) {
+		const String &name = skeletonData->getBones()[i]->getName();
+		assert(skeletonData->findBone(name) == ContainerUtil::findWithName(skeletonData->getBones(), name));
+		assert(skeleton->findBone(name) == ContainerUtil::findWithDataName(skeleton->getBones(), name));
+	}
+	for (size_t i = 0; i < skeletonData->getSlots().size(); i++) {
+		const String &name = skeletonData->getSlots()[i]->getName();
+		assert(skeletonData->findSlotIndex(name) == (int) i);
+		assert(skeleton->findSlot(name) == ContainerUtil::findWithDataName(skeleton->getSlots(), name));
+	}
+	for (size_t i = 0; i < skeletonData->getAnimations().size(); i++)
+		assert(skeletonData->findAnimation(skeletonData->getAnimations()[i]->getName()) == skeletonData->getAnimations()[i]);
+	for (size_t i = 0; i < skeletonData->getIkConstraints().size(); i++) {
+		const String &name = skeletonData->getIkConstraints()[i]->getName();
+		assert(&skeleton->findIkConstraint(name)->getData() == skeletonData->getIkConstraints()[i]);
+	}
+	assert(skeletonData->findBone("missing") == NULL && skeleton->findSlot("missing") == NULL);
+	assert(skeletonData->findAnimation("missing") == NULL && skeletonData->findSkin("missing") == NULL);
+	assert(atlas->findRegion("head") != NULL && atlas->findRegion("head")->name == "head");
+	assert(atlas->findRegion("missing") == NULL);
+
+	// Changed items fall back to a linear search until the indices are updated.
+	Animation *run = skeletonData->findAnimation("run");
+	Vector<Animation *> &animations = skeletonData->getAnimations();
+	animations.removeAt(animations.indexOf(run));
+	assert(skeletonData->findAnimation("run") == NULL && skeletonData->findAnimation("aim") != NULL);
+	animations.add(run);
+	assert(skeletonData->findAnimation("run") == run && skeletonData->findAnimation("aim") != NULL);
+	skeletonData->updateNameIndices();
+	assert(skeletonData->findAnimation("run") == run && skeletonData->findAnimation("missing") == NULL);
+
+	// Replacing an item keeps the number of items but must not hide the new name.
+	Vector<Timeline *> timelines;
+	Animation *extra = new(__FILE__, __LINE__) Animation("extra", timelines, 1);
+	size_t runIndex = animations.indexOf(run);
+	animations[runIndex] = extra;
+	assert(skeletonData->findAnimation("extra") == extra && skeletonData->findAnimation("run") == NULL);
+	animations[runIndex] = run;
+	assert(skeletonData->findAnimation("extra") == NULL && skeletonData->findAnimation("run") == run);
+	delete extra;
+
+	// Skin attachments are found through the per slot index, also after replacing and removing attachments.
+	Skin *skin = skeletonData->getDefaultSkin();
+	Skin::AttachmentMap::Entries entries = skin->getAttachments();
+	while (entries.hasNext()) {
+		Skin::AttachmentMap::Entry &entry = entries.next();
+		assert(skin->getAttachment(entry._slotIndex, entry._name) == entry._attachment);
+	}
+	size_t slotIndex = skeletonData->findSlotIndex("head");
+	Attachment *head = skin->getAttachment(slotIndex, "head");
+	assert(head && skin->getAttachment(slotIndex, "missing") == NULL);
+	Skin copy("copy");
+	copy.setAttachment(slotIndex, "a", head);
+	copy.setAttachment(slotIndex, "b", head);
+	copy.setAttachment(slotIndex, "c", head);
+	copy.setAttachment(slotIndex, "b", head);
+	copy.removeAttachment(slotIndex, "a");
+	assert(copy.getAttachment(slotIndex, "a") == NULL && copy.getAttachment(slotIndex, "b") == head);
+	assert(copy.getAttachment(slotIndex, "c") == head && copy.getAttachment(slotIndex + 1, "c") == NULL);
+	Vector<String> names;
+	copy.findNamesForSlot(slotIndex, names);
+	assert(names.size() == 2 && names[0] == "b" && names[1] == "c");
+
+	dispose(atlas, skeletonData, stateData, skeleton, state);
+}
+
+void testRtti() {
+	printf("Testing RTTI\n");
+	assert(MeshAttachment::rtti.isExactly(MeshAttachment::rtti));
+	assert(!MeshAttachment::rtti.isExactly(VertexAttachment::rtti));
+	assert(MeshAttachment::rtti.instanceOf(MeshAttachment::rtti));
+	assert(MeshAttachment::rtti.instanceOf(VertexAttachment::rtti));
+	assert(MeshAttachment::rtti.instanceOf(Attachment::rtti));
+	assert(!MeshAttachment::rtti.instanceOf(RegionAttachment::rtti));
+	assert(!Attachment::rtti.instanceOf(MeshAttachment::rtti));
+	assert(ScaleTimeline::rtti.instanceOf(TranslateTimeline::rtti));
+	assert(ScaleTimeline::rtti.instanceOf(CurveTimeline::rtti));
+	assert(ScaleTimeline::rtti.instanceOf(Timeline::rtti));
+	assert(!ScaleTimeline::rtti.instanceOf(RotateTimeline::rtti));
+	assert(!RotateTimeline::rtti.instanceOf(Attachment::rtti));
+}
+
+void testFrameCursors() {
+	Atlas *atlas = NULL;
+	SkeletonData *skeletonData = NULL;
+	AnimationStateData *stateData = NULL;
+	Skeleton *skeleton = NULL;
+	AnimationState *state = NULL;
+
+	printf("Testing frame cursors\n");
+	loadBinary("testdata/spineboy/spineboy-pro.skel", "testdata/spineboy/spineboy.atlas", atlas, skeletonData, stateData, skeleton, state);
+
+	Skeleton *searchSkeleton = new(__FILE__, __LINE__) Skeleton(skeletonData);
+	AnimationState *searchState = new(__FILE__, __LINE__) AnimationState(stateData);
+	searchState->setFrameCursorsEnabled(false);
+
+	AnimationState *states[] = {state, searchState};
+	Skeleton *skeletons[] = {skeleton, searchSkeleton};
+	for (int frame = 0; frame < 240; frame++) {
+		for (int i = 0; i < 2; i++) {
+			if (frame == 0) {
+				states[i]->setAnimation(0, "run", true);
+				states[i]->addAnimation(1, "aim", true, 0.5f);
+			} else if (frame == 90) {
+				states[i]->setAnimation(0, "walk", true);
+			} else if (frame == 150) {
+				// Seek backward.
+				states[i]->getCurrent(0)->setTrackTime(0.1f);
+			}
+			states[i]->update(1 / 60.0f);
+			states[i]->apply(*skeletons[i]);
+			skeletons[i]->updateWorldTransform();
+		}
+		for (size_t i = 0; i < skeleton->getBones().size(); i++) {
+			Bone *bone = skeleton->getBones()[i], *searchBone = searchSkeleton->getBones()[i];
+			assert(bone->getWorldX() == searchBone->getWorldX() && bone->getWorldY() == searchBone->getWorldY());
+			assert(bone->getA() == searchBone->getA() && bone->getD() == searchBone->getD());
+		}
+		for (size_t i = 0; i < skeleton->getSlots().size(); i++)
+			assert(skeleton->getSlots()[i]->getAttachment() == searchSkeleton->getSlots()[i]->getAttachment());
+	}
+
+	delete searchState;
+	delete searchSkeleton;
+	dispose(atlas, skeletonData, stateData, skeleton, state);
+}
+
+void testBakedAnimation() {
+	Atlas *atlas = NULL;
+	SkeletonData *skeletonData = NULL;
+	AnimationStateData *stateData = NULL;
+	Skeleton *skeleton = NULL;
+	AnimationState *state = NULL;
+
+	printf("Testing baked animation\n");
+	loadBinary("testdata/spineboy/spineboy-pro.skel", "testdata/spineboy/spineboy.atlas", atlas, skeletonData, stateData, skeleton, state);
+
+	Animation *run = skeletonData->findAnimation("run");
+	BakedAnimation coarse(*skeletonData, *run, 15);
+	BakedAnimation baked(*skeletonData, *run, 60);
+	BakedAnimation quantized(*skeletonData, *run, 60, true);
+	BakedAnimation budgeted(*skeletonData, *run, 60, false, baked.getMemorySize() / 4);
+	printf("  max error: %f, quantized: %f, budgeted: %f (%f fps)\n", baked.getMaxError(), quantized.getMaxError(),
+		   budgeted.getMaxError(), budgeted.getSampleRate());
+	assert(baked.getFrameCount() > 2);
+	assert(baked.getMaxError() < coarse.getMaxError());
+	assert(MathUtil::abs(quantized.getMaxError() - baked.getMaxError()) < 0.5f);
+	assert(quantized.getMemorySize() < baked.getMemorySize());
+	assert(budgeted.getMemorySize() <= baked.getMemorySize() / 4);
+	assert(budgeted.getMaxError() >= baked.getMaxError());
+
+	// Sample times match live evaluation exactly.
+	Skeleton *live = new(__FILE__, __LINE__) Skeleton(skeletonData);
+	float time = 10 / 60.0f;
+	run->apply(*live, time, time, false, NULL, 1, MixBlend_Setup, MixDirection_In);
+	live->updateWorldTransform();
+	baked.apply(*skeleton, time + run->getDuration(), true);
+	for (size_t i = 0; i < skeleton->getBones().size(); i++) {
+		Bone *bone = skeleton->getBones()[i], *liveBone = live->getBones()[i];
+		assert(MathUtil::abs(bone->getWorldX() - liveBone->getWorldX()) < 0.01f);
+		assert(MathUtil::abs(bone->getWorldY() - liveBone->getWorldY()) < 0.01f);
+	}
+	for (size_t i = 0; i < skeleton->getSlots().size(); i++)
+		assert(skeleton->getSlots()[i]->getAttachment() == live->getSlots()[i]->getAttachment());
+
+	delete live;
+	dispose(atlas, skeletonData, stateData, skeleton, state);
+}
+
+static Vector<size_t> *batchEvents;
+
+static void recordBatchEvent(AnimationState *state, EventType type, TrackEntry *entry, Event *event) {
+	SP_UNUSED(entry);
+	batchEvents->add(*(size_t *) state->getRendererObject());
+	batchEvents->add((size_t) type);
+	batchEvents->add((size_t) event);
+}
+
+void testUpdateBatch() {
+	Atlas *atlas = NULL;
+	SkeletonData *skeletonData = NULL;
+	AnimationStateData *stateData = NULL;
+	Skeleton *skeleton = NULL;
+	AnimationState *state = NULL;
+
+	printf("Testing update batch\n");
+	loadBinary("testdata/spineboy/spineboy-pro.skel", "testdata/spineboy/spineboy.atlas", atlas, skeletonData, stateData, skeleton, state);
+
+	// Updates the first half of the items one by one and the second half through the batch.
+	const size_t count = 10;
+	size_t indices[count];
+	Skeleton *skeletons[count * 2];
+	AnimationState *states[count * 2];
+	SkeletonUpdateBatch batch(3);
+	Vector<size_t> events;
+	batchEvents = &events;
+	for (size_t i = 0; i < count * 2; i++) {
+		indices[i % count] = i % count;
+		skeletons[i] = new(__FILE__, __LINE__) Skeleton(skeletonData);
+		states[i] = new(__FILE__, __LINE__) AnimationState(stateData);
+		states[i]->setRendererObject(&indices[i % count]);
+		states[i]->setListener(recordBatchEvent);
+		if (i % count % 3 == 0) {
+			states[i]->setAnimation(0, "jump", false);
+			states[i]->addAnimation(0, "walk", true, 0);
+		} else
+			states[i]->setAnimation(0, i % count % 3 == 1 ? "run" : "walk", true);
+		if (i >= count) batch.add(states[i], skeletons[i], (1 + i % count % 4) / 60.0f);
+	}
+	assert(batch.size() == count);
+
+	for (int frame = 0; frame < 180; frame++) {
+		events.clear();
+		for (size_t i = 0; i < count; i++) {
+			states[i]->update((1 + i % 4) / 60.0f);
+			states[i]->apply(*skeletons[i]);
+			skeletons[i]->updateWorldTransform();
+		}
+		Vector<size_t> expectedEvents;
+		expectedEvents.addAll(events);
+
+		events.clear();
+		if (frame % 2 == 0) {
+			batch.begin();
+			batch.run();
+			batch.run();
+			assert(events.size() == 0);
+			batch.end();
+		} else {
+			batch.begin();
+			batch.runRange(count / 2, count);
+			batch.runRange(0, count / 2);
+			batch.end();
+		}
+		assert(expectedEvents.size() == events.size());
+		for (size_t i = 0; i < expectedEvents.size(); i++)
+			assert(expectedEvents[i] == events[i]);
+
+		for (size_t i = 0; i < count; i++) {
+			Vector<Bone *> &bones = skeletons[i]->getBones(), &batchBones = skeletons[count + i]->getBones();
+			for (size_t ii = 0; ii < bones.size(); ii++) {
+				assert(bones[ii]->getWorldX() == batchBones[ii]->getWorldX());
+				assert(bones[ii]->getWorldY() == batchBones[ii]->getWorldY());
+			}
+		}
+	}
+
+	for (size_t i = 0; i < count * 2; i++) {
+		delete states[i];
+		delete skeletons[i];
+	}
+	dispose(atlas, skeletonData, stateData, skeleton, state);
+}
+
+static void runUpdateBatch(void *batch) {
+	((SkeletonUpdateBatch *) batch)->run();
+}
+
+void testThreadedUpdateBatch() {
+	printf("Testing threaded update batch\n");
+	LockingExtension locking;
+	Atlas *atlas = new(__FILE__, __LINE__) Atlas("testdata/spineboy/spineboy.atlas", NULL);
+
+	// Skeleton data in arenas, with animations that are loaded on demand by SkeletonUpdateBatch::begin().
+	SkeletonBinary binary(atlas);
+	binary.setArenaEnabled(true);
+	binary.setLazyAnimationsEnabled(true);
+	SkeletonData *lazyData = binary.readSkeletonDataFile("testdata/spineboy/spineboy-pro.skel");
+	SkeletonJson json(atlas);
+	json.setArenaEnabled(true);
+	SkeletonData *jsonData = json.readSkeletonDataFile("testdata/spineboy/spineboy-pro.json");
+	assert(lazyData && jsonData && !lazyData->findAnimation("run")->isLoaded());
+	AnimationStateData *lazyStateData = new(__FILE__, __LINE__) AnimationStateData(lazyData);
+	AnimationStateData *jsonStateData = new(__FILE__, __LINE__) AnimationStateData(jsonData);
+	lazyStateData->setDefaultMix(0.2f);
+	jsonStateData->setDefaultMix(0.2f);
+
+	// Updates the first half of the items one by one and the second half through the batch on several threads.
+	const size_t count = 40;
+	const int threadCount = 4;
+	const char *names[] = {"run", "walk", "jump", "idle", "hoverboard"};
+	Skeleton *skeletons[count * 2];
+	AnimationState *states[count * 2];
+	SkeletonUpdateBatch batch(2);
+	for (size_t i = 0; i < count * 2; i++) {
+		size_t item = i % count;
+		skeletons[i] = new(__FILE__, __LINE__) Skeleton(item % 2 ? lazyData : jsonData);
+		states[i] = new(__FILE__, __LINE__) AnimationState(item % 2 ? lazyStateData : jsonStateData);
+		states[i]->setAnimation(0, names[item % 5], true);
+		if (item % 3 == 0) states[i]->setAnimation(1, "shoot", true);
+		if (i >= count) batch.add(states[i], skeletons[i], (1 + item % 4) / 60.0f);
+	}
+
+	for (int frame = 0; frame < 120; frame++) {
+		if (frame == 60) {
+			// Animations that were not applied yet are loaded by the next begin().
+			for (size_t i = 0; i < count * 2; i++)
+				states[i]->setAnimation(0, i % count % 2 ? "death" : "portal", false);
+		}
+
+		batch.begin();
+		TestThread threads[threadCount];
+		for (int i = 0; i < threadCount; i++)
+			threads[i].start(runUpdateBatch, &batch);
+		for (int i = 0; i < threadCount; i++)
+			threads[i].join();
+		batch.end();
+
+		for (size_t i = 0; i < count; i++) {
+			states[i]->update((1 + i % 4) / 60.0f);
+			states[i]->apply(*skeletons[i]);
+			skeletons[i]->updateWorldTransform();
+		}
+
+		for (size_t i = 0; i < count; i++) {
+			Vector<Bone *> &bones = skeletons[i]->getBones(), &batchBones = skeletons[count + i]->getBones();
+			for (size_t ii = 0; ii < bones.size(); ii++) {
+				assert(bones[ii]->getWorldX() == batchBones[ii]->getWorldX());
+				assert(bones[ii]->getWorldY() == batchBones[ii]->getWorldY());
+				assert(bones[ii]->getA() == batchBones[ii]->getA() && bones[ii]->getD() == batchBones[ii]->getD());
+			}
+			Vector<Slot *> &slots = skeletons[i]->getSlots(), &batchSlots = skeletons[count + i]->getSlots();
+			for (size_t ii = 0; ii < slots.size(); ii++)
+				assert(slots[ii]->getAttachment() == batchSlots[ii]->getAttachment());
+		}
+	}
+	assert(lazyData->findAnimation("death")->isLoaded() && !lazyData->findAnimation("aim")->isLoaded());
+
+	for (size_t i = 0; i < count * 2; i++) {
+		delete states[i];
+		delete skeletons[i];
+	}
+	delete jsonStateData;
+	delete lazyStateData;
+	delete jsonData;
+	delete lazyData;
+	delete atlas;
+}
+
+void testAtlasValues() {
+	printf("Testing atlas values\n");
+	const char *data =
+		"test.png\n"
+		"size: 1024,512\n"
+		"format: RGBA8888\n"
+		"filter: Linear,Linear\n"
+		"repeat: none\n"
+		"region\n"
+		"  rotate: false\n"
+		"  xy: 231, 203\n"
+		"  size: 18, 16\n"
+		"  split: 12, 34, 56, 78\n"
+		"  pad: 1, 2, 3, 4\n"
+		"  orig: 20, 19\n"
+		"  offset: 1, 2\n"
+		"  index: -1\n";
+	Atlas *atlas = new(__FILE__, __LINE__) Atlas(data, (int) strlen(data), "", NULL, false);
+	AtlasPage *page = atlas->getPages()[0];
+	assert(page->width == 1024 && page->height == 512);
+	AtlasRegion *region = atlas->findRegion("region");
+	assert(region);
+	assert(region->x == 231 && region->y == 203);
+	assert(region->width == 18 && region->height == 16);
+	assert(region->originalWidth == 20 && region->originalHeight == 19);
+	assert(region->offsetX == 1 && region->offsetY == 2);
+	assert(region->splits.size() == 4 && region->splits[0] == 12 && region->splits[3] == 78);
+	assert(region->pads.size() == 4 && region->pads[0] == 1 && region->pads[3] == 4);
+	assert(region->u == 231 / 1024.0f && region->u2 == (231 + 18) / 1024.0f);
+	delete atlas;
+
+	// Mapped files are not NUL terminated, so nothing past the data may be read, also not for a last line without a
+	// line break or a value without a colon.
+	const char *unterminated =
+		"test.png\r\n"
+		"size: 1024,512\r\n"
+		"format: RGBA8888\r\n"
+		"filter: Linear,Linear\r\n"
+		"repeat: none\r\n"
+		"region\r\n"
+		"  rotate: false\r\n"
+		"  xy: 231, 203\r\n"
+		"  size: 18, 16\r\n"
+		"  orig: 20, 19\r\n"
+		"  offset: 1, 2\r\n"
+		"  index: -1\r\n"
+		"  ";
+	int length = (int) strlen(unterminated);
+	char *copy = SpineExtension::alloc<char>(length, __FILE__, __LINE__);
+	memcpy(copy, unterminated, length);
+	atlas = new(__FILE__, __LINE__) Atlas(copy, length, "", NULL, false);
+	region = atlas->findRegion("region");
+	assert(region && region->x == 231 && region->index == -1);
+	delete atlas;
+	atlas = new(__FILE__, __LINE__) Atlas(copy, length - 8, "", NULL, false);
+	delete atlas;
+	SpineExtension::free(copy, __FILE__, __LINE__);
+}
+
+void testMapFile() {
+	printf("Testing mapped files\n");
+	int length = 0, mappedLength = 0;
+	char *data = SpineExtension::readFile("testdata/spineboy/spineboy-pro.skel", &length);
+	const char *mapped = SpineExtension::mapFile("testdata/spineboy/spineboy-pro.skel", &mappedLength);
+	assert(data && mapped);
+	assert(length == mappedLength);
+	assert(memcmp(data, mapped, length) == 0);
+	SpineExtension::unmapFile(mapped, mappedLength);
+	SpineExtension::free(data, __FILE__, __LINE__);
+
+	assert(SpineExtension::mapFile("testdata/missing.skel", &mappedLength) == NULL);
+	assert(mappedLength == 0);
+}
+
+/// Decodes a timeline, then fails like a loader that finds a missing attachment.
+class FailingTimelineLoader : public TimelineLoader {
+public:
+	int _calls;
+
+	FailingTimelineLoader() : _calls(0) {
+	}
+
+	virtual bool loadTimelines(Animation &animation, Vector<Timeline *> &timelines) {
+		SP_UNUSED(animation);
+		_calls++;
+		timelines.add(new(__FILE__, __LINE__) RotateTimeline(2));
+		return false;
+	}
+};
+
+void testLazyAnimations() {
+	Atlas *atlas = NULL;
+	SkeletonData *skeletonData = NULL;
+	AnimationStateData *stateData = NULL;
+	Skeleton *skeleton = NULL;
+	AnimationState *state = NULL;
+
+	printf("Testing lazy animations\n");
+	loadBinary("testdata/spineboy/spineboy-pro.skel", "testdata/spineboy/spineboy.atlas", atlas, skeletonData, stateData, skeleton, state);
+
+	SkeletonBinary binary(atlas);
+	binary.setLazyAnimationsEnabled(true);
+	SkeletonData *lazyData = binary.readSkeletonDataFile("testdata/spineboy/spineboy-pro.skel");
+	assert(lazyData);
+	assert(lazyData->getAnimations().size() == skeletonData->getAnimations().size());
+	for (size_t i = 0; i < lazyData->getAnimations().size(); i++) {
+		Animation *animation = skeletonData->getAnimations()[i], *lazyAnimation = lazyData->getAnimations()[i];
+		assert(!lazyAnimation->isLoaded());
+		assert(animation->getName() == lazyAnimation->getName());
+		assert(animation->getDuration() == lazyAnimation->getDuration());
+	}
+
+	AnimationStateData *lazyStateData = new(__FILE__, __LINE__) AnimationStateData(lazyData);
+	lazyStateData->setDefaultMix(0.4f);
+	Skeleton *lazySkeleton = new(__FILE__, __LINE__) Skeleton(lazyData);
+	AnimationState *lazyState = new(__FILE__, __LINE__) AnimationState(lazyStateData);
+	Animation *run = lazyData->findAnimation("run");
+	for (int frame = 0; frame < 120; frame++) {
+		if (frame == 0) {
+			state->setAnimation(0, "walk", true);
+			lazyState->setAnimation(0, "walk", true);
+		} else if (frame == 30) {
+			state->setAnimation(0, "run", true);
+			lazyState->setAnimation(0, "run", true);
+		} else if (frame == 90) {
+			// Evicted animations are decoded again when next applied.
+			run->unload();
+			assert(!run->isLoaded());
+		}
+		state->update(1 / 60.0f);
+		state->apply(*skeleton);
+		skeleton->updateWorldTransform();
+		lazyState->update(1 / 60.0f);
+		lazyState->apply(*lazySkeleton);
+		lazySkeleton->updateWorldTransform();
+		for (size_t i = 0; i < skeleton->getBones().size(); i++) {
+			Bone *bone = skeleton->getBones()[i], *lazyBone = lazySkeleton->getBones()[i];
+			assert(bone->getWorldX() == lazyBone->getWorldX() && bone->getWorldY() == lazyBone->getWorldY());
+		}
+	}
+	assert(run->isLoaded());
+	assert(run->getTimelines().size() == skeletonData->findAnimation("run")->getTimelines().size());
+	assert(!lazyData->findAnimation("death")->isLoaded());
+	assert(lazyData->findAnimation("death")->load() && lazyData->findAnimation("death")->isLoaded());
+
+	// A failed load leaves the animation empty and unloaded, and is only retried after unload().
+	FailingTimelineLoader failingLoader;
+	Animation failing("failing", 1, &failingLoader);
+	assert(!failing.load() && !failing.isLoaded() && failingLoader._calls == 1);
+	assert(failing.getTimelines().size() == 0 && failingLoader._calls == 1);
+	failing.unload();
+	assert(!failing.load() && failingLoader._calls == 2);
+
+	delete lazyState;
+	delete lazySkeleton;
+	delete lazyStateData;
+	delete lazyData;
+	dispose(atlas, skeletonData, stateData, skeleton, state);
+}
+
+/// Runs jobs last to first, so results that depend on the job order show up as differences.
+class ReverseJobRunner : public JobRunner {
+public:
+	int _jobs;
+
+	ReverseJobRunner() : _jobs(0) {
+	}
+
+	virtual void run(Job &job, int count) {
+		for (int i = count - 1; i >= 0; i--)
+			job.run(i);
+		_jobs += count;
+	}
+};
+
+/// Asserts that skeleton data loaded with a job runner matches the data loaded without one.
+static void assertSameSkeletonData(SkeletonData *serialData, SkeletonData *parallelData) {
+	assert(parallelData->getSkins().size() == serialData->getSkins().size());
+	assert(parallelData->getDefaultSkin()->getName() == serialData->getDefaultSkin()->getName());
+	for (size_t i = 0; i < serialData->getSkins().size(); i++) {
+		Skin *serialSkin = serialData->getSkins()[i], *parallelSkin = parallelData->getSkins()[i];
+		assert(serialSkin->getName() == parallelSkin->getName());
+		Skin::AttachmentMap::Entries entries = serialSkin->getAttachments();
+		while (entries.hasNext()) {
+			Skin::AttachmentMap::Entry &entry = entries.next();
+			Attachment *attachment = parallelSkin->getAttachment(entry._slotIndex, entry._name);
+			assert(attachment && attachment->getRTTI().isExactly(entry._attachment->getRTTI()));
+			if (!attachment->getRTTI().isExactly(MeshAttachment::rtti)) continue;
+			MeshAttachment *serialMesh = static_cast<MeshAttachment *>(entry._attachment);
+			MeshAttachment *parallelMesh = static_cast<MeshAttachment *>(attachment);
+			assert(serialMesh->getVertices().size() == parallelMesh->getVertices().size());
+			assert(serialMesh->getUVs().size() == parallelMesh->getUVs().size());
+			for (size_t ii = 0; ii < serialMesh->getUVs().size(); ii++)
+				assert(serialMesh->getUVs()[ii] == parallelMesh->getUVs()[ii]);
+			// Linked meshes are resolved against the parent in the same skin data.
+			assert((serialMesh->getParentMesh() == NULL) == (parallelMesh->getParentMesh() == NULL));
+			if (serialMesh->getParentMesh())
+				assert(parallelMesh->getParentMesh()->getName() == serialMesh->getParentMesh()->getName());
+		}
+	}
+
+	assert(parallelData->getAnimations().size() == serialData->getAnimations().size());
+	Skeleton serial(serialData), parallel(parallelData);
+	for (size_t i = 0; i < serialData->getAnimations().size(); i++) {
+		Animation *serialAnimation = serialData->getAnimations()[i], *parallelAnimation = parallelData->getAnimations()[i];
+		assert(serialAnimation->getName() == parallelAnimation->getName());
+		assert(serialAnimation->getDuration() == parallelAnimation->getDuration());
+		assert(serialAnimation->getTimelines().size() == parallelAnimation->getTimelines().size());
+		float time = serialAnimation->getDuration() * 0.5f;
+		serial.setToSetupPose();
+		parallel.setToSetupPose();
+		serialAnimation->apply(serial, 0, time, false, NULL, 1, MixBlend_Setup, MixDirection_In);
+		parallelAnimation->apply(parallel, 0, time, false, NULL, 1, MixBlend_Setup, MixDirection_In);
+		serial.updateWorldTransform();
+		parallel.updateWorldTransform();
+		for (size_t ii = 0; ii < serial.getBones().size(); ii++) {
+			Bone *bone = serial.getBones()[ii], *parallelBone = parallel.getBones()[ii];
+			assert(bone->getWorldX() == parallelBone->getWorldX() && bone->getWorldY() == parallelBone->getWorldY());
+		}
+	}
+}
+
+void testParallelLoading() {
+	const char *files[][2] = {
+		{"testdata/goblins/goblins-pro.skel", "testdata/goblins/goblins.atlas"},
+		{"testdata/spineboy/spineboy-pro.skel", "testdata/spineboy/spineboy.atlas"}
+	};
+	printf("Testing parallel loading\n");
+	for (int f = 0; f < 2; f++) {
+		Atlas *atlas = new(__FILE__, __LINE__) Atlas(files[f][1], NULL);
+		SkeletonBinary binary(atlas);
+		SkeletonData *serialData = binary.readSkeletonDataFile(files[f][0]);
+		assert(serialData);
+		ReverseJobRunner runner;
+		binary.setJobRunner(&runner);
+		SkeletonData *parallelData = binary.readSkeletonDataFile(files[f][0]);
+		assert(parallelData);
+		assert(runner._jobs == (int) (serialData->getSkins().size() + serialData->getAnimations().size()) + (serialData->getDefaultSkin() ? 0 : 1));
+
+		assertSameSkeletonData(serialData, parallelData);
+
+		// Jobs running on other threads, with the skeleton data in an arena.
+		{
+			LockingExtension locking;
+			ThreadJobRunner threadRunner(4);
+			binary.setJobRunner(&threadRunner);
+			binary.setArenaEnabled(true);
+			SkeletonData *threadData = binary.readSkeletonDataFile(files[f][0]);
+			assert(threadData && threadRunner._jobs == runner._jobs);
+			assertSameSkeletonData(serialData, threadData);
+			delete threadData;
+			binary.setJobRunner(NULL);
+		}
+
+		delete parallelData;
+		delete serialData;
+		delete atlas;
+	}
+}
+
+void testBinaryAtlas() {
+	const char *files[][3] = {
+		{"testdata/goblins/goblins-pro.skel", "testdata/goblins/goblins.atlas", "testdata/goblins"},
+		{"testdata/spineboy/spineboy-pro.skel", "testdata/spineboy/spineboy.atlas", "testdata/spineboy"}
+	};
+	printf("Testing binary atlas\n");
+	for (int f = 0; f < 2; f++) {
+		Atlas *textAtlas = new(__FILE__, __LINE__) Atlas(files[f][1], NULL, false);
+		Vector<unsigned char> binary;
+		textAtlas->writeBinary(binary);
+		Atlas *binaryAtlas = new(__FILE__, __LINE__) Atlas((const char *) binary.buffer(), (int) binary.size(), files[f][2], NULL, false);
+
+		// Writing the atlas read from the binary format gives the same binary.
+		Vector<unsigned char> binary2;
+		binaryAtlas->writeBinary(binary2);
+		assert(binary2.size() == binary.size() && memcmp(binary.buffer(), binary2.buffer(), binary.size()) == 0);
+		assert(binaryAtlas->getPages().size() == textAtlas->getPages().size());
+		assert(binaryAtlas->getPages()[0]->texturePath == textAtlas->getPages()[0]->texturePath);
+
+		// Every attachment finds the same region in both atlases.
+		SkeletonBinary textLoader(textAtlas), binaryLoader(binaryAtlas);
+		SkeletonData *textData = textLoader.readSkeletonDataFile(files[f][0]);
+		SkeletonData *binaryData = binaryLoader.readSkeletonDataFile(files[f][0]);
+		assert(textData && binaryData);
+		Skin::AttachmentMap::Entries entries = textData->getDefaultSkin()->getAttachments();
+		while (entries.hasNext()) {
+			Skin::AttachmentMap::Entry &entry = entries.next();
+			if (!entry._attachment->getRTTI().isExactly(RegionAttachment::rtti)) continue;
+			RegionAttachment *region = static_cast<RegionAttachment *>(entry._attachment);
+			RegionAttachment *binaryRegion = static_cast<RegionAttachment *>(binaryData->getDefaultSkin()->getAttachment(entry._slotIndex, entry._name));
+			AtlasRegion *atlasRegion = textAtlas->findRegion(region->getPath());
+			AtlasRegion *binaryAtlasRegion = binaryAtlas->findRegion(region->getPath());
+			assert(atlasRegion && binaryAtlasRegion && atlasRegion != binaryAtlasRegion);
+			assert(atlasRegion->name == binaryAtlasRegion->name && atlasRegion->index == binaryAtlasRegion->index);
+			assert(atlasRegion->u == binaryAtlasRegion->u && atlasRegion->v2 == binaryAtlasRegion->v2);
+			for (int i = 0; i < 8; i++)
+				assert(region->getUVs()[i] == binaryRegion->getUVs()[i]);
+		}
+		assert(!binaryAtlas->findRegion("no such region"));
+		delete binaryData;
+		delete textData;
+
+		// Truncated binary atlases load nothing.
+		for (size_t length = 4; length < binary.size(); length += binary.size() / 20 + 1) {
+			Atlas truncated((const char *) binary.buffer(), (int) length, "", NULL, false);
+			assert(truncated.getPages().size() == 0);
+		}
+
+		delete binaryAtlas;
+		delete textAtlas;
+	}
+}
+
+/// Queues jobs until runAll(), like a thread pool that has not got to them yet.
+class DeferredJobRunner : public JobRunner {
+public:
+	Vector<Job *> _queued;
+	Vector<Job *> _done;
+
+	virtual void start(Job &job, int count) {
+		assert(count == 1);
+		_queued.add(&job);
+	}
+
+	virtual bool isDone(Job &job) {
+		return _done.contains(&job);
+	}
+
+	void runAll() {
+		for (size_t i = 0; i < _queued.size(); i++) {
+			_queued[i]->run(0);
+			_done.add(_queued[i]);
+		}
+		_queued.clear();
+	}
+};
+
+class CountingTextureLoader : public TextureLoader {
+public:
+	int _loaded, _unloaded;
+
+	CountingTextureLoader() : _loaded(0), _unloaded(0) {
+	}
+
+	virtual void load(AtlasPage &page, const String &path) {
+		assert(path.length() > 0);
+		page.setRendererObject(&page);
+		_loaded++;
+	}
+
+	virtual void unload(void *texture) {
+		assert(texture);
+		_unloaded++;
+	}
+};
+
+static int asyncLoadsDone;
+
+static void countAsyncLoad(AsyncLoader *loader, AsyncLoad *load) {
+	assert(loader && load->isDone());
+	asyncLoadsDone++;
+}
+
+void testAsyncLoader() {
+	printf("Testing async loader\n");
+	DeferredJobRunner runner;
+	CountingTextureLoader textureLoader;
+	asyncLoadsDone = 0;
+	{
+		AsyncLoader loader(&runner);
+		loader.setListener(countAsyncLoad);
+		AsyncLoad *atlasLoad = loader.loadAtlas("testdata/spineboy/spineboy.atlas", &textureLoader);
+		AsyncLoad *binaryLoad = loader.loadSkeletonData("testdata/spineboy/spineboy-pro.skel", atlasLoad);
+		AsyncLoad *jsonLoad = loader.loadSkeletonData("testdata/spineboy/spineboy-pro.json", atlasLoad, 0.5f);
+		// Concurrent requests for a path share one load, unless they differ in scale or atlas.
+		assert(loader.loadSkeletonData("testdata/spineboy/spineboy-pro.skel", atlasLoad) == binaryLoad);
+		loader.release(binaryLoad);
+		AsyncLoad *scaledLoad = loader.loadSkeletonData("testdata/spineboy/spineboy-pro.skel", atlasLoad, 2);
+		assert(scaledLoad != binaryLoad);
+		loader.release(scaledLoad);
+		AsyncLoad *otherAtlasLoad = loader.loadAtlas("testdata/spineboy/spineboy.atlas", NULL);
+		assert(otherAtlasLoad != atlasLoad);
+		AsyncLoad *otherBinaryLoad = loader.loadSkeletonData("testdata/spineboy/spineboy-pro.skel", otherAtlasLoad);
+		assert(otherBinaryLoad != binaryLoad);
+		loader.release(otherBinaryLoad);
+		loader.release(otherAtlasLoad);
+		AsyncLoad *missingLoad = loader.loadSkeletonData("testdata/spineboy/missing.skel", atlasLoad);
+		assert(runner._queued.size() == 2);
+
+		// Nothing happens until the jobs run and update() is called.
+		loader.update();
+		assert(!atlasLoad->isDone() && !atlasLoad->getAtlas() && textureLoader._loaded == 0);
+		runner.runAll();
+		assert(!atlasLoad->isDone() && textureLoader._loaded == 0);
+		loader.update();
+		assert(atlasLoad->isDone() && atlasLoad->getAtlas() && atlasLoad->getError().isEmpty());
+		assert(textureLoader._loaded == (int) atlasLoad->getAtlas()->getPages().size());
+		assert(asyncLoadsDone == 1);
+		assert(runner._queued.size() == 3 && loader.getPendingCount() == 3);
+
+		runner.runAll();
+		loader.update();
+		assert(loader.getPendingCount() == 0 && asyncLoadsDone == 4);
+		assert(binaryLoad->getSkeletonData() && jsonLoad->getSkeletonData());
+		assert(binaryLoad->getSkeletonData()->getBones().size() == jsonLoad->getSkeletonData()->getBones().size());
+		assert(jsonLoad->getSkeletonData()->getBones()[1]->getX() == binaryLoad->getSkeletonData()->getBones()[1]->getX() * 0.5f);
+		assert(!missingLoad->getSkeletonData() && !missingLoad->getError().isEmpty());
+
+		// Loads released while their job runs are deleted once it returns, without calling the listener.
+		AsyncLoad *releasedLoad = loader.loadSkeletonData("testdata/spineboy/spineboy-ess.skel", atlasLoad);
+		loader.release(releasedLoad);
+		assert(loader.getPendingCount() == 1);
+		runner.runAll();
+		loader.update();
+		assert(loader.getPendingCount() == 0 && asyncLoadsDone == 4);
+
+		// Skeleton data waiting for an atlas that failed fails too.
+		AsyncLoad *missingAtlasLoad = loader.loadAtlas("testdata/missing.atlas", &textureLoader);
+		AsyncLoad *orphanLoad = loader.loadSkeletonData("testdata/goblins/goblins-pro.json", missingAtlasLoad);
+		runner.runAll();
+		loader.update();
+		assert(missingAtlasLoad->isDone() && !missingAtlasLoad->getAtlas() && !missingAtlasLoad->getError().isEmpty());
+		assert(orphanLoad->isDone() && !orphanLoad->getError().isEmpty() && asyncLoadsDone == 6);
+		loader.release(orphanLoad);
+		loader.release(missingAtlasLoad);
+
+		loader.release(binaryLoad);
+		loader.release(missingLoad);
+		assert(textureLoader._unloaded == 0);
+		// The loader deletes the loads that are still referenced.
+	}
+	assert(textureLoader._unloaded == textureLoader._loaded);
+
+	// Without a job runner, files are loaded when requested.
+	AsyncLoader syncLoader(NULL);
+	AsyncLoad *atlasLoad = syncLoader.loadAtlas("testdata/goblins/goblins.atlas", NULL);
+	AsyncLoad *skeletonLoad = syncLoader.loadSkeletonData("testdata/goblins/goblins-pro.skel", atlasLoad);
+	syncLoader.update();
+	assert(skeletonLoad->getSkeletonData());
+	syncLoader.release(skeletonLoad);
+	syncLoader.release(atlasLoad);
+	assert(syncLoader.getPendingCount() == 0);
+
+	// Jobs running on other threads while the loader is polled.
+	LockingExtension locking;
+	ThreadJobRunner threadRunner(1);
+	{
+		AsyncLoader threadLoader(&threadRunner);
+		AsyncLoad *raptorAtlasLoad = threadLoader.loadAtlas("testdata/raptor/raptor.atlas", &textureLoader);
+		AsyncLoad *binaryLoad = threadLoader.loadSkeletonData("testdata/raptor/raptor-pro.skel", raptorAtlasLoad);
+		AsyncLoad *jsonLoad = threadLoader.loadSkeletonData("testdata/raptor/raptor-pro.json", raptorAtlasLoad);
+		while (threadLoader.getPendingCount() > 0) {
+			threadLoader.update();
+			TestThread::yield();
+		}
+		assert(binaryLoad->getSkeletonData() && jsonLoad->getSkeletonData());
+		assert(binaryLoad->getSkeletonData()->getBones().size() == jsonLoad->getSkeletonData()->getBones().size());
+		assert(binaryLoad->getSkeletonData()->getAnimations().size() == jsonLoad->getSkeletonData()->getAnimations().size());
+
+		// The loader waits for the jobs that are still running when it is deleted.
+		AsyncLoad *goblinsAtlasLoad = threadLoader.loadAtlas("testdata/goblins/goblins.atlas", &textureLoader);
+		threadLoader.loadSkeletonData("testdata/goblins/goblins-pro.skel", goblinsAtlasLoad);
+	}
+	assert(threadRunner._waits == 1);
+	assert(textureLoader._unloaded == textureLoader._loaded);
+}
+
+void testSkeletonDataCache() {
+	printf("Testing skeleton data cache\n");
+	CountingTextureLoader textureLoader;
+	{
+		SkeletonDataCache cache(0);
+		Atlas *atlas = cache.acquireAtlas("testdata/spineboy/spineboy.atlas", &textureLoader);
+		SkeletonData *skeletonData = cache.acquireSkeletonData("testdata/spineboy/spineboy-pro.skel", atlas);
+		assert(atlas && skeletonData && cache.getMisses() == 2 && cache.getHits() == 0);
+
+		// The same path, scale and atlas share an entry.
+		assert(cache.acquireAtlas("testdata/spineboy/spineboy.atlas", &textureLoader) == atlas);
+		assert(cache.acquireSkeletonData("testdata/spineboy/spineboy-pro.skel", atlas) == skeletonData);
+		SkeletonData *scaled = cache.acquireSkeletonData("testdata/spineboy/spineboy-pro.skel", atlas, 0.5f);
+		assert(scaled && scaled != skeletonData);
+		assert(scaled->getBones()[1]->getX() == skeletonData->getBones()[1]->getX() * 0.5f);
+		assert(cache.getHits() == 2 && cache.getMisses() == 3 && textureLoader._loaded == 1);
+
+		// Without a budget, entries are deleted when the last reference is released, and the skeleton data keeps its
+		// atlas referenced.
+		size_t memoryUsed = cache.getMemoryUsed();
+		assert(memoryUsed > 0);
+		cache.release(scaled);
+		assert(cache.getEvictions() == 1 && cache.getMemoryUsed() < memoryUsed);
+		cache.release(atlas);
+		cache.release(atlas);
+		cache.release(skeletonData);
+		assert(cache.getEvictions() == 1 && textureLoader._unloaded == 0);
+		cache.release(skeletonData);
+		assert(cache.getEvictions() == 3 && cache.getMemoryUsed() == 0 && textureLoader._unloaded == 1);
+
+		assert(!cache.acquireAtlas("testdata/missing.atlas", &textureLoader) && !cache.getError().isEmpty());
+		assert(!cache.acquireSkeletonData("testdata/missing.skel", NULL) && !cache.getError().isEmpty());
+
+		// Unreferenced entries stay within the budget, least recently used are deleted first.
+		cache.setMemoryBudget((size_t) -1);
+		atlas = cache.acquireAtlas("testdata/spineboy/spineboy.atlas", &textureLoader);
+		SkeletonData *binary = cache.acquireSkeletonData("testdata/spineboy/spineboy-pro.skel", atlas);
+		SkeletonData *json = cache.acquireSkeletonData("testdata/spineboy/spineboy-pro.json", atlas);
+		assert(json && json != binary && json->getBones().size() == binary->getBones().size());
+		cache.release(binary);
+		cache.release(json);
+		cache.release(atlas);
+		int evictions = cache.getEvictions();
+		assert(cache.acquireSkeletonData("testdata/spineboy/spineboy-pro.skel", atlas) == binary);
+		cache.release(binary);
+		memoryUsed = cache.getMemoryUsed();
+		cache.setMemoryBudget(memoryUsed - 1);
+		assert(cache.getEvictions() == evictions + 1 && cache.getMemoryUsed() < memoryUsed);
+		assert(cache.acquireSkeletonData("testdata/spineboy/spineboy-pro.skel", atlas) == binary);
+		cache.release(binary);
+
+		cache.evictUnused();
+		assert(cache.getMemoryUsed() == 0 && textureLoader._unloaded == 2);
+
+		// Entries still referenced are deleted with the cache.
+		cache.acquireSkeletonData("testdata/spineboy/spineboy-pro.skel", cache.acquireAtlas("testdata/spineboy/spineboy.atlas", &textureLoader));
+	}
+	assert(textureLoader._unloaded == textureLoader._loaded);
+}
+
+void testQuantizedTimelines() {
+	Atlas *atlas = NULL;
+	SkeletonData *skeletonData = NULL;
+	AnimationStateData *stateData = NULL;
+	Skeleton *skeleton = NULL;
+	AnimationState *state = NULL;
+
+	printf("Testing quantized timelines\n");
+	loadBinary("testdata/spineboy/spineboy-pro.skel", "testdata/spineboy/spineboy.atlas", atlas, skeletonData, stateData, skeleton, state);
+
+	const float tolerance = 0.01f;
+	SkeletonBinary binary(atlas);
+	binary.setQuantizeTolerance(tolerance);
+	SkeletonData *quantizedData = binary.readSkeletonDataFile("testdata/spineboy/spineboy-pro.skel");
+	assert(quantizedData && binary.getQuantizedBytesSaved() > 0);
+	int quantizedCount = 0;
+	for (size_t i = 0; i < quantizedData->getAnimations().size(); i++) {
+		Vector<Timeline *> &timelines = quantizedData->getAnimations()[i]->getTimelines();
+		Vector<Timeline *> &original = skeletonData->getAnimations()[i]->getTimelines();
+		for (size_t ii = 0; ii < timelines.size(); ii++) {
+			if (!timelines[ii]->getRTTI().instanceOf(CurveTimeline::rtti)) continue;
+			CurveTimeline *timeline = static_cast<CurveTimeline *>(timelines[ii]);
+			CurveTimeline *originalTimeline = static_cast<CurveTimeline *>(original[ii]);
+			assert(timeline->getFrameCount() == originalTimeline->getFrameCount());
+			for (size_t frame = 0; frame + 1 < timeline->getFrameCount(); frame++)
+				assert(timeline->getCurveType(frame) == originalTimeline->getCurveType(frame));
+			if (timeline->isQuantized()) quantizedCount++;
+		}
+	}
+	assert(quantizedCount > 0);
+
+	// Poses match within the tolerance, including while mixing rotations.
+	AnimationStateData *quantizedStateData = new(__FILE__, __LINE__) AnimationStateData(quantizedData);
+	quantizedStateData->setDefaultMix(0.4f);
+	Skeleton *quantizedSkeleton = new(__FILE__, __LINE__) Skeleton(quantizedData);
+	AnimationState *quantizedState = new(__FILE__, __LINE__) AnimationState(quantizedStateData);
+	for (int frame = 0; frame < 120; frame++) {
+		if (frame == 0) {
+			state->setAnimation(0, "walk", true);
+			quantizedState->setAnimation(0, "walk", true);
+		} else if (frame == 30) {
+			state->setAnimation(0, "run", true);
+			quantizedState->setAnimation(0, "run", true);
+		}
+		state->update(1 / 60.0f);
+		state->apply(*skeleton);
+		quantizedState->update(1 / 60.0f);
+		quantizedState->apply(*quantizedSkeleton);
+		for (size_t i = 0; i < skeleton->getBones().size(); i++) {
+			Bone *bone = skeleton->getBones()[i], *quantizedBone = quantizedSkeleton->getBones()[i];
+			assert(MathUtil::abs(bone->getX() - quantizedBone->getX()) < tolerance * 2);
+			assert(MathUtil::abs(bone->getY() - quantizedBone->getY()) < tolerance * 2);
+			float rotation = bone->getRotation() - quantizedBone->getRotation();
+			rotation -= (16384 - (int) (16384.499999999996 - rotation / 360)) * 360;
+			assert(MathUtil::abs(rotation) < tolerance * 2);
+			assert(MathUtil::abs(bone->getScaleX() - quantizedBone->getScaleX()) < tolerance * 2);
+		}
+	}
+
+	// A tolerance smaller than the 16-bit steps leaves timelines unchanged, unless they quantize exactly.
+	Animation *walk = skeletonData->findAnimation("walk");
+	walk->quantize(0.0000001f);
+	int unchangedCount = 0;
+	for (size_t i = 0; i < walk->getTimelines().size(); i++) {
+		if (walk->getTimelines()[i]->getRTTI().isExactly(RotateTimeline::rtti) &&
+			!static_cast<CurveTimeline *>(walk->getTimelines()[i])->isQuantized())
+			unchangedCount++;
+	}
+	assert(unchangedCount > 0);
+
+	// Animations loaded on demand are quantized each time they are loaded.
+	binary.setLazyAnimationsEnabled(true);
+	SkeletonData *lazyData = binary.readSkeletonDataFile("testdata/spineboy/spineboy-pro.skel");
+	assert(lazyData && binary.getQuantizedBytesSaved() == 0);
+	Animation *run = lazyData->findAnimation("run");
+	for (int i = 0; i < 2; i++) {
+		bool quantized = false;
+		for (size_t ii = 0; ii < run->getTimelines().size(); ii++) {
+			if (run->getTimelines()[ii]->getRTTI().instanceOf(CurveTimeline::rtti))
+				quantized |= static_cast<CurveTimeline *>(run->getTimelines()[ii])->isQuantized();
+		}
+		assert(quantized);
+		run->unload();
+	}
+
+	delete lazyData;
+	delete quantizedState;
+	delete quantizedSkeleton;
+	delete quantizedStateData;
+	delete quantizedData;
+	dispose(atlas, skeletonData, stateData, skeleton, state);
+}
+
+void testSparseDeform() {
+	Atlas *atlas = NULL;
+	SkeletonData *skeletonData = NULL;
+	AnimationStateData *stateData = NULL;
+	Skeleton *skeleton = NULL;
+	AnimationState *state = NULL;
+
+	printf("Testing sparse deform timelines\n");
+	loadBinary("testdata/spineboy/spineboy-pro.skel", "testdata/spineboy/spineboy.atlas", atlas, skeletonData, stateData, skeleton, state);
+	SkeletonJson json(atlas);
+	SkeletonData *jsonData = json.readSkeletonDataFile("testdata/spineboy/spineboy-pro.json");
+	assert(jsonData);
+
+	// Both loaders give the same keyframes.
+	int deformCount = 0;
+	Vector<float> vertices, jsonVertices;
+	for (size_t i = 0; i < skeletonData->getAnimations().size(); i++) {
+		Vector<Timeline *> &timelines = skeletonData->getAnimations()[i]->getTimelines();
+		Vector<Timeline *> &jsonTimelines = jsonData->findAnimation(skeletonData->getAnimations()[i]->getName())->getTimelines();
+		for (size_t ii = 0; ii < timelines.size(); ii++) {
+			if (!timelines[ii]->getRTTI().isExactly(DeformTimeline::rtti)) continue;
+			DeformTimeline *timeline = static_cast<DeformTimeline *>(timelines[ii]), *jsonTimeline = NULL;
+			for (size_t iii = 0; iii < jsonTimelines.size() && !jsonTimeline; iii++) {
+				if (!jsonTimelines[iii]->getRTTI().isExactly(DeformTimeline::rtti)) continue;
+				DeformTimeline *candidate = static_cast<DeformTimeline *>(jsonTimelines[iii]);
+				if (candidate->getSlotIndex() == timeline->getSlotIndex() &&
+					candidate->getAttachment()->getName() == timeline->getAttachment()->getName())
+					jsonTimeline = candidate;
+			}
+			assert(jsonTimeline && jsonTimeline->getFrames().size() == timeline->getFrames().size());
+			for (size_t frame = 0; frame < timeline->getFrames().size(); frame++) {
+				timeline->getFrameVertices((int) frame, vertices);
+				jsonTimeline->getFrameVertices((int) frame, jsonVertices);
+				assert(vertices.size() == timeline->getVertexCount() && vertices.size() == jsonVertices.size());
+				for (size_t v = 0; v < vertices.size(); v++)
+					assert(MathUtil::abs(vertices[v] - jsonVertices[v]) < 0.001f);
+			}
+			deformCount++;
+		}
+	}
+	assert(deformCount > 0);
+
+	// Applying a sparse timeline gives the same vertices as interpolating the full keyframes.
+	Animation *hoverboard = skeletonData->findAnimation("hoverboard");
+	DeformTimeline *timeline = NULL;
+	for (size_t i = 0; i < hoverboard->getTimelines().size() && !timeline; i++) {
+		if (hoverboard->getTimelines()[i]->getRTTI().isExactly(DeformTimeline::rtti) &&
+			static_cast<DeformTimeline *>(hoverboard->getTimelines()[i])->getFrames().size() > 1)
+			timeline = static_cast<DeformTimeline *>(hoverboard->getTimelines()[i]);
+	}
+	assert(timeline);
+	Slot *slot = skeleton->getSlots()[timeline->getSlotIndex()];
+	slot->setAttachment(timeline->getAttachment());
+	Vector<float> prevVertices, nextVertices;
+	timeline->getFrameVertices(0, prevVertices);
+	timeline->getFrameVertices(1, nextVertices);
+	float time = (timeline->getFrames()[0] + timeline->getFrames()[1]) / 2;
+	float percent = timeline->getCurvePercent(0, (time - timeline->getFrames()[0]) / (timeline->getFrames()[1] - timeline->getFrames()[0]));
+	timeline->apply(*skeleton, time, time, NULL, 1, MixBlend_Setup, MixDirection_In);
+	Vector<float> &deform = slot->getDeform();
+	assert(deform.size() == prevVertices.size());
+	for (size_t v = 0; v < deform.size(); v++)
+		assert(MathUtil::abs(deform[v] - (prevVertices[v] + (nextVertices[v] - prevVertices[v]) * percent)) < 0.0001f);
+	timeline->apply(*skeleton, time, time, NULL, 0.5f, MixBlend_Add, MixDirection_In);
+	Vector<float> &setupVertices = timeline->getAttachment()->getVertices();
+	bool weighted = timeline->getAttachment()->getBones().size() > 0;
+	for (size_t v = 0; v < deform.size(); v++) {
+		float value = prevVertices[v] + (nextVertices[v] - prevVertices[v]) * percent;
+		float expected = value + (value - (weighted ? 0 : setupVertices[v])) * 0.5f;
+		assert(MathUtil::abs(deform[v] - expected) < 0.0001f);
+	}
+
+	delete jsonData;
+	dispose(atlas, skeletonData, stateData, skeleton, state);
+}
+
+static float bezierValue(float c1, float c2, float t) {
+	float u = 1 - t;
+	return 3 * u * u * t * c1 + 3 * u * t * t * c2 + t * t * t;
+}
+
+void testCurveLookup() {
+	printf("Testing curve lookups\n");
+
+	// Lookups are at least as close to the bezier curve as the samples.
+	const float handles[][4] = {{0.25f, 0, 0.75f, 1}, {0.5f, 0, 0.5f, 1}, {0, 0.8f, 0.2f, 1}, {0.9f, 0, 1, 0.3f}, {0.3f, -0.4f, 0.7f, 1.5f}};
+	for (int h = 0; h < 5; h++) {
+		TranslateTimeline sampled(2), lookup(2);
+		sampled.setCurve(0, handles[h][0], handles[h][1], handles[h][2], handles[h][3]);
+		lookup.setCurve(0, handles[h][0], handles[h][1], handles[h][2], handles[h][3]);
+		lookup.buildCurveLookup();
+		float sampledError = 0, lookupError = 0;
+		for (int i = 0; i <= 1000; i++) {
+			float t = i / 1000.0f;
+			float x = bezierValue(handles[h][0], handles[h][2], t), y = bezierValue(handles[h][1], handles[h][3], t);
+			sampledError = MathUtil::max(sampledError, MathUtil::abs(sampled.getCurvePercent(0, x) - y));
+			lookupError = MathUtil::max(lookupError, MathUtil::abs(lookup.getCurvePercent(0, x) - y));
+		}
+		assert(lookupError <= sampledError + 0.001f);
+	}
+
+	// Both backends give close results for the curves of all test animations.
+	const char *files[][2] = {
+		{"testdata/coin/coin-pro.skel", "testdata/coin/coin.atlas"},
+		{"testdata/goblins/goblins-pro.skel", "testdata/goblins/goblins.atlas"},
+		{"testdata/raptor/raptor-pro.skel", "testdata/raptor/raptor.atlas"},
+		{"testdata/spineboy/spineboy-pro.skel", "testdata/spineboy/spineboy.atlas"},
+		{"testdata/stretchyman/stretchyman-pro.skel", "testdata/stretchyman/stretchyman.atlas"},
+		{"testdata/tank/tank-pro.skel", "testdata/tank/tank.atlas"}
+	};
+	int curveCount = 0, lookupCount = 0;
+	float maxError = 0, sum = 0;
+	clock_t sampledTime = 0, lookupTime = 0;
+	for (int f = 0; f < 6; f++) {
+		Atlas *atlas = new(__FILE__, __LINE__) Atlas(files[f][1], NULL);
+		SkeletonBinary binary(atlas);
+		SkeletonData *sampledData = binary.readSkeletonDataFile(files[f][0]);
+		binary.setCurveLookupEnabled(true);
+		SkeletonData *lookupData = binary.readSkeletonDataFile(files[f][0]);
+		binary.setQuantizeTolerance(0.01f);
+		SkeletonData *quantizedData = binary.readSkeletonDataFile(files[f][0]);
+		assert(sampledData && lookupData && quantizedData);
+		Vector<CurveTimeline *> sampled, lookup;
+		for (size_t i = 0; i < sampledData->getAnimations().size(); i++) {
+			Vector<Timeline *> &sampledTimelines = sampledData->getAnimations()[i]->getTimelines();
+			Vector<Timeline *> &lookupTimelines = lookupData->getAnimations()[i]->getTimelines();
+			Vector<Timeline *> &quantizedTimelines = quantizedData->getAnimations()[i]->getTimelines();
+			for (size_t ii = 0; ii < sampledTimelines.size(); ii++) {
+				if (!sampledTimelines[ii]->getRTTI().instanceOf(CurveTimeline::rtti)) continue;
+				sampled.add(static_cast<CurveTimeline *>(sampledTimelines[ii]));
+				lookup.add(static_cast<CurveTimeline *>(lookupTimelines[ii]));
+				// Quantized timelines keep the lookups in the curve table.
+				CurveTimeline *quantized = static_cast<CurveTimeline *>(quantizedTimelines[ii]);
+				for (size_t frame = 0; frame + 1 < quantized->getFrameCount(); frame++)
+					for (int p = 0; p <= 10; p++)
+						assert(quantized->getCurvePercent(frame, p / 10.0f) == lookup[lookup.size() - 1]->getCurvePercent(frame, p / 10.0f));
+			}
+		}
+		for (size_t i = 0; i < sampled.size(); i++) {
+			for (size_t frame = 0; frame + 1 < sampled[i]->getFrameCount(); frame++) {
+				if (sampled[i]->getCurveType(frame) != 2) continue;
+				curveCount++;
+				for (int p = 0; p <= 100; p++)
+					maxError = MathUtil::max(maxError,
+						MathUtil::abs(sampled[i]->getCurvePercent(frame, p / 100.0f) - lookup[i]->getCurvePercent(frame, p / 100.0f)));
+			}
+		}
+		for (int backend = 0; backend < 2; backend++) {
+			Vector<CurveTimeline *> &timelines = backend ? lookup : sampled;
+			clock_t start = clock();
+			for (int n = 0; n < 20; n++) {
+				for (size_t i = 0; i < timelines.size(); i++) {
+					for (size_t frame = 0; frame + 1 < timelines[i]->getFrameCount(); frame++) {
+						if (sampled[i]->getCurveType(frame) != 2) continue;
+						for (int p = 0; p <= 100; p++)
+							sum += timelines[i]->getCurvePercent(frame, p / 100.0f);
+					}
+				}
+			}
+			(backend ? lookupTime : sampledTime) += clock() - start;
+		}
+		for (size_t i = 0; i < sampled.size(); i++)
+			lookupCount += sampled[i]->buildCurveLookup();
+		delete quantizedData;
+		delete lookupData;
+		delete sampledData;
+		delete atlas;
+	}
+	assert(lookupCount > 0 && lookupCount <= curveCount && maxError > 0 && maxError < 0.05f);
+	printf("%d of %d curves use lookups, max difference %f: samples %.2f ms, lookup %.2f ms (%f)\n", lookupCount, curveCount, maxError,
+		sampledTime * 1000.0 / CLOCKS_PER_SEC, lookupTime * 1000.0 / CLOCKS_PER_SEC, sum);
+}
+
+void testTimelineBatches() {
+	Atlas *atlas = NULL;
+	SkeletonData *skeletonData = NULL;
+	AnimationStateData *stateData = NULL;
+	Skeleton *skeleton = NULL;
+	AnimationState *state = NULL;
+
+	printf("Testing timeline batches\n");
+	loadBinary("testdata/spineboy/spineboy-pro.skel", "testdata/spineboy/spineboy.atlas", atlas, skeletonData, stateData, skeleton, state);
+
+	// Each type has one batch, attachment timelines first, covering all timelines.
+	for (size_t i = 0; i < skeletonData->getAnimations().size(); i++) {
+		Animation *animation = skeletonData->getAnimations()[i];
+		Vector<Timeline *> &timelines = animation->getTimelines();
+		Vector<TimelineBatch> &batches = animation->getTimelineBatches();
+		size_t end = 0;
+		for (size_t ii = 0; ii < batches.size(); ii++) {
+			TimelineBatch &batch = batches[ii];
+			assert(batch.start == end && batch.end > batch.start);
+			assert(ii == 0 || batch.rtti != &AttachmentTimeline::rtti);
+			for (size_t iii = batch.start; iii < batch.end; iii++)
+				assert(timelines[iii]->getRTTI().isExactly(*batch.rtti));
+			for (size_t iii = 0; iii < ii; iii++)
+				assert(batches[iii].rtti != batch.rtti);
+			end = batch.end;
+		}
+		assert(end == timelines.size());
+	}
+
+	// The order of the timelines within and between types does not change the pose, including while mixing with hold
+	// modes and rotation directions.
+	const char *names[] = {"walk", "run", "shoot", "aim"};
+	Vector<Animation *> reversed;
+	for (int i = 0; i < 4; i++) {
+		Animation *animation = skeletonData->findAnimation(names[i]);
+		Vector<Timeline *> timelines;
+		for (size_t ii = animation->getTimelines().size(); ii > 0; ii--)
+			timelines.add(animation->getTimelines()[ii - 1]);
+		reversed.add(new(__FILE__, __LINE__) Animation(animation->getName(), timelines, animation->getDuration()));
+	}
+	Vector<TimelineBatch> &walkBatches = skeletonData->findAnimation("walk")->getTimelineBatches();
+	bool reordered = false;
+	for (size_t i = 0; i < walkBatches.size(); i++)
+		reordered |= reversed[0]->getTimelineBatches()[i].rtti != walkBatches[i].rtti;
+	assert(reordered);
+	Skeleton *reversedSkeleton = new(__FILE__, __LINE__) Skeleton(skeletonData);
+	AnimationState *reversedState = new(__FILE__, __LINE__) AnimationState(stateData);
+	for (int frame = 0; frame < 150; frame++) {
+		for (int s = 0; s < 2; s++) {
+			AnimationState *animationState = s ? reversedState : state;
+			Animation *animations[4];
+			for (int i = 0; i < 4; i++)
+				animations[i] = s ? reversed[i] : skeletonData->findAnimation(names[i]);
+			if (frame == 0) {
+				animationState->setAnimation(0, animations[0], true);
+			} else if (frame == 20) {
+				animationState->setAnimation(0, animations[1], true)->setHoldPrevious(true);
+				animationState->setAnimation(1, animations[3], true)->setAlpha(0.5f);
+			} else if (frame == 30) {
+				animationState->setAnimation(0, animations[2], false);
+			} else if (frame == 90) {
+				animationState->setAnimation(0, animations[0], true);
+			}
+			animationState->update(1 / 60.0f);
+		}
+		state->apply(*skeleton);
+		reversedState->apply(*reversedSkeleton);
+		for (size_t i = 0; i < skeleton->getBones().size(); i++) {
+			Bone *bone = skeleton->getBones()[i], *reversedBone = reversedSkeleton->getBones()[i];
+			assert(bone->getX() == reversedBone->getX() && bone->getY() == reversedBone->getY());
+			assert(bone->getRotation() == reversedBone->getRotation());
+			assert(bone->getScaleX() == reversedBone->getScaleX() && bone->getShearY() == reversedBone->getShearY());
+		}
+		for (size_t i = 0; i < skeleton->getSlots().size(); i++) {
+			Slot *slot = skeleton->getSlots()[i], *reversedSlot = reversedSkeleton->getSlots()[i];
+			assert(slot->getAttachment() == reversedSlot->getAttachment());
+			assert(slot->getColor().a == reversedSlot->getColor().a);
+			assert(slot->getDeform().size() == reversedSlot->getDeform().size());
+			for (size_t ii = 0; ii < slot->getDeform().size(); ii++)
+				assert(slot->getDeform()[ii] == reversedSlot->getDeform()[ii]);
+		}
+	}
+
+	// Changed timelines are sorted and batched again by updateTimelineBatches(), not while applying.
+	Animation *changed = reversed[0];
+	Vector<Timeline *> &aimTimelines = skeletonData->findAnimation("aim")->getTimelines();
+	for (size_t i = 0; i < aimTimelines.size(); i++)
+		changed->getTimelines().add(aimTimelines[i]);
+	changed->updateTimelineBatches();
+	Vector<TimelineBatch> &changedBatches = changed->getTimelineBatches();
+	assert(changedBatches[changedBatches.size() - 1].end == changed->getTimelines().size());
+	for (size_t i = 0; i < changedBatches.size(); i++) {
+		for (size_t ii = changedBatches[i].start; ii < changedBatches[i].end; ii++)
+			assert(changed->getTimelines()[ii]->getRTTI().isExactly(*changedBatches[i].rtti));
+	}
+	for (size_t i = 0; i < aimTimelines.size(); i++)
+		assert(changed->hasTimeline(aimTimelines[i]->getPropertyId()));
+
+	delete reversedState;
+	delete reversedSkeleton;
+	for (size_t i = 0; i < reversed.size(); i++) {
+		// The timelines belong to the skeleton data's animations.
+		reversed[i]->getTimelines().clear();
+		delete reversed[i];
+	}
+	dispose(atlas, skeletonData, stateData, skeleton, state);
+}
+
+static void assertPoseMatches(Pose &pose, Skeleton &skeleton) {
+	for (size_t i = 0; i < skeleton.getBones().size(); i++) {
+		Bone *bone = skeleton.getBones()[i];
+		float *values = pose.getBoneTransform(i);
+		assert(values[Pose::X] == bone->getX() && values[Pose::Y] == bone->getY());
+		// Sampled rotations wrap like mixed ones, so they may differ by whole turns.
+		float r = values[Pose::ROTATION] - bone->getRotation();
+		assert(MathUtil::abs(r - (16384 - (int)(16384.499999999996 - r / 360)) * 360) < 0.001f);
+		assert(values[Pose::SCALE_X] == bone->getScaleX() && values[Pose::SCALE_Y] == bone->getScaleY());
+		assert(values[Pose::SHEAR_X] == bone->getShearX() && values[Pose::SHEAR_Y] == bone->getShearY());
+	}
+	for (size_t i = 0; i < skeleton.getSlots().size(); i++) {
+		Slot *slot = skeleton.getSlots()[i];
+		assert(pose.getAttachment(i) == slot->getAttachment());
+		Color &color = pose.getColor(i);
+		assert(color.r == slot->getColor().r && color.g == slot->getColor().g);
+		assert(color.b == slot->getColor().b && color.a == slot->getColor().a);
+	}
+}
+
+void testPoseSampling() {
+	Atlas *atlas = NULL;
+	SkeletonData *skeletonData = NULL;
+	AnimationStateData *stateData = NULL;
+	Skeleton *skeleton = NULL;
+	AnimationState *state = NULL;
+
+	printf("Testing pose sampling\n");
+	loadBinary("testdata/spineboy/spineboy-pro.skel", "testdata/spineboy/spineboy.atlas", atlas, skeletonData, stateData, skeleton, state);
+
+	// Sampling gives the same values as applying the animation over the setup pose, with quantized timelines too.
+	Pose pose(*skeletonData);
+	Vector<Pose *> poses;
+	Vector<float> times;
+	for (int i = 0; i < 8; i++) {
+		poses.add(new(__FILE__, __LINE__) Pose(*skeletonData));
+		times.add(i * 0.37f - 0.1f);
+	}
+	for (int quantized = 0; quantized < 2; quantized++) {
+		for (size_t i = 0; i < skeletonData->getAnimations().size(); i++) {
+			Animation *animation = skeletonData->getAnimations()[i];
+			if (quantized) animation->quantize(0.001f);
+			animation->sample(poses, times, true);
+			for (size_t ii = 0; ii < times.size(); ii++) {
+				float time = animation->getDuration() != 0 ? MathUtil::fmod(times[ii], animation->getDuration()) : times[ii];
+				skeleton->setToSetupPose();
+				animation->apply(*skeleton, time, time, false, NULL, 1, MixBlend_Setup, MixDirection_In);
+				animation->sample(pose, time, false);
+				assertPoseMatches(pose, *skeleton);
+				assertPoseMatches(*poses[ii], *skeleton);
+			}
+		}
+	}
+
+	// Applying a pose sets the skeleton to it, and mixing takes the shortest rotation.
+	Animation *walk = skeletonData->findAnimation("walk"), *run = skeletonData->findAnimation("run");
+	Pose from(*skeletonData), to(*skeletonData);
+	walk->sample(from, 0.2f, true);
+	run->sample(to, 0.3f, true);
+	pose.mix(from, to, 0.25f);
+	skeleton->setToSetupPose();
+	skeleton->applyPose(pose);
+	assertPoseMatches(pose, *skeleton);
+	for (size_t i = 0; i < pose.getBoneCount(); i++) {
+		float fromRotation = from.getBoneTransform(i)[Pose::ROTATION], rotation = pose.getBoneTransform(i)[Pose::ROTATION];
+		float delta = to.getBoneTransform(i)[Pose::ROTATION] - fromRotation;
+		while (delta > 180) delta -= 360;
+		while (delta < -180) delta += 360;
+		assert(MathUtil::abs(rotation - (fromRotation + delta * 0.25f)) < 0.001f);
+		assert(pose.getBoneTransform(i)[Pose::X] == from.getBoneTransform(i)[Pose::X] + (to.getBoneTransform(i)[Pose::X] - from.getBoneTransform(i)[Pose::X]) * 0.25f);
+	}
+	for (size_t i = 0; i < pose.getSlotCount(); i++)
+		assert(pose.getAttachment(i) == from.getAttachment(i));
+	pose.mix(pose, to, 1);
+	for (size_t i = 0; i < pose.getSlotCount(); i++)
+		assert(pose.getAttachment(i) == to.getAttachment(i));
+
+	// Adding a pose adds its difference from the setup pose.
+	Pose setup(*skeletonData);
+	pose.set(from);
+	pose.add(setup, 1);
+	for (size_t i = 0; i < pose.getTransforms().size(); i++)
+		assert(pose.getTransforms()[i] == from.getTransforms()[i]);
+
+	for (size_t i = 0; i < poses.size(); i++)
+		delete poses[i];
+	dispose(atlas, skeletonData, stateData, skeleton, state);
+}
+
+void testAnimationLod() {
+	Atlas *atlas = NULL;
+	SkeletonData *skeletonData = NULL;
+	AnimationStateData *stateData = NULL;
+	Skeleton *skeleton = NULL;
+	AnimationState *state = NULL;
+
+	printf("Testing animation LOD\n");
+	loadBinary("testdata/spineboy/spineboy-pro.skel", "testdata/spineboy/spineboy.atlas", atlas, skeletonData, stateData, skeleton, state);
+
+	// With an update interval, the skeleton trails the full rate skeleton by one interval, interpolating in between.
+	Skeleton *reduced = new(__FILE__, __LINE__) Skeleton(skeletonData);
+	LodLevel lod;
+	lod.updateInterval = 3;
+	reduced->setLodLevel(lod);
+	Vector<Pose *> history;
+	Pose expected(*skeletonData);
+	state->setAnimation(0, "walk", true);
+	for (int frame = 0; frame < 30; frame++) {
+		state->update(1 / 60.0f);
+		state->apply(*skeleton);
+		state->apply(*reduced);
+		history.add(new(__FILE__, __LINE__) Pose(*skeletonData));
+		skeleton->getPose(*history[frame]);
+
+		int step = frame % 3, applied = frame - step;
+		if (applied < 3) continue;
+		expected.mix(*history[applied - 3], *history[applied], step / 3.0f);
+		for (size_t i = 0; i < reduced->getBones().size(); i++) {
+			Bone *bone = reduced->getBones()[i];
+			float *values = expected.getBoneTransform(i);
+			assert(MathUtil::abs(bone->getX() - values[Pose::X]) < 0.001f);
+			assert(MathUtil::abs(bone->getY() - values[Pose::Y]) < 0.001f);
+			assert(MathUtil::abs(bone->getRotation() - values[Pose::ROTATION]) < 0.001f);
+		}
+	}
+	assert(reduced->getLodCounters().interpolatedApplies == 20);
+	assert(skeleton->getLodCounters().interpolatedApplies == 0);
+	for (size_t i = 0; i < history.size(); i++)
+		delete history[i];
+
+	// Interpolated frames keep the attachments of the last applied pose, so they keep the deform applied for them.
+	Animation *hoverboard = skeletonData->findAnimation("hoverboard");
+	DeformTimeline *hoverboardDeform = NULL;
+	for (size_t i = 0; i < hoverboard->getTimelines().size() && !hoverboardDeform; i++)
+		if (hoverboard->getTimelines()[i]->getRTTI().isExactly(DeformTimeline::rtti))
+			hoverboardDeform = static_cast<DeformTimeline *>(hoverboard->getTimelines()[i]);
+	assert(hoverboardDeform);
+	int meshSlot = hoverboardDeform->getSlotIndex();
+	VertexAttachment *mesh = hoverboardDeform->getAttachment();
+	Vector<float> meshVertices;
+	hoverboardDeform->getFrameVertices(0, meshVertices);
+	AttachmentTimeline *swap = new(__FILE__, __LINE__) AttachmentTimeline(2);
+	swap->setSlotIndex(meshSlot);
+	swap->setFrame(0, 0, "");
+	swap->setFrame(1, 0.1f, mesh->getName());
+	DeformTimeline *deformTimeline = new(__FILE__, __LINE__) DeformTimeline(1);
+	deformTimeline->setSlotIndex(meshSlot);
+	deformTimeline->setAttachment(mesh);
+	deformTimeline->setFrame(0, 0, meshVertices);
+	Vector<Timeline *> swapTimelines;
+	swapTimelines.add(swap);
+	swapTimelines.add(deformTimeline);
+	Animation *swapAnimation = new(__FILE__, __LINE__) Animation("swap", swapTimelines, 1);
+	reduced->setToSetupPose();
+	state->setAnimation(0, swapAnimation, false);
+	Slot *reducedMeshSlot = reduced->getSlots()[meshSlot];
+	int meshFrames = 0;
+	for (int frame = 0; frame < 30; frame++) {
+		state->update(1 / 60.0f);
+		state->apply(*reduced);
+		if (reducedMeshSlot->getAttachment() != mesh) continue;
+		assert(reducedMeshSlot->getDeform().size() == meshVertices.size());
+		meshFrames++;
+	}
+	assert(meshFrames > 3);
+	state->clearTracks();
+	delete swapAnimation;
+	delete reduced;
+
+	// Deform timelines are skipped, leaving meshes in their setup shape.
+	lod = LodLevel();
+	lod.skipDeform = true;
+	skeleton->setLodLevel(lod);
+	skeleton->setToSetupPose();
+	state->setAnimation(0, "hoverboard", true);
+	state->update(0.5f);
+	state->apply(*skeleton);
+	assert(skeleton->getLodCounters().skippedTimelines > 0);
+	for (size_t i = 0; i < skeleton->getSlots().size(); i++)
+		assert(skeleton->getSlots()[i]->getDeform().size() == 0);
+
+	// Low importance bones stay in the setup pose while the others are animated.
+	Animation *walk = skeletonData->findAnimation("walk");
+	RotateTimeline *rotateTimeline = NULL;
+	for (size_t i = 0; i < walk->getTimelines().size() && !rotateTimeline; i++)
+		if (walk->getTimelines()[i]->getRTTI().isExactly(RotateTimeline::rtti))
+			rotateTimeline = static_cast<RotateTimeline *>(walk->getTimelines()[i]);
+	assert(rotateTimeline);
+	BoneData &lowData = *skeletonData->getBones()[rotateTimeline->getBoneIndex()];
+	lowData.setLowImportance(true);
+	lod = LodLevel();
+	lod.skipLowImportanceBones = true;
+	skeleton->setLodLevel(lod);
+	skeleton->getLodCounters().reset();
+	state->setAnimation(0, walk, true);
+	state->update(0.3f);
+	state->apply(*skeleton);
+	Bone *lowBone = skeleton->getBones()[lowData.getIndex()];
+	assert(lowBone->getRotation() == lowData.getRotation() && lowBone->getX() == lowData.getX());
+	assert(skeleton->getLodCounters().skippedTimelines > 0);
+	skeleton->setLodLevel(LodLevel());
+	state->apply(*skeleton);
+	assert(lowBone->getRotation() != lowData.getRotation());
+	lowData.setLowImportance(false);
+
+	// Constraints below the threshold are skipped, with and without bone transforms.
+	size_t constraintCount = skeleton->getIkConstraints().size() + skeleton->getTransformConstraints().size() +
+		skeleton->getPathConstraints().size();
+	assert(constraintCount > 0);
+	skeleton->getLodCounters().reset();
+	skeleton->updateWorldTransform();
+	assert(skeleton->getLodCounters().skippedConstraints == 0);
+	lod = LodLevel();
+	lod.constraintThreshold = 2;
+	skeleton->setLodLevel(lod);
+	skeleton->updateWorldTransform();
+	assert(skeleton->getLodCounters().skippedConstraints == constraintCount);
+	skeleton->setBoneTransformsEnabled(true);
+	skeleton->updateWorldTransform();
+	assert(skeleton->getLodCounters().skippedConstraints == constraintCount * 2);
+
+	dispose(atlas, skeletonData, stateData, skeleton, state);
+}
+
+void testJsonReader() {
+	printf("Testing JSON reader\n");
+	JsonReader reader("{\"a\": [1, 2.5, -3e2], \"B\": {\"c\": \"x\\ny\\u00e9\", \"d\": true}, \"e\": null}");
+	assert(reader.beginObject());
+	assert(reader.nextKey() && reader.isKey("a"));
+	assert(reader.peekArraySize() == 3);
+	assert(reader.beginArray());
+	assert(reader.nextValue() && reader.readInt() == 1);
+	assert(reader.nextValue() && reader.readFloat() == 2.5f);
+	assert(reader.nextValue() && reader.readFloat() == -300);
+	assert(!reader.nextValue());
+	// Keys are matched and hashed ignoring case, like Json::getItem().
+	assert(reader.nextKey() && reader.isKey("b") && reader.getKeyHash() == JsonReader::hash("b"));
+	const char *objectB = reader.getPosition();
+	reader.skipValue();
+	assert(reader.nextKey() && reader.isKey("e"));
+	assert(reader.peek() == Json::JSON_NULL && reader.readString() == NULL);
+	assert(!reader.nextKey());
+	assert(!reader.getError());
+
+	reader.setPosition(objectB);
+	assert(reader.beginObject());
+	assert(reader.nextKey() && strcmp(reader.readString(), "x\ny\xc3\xa9") == 0);
+	assert(reader.nextKey() && reader.readBoolean());
+	assert(!reader.nextKey());
+
+	JsonReader malformed("{\"a\": [1, 2}");
+	assert(malformed.beginObject() && malformed.nextKey());
+	malformed.skipValue();
+	assert(!malformed.nextKey());
+	assert(malformed.getError());
+
+	// Sections and keys can be in any order.
+	const char *json =
+		"{\"animations\": {\"spin\": {\"bones\": {\"child\": {\"rotate\": [{\"angle\": 90, \"time\": 0.5}]}}}},"
+		"\"slots\": [{\"bone\": \"child\", \"name\": \"slot\", \"attachment\": \"box\"}],"
+		"\"skins\": [{\"attachments\": {\"slot\": {\"box\": {\"vertexCount\": 3, \"vertices\": [0, 0, 1, 0, 1, 1],"
+		"\"type\": \"boundingbox\"}}}, \"name\": \"default\"}],"
+		"\"bones\": [{\"name\": \"root\"}, {\"x\": 5, \"parent\": \"root\", \"name\": \"child\", \"skin\": true}]}";
+	SkeletonJson skeletonJson((Atlas *) NULL);
+	SkeletonData *skeletonData = skeletonJson.readSkeletonData(json);
+	assert(skeletonData);
+	assert(skeletonData->getBones().size() == 2);
+	BoneData *child = skeletonData->findBone("child");
+	assert(child && child->getParent() == skeletonData->findBone("root") && child->getX() == 5 && child->isSkinRequired());
+	assert(skeletonData->getDefaultSkin()->getAttachment(0, "box"));
+	Animation *spin = skeletonData->findAnimation("spin");
+	assert(spin && spin->getDuration() == 0.5f && spin->getTimelines().size() == 1);
+	delete skeletonData;
+
+	assert(!skeletonJson.readSkeletonData("{\"bones\": [{\"name\": \"root\"}"));
+	assert(strncmp(skeletonJson.getError().buffer(), "Invalid skeleton JSON", 21) == 0);
+
+	// Truncated text fails at its terminator instead of reading past it.
+	int length = 0;
+	char *data = SpineExtension::readFile("testdata/spineboy/spineboy-pro.json", &length);
+	assert(data && length > 0);
+	char *truncated = SpineExtension::alloc<char>(length + 1, __FILE__, __LINE__);
+	for (int end = 1; end < length; end += 4999) {
+		memcpy(truncated, data, end);
+		truncated[end] = 0;
+		assert(!skeletonJson.readSkeletonData(truncated));
+	}
+	SpineExtension::free(truncated, __FILE__, __LINE__);
+	SpineExtension::free(data, __FILE__, __LINE__);
+
+	assert(!skeletonJson.readSkeletonDataFile("testdata/missing.json"));
+	assert(strncmp(skeletonJson.getError().buffer(), "Unable to read skeleton file", 28) == 0);
+}
+
+void testJsonNumbers() {
+	printf("Testing JSON numbers\n");
+	float floatValue;
+	int intValue;
+	const char *end = Json::parseNumber("-12.5e1,", floatValue, intValue);
+	assert(end && *end == ',' && floatValue == -125 && intValue == -125);
+	assert(Json::parseNumber("0.7", floatValue, intValue) && floatValue == 0.7f && intValue == 0);
+	assert(Json::parseNumber("-0.7", floatValue, intValue) && floatValue == -0.7f && intValue == 0);
+	assert(Json::parseNumber("16777217", floatValue, intValue) && floatValue == 16777216 && intValue == 16777217);
+	assert(Json::parseNumber("1e39", floatValue, intValue) && floatValue > 3.4e38f && intValue == 2147483647);
+	assert(Json::parseNumber("-3e9", floatValue, intValue) && intValue == -2147483647 - 1);
+	assert(Json::parseNumber("1e-46", floatValue, intValue) && floatValue == 0);
+	assert(!Json::parseNumber("-x", floatValue, intValue));
+
+	// Exactly halfway between two floats rounds to even, a tail of more digits rounds up.
+	assert(Json::parseNumber("2.11373674869537353515625", floatValue, intValue) && floatValue == 2.11373663f);
+	assert(Json::parseNumber("2.113736748695373535156250000000000000001", floatValue, intValue) &&
+		   floatValue == 2.11373687f);
+	assert(Json::parseNumber("1.4012984643248170709e-45", floatValue, intValue) && floatValue > 0);
+
+	// Every float survives a round trip through its shortest exact text.
+	char text[32];
+	unsigned int seed = 1;
+	for (int i = 0; i < 100000; i++) {
+		seed = seed * 1664525 + 1013904223;
+		unsigned int bits = seed & 0x7f7fffff;
+		float value, parsed;
+		memcpy(&value, &bits, sizeof(float));
+		sprintf(text, "%.9g", value);
+		assert(Json::parseNumber(text, parsed, intValue) && parsed == value);
+	}
+}
+
 int main(int argc, char **argv) {
 	DebugExtension debug(SpineExtension::getInstance());
 	SpineExtension::setInstance(&debug);
 
+	testRtti();
+	testHashMap();
+	testMapFile();
 	testLoading();
+	testJsonReader();
+	testJsonNumbers();
+	testArena();
+	testArenaStrings();
+	testLazyAnimations();
+	testParallelLoading();
+	testBinaryAtlas();
+	testAsyncLoader();
+	testSkeletonDataCache();
+	testQuantizedTimelines();
+	testSparseDeform();
+	testCurveLookup();
+	testTimelineBatches();
+	testPoseSampling();
+	testAnimationLod();
+	testNameLookup();
+	testFrameCursors();
+	testBakedAnimation();
+	testUpdateBatch();
+	testThreadedUpdateBatch();
+	testBoneTransforms();
+	testSimdVertices();
+	testAtlasValues();
 
 	debug.reportLeaks();
 }
@@ -40,10 +40,35 @@
 namespace spine {
 class Timeline;
 
+class QuantizedFrames;
+
+class CurveTable;
+
 class Skeleton;
 
 class Event;
 
+class Pose;
+
+class Animation;
+
+class RTTI;
+
+/// A run of timelines of the same type in Animation::getTimelines().
+struct SP_API TimelineBatch {
+	const RTTI *rtti;
+	size_t start, end;
+};
+
+/// Decodes the timelines of animations that are loaded on demand. See SkeletonBinary::setLazyAnimationsEnabled().
+class SP_API TimelineLoader : public SpineObject {
+public:
+	virtual ~TimelineLoader();
+
+	/// Adds the animation's timelines. Returns false if they could not be decoded.
+	virtual bool loadTimelines(Animation &animation, Vector<Timeline *> &timelines) = 0;
+};
+
 class SP_API Animation : public SpineObject {
 	friend class AnimationState;
 
@@ -84,6 +109,10 @@ class SP_API Animation : public SpineObject {
 public:
 	Animation(const String &name, Vector<Timeline *> &timelines, float duration);
 
+	/// Creates an animation whose timelines are loaded from the loader the first time they are needed.
+	/// @param timelineLoader Not owned.
+	Animation(const String &name, float duration, TimelineLoader *timelineLoader);
+
 	~Animation();
 
 	/// Applies all the animation's timelines to the specified skeleton.
@@ -91,31 +120,106 @@ public:
 	void apply(Skeleton &skeleton, float lastTime, float time, bool loop, Vector<Event *> *pEvents, float alpha,
 		MixBlend blend, MixDirection direction);
 
+	/// Sets the pose to the setup pose with the animation applied at the specified time, without changing a skeleton. Events
+	/// are not fired. Does not allocate and can be called from multiple threads if the animation is loaded, see load().
+	void sample(Pose &pose, float time, bool loop);
+
+	/// Samples the animation into many poses at once, each at its own time, applying each timeline to all the poses before
+	/// the next. This is faster than sampling the poses one at a time when there are many of them.
+	/// @param times One time per pose.
+	void sample(Vector<Pose *> &poses, Vector<float> &times, bool loop);
+
 	const String &getName();
 
+	/// The timelines are reordered by type when the animation is created or loaded, keeping their order within each type,
+	/// so timelines of the same type are applied together. Attachment timelines come first, since deform timelines depend
+	/// on the attachments they set. The order may therefore differ from the order the timelines were passed to the
+	/// constructor or stored in the skeleton file. Call updateTimelineBatches() after adding, removing or replacing
+	/// timelines.
 	Vector<Timeline *> &getTimelines();
 
+	/// The runs of timelines of the same type, which AnimationState applies without checking the type of each timeline.
+	/// Built when the animation is created or loaded and only changed by updateTimelineBatches(), so applying the
+	/// animation never writes to it.
+	Vector<TimelineBatch> &getTimelineBatches();
+
+	/// Sorts the timelines by type and rebuilds the batches and the timeline IDs hasTimeline() checks. Must be called
+	/// after the timelines were changed, and not while the animation is applied.
+	void updateTimelineBatches();
+
 	bool hasTimeline(int id);
 
 	float getDuration();
 
 	void setDuration(float inValue);
 
-
+	/// Returns false if the animation's timelines are loaded on demand and are not currently loaded.
+	bool isLoaded();
+
+	/// Loads the timelines of an animation loaded on demand, if not loaded yet. This happens automatically when the
+	/// animation is applied or its timelines are accessed. Loading is not thread safe and the first access must not happen
+	/// on multiple threads at once, so animations that may be applied from multiple threads should be loaded beforehand,
+	/// as SkeletonUpdateBatch::begin() does. isLoaded() only returns true once the timelines are complete.
+	/// @return False if the timelines could not be decoded. The animation then has no timelines and is not loaded again
+	/// until unload() is called.
+	bool load();
+
+	/// Deletes the timelines of an animation loaded on demand, to reduce memory usage. They are loaded again when next
+	/// needed. Must not be called while the animation is being applied. Events from the animation's event timeline are
+	/// deleted too.
+	void unload();
+
+	/// Quantizes the animation's timelines that support it, sharing a curve table between them. See
+	/// CurveTimeline::quantize(). If the animation is loaded on demand and not currently loaded, its timelines are
+	/// quantized each time they are loaded instead.
+	/// @param tolerance The maximum error allowed for a keyframe value, in the value's units, or for a keyframe time, in
+	/// seconds.
+	/// @return The number of bytes saved.
+	size_t quantize(float tolerance);
+
+	/// Builds the curve lookups of the animation's timelines, see CurveTimeline::buildCurveLookup(). Must be called before
+	/// quantize(), since quantized timelines are left unchanged. If the animation is loaded on demand and not currently
+	/// loaded, the lookups are built each time its timelines are loaded instead.
+	void buildCurveLookup();
+
+	/// Sets the frame cursor used by timelines on the calling thread, or NULL for none. A cursor holds the frame found by
+	/// the last keyframe search, so the next search checks that frame and the one after it before doing a binary search.
+	/// AnimationState sets a cursor for each timeline of a TrackEntry while applying it.
+	static void setFrameCursor(int *cursor);
+
+	static int *getFrameCursor();
 
 private:
 	Vector<Timeline *> _timelines;
+	Vector<TimelineBatch> _timelineBatches;
 	HashMap<int, bool> _timelineIds;
 	float _duration;
 	String _name;
+	TimelineLoader *_timelineLoader;
+	bool _loaded;
+	bool _loadFailed;
+	float _quantizeTolerance;
+	bool _curveLookup;
+	CurveTable *_curveTable;
 
 	/// @param target After the first and before the last entry.
 	static int binarySearch(Vector<float> &values, float target, int step);
 
+	/// @param target After the first and before the last entry.
+	static int binarySearch(QuantizedFrames &values, float target, int step);
+
 	/// @param target After the first and before the last entry.
 	static int binarySearch(Vector<float> &values, float target);
 
 	static int linearSearch(Vector<float> &values, float target, int step);
+
+	void sortTimelines();
+
+	void buildTimelineBatches();
+
+	size_t quantizeTimelines();
+
+	void buildTimelineCurveLookups();
 };
 }
 
@@ -249,6 +249,7 @@ namespace spine {
 		Vector<int> _timelineMode;
 		Vector<TrackEntry*> _timelineHoldMix;
 		Vector<float> _timelinesRotation;
+		Vector<int> _timelineCursors;
 		AnimationStateListener _listener;
 		AnimationStateListenerObject* _listenerObject;
 
@@ -268,6 +269,7 @@ namespace spine {
 
 	class SP_API EventQueue : public SpineObject {
 		friend class AnimationState;
+		friend class SkeletonUpdateBatch;
 
 	private:
 		Vector<EventQueueEntry> _eventQueueEntries;
@@ -302,6 +304,7 @@ namespace spine {
 	class SP_API AnimationState : public SpineObject, public HasRendererObject {
 		friend class TrackEntry;
 		friend class EventQueue;
+		friend class SkeletonUpdateBatch;
 
 	public:
 		explicit AnimationState(AnimationStateData* data);
@@ -313,7 +316,8 @@ namespace spine {
 		void update(float delta);
 
 		/// Poses the skeleton using the track entry animations. There are no side effects other than invoking listeners, so the
-		/// animation state can be applied to multiple skeletons to pose them identically.
+		/// animation state can be applied to multiple skeletons to pose them identically. Work is skipped as set by the
+		/// skeleton's LodLevel, see Skeleton::setLodLevel().
 		bool apply(Skeleton& skeleton);
 
 		/// Removes all animations from all tracks, leaving skeletons in their previous pose.
@@ -386,6 +390,11 @@ namespace spine {
 		void disableQueue();
 		void enableQueue();
 
+		/// If true, each TrackEntry remembers the last keyframe found by each timeline and checks it and the following
+		/// keyframe before doing a binary search. The results are the same either way. Default is true.
+		void setFrameCursorsEnabled(bool inValue);
+		bool isFrameCursorsEnabled();
+
 	private:
 
 		AnimationStateData* _data;
@@ -405,14 +414,26 @@ namespace spine {
 
 		float _timeScale;
 
+		bool _frameCursorsEnabled;
+
+		// The alpha and blend of each timeline of the entry being applied.
+		Vector<float> _timelineAlphas;
+		Vector<MixBlend> _timelineBlends;
+
 		static Animation* getEmptyAnimation();
 
+		/// @return The frame cursors for the entry's timelines, or NULL if frame cursors are disabled.
+		int* getFrameCursors(TrackEntry* entry, size_t timelineCount);
+
 		static void applyRotateTimeline(RotateTimeline* rotateTimeline, Skeleton& skeleton, float time, float alpha, MixBlend pose, Vector<float>& timelinesRotation, size_t i, bool firstFrame);
         void applyAttachmentTimeline(AttachmentTimeline* attachmentTimeline, Skeleton& skeleton, float animationTime, MixBlend pose, bool firstFrame);
 
 		/// Returns true when all mixing from entries are complete.
 		bool updateMixingFrom(TrackEntry* to, float delta);
 
+		/// Applies the track entry animations, see apply().
+		bool applyTracks(Skeleton& skeleton);
+
 		float applyMixingFrom(TrackEntry* to, Skeleton& skeleton, MixBlend currentPose);
 
 		void queueEvents(TrackEntry* entry, float animationTime);
@@ -76,9 +76,14 @@ namespace spine {
 			bool operator==(const AnimationPair &other) const;
 		};
 
+		class AnimationPairHash {
+		public:
+			size_t operator()(const AnimationPair &pair) const;
+		};
+
 		SkeletonData* _skeletonData;
 		float _defaultMix;
-		HashMap<AnimationPair, float> _animationToMixTime;
+		HashMap<AnimationPair, float, AnimationPairHash> _animationToMixTime;
 	};
 }
 
@@ -0,0 +1,107 @@
+/******************************************************************************
+ * Spine Runtimes License Agreement
+ * Last updated January 1, 2020. Replaces all prior versions.
+ *
+ * Copyright (c) 2013-2020, Esoteric Software LLC
+ *
+ * Integration of the Spine Runtimes into software or otherwise creating
+ * derivative works of the Spine Runtimes is permitted under the terms and
+ * conditions of Section 2 of the Spine Editor License Agreement:
+ * http://esotericsoftware.com/spine-editor-license
+ *
+ * Otherwise, it is permitted to integrate the Spine Runtimes into software
+ * or otherwise create derivative works of the Spine Runtimes (collectively,
+ * "Products"), provided that each user of the Products must obtain their own
+ * Spine Editor license and redistribution of the Products in any form must
+ * include this license and copyright notice.
+ *
+ * THE SPINE RUNTIMES ARE PROVIDED BY ESOTERIC SOFTWARE LLC "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL ESOTERIC SOFTWARE LLC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES,
+ * BUSINESS INTERRUPTION, OR LOSS OF USE, DATA, OR PROFITS) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THE SPINE RUNTIMES, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+#ifndef Spine_Arena_h
+#define Spine_Arena_h
+
+#include <spine/SpineObject.h>
+
+namespace spine {
+/// A region allocator for memory that lives as long as its owner, e.g. a SkeletonData. While an arena is current, all
+/// allocations made through SpineExtension are carved from large blocks. Freeing arena memory does nothing, since arena
+/// strings may be shared, and reallocating it copies it to a new allocation. All blocks are released at once when the
+/// arena is deleted. Scratch memory should be allocated while no arena is current, see ArenaScope.
+///
+/// The current arena is per thread. Arenas can be created, freed into and deleted on any thread, while each arena is
+/// only allocated from by one thread at a time.
+class SP_API Arena : public SpineObject {
+public:
+	explicit Arena(size_t blockSize = 64 * 1024);
+
+	~Arena();
+
+	/// Returns NULL if the arena can't register more blocks, see contains(). SpineExtension then allocates from the heap.
+	void *alloc(size_t size, bool clear);
+
+	/// The number of bytes allocated from the SpineExtension for this arena's blocks.
+	size_t getCapacity();
+
+	/// The number of bytes handed out by this arena, including allocation headers and padding.
+	size_t getUsed();
+
+	/// The arena SpineExtension allocates from on the calling thread. May be NULL.
+	static Arena *getCurrent();
+
+	static void setCurrent(Arena *inValue);
+
+	/// Returns true if the memory was allocated by this arena. Searches only this arena's blocks.
+	bool owns(const void *ptr);
+
+	/// Returns true if the memory was allocated by any arena that has not been deleted. This is called for every
+	/// SpineExtension::free() and realloc() and never blocks: the blocks of all arenas are kept in a fixed size table
+	/// that is read without locking.
+	static bool contains(const void *ptr);
+
+	/// Reallocates memory allocated by an arena. The new memory comes from the current arena, if any.
+	static void *realloc(void *ptr, size_t size, const char *file, int line);
+
+private:
+	struct Block {
+		Block *next;
+		size_t size;
+		size_t used;
+	};
+
+	Block *_blocks;
+	size_t _blockSize;
+	size_t _capacity;
+	size_t _used;
+
+	Block *newBlock(size_t size);
+
+	/// Returns the block holding ptr if it is the last allocation of one of the two most recent blocks, else NULL.
+	Block *findLast(const void *ptr);
+
+	static char *getData(Block *block);
+};
+
+/// Makes an arena current until the end of the scope, then restores the previous one. A NULL arena allocates through
+/// the SpineExtension for the scope.
+class SP_API ArenaScope {
+public:
+	explicit ArenaScope(Arena *arena);
+
+	~ArenaScope();
+
+private:
+	Arena *_previous;
+};
+}
+
+#endif /* Spine_Arena_h */
@@ -0,0 +1,189 @@
+/******************************************************************************
+ * Spine Runtimes License Agreement
+ * Last updated January 1, 2020. Replaces all prior versions.
+ *
+ * Copyright (c) 2013-2020, Esoteric Software LLC
+ *
+ * Integration of the Spine Runtimes into software or otherwise creating
+ * derivative works of the Spine Runtimes is permitted under the terms and
+ * conditions of Section 2 of the Spine Editor License Agreement:
+ * http://esotericsoftware.com/spine-editor-license
+ *
+ * Otherwise, it is permitted to integrate the Spine Runtimes into software
+ * or otherwise create derivative works of the Spine Runtimes (collectively,
+ * "Products"), provided that each user of the Products must obtain their own
+ * Spine Editor license and redistribution of the Products in any form must
+ * include this license and copyright notice.
+ *
+ * THE SPINE RUNTIMES ARE PROVIDED BY ESOTERIC SOFTWARE LLC "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL ESOTERIC SOFTWARE LLC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES,
+ * BUSINESS INTERRUPTION, OR LOSS OF USE, DATA, OR PROFITS) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THE SPINE RUNTIMES, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+#ifndef Spine_AsyncLoader_h
+#define Spine_AsyncLoader_h
+
+#include <spine/HashMap.h>
+#include <spine/SpineObject.h>
+#include <spine/SpineString.h>
+#include <spine/Vector.h>
+
+#ifdef SPINE_USE_STD_FUNCTION
+#include <functional>
+#endif
+
+namespace spine {
+	class AsyncLoader;
+	class AsyncLoad;
+	class AsyncLoadJob;
+	class Atlas;
+	class JobRunner;
+	class SkeletonData;
+	class TextureLoader;
+
+#ifdef SPINE_USE_STD_FUNCTION
+	typedef std::function<void (AsyncLoader* loader, AsyncLoad* load)> AsyncLoadListener;
+#else
+	typedef void (*AsyncLoadListener) (AsyncLoader* loader, AsyncLoad* load);
+#endif
+
+	/// Abstract class to inherit from to create a callback object
+	class SP_API AsyncLoadListenerObject {
+	public:
+		AsyncLoadListenerObject() { };
+		virtual ~AsyncLoadListenerObject() { };
+	public:
+		/// The callback function to be called
+		virtual void callback(AsyncLoader* loader, AsyncLoad* load) = 0;
+	};
+
+	/// An atlas or skeleton data being loaded by an AsyncLoader. The load owns the atlas or skeleton data, which is deleted
+	/// when the last reference to the load is released.
+	class SP_API AsyncLoad : public SpineObject {
+		friend class AsyncLoader;
+		friend class AsyncLoadJob;
+
+	public:
+		const String& getPath();
+
+		/// True once the atlas or skeleton data is loaded and the atlas textures are created, or loading failed.
+		bool isDone();
+
+		/// The atlas, or NULL if this loads skeleton data, it is not done, or it failed.
+		Atlas* getAtlas();
+
+		/// The skeleton data, or NULL if this loads an atlas, it is not done, or it failed.
+		SkeletonData* getSkeletonData();
+
+		/// Empty unless loading failed.
+		const String& getError();
+
+	private:
+		enum State {
+			State_Waiting, // For the atlas the skeleton data needs.
+			State_Running,
+			State_Done
+		};
+
+		AsyncLoad(const String& path, TextureLoader* textureLoader, AsyncLoad* atlasLoad, float scale);
+
+		~AsyncLoad();
+
+		/// Reads the file and parses it. Called on a thread of the JobRunner.
+		void load();
+
+		const String _path;
+		State _state;
+		int _references;
+		TextureLoader* _textureLoader;
+		AsyncLoad* _atlasLoad;
+		float _scale;
+		AsyncLoadJob* _job;
+		Atlas* _atlas;
+		SkeletonData* _skeletonData;
+		String _error;
+	};
+
+	/// Loads atlases and skeleton data without blocking the calling thread. Files are read and parsed by jobs started on a
+	/// JobRunner, which is expected to run them on background threads. Everything else, including the TextureLoader
+	/// callbacks for atlas pages and the listener, happens in update(), on the thread that calls it.
+	///
+	/// While a load is running, or done and still referenced, further requests with the same path, texture loader or atlas
+	/// load, and scale return the same load, so concurrent requests read the file once.
+	class SP_API AsyncLoader : public SpineObject {
+	public:
+		/// @param jobRunner Starts the jobs that read and parse files. If NULL, files are read and parsed synchronously.
+		explicit AsyncLoader(JobRunner* jobRunner);
+
+		/// Waits for the jobs that are running, then deletes all loads, including the loaded atlases and skeleton data.
+		~AsyncLoader();
+
+		/// Starts loading an atlas. Its page textures are created with the texture loader in update().
+		/// @return A load with a reference the caller must release.
+		AsyncLoad* loadAtlas(const String& path, TextureLoader* textureLoader);
+
+		/// Starts loading skeleton data from a JSON file if the path ends with .json, otherwise from a binary file. Parsing
+		/// starts once the atlas load is done. The skeleton data load keeps a reference to the atlas load until it is
+		/// released.
+		/// @return A load with a reference the caller must release.
+		AsyncLoad* loadSkeletonData(const String& path, AsyncLoad* atlasLoad, float scale = 1);
+
+		/// Releases a reference to the load, deleting it and its atlas or skeleton data once there are no references left.
+		void release(AsyncLoad* load);
+
+		/// Starts the loads that were waiting for an atlas, creates the page textures of loaded atlases and calls the listener
+		/// for each load that is done. Call this regularly, e.g. once a frame, on the thread textures must be created on.
+		void update();
+
+		/// The number of loads that are not done.
+		int getPendingCount();
+
+		void setListener(AsyncLoadListener listener);
+
+		void setListener(AsyncLoadListenerObject* listener);
+
+	private:
+		class Key {
+		public:
+			Key(const String& inPath, float inScale, void* inOwner) : path(inPath), scale(inScale), owner(inOwner) {
+			}
+
+			bool operator==(const Key& other) const {
+				return scale == other.scale && owner == other.owner && path == other.path;
+			}
+
+			String path;
+			float scale;
+			void* owner; // The texture loader of an atlas, or the atlas load of skeleton data.
+		};
+
+		class KeyHash {
+		public:
+			size_t operator()(const Key& key) const;
+		};
+
+		JobRunner* _jobRunner;
+		const bool _ownsJobRunner;
+		Vector<AsyncLoad*> _loads;
+		HashMap<Key, AsyncLoad*, KeyHash> _loadIndex;
+		AsyncLoadListener _listener;
+		AsyncLoadListenerObject* _listenerObject;
+
+		AsyncLoad* addLoad(const String& path, TextureLoader* textureLoader, AsyncLoad* atlasLoad, float scale);
+
+		static Key getKey(AsyncLoad* load);
+
+		void start(AsyncLoad* load);
+
+		void finish(AsyncLoad* load);
+	};
+}
+
+#endif /* Spine_AsyncLoader_h */
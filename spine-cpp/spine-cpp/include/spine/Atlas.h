@@ -31,6 +31,7 @@
 #define Spine_Atlas_h
 
 #include <spine/Vector.h>
+#include <spine/HashMap.h>
 #include <spine/Extension.h>
 #include <spine/SpineObject.h>
 #include <spine/SpineString.h>
@@ -83,6 +84,10 @@ public:
 
 class SP_API AtlasRegion : public SpineObject {
 public:
+	AtlasRegion() : page(NULL), x(0), y(0), width(0), height(0), u(0), v(0), u2(0), v2(0), offsetX(0), offsetY(0),
+		originalWidth(0), originalHeight(0), index(0), rotate(false), degrees(0) {
+	}
+
 	AtlasPage *page;
 	String name;
 	int x, y, width, height;
@@ -98,6 +103,9 @@ public:
 
 class TextureLoader;
 
+/// Stores the pages and regions of a texture atlas. Atlases are loaded from the text format written by the Spine texture
+/// packer, or from the binary format written by writeBinary(), which is detected by its first bytes. The binary format
+/// stores the values as varints and all region names in one block, so loading it does not tokenize or parse numbers.
 class SP_API Atlas : public SpineObject {
 public:
 	Atlas(const String &path, TextureLoader *textureLoader, bool createTexture = true);
@@ -108,20 +116,54 @@ public:
 
 	void flipV();
 
-	/// Returns the first region found with the specified name. This method uses String comparison to find the region, so the result
-	/// should be cached rather than calling this method multiple times.
+	/// Returns the first region found with the specified name, using a hashed index of the region names.
 	/// @return The region, or NULL.
 	AtlasRegion *findRegion(const String &name);
 
 	Vector<AtlasPage*> &getPages();
 
+	/// The regions are stored contiguously and must not be added or removed.
+	Vector<AtlasRegion> &getRegions();
+
+	/// Writes the atlas in the binary format, replacing the contents of the vector. An atlas loaded from the text format
+	/// with createTexture false can be written this way to convert it.
+	void writeBinary(Vector<unsigned char> &output);
+
+	bool writeBinaryFile(const String &path);
+
 private:
 	Vector<AtlasPage *> _pages;
-	Vector<AtlasRegion *> _regions;
+	Vector<AtlasRegion> _regions; // Stored contiguously, so regions must not be added once loading is done.
+	Vector<int> _regionSlots; // Open addressed hash of the region names, each slot is a region index + 1 or 0 if empty.
 	TextureLoader *_textureLoader;
 
 	void load(const char *begin, int length, const char *dir, bool createTexture);
 
+	class BinaryInput {
+	public:
+		const unsigned char *cursor;
+		const unsigned char *end;
+		bool overflow;
+	};
+
+	/// Returns false if the binary atlas is invalid, in which case nothing is loaded.
+	bool loadBinary(const char *begin, int length, const char *dir, bool createTexture);
+
+	/// Loads the page's texture from the directory, or stores its path if createTexture is false, and adds the page.
+	void addPage(AtlasPage *page, const char *dir, bool createTexture);
+
+	AtlasRegion &addRegion(AtlasPage *page);
+
+	void indexRegions();
+
+	static void setUVs(AtlasRegion &region);
+
+	static unsigned char readByte(BinaryInput *input);
+
+	static int readVarint(BinaryInput *input, bool optimizePositive);
+
+	static void writeVarint(Vector<unsigned char> &output, int value, bool optimizePositive);
+
 	class Str {
 	public:
 		const char *begin;
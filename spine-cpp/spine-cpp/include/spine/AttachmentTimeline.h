@@ -54,6 +54,8 @@ namespace spine {
 
 		virtual void apply(Skeleton& skeleton, float lastTime, float time, Vector<Event*>* pEvents, float alpha, MixBlend blend, MixDirection direction);
 
+		virtual void sample(Pose& pose, float time);
+
 		virtual int getPropertyId();
 
 		/// Sets the time and value of the specified keyframe.
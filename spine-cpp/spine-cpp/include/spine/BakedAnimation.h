@@ -0,0 +1,117 @@
+/******************************************************************************
+ * Spine Runtimes License Agreement
+ * Last updated January 1, 2020. Replaces all prior versions.
+ *
+ * Copyright (c) 2013-2020, Esoteric Software LLC
+ *
+ * Integration of the Spine Runtimes into software or otherwise creating
+ * derivative works of the Spine Runtimes is permitted under the terms and
+ * conditions of Section 2 of the Spine Editor License Agreement:
+ * http://esotericsoftware.com/spine-editor-license
+ *
+ * Otherwise, it is permitted to integrate the Spine Runtimes into software
+ * or otherwise create derivative works of the Spine Runtimes (collectively,
+ * "Products"), provided that each user of the Products must obtain their own
+ * Spine Editor license and redistribution of the Products in any form must
+ * include this license and copyright notice.
+ *
+ * THE SPINE RUNTIMES ARE PROVIDED BY ESOTERIC SOFTWARE LLC "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL ESOTERIC SOFTWARE LLC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES,
+ * BUSINESS INTERRUPTION, OR LOSS OF USE, DATA, OR PROFITS) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THE SPINE RUNTIMES, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+#ifndef Spine_BakedAnimation_h
+#define Spine_BakedAnimation_h
+
+#include <spine/Vector.h>
+#include <spine/SpineObject.h>
+
+namespace spine {
+class SkeletonData;
+
+class Skeleton;
+
+class Animation;
+
+class Skin;
+
+class Attachment;
+
+/// An animation pre-sampled at a fixed rate into a table of applied local bone transforms, slot attachments, slot colors
+/// and draw order. Applying it interpolates two samples straight into the bones' world transforms, skipping timelines,
+/// curves and constraints, which is useful for many skeletons playing the same looping animation.
+///
+/// Samples are taken after constraints are applied, with the animation applied alone over the setup pose. Mesh deform and
+/// dark colors are not baked.
+class SP_API BakedAnimation : public SpineObject {
+public:
+	/// @param sampleRate Samples per second.
+	/// @param quantize If true, transforms are stored as 16 bit values within each bone's range and colors as 8 bit values.
+	/// @param memoryBudget If greater than 0, the sample rate is lowered until the samples fit in this many bytes.
+	/// @param skin The skin used to find attachments. May be NULL for the default skin.
+	BakedAnimation(SkeletonData &skeletonData, Animation &animation, float sampleRate = 30, bool quantize = false,
+		size_t memoryBudget = 0, Skin *skin = NULL);
+
+	~BakedAnimation();
+
+	/// Poses the skeleton at the specified time and computes its world transforms. Use this instead of AnimationState::apply
+	/// and Skeleton::updateWorldTransform. The skeleton must be for the skeleton data the animation was baked for.
+	void apply(Skeleton &skeleton, float time, bool loop);
+
+	Animation &getAnimation();
+
+	/// The sample rate, which may be lower than requested to fit the memory budget.
+	float getSampleRate();
+
+	int getFrameCount();
+
+	bool isQuantized();
+
+	/// The number of bytes used by the samples.
+	size_t getMemorySize();
+
+	/// The largest distance between a bone's world position when applying the baked animation and when applying the
+	/// animation, measured halfway between samples.
+	float getMaxError();
+
+private:
+	static const int TRANSFORM_ENTRIES = 7;
+
+	SkeletonData &_skeletonData;
+	Animation &_animation;
+	float _sampleRate;
+	int _frameCount;
+	bool _quantize;
+	bool _drawOrder;
+	float _maxError;
+	size_t _boneCount, _slotCount;
+
+	Vector<float> _transforms;
+	Vector<unsigned short> _quantizedTransforms;
+	Vector<float> _transformRanges; // Minimum and step per bone transform value, when quantized.
+	Vector<Attachment *> _attachments; // Attachments used by the animation, the first is NULL.
+	Vector<unsigned short> _slotAttachments; // Indices into _attachments.
+	Vector<float> _colors;
+	Vector<unsigned char> _quantizedColors;
+	Vector<unsigned short> _drawOrders;
+
+	void bake(Skin *skin);
+
+	void measureError(Skin *skin);
+
+	size_t computeMemorySize(int frameCount);
+
+	float getTransform(int frame, size_t index);
+
+	float getColor(int frame, size_t index);
+};
+}
+
+#endif /* Spine_BakedAnimation_h */
@@ -69,6 +69,10 @@ class SP_API Bone : public Updatable {
 
 	friend class TranslateTimeline;
 
+	friend class BoneTransforms;
+
+	friend class BakedAnimation;
+
 RTTI_DECL
 
 public:
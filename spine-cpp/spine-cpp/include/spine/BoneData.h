@@ -109,6 +109,11 @@ public:
 	bool isSkinRequired();
 	void setSkinRequired(bool inValue);
 
+	/// If true, the bone is not animated when a skeleton's LodLevel::skipLowImportanceBones is set, eg for secondary motion
+	/// such as hair or cloth. Not stored in skeleton files. Defaults to false.
+	bool isLowImportance();
+	void setLowImportance(bool inValue);
+
 private:
 	const int _index;
 	const String _name;
@@ -117,6 +122,7 @@ private:
 	float _x, _y, _rotation, _scaleX, _scaleY, _shearX, _shearY;
 	TransformMode _transformMode;
 	bool _skinRequired;
+	bool _lowImportance;
 };
 }
 
@@ -0,0 +1,113 @@
+/******************************************************************************
+ * Spine Runtimes License Agreement
+ * Last updated January 1, 2020. Replaces all prior versions.
+ *
+ * Copyright (c) 2013-2020, Esoteric Software LLC
+ *
+ * Integration of the Spine Runtimes into software or otherwise creating
+ * derivative works of the Spine Runtimes is permitted under the terms and
+ * conditions of Section 2 of the Spine Editor License Agreement:
+ * http://esotericsoftware.com/spine-editor-license
+ *
+ * Otherwise, it is permitted to integrate the Spine Runtimes into software
+ * or otherwise create derivative works of the Spine Runtimes (collectively,
+ * "Products"), provided that each user of the Products must obtain their own
+ * Spine Editor license and redistribution of the Products in any form must
+ * include this license and copyright notice.
+ *
+ * THE SPINE RUNTIMES ARE PROVIDED BY ESOTERIC SOFTWARE LLC "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL ESOTERIC SOFTWARE LLC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES,
+ * BUSINESS INTERRUPTION, OR LOSS OF USE, DATA, OR PROFITS) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THE SPINE RUNTIMES, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+#ifndef Spine_BoneTransforms_h
+#define Spine_BoneTransforms_h
+
+#include <spine/Vector.h>
+#include <spine/SpineObject.h>
+
+namespace spine {
+class Skeleton;
+
+class Updatable;
+
+/// Stores the local, applied and world transforms of a skeleton's bones in contiguous arrays, indexed by bone index and
+/// therefore ordered parents first.
+///
+/// When enabled via Skeleton::setBoneTransformsEnabled(), Skeleton::updateWorldTransform() computes bone world transforms
+/// from these arrays in a tight loop without virtual dispatch. The local rotation, scale and shear matrix of each bone is
+/// cached and only recomputed when those values change. Bone objects are written back before each constraint is applied
+/// and when the update completes, so the results are identical to the per-Bone update.
+class SP_API BoneTransforms : public SpineObject {
+	friend class Skeleton;
+
+public:
+	explicit BoneTransforms(Skeleton &skeleton);
+
+	~BoneTransforms();
+
+	/// Builds the update program from the skeleton's update cache. Called by Skeleton::updateCache().
+	void updateCache();
+
+	/// Updates the world transform for each bone and applies constraints. See Skeleton::updateWorldTransform().
+	void updateWorldTransform();
+
+	size_t getBoneCount();
+
+	Vector<float> &getA();
+
+	Vector<float> &getB();
+
+	Vector<float> &getC();
+
+	Vector<float> &getD();
+
+	Vector<float> &getWorldX();
+
+	Vector<float> &getWorldY();
+
+private:
+	Skeleton &_skeleton;
+	Vector<int> _parents;
+	Vector<int> _transformModes;
+
+	// Local transform.
+	Vector<float> _x, _y, _rotation, _scaleX, _scaleY, _shearX, _shearY;
+
+	// Applied transform.
+	Vector<float> _ax, _ay, _arotation, _ascaleX, _ascaleY, _ashearX, _ashearY;
+
+	// World transform.
+	Vector<float> _a, _b, _c, _d, _worldX, _worldY;
+
+	// Cached local matrix and the rotation, scale and shear it was computed from.
+	Vector<float> _la, _lb, _lc, _ld;
+	Vector<float> _cacheRotation, _cacheScaleX, _cacheScaleY, _cacheShearX, _cacheShearY;
+	Vector<bool> _cacheValid;
+
+	/// Bone indices >= 0, constraints as -(index + 1) into _constraints.
+	Vector<int> _program;
+	Vector<Updatable *> _constraints;
+
+	/// Bone indices whose world transform each constraint may change, _constraintBonesStart[i] to _constraintBonesStart[i + 1].
+	Vector<int> _constraintBones;
+	Vector<int> _constraintBonesStart;
+
+	void updateBone(int i, float sx, float sy);
+
+	void readLocal(int i);
+
+	void readWorld(int i);
+
+	void writeBone(int i);
+};
+}
+
+#endif /* Spine_BoneTransforms_h */
@@ -33,6 +33,8 @@
 #include <spine/CurveTimeline.h>
 
 namespace spine {
+class Color;
+
 class SP_API ColorTimeline : public CurveTimeline {
 	friend class SkeletonBinary;
 
@@ -49,6 +51,8 @@ public:
 	apply(Skeleton &skeleton, float lastTime, float time, Vector<Event *> *pEvents, float alpha, MixBlend blend,
 		MixDirection direction);
 
+	virtual void sample(Pose &pose, float time);
+
 	virtual int getPropertyId();
 
 	/// Sets the time and value of the specified keyframe.
@@ -74,6 +78,9 @@ protected:
 private:
 	int _slotIndex;
 	Vector<float> _frames;
+
+	/// Sets the color at the time, which must not be before the first frame.
+	void getValues(float time, Color &color);
 };
 }
 
@@ -37,6 +37,7 @@
 #include <spine/SpineString.h>
 
 #include <assert.h>
+#include <string.h>
 
 namespace spine {
 	class SP_API ContainerUtil : public SpineObject {
@@ -122,6 +123,56 @@ namespace spine {
 		ContainerUtil(const ContainerUtil&);
 		ContainerUtil& operator=(const ContainerUtil&);
 	};
+
+	/// Maps item names to indices for O(1) lookups by name. The index is built once by update() when the items are loaded
+	/// and find() only reads it, so lookups can run on many threads at once. The items are not owned and may change after
+	/// update(): a hit is verified against the item, and a miss is only trusted if the items are still the ones that were
+	/// indexed, else find() falls back to a linear search until update() is called again. Item names never change after
+	/// construction, so comparing the item pointers is enough to detect a stale index.
+	template<typename T>
+	class SP_API NameIndex : public SpineObject {
+	public:
+		NameIndex() : _indexed(false) {
+		}
+
+		void update(Vector<T*>& items) {
+			_indices.clear();
+			// Reverse order so the first of items with the same name wins.
+			for (int i = (int)items.size() - 1; i >= 0; i--)
+				if (items[i]) _indices.put(items[i]->getName(), i);
+			_items.clearAndAddAll(items);
+			_indexed = true;
+		}
+
+		/// @return -1 if the item was not found.
+		int find(Vector<T*>& items, const String& name) {
+			assert(name.length() > 0);
+
+			int *index = _indices.get(name);
+			if (index) {
+				if (*index < (int)items.size() && items[*index] && items[*index]->getName() == name) return *index;
+			} else if (isCurrent(items)) {
+				return -1;
+			}
+
+			for (size_t i = 0, len = items.size(); i < len; ++i) {
+				T* item = items[i];
+				if (item && item->getName() == name) return static_cast<int>(i);
+			}
+			return -1;
+		}
+
+	private:
+		HashMap<String, int> _indices;
+		Vector<T*> _items;
+		bool _indexed;
+
+		/// Returns true if the items are the ones the index was built from, in the same order.
+		bool isCurrent(Vector<T*>& items) {
+			if (!_indexed || _items.size() != items.size()) return false;
+			return items.size() == 0 || memcmp(_items.buffer(), items.buffer(), items.size() * sizeof(T*)) == 0;
+		}
+	};
 }
 
 #endif /* Spine_ContainerUtil_h */
@@ -30,10 +30,58 @@
 #ifndef Spine_CurveTimeline_h
 #define Spine_CurveTimeline_h
 
+#include <spine/HashMap.h>
 #include <spine/Timeline.h>
 #include <spine/Vector.h>
 
 namespace spine {
+	/// Bezier curves sampled by CurveTimeline::setCurve() or CurveTimeline::buildCurveLookup(), shared by the quantized timelines of an animation so that
+	/// identical curves are stored once.
+	class SP_API CurveTable : public SpineObject {
+	public:
+		/// The number of floats sampled for each curve.
+		static const int SAMPLES = 18;
+
+		/// Returns the index of the curve with the samples, adding it if it is not in the table yet.
+		int add(const float* samples);
+
+		const float* getSamples(int index) { return _samples.buffer() + index * SAMPLES; }
+
+		size_t size() { return _samples.size() / SAMPLES; }
+
+		void clear();
+
+	private:
+		Vector<float> _samples;
+		HashMap<int, int> _index; // Hash of the samples to the first curve with that hash.
+	};
+
+	/// Keyframe values stored as 16-bit integers, each entry of a frame quantized over its own range. Values are decoded
+	/// when they are read.
+	class SP_API QuantizedFrames : public SpineObject {
+	public:
+		QuantizedFrames();
+
+		/// Quantizes the frames, unless a value would be off by more than the tolerance.
+		/// @return False if the frames were not quantized.
+		bool set(Vector<float>& frames, int entries, float tolerance);
+
+		inline float operator[](size_t index) {
+			size_t entry = index % _entries;
+			return _offsets[entry] + _values[index] * _steps[entry];
+		}
+
+		inline size_t size() { return _values.size(); }
+
+		/// The number of bytes used by the values and ranges.
+		size_t getMemory();
+
+	private:
+		Vector<unsigned short> _values;
+		Vector<float> _offsets, _steps;
+		size_t _entries;
+	};
+
 	/// Base class for frames that use an interpolation bezier curve.
 	class SP_API CurveTimeline : public Timeline {
 		RTTI_DECL
@@ -62,14 +110,40 @@ namespace spine {
 
 		float getCurveType(size_t frameIndex);
 
+		/// Replaces the samples of each bezier curve with the curve's values at evenly spaced times, so getCurvePercent()
+		/// reads them by index instead of searching the samples. The values are computed from the bezier curve the samples
+		/// were taken from. A curve keeps its samples if they are closer to the bezier curve than the values would be,
+		/// which happens when the curve is steep near its start or end. The curves can't be changed afterward. Quantized
+		/// timelines are left unchanged.
+		/// @return The number of curves replaced.
+		int buildCurveLookup();
+
+		/// Stores the keyframes as 16-bit values and the bezier curves in the curve table, unless a keyframe value or time
+		/// would be off by more than the tolerance. The keyframes can't be changed and their frames are empty once
+		/// quantized. Only bone timelines can be quantized, other timelines are left unchanged.
+		/// @param curveTable Must outlive the timeline.
+		/// @return The number of bytes saved, or 0 if the timeline was not quantized.
+		virtual size_t quantize(float tolerance, CurveTable& curveTable);
+
+		bool isQuantized();
+
 	protected:
 		static const float LINEAR;
 		static const float STEPPED;
 		static const float BEZIER;
+		static const float LOOKUP; // A bezier curve stored as its values at times 1 / (SAMPLES + 1), 2 / (SAMPLES + 1), ...
 		static const int BEZIER_SIZE;
 
+		QuantizedFrames _quantizedFrames;
+
+		/// Quantizes the frames and the curves, then frees the float frames and curves.
+		size_t quantizeFrames(Vector<float>& frames, int entries, float tolerance, CurveTable& curveTable);
+
 	private:
 		Vector<float> _curves; // type, x, y, ...
+		Vector<unsigned short> _curveIndices; // Set when quantized: LINEAR, STEPPED, or BEZIER + the curve table index * 2,
+		                                      // + 1 for a lookup.
+		CurveTable* _curveTable;
 	};
 }
 
@@ -108,6 +108,14 @@ public:
 	virtual char *_readFile(const String &path, int *length) {
 		return _extension->_readFile(path, length);
 	}
+
+	virtual const char *_mapFile(const String &path, int *length) {
+		return _extension->_mapFile(path, length);
+	}
+
+	virtual void _unmapFile(const char *data, int length) {
+		_extension->_unmapFile(data, length);
+	}
 	
 	size_t getUsedMemory() {
 		return _usedMemory;
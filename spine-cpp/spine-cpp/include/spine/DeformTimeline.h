@@ -35,6 +35,8 @@
 namespace spine {
 	class VertexAttachment;
 
+	/// Stores for each keyframe only the range of vertices that differ from the setup pose: the attachment's vertices if
+	/// it is unweighted, else deform offsets of 0. Keyframes with identical ranges share their vertices.
 	class SP_API DeformTimeline : public CurveTimeline {
 		friend class SkeletonBinary;
 		friend class SkeletonJson;
@@ -48,21 +50,37 @@ namespace spine {
 
 		virtual int getPropertyId();
 
-		/// Sets the time and value of the specified keyframe.
+		/// Sets the time and value of the specified keyframe. The attachment must be set first.
+		/// @param vertices The vertex positions if the attachment is unweighted, else the deform offsets.
 		void setFrame(int frameIndex, float time, Vector<float>& vertices);
 
+		/// Sets the time and value of the specified keyframe, where only the vertices from start to start + vertices.size()
+		/// differ from the setup pose. The attachment must be set first.
+		void setFrame(int frameIndex, float time, Vector<float>& vertices, int start);
+
 		int getSlotIndex();
 		void setSlotIndex(int inValue);
 		Vector<float>& getFrames();
-		Vector< Vector<float> >& getVertices();
+
+		/// The number of vertex positions or deform offsets of each keyframe.
+		size_t getVertexCount();
+
+		/// Sets the vertices to the vertex positions or deform offsets of the specified keyframe.
+		void getFrameVertices(int frameIndex, Vector<float>& vertices);
+
 		VertexAttachment* getAttachment();
 		void setAttachment(VertexAttachment* inValue);
 
 	private:
 		int _slotIndex;
 		Vector<float> _frames;
-		Vector< Vector<float> > _frameVertices;
+		Vector<int> _vertexStarts; // For each frame, the range of vertices that differ from the setup pose.
+		Vector<int> _vertexEnds;
+		Vector<int> _vertexOffsets; // For each frame, the index in _vertices of the range's first value.
+		Vector<float> _vertices;
 		VertexAttachment* _attachment;
+
+		void setVertices(int frameIndex, const float* vertices, int start, int end);
 	};
 }
 
@@ -43,28 +43,38 @@ class SP_API SpineExtension {
 public:
 	template<typename T>
 	static T *alloc(size_t num, const char *file, int line) {
-		return (T *) getInstance()->_alloc(sizeof(T) * num, file, line);
+		return (T *) allocate(sizeof(T) * num, false, file, line);
 	}
 
 	template<typename T>
 	static T *calloc(size_t num, const char *file, int line) {
-		return (T *) getInstance()->_calloc(sizeof(T) * num, file, line);
+		return (T *) allocate(sizeof(T) * num, true, file, line);
 	}
 
 	template<typename T>
 	static T *realloc(T *ptr, size_t num, const char *file, int line) {
-		return (T *) getInstance()->_realloc(ptr, sizeof(T) * num, file, line);
+		return (T *) reallocate((void *) ptr, sizeof(T) * num, file, line);
 	}
 
 	template<typename T>
 	static void free(T *ptr, const char *file, int line) {
-		getInstance()->_free((void *) ptr, file, line);
+		deallocate((void *) ptr, file, line);
 	}
 
 	static char *readFile(const String &path, int *length) {
 		return getInstance()->_readFile(path, length);
 	}
 
+	/// Returns a read-only view of a file's contents, or NULL if it can't be read. The view must be released with
+	/// unmapFile() instead of free().
+	static const char *mapFile(const String &path, int *length) {
+		return getInstance()->_mapFile(path, length);
+	}
+
+	static void unmapFile(const char *data, int length) {
+		getInstance()->_unmapFile(data, length);
+	}
+
 	static void setInstance(SpineExtension *inSpineExtension);
 
 	static SpineExtension *getInstance();
@@ -83,11 +93,24 @@ public:
 
 	virtual char *_readFile(const String &path, int *length) = 0;
 
+	/// Implement this function to load files without copying them, e.g. by memory mapping. The default reads the file
+	/// with _readFile(). Subclasses of DefaultSpineExtension that override _readFile() should override this too.
+	virtual const char *_mapFile(const String &path, int *length);
+
+	virtual void _unmapFile(const char *data, int length);
+
 protected:
 	SpineExtension();
 
 private:
 	static SpineExtension *_instance;
+
+	/// Allocate from the current Arena if there is one, else from the instance.
+	static void *allocate(size_t size, bool clear, const char *file, int line);
+
+	static void *reallocate(void *ptr, size_t size, const char *file, int line);
+
+	static void deallocate(void *ptr, const char *file, int line);
 };
 
 class SP_API DefaultSpineExtension : public SpineExtension {
@@ -106,6 +129,11 @@ protected:
 	virtual void _free(void *mem, const char *file, int line);
 
 	virtual char *_readFile(const String &path, int *length);
+
+	/// Memory maps the file on POSIX systems and Windows, else reads it. Only regular, non-empty files can be mapped.
+	virtual const char *_mapFile(const String &path, int *length);
+
+	virtual void _unmapFile(const char *data, int length);
 };
 
 // This function is to be implemented by engine specific runtimes to provide
@@ -33,6 +33,7 @@
 #include <spine/Extension.h>
 #include <spine/Vector.h>
 #include <spine/SpineObject.h>
+#include <spine/SpineString.h>
 
  // Required for new with line number and file name in MSVC
 #ifdef _MSC_VER
@@ -40,11 +41,52 @@
 #endif
 
 namespace spine {
-template<typename K, typename V>
-class SP_API HashMap : public SpineObject {
-private:
-	class Entry;
+/// Hash functor used by HashMap. Specialized for int, String and pointers; other key types must provide their own functor.
+template<typename K>
+class Hash;
 
+template<>
+class SP_API Hash<int> {
+public:
+	size_t operator()(int key) const {
+		unsigned int h = (unsigned int) key;
+		h ^= h >> 16;
+		h *= 0x85ebca6bu;
+		h ^= h >> 13;
+		h *= 0xc2b2ae35u;
+		h ^= h >> 16;
+		return h;
+	}
+};
+
+template<>
+class SP_API Hash<String> {
+public:
+	size_t operator()(const String &key) const {
+		unsigned int h = 2166136261u;
+		const char *chars = key.buffer();
+		for (size_t i = 0, n = key.length(); i < n; i++) {
+			h ^= (unsigned char) chars[i];
+			h *= 16777619u;
+		}
+		return h;
+	}
+};
+
+template<typename T>
+class SP_API Hash<T *> {
+public:
+	size_t operator()(T *key) const {
+		size_t address = (size_t) key;
+		return Hash<int>()((int) (address ^ (address >> 16 >> 16)));
+	}
+};
+
+/// A hash map using open addressing with linear probing. Entries are stored contiguously in insertion order and the
+/// probe table only holds indices into them. Removal shifts following probes back instead of leaving tombstones, and
+/// keeps the remaining entries in order, so it is O(n). Iteration visits the most recently added entries first.
+template<typename K, typename V, typename H = Hash<K> >
+class SP_API HashMap : public SpineObject {
 public:
 	class SP_API Pair {
 	public:
@@ -58,101 +100,102 @@ public:
 	public:
 		friend class HashMap;
 
-		explicit Entries(Entry *entry) : _entry(NULL), _hasChecked(false) {
-			_start.next = entry;
-			_entry = &_start;
-		}
-
 		Pair next() {
-			assert(_entry);
+			assert(_index > 0);
 			assert(_hasChecked);
-			_entry = _entry->next;
-			Pair pair(_entry->_key, _entry->_value);
+			_index--;
+			Pair pair(_map->_keys[_index], _map->_values[_index]);
 			_hasChecked = false;
 			return pair;
 		}
 
 		bool hasNext() {
 			_hasChecked = true;
-			return _entry->next;
+			return _index > 0;
 		}
 
 	private:
+		explicit Entries(HashMap *map) : _map(map), _index(map->_keys.size()), _hasChecked(false) {
+		}
+
+		HashMap *_map;
+		size_t _index;
 		bool _hasChecked;
-		Entry _start;
-		Entry *_entry;
 	};
 
-	HashMap() :
-			_head(NULL),
-			_size(0) {
+	HashMap() {
 	}
 
 	~HashMap() {
-		clear();
 	}
 
 	void clear() {
-		for (Entry *entry = _head; entry != NULL;) {
-			Entry* next = entry->next;
-			delete entry;
-			entry = next;
-		}
-		_head = NULL;
-		_size = 0;
+		_keys.clear();
+		_values.clear();
+		_hashes.clear();
+		for (size_t i = 0, n = _slots.size(); i < n; i++)
+			_slots[i] = 0;
 	}
 
 	size_t size() {
-		return _size;
+		return _keys.size();
 	}
 
 	void put(const K &key, const V &value) {
-		Entry *entry = find(key);
-		if (entry) {
-			entry->_key = key;
-			entry->_value = value;
+		size_t hash = _hash(key);
+		size_t slot = findSlot(key, hash);
+		if (slot != NOT_FOUND) {
+			size_t index = _slots[slot] - 1;
+			_keys[index] = key;
+			_values[index] = value;
 		} else {
-			entry = new(__FILE__, __LINE__) Entry();
-			entry->_key = key;
-			entry->_value = value;
-
-			Entry *oldHead = _head;
-
-			if (oldHead) {
-				_head = entry;
-				oldHead->prev = entry;
-				entry->next = oldHead;
-			} else {
-				_head = entry;
-			}
-			_size++;
+			if ((_keys.size() + 1) << 1 > _slots.size()) resize(_slots.size() < 16 ? 16 : _slots.size() << 1);
+			_keys.add(key);
+			_values.add(value);
+			_hashes.add(hash);
+			insertSlot(hash, _keys.size());
 		}
 	}
 
 	bool containsKey(const K &key) {
-		return find(key) != NULL;
+		return findSlot(key, _hash(key)) != NOT_FOUND;
 	}
 
 	bool remove(const K &key) {
-		Entry *entry = find(key);
-		if (!entry) return false;
-
-		Entry *prev = entry->prev;
-		Entry *next = entry->next;
-
-		if (prev) prev->next = next;
-		else _head = next;
-		if (next) next->prev = entry->prev;
-
-		delete entry;
-		_size--;
+		size_t slot = findSlot(key, _hash(key));
+		if (slot == NOT_FOUND) return false;
+		size_t index = _slots[slot] - 1;
+
+		// Shift back following entries of the probe sequence that may occupy the freed slot.
+		size_t mask = _slots.size() - 1;
+		for (size_t i = (slot + 1) & mask;; i = (i + 1) & mask) {
+			size_t next = _slots[i];
+			if (next == 0) break;
+			size_t ideal = _hashes[next - 1] & mask;
+			if (((i - ideal) & mask) >= ((i - slot) & mask)) {
+				_slots[slot] = next;
+				slot = i;
+			}
+		}
+		_slots[slot] = 0;
 
+		_keys.removeAt(index);
+		_values.removeAt(index);
+		_hashes.removeAt(index);
+		for (size_t i = 0, n = _slots.size(); i < n; i++)
+			if (_slots[i] > index + 1) _slots[i]--;
 		return true;
 	}
 
+	/// @return May be NULL.
+	V *get(const K &key) {
+		size_t slot = findSlot(key, _hash(key));
+		return slot != NOT_FOUND ? &_values[_slots[slot] - 1] : NULL;
+	}
+
 	V operator[](const K &key) {
-		Entry *entry = find(key);
-		if (entry) return entry->_value;
+		size_t slot = findSlot(key, _hash(key));
+		if (slot != NOT_FOUND) return _values[_slots[slot] - 1];
 		else {
 			assert(false);
 			return 0;
@@ -160,30 +203,43 @@ public:
 	}
 
 	Entries getEntries() const {
-		return Entries(_head);
+		return Entries(const_cast<HashMap *>(this));
 	}
 
 private:
-	Entry *find(const K &key) {
-		for (Entry *entry = _head; entry != NULL; entry = entry->next) {
-			if (entry->_key == key)
-				return entry;
+	static const size_t NOT_FOUND = (size_t) -1;
+
+	/// Returns the probe table position of the key, or NOT_FOUND.
+	size_t findSlot(const K &key, size_t hash) {
+		if (_keys.size() == 0) return NOT_FOUND;
+		size_t mask = _slots.size() - 1;
+		for (size_t i = hash & mask;; i = (i + 1) & mask) {
+			size_t index = _slots[i];
+			if (index == 0) return NOT_FOUND;
+			if (_hashes[index - 1] == hash && _keys[index - 1] == key) return i;
 		}
-		return NULL;
 	}
 
-	class SP_API Entry : public SpineObject {
-	public:
-		K _key;
-		V _value;
-		Entry *next;
-		Entry *prev;
+	void insertSlot(size_t hash, size_t index) {
+		size_t mask = _slots.size() - 1;
+		size_t i = hash & mask;
+		while (_slots[i] != 0)
+			i = (i + 1) & mask;
+		_slots[i] = index;
+	}
 
-		Entry() : next(NULL), prev(NULL) {}
-	};
+	void resize(size_t capacity) {
+		_slots.clear();
+		_slots.setSize(capacity, 0);
+		for (size_t i = 0, n = _keys.size(); i < n; i++)
+			insertSlot(_hashes[i], i + 1);
+	}
 
-	Entry *_head;
-	size_t _size;
+	H _hash;
+	Vector<K> _keys;
+	Vector<V> _values;
+	Vector<size_t> _hashes;
+	Vector<size_t> _slots; // Entry index + 1, 0 if empty. Size is 0 or a power of 2.
 };
 }
 
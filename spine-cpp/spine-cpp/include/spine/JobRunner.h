@@ -0,0 +1,70 @@
+/******************************************************************************
+ * Spine Runtimes License Agreement
+ * Last updated January 1, 2020. Replaces all prior versions.
+ *
+ * Copyright (c) 2013-2020, Esoteric Software LLC
+ *
+ * Integration of the Spine Runtimes into software or otherwise creating
+ * derivative works of the Spine Runtimes is permitted under the terms and
+ * conditions of Section 2 of the Spine Editor License Agreement:
+ * http://esotericsoftware.com/spine-editor-license
+ *
+ * Otherwise, it is permitted to integrate the Spine Runtimes into software
+ * or otherwise create derivative works of the Spine Runtimes (collectively,
+ * "Products"), provided that each user of the Products must obtain their own
+ * Spine Editor license and redistribution of the Products in any form must
+ * include this license and copyright notice.
+ *
+ * THE SPINE RUNTIMES ARE PROVIDED BY ESOTERIC SOFTWARE LLC "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL ESOTERIC SOFTWARE LLC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES,
+ * BUSINESS INTERRUPTION, OR LOSS OF USE, DATA, OR PROFITS) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THE SPINE RUNTIMES, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+#ifndef Spine_JobRunner_h
+#define Spine_JobRunner_h
+
+#include <spine/SpineObject.h>
+
+namespace spine {
+/// A unit of work made of independent jobs, identified by index.
+class SP_API Job {
+public:
+	virtual ~Job();
+
+	virtual void run(int index) = 0;
+};
+
+/// Runs independent jobs, e.g. on a thread pool. Implement this to let the runtime use the application's threads, for
+/// example via SkeletonBinary::setJobRunner().
+class SP_API JobRunner : public SpineObject {
+public:
+	virtual ~JobRunner();
+
+	/// Calls job.run(index) for every index from 0 to count - 1 and returns once all calls have returned. Calls may run
+	/// concurrently and in any order. The default runs them one after another on the calling thread.
+	virtual void run(Job &job, int count);
+
+	/// Starts calls to job.run(index) for every index from 0 to count - 1 and returns without waiting for them, e.g. by
+	/// queuing them on background threads. Used by AsyncLoader. The default calls run(), so the job is done on return.
+	virtual void start(Job &job, int count);
+
+	/// Returns true once all calls started by start() for the job have returned. Called on the thread that called start(),
+	/// which must then see everything the calls wrote, so implementations must synchronize with the threads that made the
+	/// calls, e.g. with a mutex. The default returns true.
+	virtual bool isDone(Job &job);
+
+	/// Returns once all calls started by start() for the job have returned, with the same guarantees as isDone(). Used by
+	/// AsyncLoader when it is deleted while jobs run. The default calls isDone() until it returns true, so implementations
+	/// that run jobs on other threads should override this to block, e.g. on a condition variable.
+	virtual void wait(Job &job);
+};
+}
+
+#endif /* Spine_JobRunner_h */
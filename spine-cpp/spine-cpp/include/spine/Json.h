@@ -65,6 +65,10 @@ public:
 	/* For analysing failed parses. This returns a pointer to the parse error. You'll probably need to look a few chars back to make sense of it. Defined when Json_create() returns 0. 0 when Json_create() succeeds. */
 	static const char *getError();
 
+	/* Parses the number at value to the nearest float, independent of the locale, and to its integer part, saturated.
+	 * Returns the end of the number, or NULL if value does not start with one. */
+	static const char *parseNumber(const char *value, float &floatValue, int &intValue);
+
 	/* Supply a block of JSON, and this returns a Json object you can interrogate. Call Json_dispose when finished. */
 	explicit Json(const char *value);
 
@@ -0,0 +1,122 @@
+/******************************************************************************
+ * Spine Runtimes License Agreement
+ * Last updated January 1, 2020. Replaces all prior versions.
+ *
+ * Copyright (c) 2013-2020, Esoteric Software LLC
+ *
+ * Integration of the Spine Runtimes into software or otherwise creating
+ * derivative works of the Spine Runtimes is permitted under the terms and
+ * conditions of Section 2 of the Spine Editor License Agreement:
+ * http://esotericsoftware.com/spine-editor-license
+ *
+ * Otherwise, it is permitted to integrate the Spine Runtimes into software
+ * or otherwise create derivative works of the Spine Runtimes (collectively,
+ * "Products"), provided that each user of the Products must obtain their own
+ * Spine Editor license and redistribution of the Products in any form must
+ * include this license and copyright notice.
+ *
+ * THE SPINE RUNTIMES ARE PROVIDED BY ESOTERIC SOFTWARE LLC "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL ESOTERIC SOFTWARE LLC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES,
+ * BUSINESS INTERRUPTION, OR LOSS OF USE, DATA, OR PROFITS) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THE SPINE RUNTIMES, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+#ifndef Spine_JsonReader_h
+#define Spine_JsonReader_h
+
+#include <spine/SpineObject.h>
+
+namespace spine {
+/// A pull parser that reads JSON values in document order without building a Json tree. Each key or array value must be
+/// followed by reading or skipping exactly one value. Strings are unescaped into buffers owned by the reader, so returned
+/// strings and keys are only valid until the next string or key is read. Malformed JSON stops the reader: all further
+/// reads return defaults, nextKey() and nextValue() return false and getError() is set.
+class SP_API JsonReader : public SpineObject {
+public:
+	/// The JSON must be NULL terminated and must outlive the reader.
+	explicit JsonReader(const char *json);
+
+	~JsonReader();
+
+	/// Returns the Json type of the next value, without reading it. Returns -1 at the end of an object or array or after
+	/// an error.
+	int peek();
+
+	/// Enters the object that is the next value. Returns false and skips the value if it is not an object.
+	bool beginObject();
+
+	/// Reads the next key of the current object. Returns false and leaves the object if there are no more keys.
+	bool nextKey();
+
+	const char *getKey();
+
+	/// A case insensitive hash of the last key read, for dispatching keys with a switch.
+	unsigned int getKeyHash();
+
+	/// Returns true if the last key read equals the name, ignoring case like Json::getItem().
+	bool isKey(const char *name);
+
+	/// Enters the array that is the next value. Returns false and skips the value if it is not an array.
+	bool beginArray();
+
+	/// Returns true if the current array has another value. Returns false and leaves the array otherwise.
+	bool nextValue();
+
+	/// Returns the number of values in the array that is the next value, without reading it. Returns 0 if the next value
+	/// is not an array.
+	int peekArraySize();
+
+	/// Returns NULL and skips the value if it is not a string.
+	const char *readString();
+
+	/// Returns 0 and skips the value if it is not a number.
+	float readFloat();
+
+	/// Returns 1 for true, 0 for false and skips the value if it is not a number or boolean.
+	int readInt();
+
+	/// Strings are true if they are "true" and numbers if they are not 0.
+	bool readBoolean();
+
+	void skipValue();
+
+	/// Returns the current position, which can be passed to setPosition() to read the next value again. Whitespace is not
+	/// skipped, so no text after a value that was read completely is touched.
+	const char *getPosition();
+
+	void setPosition(const char *inValue);
+
+	/// Returns the text where parsing failed, or NULL.
+	const char *getError();
+
+	static unsigned int hash(const char *value);
+
+private:
+	const char *_cursor;
+	const char *_error;
+	char *_key;
+	size_t _keyCapacity;
+	unsigned int _keyHash;
+	char *_string;
+	size_t _stringCapacity;
+
+	void skipWhitespace();
+
+	void fail(const char *at);
+
+	/// Unescapes the string at the cursor into the buffer, growing it as needed. Returns false on malformed input.
+	bool parseString(char *&buffer, size_t &capacity);
+
+	bool parseNumber(float &floatValue, int &intValue);
+
+	bool skipLiteral(const char *literal);
+};
+}
+
+#endif /* Spine_JsonReader_h */
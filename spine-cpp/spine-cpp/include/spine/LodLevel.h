@@ -0,0 +1,84 @@
+/******************************************************************************
+ * Spine Runtimes License Agreement
+ * Last updated January 1, 2020. Replaces all prior versions.
+ *
+ * Copyright (c) 2013-2020, Esoteric Software LLC
+ *
+ * Integration of the Spine Runtimes into software or otherwise creating
+ * derivative works of the Spine Runtimes is permitted under the terms and
+ * conditions of Section 2 of the Spine Editor License Agreement:
+ * http://esotericsoftware.com/spine-editor-license
+ *
+ * Otherwise, it is permitted to integrate the Spine Runtimes into software
+ * or otherwise create derivative works of the Spine Runtimes (collectively,
+ * "Products"), provided that each user of the Products must obtain their own
+ * Spine Editor license and redistribution of the Products in any form must
+ * include this license and copyright notice.
+ *
+ * THE SPINE RUNTIMES ARE PROVIDED BY ESOTERIC SOFTWARE LLC "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL ESOTERIC SOFTWARE LLC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES,
+ * BUSINESS INTERRUPTION, OR LOSS OF USE, DATA, OR PROFITS) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THE SPINE RUNTIMES, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+#ifndef Spine_LodLevel_h
+#define Spine_LodLevel_h
+
+#include <spine/dll.h>
+
+#include <stddef.h>
+
+namespace spine {
+/// How much animation work is skipped for a skeleton, eg for one that is distant or small on screen. Set per skeleton
+/// with Skeleton::setLodLevel(), which AnimationState::apply() and Skeleton::updateWorldTransform() follow. The default
+/// level skips nothing.
+struct SP_API LodLevel {
+	LodLevel() : updateInterval(1), skipDeform(false), skipLowImportanceBones(false), constraintThreshold(0) {
+	}
+
+	/// AnimationState::apply() applies the timelines only once every this many calls. The calls in between interpolate
+	/// the bones between the last two applied poses, so the skeleton trails the animation by one interval. Colors are
+	/// interpolated with the bones, while attachments, draw order and deform change when the timelines are applied.
+	int updateInterval;
+
+	/// If true, AnimationState::apply() skips deform timelines and clears the deform of the slots they key, so meshes
+	/// keep their setup shape.
+	bool skipDeform;
+
+	/// If true, AnimationState::apply() skips the timelines of bones whose BoneData::isLowImportance() is true and sets
+	/// those bones to the setup pose. The bones are still updated, so their attachments follow their parent.
+	bool skipLowImportanceBones;
+
+	/// Skeleton::updateWorldTransform() skips constraints whose largest mix is below this.
+	float constraintThreshold;
+};
+
+/// Counts the work skipped for a skeleton because of its LodLevel, until reset.
+struct SP_API LodCounters {
+	LodCounters() : interpolatedApplies(0), skippedTimelines(0), skippedConstraints(0) {
+	}
+
+	void reset() {
+		interpolatedApplies = 0;
+		skippedTimelines = 0;
+		skippedConstraints = 0;
+	}
+
+	/// AnimationState::apply() calls that interpolated instead of applying the timelines.
+	size_t interpolatedApplies;
+
+	/// Timelines not applied because of LodLevel::skipDeform or LodLevel::skipLowImportanceBones.
+	size_t skippedTimelines;
+
+	/// Constraints not applied because of LodLevel::constraintThreshold.
+	size_t skippedConstraints;
+};
+}
+
+#endif /* Spine_LodLevel_h */
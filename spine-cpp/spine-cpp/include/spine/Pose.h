@@ -0,0 +1,116 @@
+/******************************************************************************
+ * Spine Runtimes License Agreement
+ * Last updated January 1, 2020. Replaces all prior versions.
+ *
+ * Copyright (c) 2013-2020, Esoteric Software LLC
+ *
+ * Integration of the Spine Runtimes into software or otherwise creating
+ * derivative works of the Spine Runtimes is permitted under the terms and
+ * conditions of Section 2 of the Spine Editor License Agreement:
+ * http://esotericsoftware.com/spine-editor-license
+ *
+ * Otherwise, it is permitted to integrate the Spine Runtimes into software
+ * or otherwise create derivative works of the Spine Runtimes (collectively,
+ * "Products"), provided that each user of the Products must obtain their own
+ * Spine Editor license and redistribution of the Products in any form must
+ * include this license and copyright notice.
+ *
+ * THE SPINE RUNTIMES ARE PROVIDED BY ESOTERIC SOFTWARE LLC "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL ESOTERIC SOFTWARE LLC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES,
+ * BUSINESS INTERRUPTION, OR LOSS OF USE, DATA, OR PROFITS) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THE SPINE RUNTIMES, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+#ifndef Spine_Pose_h
+#define Spine_Pose_h
+
+#include <spine/Vector.h>
+#include <spine/Color.h>
+#include <spine/SpineObject.h>
+#include <spine/SpineString.h>
+
+namespace spine {
+class SkeletonData;
+
+class Skin;
+
+class Attachment;
+
+/// The local transforms of a skeleton's bones and the attachments and colors of its slots, stored apart from any Skeleton
+/// so animations can be sampled without changing one. See Animation::sample() and Skeleton::applyPose().
+///
+/// Draw order, mesh deform, dark colors and constraint mixes are not part of a pose.
+class SP_API Pose : public SpineObject {
+public:
+	/// The transform values of each bone, in order.
+	static const int X = 0;
+	static const int Y = 1;
+	static const int ROTATION = 2;
+	static const int SCALE_X = 3;
+	static const int SCALE_Y = 4;
+	static const int SHEAR_X = 5;
+	static const int SHEAR_Y = 6;
+	static const int TRANSFORM_ENTRIES = 7;
+
+	/// Creates a pose in the setup pose.
+	/// @param skin The skin used to find attachments, before the default skin. May be NULL.
+	explicit Pose(SkeletonData &skeletonData, Skin *skin = NULL);
+
+	~Pose();
+
+	/// Sets the bones and slots to the setup pose. Does not allocate.
+	void setToSetupPose();
+
+	/// Copies the values of another pose for the same skeleton data.
+	void set(Pose &pose);
+
+	/// Sets this pose between two poses for the same skeleton data, which may include this pose. Rotations take the
+	/// shortest way, colors are interpolated and attachments are taken from the second pose when alpha is 0.5 or more.
+	void mix(Pose &from, Pose &to, float alpha);
+
+	/// Adds the difference between another pose and the setup pose to the bone transforms of this pose, like
+	/// MixBlend_Add. Attachments and colors are not changed.
+	void add(Pose &pose, float alpha);
+
+	SkeletonData &getSkeletonData();
+
+	Skin *getSkin();
+
+	size_t getBoneCount();
+
+	size_t getSlotCount();
+
+	/// The TRANSFORM_ENTRIES values for the bone at the index.
+	float *getBoneTransform(size_t boneIndex);
+
+	/// The bone transforms, TRANSFORM_ENTRIES values per bone.
+	Vector<float> &getTransforms();
+
+	/// May be NULL.
+	Attachment *getAttachment(size_t slotIndex);
+
+	void setAttachment(size_t slotIndex, Attachment *attachment);
+
+	/// Finds an attachment for the slot in the pose's skin, then in the default skin, like Skeleton::getAttachment().
+	/// @return May be NULL.
+	Attachment *findAttachment(size_t slotIndex, const String &attachmentName);
+
+	Color &getColor(size_t slotIndex);
+
+private:
+	SkeletonData &_skeletonData;
+	Skin *_skin;
+	Vector<float> _transforms;
+	Vector<Attachment *> _attachments;
+	Vector<Attachment *> _setupAttachments;
+	Vector<Color> _colors;
+};
+}
+
+#endif /* Spine_Pose_h */
@@ -41,11 +41,15 @@ public:
 
 	const char *getClassName() const;
 
+	/// Compares the addresses of the RTTI instances.
 	bool isExactly(const RTTI &rtti) const;
 
+	/// Checks the ancestor of this class at the depth of the other class, so the cost does not depend on the depth.
 	bool instanceOf(const RTTI &rtti) const;
 
 private:
+	static const int MAX_DEPTH = 8;
+
 	// Prevent copying
 	RTTI(const RTTI &obj);
 
@@ -53,6 +57,18 @@ private:
 
 	const char* _className;
 	const RTTI *_pBaseRTTI;
+
+	// Filled in once all of the bases have been constructed, which may be after this instance during static
+	// initialization. 0 until then.
+	mutable int _depth;
+	mutable const RTTI *_ancestors[MAX_DEPTH];
+	const RTTI *_next;
+
+	static const RTTI *_all;
+
+	void registerInstance();
+
+	void resolve() const;
 };
 }
 
@@ -47,6 +47,8 @@ namespace spine {
 
 		virtual void apply(Skeleton& skeleton, float lastTime, float time, Vector<Event*>* pEvents, float alpha, MixBlend blend, MixDirection direction);
 
+		virtual void sample(Pose& pose, float time);
+
 		virtual int getPropertyId();
 
 		/// Sets the time and value of the specified keyframe.
@@ -55,8 +57,11 @@ namespace spine {
 		int getBoneIndex();
 		void setBoneIndex(int inValue);
 
+		/// Empty if the timeline is quantized.
 		Vector<float>& getFrames();
 
+		virtual size_t quantize(float tolerance, CurveTable& curveTable);
+
 	private:
 		static const int PREV_TIME = -2;
 		static const int PREV_ROTATION = -1;
@@ -64,6 +69,19 @@ namespace spine {
 
 		int _boneIndex;
 		Vector<float> _frames; // time, angle, ...
+
+		template<typename T>
+		void applyFrames(T& frames, Skeleton& skeleton, float time, float alpha, MixBlend blend);
+
+		template<typename T>
+		void sampleFrames(T& frames, Pose& pose, float time);
+
+		/// For AnimationState: sets the rotation of the bone at the time, including its setup rotation.
+		/// @return False if the time is before the first frame.
+		bool getRotation(float time, float setupRotation, float& rotation);
+
+		template<typename T>
+		bool getRotation(T& frames, float time, float setupRotation, float& rotation);
 	};
 }
 
@@ -44,7 +44,13 @@ namespace spine {
 
 		virtual void apply(Skeleton& skeleton, float lastTime, float time, Vector<Event*>* pEvents, float alpha, MixBlend blend, MixDirection direction);
 
+		virtual void sample(Pose& pose, float time);
+
 		virtual int getPropertyId();
+
+	private:
+		template<typename T>
+		void applyFrames(T& frames, Skeleton& skeleton, float time, float alpha, MixBlend blend, MixDirection direction);
 	};
 }
 
@@ -35,6 +35,7 @@
 #include <spine/SpineObject.h>
 #include <spine/SpineString.h>
 #include <spine/Color.h>
+#include <spine/LodLevel.h>
 
 namespace spine {
 class SkeletonData;
@@ -55,6 +56,10 @@ class Skin;
 
 class Attachment;
 
+class BoneTransforms;
+
+class Pose;
+
 class SP_API Skeleton : public SpineObject {
 	friend class AnimationState;
 
@@ -90,6 +95,8 @@ class SP_API Skeleton : public SpineObject {
 
 	friend class TwoColorTimeline;
 
+	friend class BoneTransforms;
+
 public:
 	explicit Skeleton(SkeletonData *skeletonData);
 
@@ -112,6 +119,13 @@ public:
 
 	void setSlotsToSetupPose();
 
+	/// Sets the bones' local transforms and the slots' attachments and colors from a pose for the skeleton's data. Draw
+	/// order, dark colors and constraints are not changed. Deform is cleared only for slots whose attachment changes.
+	void applyPose(Pose &pose);
+
+	/// Sets the pose from the bones' local transforms and the slots' attachments and colors.
+	void getPose(Pose &pose);
+
 	/// @return May be NULL.
 	Bone *findBone(const String &boneName);
 
@@ -182,6 +196,23 @@ public:
 
 	Vector<TransformConstraint *> &getTransformConstraints();
 
+	/// If true, updateWorldTransform() computes bone world transforms using BoneTransforms, which stores them in contiguous
+	/// arrays. Defaults to false.
+	bool isBoneTransformsEnabled();
+
+	void setBoneTransformsEnabled(bool inValue);
+
+	/// @return May be NULL if bone transforms are not enabled.
+	BoneTransforms *getBoneTransforms();
+
+	/// The work skipped when animating this skeleton. Can be changed at any time, eg each frame based on the skeleton's
+	/// distance or size on screen.
+	const LodLevel &getLodLevel();
+
+	void setLodLevel(const LodLevel &inValue);
+
+	LodCounters &getLodCounters();
+
 	Skin *getSkin();
 
 	Color &getColor();
@@ -218,6 +249,12 @@ private:
 	Vector<PathConstraint *> _pathConstraints;
 	Vector<Updatable *> _updateCache;
 	Vector<Bone *> _updateCacheReset;
+	BoneTransforms *_boneTransforms;
+	LodLevel _lodLevel;
+	LodCounters _lodCounters;
+	Pose *_lodFrom, *_lodTo, *_lodPose; // For LodLevel::updateInterval, the last two applied poses and the interpolated one.
+	int _lodStep;
+	bool _lodPosed;
 	Skin *_skin;
 	Color _color;
 	float _time;
@@ -237,6 +274,9 @@ private:
 	void sortBone(Bone *bone);
 
 	static void sortReset(Vector<Bone *> &bones);
+
+	/// Returns true if the constraint's mixes are below LodLevel::constraintThreshold, counting it as skipped.
+	bool isLodSkipped(Updatable &updatable);
 };
 }
 
@@ -46,6 +46,8 @@ namespace spine {
 	class VertexAttachment;
 	class Animation;
 	class CurveTimeline;
+	class Timeline;
+	class JobRunner;
 
 	class SP_API SkeletonBinary : public SpineObject {
 	public:
@@ -72,15 +74,58 @@ namespace spine {
 
 		~SkeletonBinary();
 
+		/// The binary is not referenced once this returns, so the caller may free it right away.
 		SkeletonData* readSkeletonData(const unsigned char* binary, int length);
 
 		SkeletonData* readSkeletonDataFile(const String& path);
 
 		void setScale(float scale) { _scale = scale; }
 
+		/// If true, the skeleton data is allocated from its own Arena, which is released in one shot when the skeleton
+		/// data is deleted. Each string in the binary is then copied into the arena once and shared by all names that
+		/// refer to it, so loading makes no per-string allocations. Default is false.
+		void setArenaEnabled(bool inValue) { _arenaEnabled = inValue; }
+
+		bool isArenaEnabled() { return _arenaEnabled; }
+
+		/// If true, animations are only scanned for their duration when the skeleton data is read. Each animation's
+		/// timelines are decoded the first time it is applied or its timelines are accessed, and can be released with
+		/// Animation::unload(). The skeleton data keeps a copy of the binary's animation section. Default is false.
+		void setLazyAnimationsEnabled(bool inValue) { _lazyAnimationsEnabled = inValue; }
+
+		bool isLazyAnimationsEnabled() { return _lazyAnimationsEnabled; }
+
+		/// If set, skins and animations are decoded as jobs on the runner, which may use multiple threads. The attachment
+		/// loader must then be safe to call from multiple threads. The result is the same as decoding serially, except that
+		/// skins and animations are not allocated from the arena. Default is NULL.
+		void setJobRunner(JobRunner* inValue) { _jobRunner = inValue; }
+
+		JobRunner* getJobRunner() { return _jobRunner; }
+
+		/// If true, bezier curves are evaluated from values at evenly spaced times instead of by searching their samples. See
+		/// Animation::buildCurveLookup(). Default is false.
+		void setCurveLookupEnabled(bool inValue) { _curveLookupEnabled = inValue; }
+
+		bool isCurveLookupEnabled() { return _curveLookupEnabled; }
+
+		/// If greater than 0, the keyframes of bone timelines are stored as 16-bit values when no value or time would be off by
+		/// more than this tolerance, and identical bezier curves in an animation are stored once. See Animation::quantize().
+		/// This saves little when the arena is enabled, since memory allocated from the arena is only freed with the skeleton
+		/// data. Default is 0.
+		void setQuantizeTolerance(float inValue) { _quantizeTolerance = inValue; }
+
+		float getQuantizeTolerance() { return _quantizeTolerance; }
+
+		/// The number of bytes saved by quantizing the animations of the last skeleton data read. Animations loaded on demand
+		/// are quantized when they are loaded, and are not included.
+		size_t getQuantizedBytesSaved() { return _quantizedBytesSaved; }
+
 		String& getError() { return _error; }
 
 	private:
+		friend class BinaryTimelineLoader;
+		friend class BinarySectionJob;
+
 		struct DataInput : public SpineObject {
 			const unsigned char* cursor;
 			const unsigned char* end;
@@ -91,6 +136,15 @@ namespace spine {
 		String _error;
 		float _scale;
 		const bool _ownsLoader;
+		bool _arenaEnabled;
+		bool _lazyAnimationsEnabled;
+		JobRunner* _jobRunner;
+		bool _curveLookupEnabled;
+		float _quantizeTolerance;
+		size_t _quantizedBytesSaved;
+
+		/// For decoding timelines only.
+		explicit SkeletonBinary(float scale);
 
 		void setError(const char* value1, const char* value2);
 
@@ -124,7 +178,29 @@ namespace spine {
 
 		Animation* readAnimation(const String& name, DataInput* input, SkeletonData *skeletonData);
 
+		bool readTimelines(DataInput* input, SkeletonData* skeletonData, Vector<Timeline*>& timelines, float& duration);
+
+		bool readLazyAnimations(DataInput* input, SkeletonData* skeletonData);
+
+		/// Moves past an animation's timelines without decoding them, computing only the duration.
+		bool skipTimelines(DataInput* input, SkeletonData* skeletonData, float& duration);
+
+		float skipCurveFrames(DataInput* input, int frameCount, int valueBytes);
+
+		bool readSkinsParallel(DataInput* input, SkeletonData* skeletonData, bool nonessential);
+
+		bool readAnimationsParallel(DataInput* input, SkeletonData* skeletonData);
+
+		bool skipSkin(DataInput* input, bool defaultSkin, bool nonessential);
+
+		bool skipAttachment(DataInput* input, bool nonessential);
+
+		void skipVertices(DataInput* input, int vertexCount);
+
 		void readCurve(DataInput* input, int frameIndex, CurveTimeline* timeline);
+
+		/// Builds the name indices, then the curve lookups and quantizes the animations, if enabled.
+		void prepareSkeletonData(SkeletonData* skeletonData);
 	};
 }
 
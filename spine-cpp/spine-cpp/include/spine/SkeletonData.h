@@ -30,6 +30,8 @@
 #ifndef Spine_SkeletonData_h
 #define Spine_SkeletonData_h
 
+#include <spine/Arena.h>
+#include <spine/ContainerUtil.h>
 #include <spine/Vector.h>
 #include <spine/SpineString.h>
 
@@ -50,6 +52,8 @@ class TransformConstraintData;
 
 class PathConstraintData;
 
+class TimelineLoader;
+
 /// Stores the setup pose and all of the stateless data for a skeleton.
 class SP_API SkeletonData : public SpineObject {
 	friend class SkeletonBinary;
@@ -63,8 +67,7 @@ public:
 
 	~SkeletonData();
 
-	/// Finds a bone by comparing each bone's name.
-	/// It is more efficient to cache the results of this method than to call it multiple times.
+	/// Finds a bone by name using a hashed index of the bone names.
 	/// @return May be NULL.
 	BoneData *findBone(const String &boneName);
 
@@ -89,15 +92,25 @@ public:
 	/// @return May be NULL.
 	IkConstraintData *findIkConstraint(const String &constraintName);
 
+	/// @return -1 if the IK constraint was not found.
+	int findIkConstraintIndex(const String &constraintName);
+
 	/// @return May be NULL.
 	TransformConstraintData *findTransformConstraint(const String &constraintName);
 
+	/// @return -1 if the transform constraint was not found.
+	int findTransformConstraintIndex(const String &constraintName);
+
 	/// @return May be NULL.
 	PathConstraintData *findPathConstraint(const String &constraintName);
 
 	/// @return -1 if the path constraint was not found.
 	int findPathConstraintIndex(const String &pathConstraintName);
 
+	/// Rebuilds the hashed indices used by the find methods. The loaders call this once the skeleton data is complete, so
+	/// the find methods only read shared skeleton data. Call it again after adding, removing or renaming items.
+	void updateNameIndices();
+
 	const String &getName();
 
 	void setName(const String &inValue);
@@ -165,7 +178,12 @@ public:
 
 	void setFps(float inValue);
 
+	/// The arena the loader allocated this skeleton data from, if it was loaded with an arena enabled. The arena's memory
+	/// is released when the skeleton data is deleted.
+	Arena &getArena();
+
 private:
+	Arena _arena; // Declared first so it is destroyed after the members that may use its memory.
 	String _name;
 	Vector<BoneData *> _bones; // Ordered parents first
 	Vector<SlotData *> _slots; // Setup pose draw order.
@@ -180,6 +198,15 @@ private:
 	String _version;
 	String _hash;
 	Vector<char*> _strings;
+	TimelineLoader *_timelineLoader; // Set when animations are loaded on demand.
+	NameIndex<BoneData> _boneIndex;
+	NameIndex<SlotData> _slotIndex;
+	NameIndex<Skin> _skinIndex;
+	NameIndex<EventData> _eventIndex;
+	NameIndex<Animation> _animationIndex;
+	NameIndex<IkConstraintData> _ikConstraintIndex;
+	NameIndex<TransformConstraintData> _transformConstraintIndex;
+	NameIndex<PathConstraintData> _pathConstraintIndex;
 
 	// Nonessential.
 	float _fps;
@@ -0,0 +1,152 @@
+/******************************************************************************
+ * Spine Runtimes License Agreement
+ * Last updated January 1, 2020. Replaces all prior versions.
+ *
+ * Copyright (c) 2013-2020, Esoteric Software LLC
+ *
+ * Integration of the Spine Runtimes into software or otherwise creating
+ * derivative works of the Spine Runtimes is permitted under the terms and
+ * conditions of Section 2 of the Spine Editor License Agreement:
+ * http://esotericsoftware.com/spine-editor-license
+ *
+ * Otherwise, it is permitted to integrate the Spine Runtimes into software
+ * or otherwise create derivative works of the Spine Runtimes (collectively,
+ * "Products"), provided that each user of the Products must obtain their own
+ * Spine Editor license and redistribution of the Products in any form must
+ * include this license and copyright notice.
+ *
+ * THE SPINE RUNTIMES ARE PROVIDED BY ESOTERIC SOFTWARE LLC "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL ESOTERIC SOFTWARE LLC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES,
+ * BUSINESS INTERRUPTION, OR LOSS OF USE, DATA, OR PROFITS) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THE SPINE RUNTIMES, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+#ifndef Spine_SkeletonDataCache_h
+#define Spine_SkeletonDataCache_h
+
+#include <spine/HashMap.h>
+#include <spine/SpineObject.h>
+#include <spine/SpineString.h>
+#include <spine/Vector.h>
+
+namespace spine {
+	class Atlas;
+	class SkeletonData;
+	class TextureLoader;
+
+	/// Shares atlases and skeleton data between the systems that load them, so each file is parsed and resident once.
+	/// Atlases are keyed on their path and texture loader, skeleton data on its path, scale and atlas. Each acquire must be
+	/// balanced by a release.
+	///
+	/// Entries that are no longer referenced stay cached until the estimated memory of all entries exceeds the memory
+	/// budget, then the least recently used of them are deleted. The memory of an atlas is estimated from its regions and
+	/// page sizes, assuming 4 bytes per texel, and that of skeleton data from the size of its file.
+	///
+	/// The cache is not thread safe. A single cache is normally shared by the whole process.
+	class SP_API SkeletonDataCache : public SpineObject {
+	public:
+		/// @param memoryBudget The estimated memory in bytes that unreferenced entries are kept within. 0 deletes them as
+		/// soon as they are released.
+		explicit SkeletonDataCache(size_t memoryBudget);
+
+		/// Deletes all entries, including those still referenced.
+		~SkeletonDataCache();
+
+		/// Returns the cached atlas for the path and texture loader, or loads it.
+		/// @return NULL if the atlas could not be loaded, see getError().
+		Atlas* acquireAtlas(const String& path, TextureLoader* textureLoader);
+
+		/// Returns the cached skeleton data for the path, atlas and scale, or loads it from a JSON file if the path ends
+		/// with .json, otherwise from a binary file. If the atlas was acquired from this cache, the skeleton data keeps it
+		/// referenced. Otherwise the atlas must outlive the entry, see evictUnused().
+		/// @return NULL if the skeleton data could not be loaded, see getError().
+		SkeletonData* acquireSkeletonData(const String& path, Atlas* atlas, float scale = 1);
+
+		void release(Atlas* atlas);
+
+		void release(SkeletonData* skeletonData);
+
+		/// Deletes all entries that are not referenced, regardless of the memory budget.
+		void evictUnused();
+
+		void setMemoryBudget(size_t inValue);
+
+		size_t getMemoryBudget();
+
+		/// The estimated memory of all entries, referenced or not.
+		size_t getMemoryUsed();
+
+		/// The number of acquires that returned a cached entry.
+		int getHits();
+
+		/// The number of acquires that loaded a file.
+		int getMisses();
+
+		/// The number of unreferenced entries deleted to stay within the memory budget or by evictUnused().
+		int getEvictions();
+
+		/// Empty unless the last acquire failed.
+		const String& getError();
+
+	private:
+		class Key {
+		public:
+			Key(const String& inPath, float inScale, void* inOwner) : path(inPath), scale(inScale), owner(inOwner) {
+			}
+
+			bool operator==(const Key& other) const {
+				return scale == other.scale && owner == other.owner && path == other.path;
+			}
+
+			String path;
+			float scale;
+			void* owner; // The texture loader of an atlas, or the atlas of skeleton data.
+		};
+
+		class KeyHash {
+		public:
+			size_t operator()(const Key& key) const;
+		};
+
+		class Entry : public SpineObject {
+		public:
+			explicit Entry(const Key& inKey) : key(inKey), atlas(NULL), skeletonData(NULL), atlasEntry(NULL), references(1), memory(0),
+				lastUse(0) {
+			}
+
+			Key key;
+			Atlas* atlas;
+			SkeletonData* skeletonData;
+			Entry* atlasEntry; // Set if the skeleton data's atlas is cached.
+			int references;
+			size_t memory;
+			unsigned int lastUse;
+		};
+
+		HashMap<Key, Entry*, KeyHash> _entries;
+		HashMap<void*, Entry*> _entriesByObject;
+		size_t _memoryBudget;
+		size_t _memoryUsed;
+		unsigned int _useCount;
+		int _hits, _misses, _evictions;
+		String _error;
+
+		Entry* acquire(const Key& key);
+
+		void add(Entry* entry, void* object);
+
+		void release(void* object);
+
+		void trim();
+
+		void evict(Entry* entry);
+	};
+}
+
+#endif /* Spine_SkeletonDataCache_h */
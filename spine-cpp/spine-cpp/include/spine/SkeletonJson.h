@@ -41,7 +41,17 @@ class VertexAttachment;
 
 class Animation;
 
-class Json;
+class JsonReader;
+
+class JsonMap;
+
+class BoneData;
+
+class SlotData;
+
+class Skin;
+
+class Attachment;
 
 class SkeletonData;
 
@@ -63,10 +73,37 @@ public:
 
 	SkeletonData *readSkeletonDataFile(const String &path);
 
+	/// @param json The JSON text, which must be NULL terminated.
 	SkeletonData *readSkeletonData(const char *json);
 
+	/// Reads JSON text that is not NULL terminated, e.g. a mapped file, from a terminated copy.
+	SkeletonData *readSkeletonData(const char *json, int length);
+
 	void setScale(float scale) { _scale = scale; }
 
+	/// If true, the skeleton data is allocated from its own Arena, which is released in one shot when the skeleton data
+	/// is deleted. Default is false.
+	void setArenaEnabled(bool inValue) { _arenaEnabled = inValue; }
+
+	bool isArenaEnabled() { return _arenaEnabled; }
+
+	/// If true, bezier curves are evaluated from values at evenly spaced times instead of by searching their samples. See
+	/// Animation::buildCurveLookup(). Default is false.
+	void setCurveLookupEnabled(bool inValue) { _curveLookupEnabled = inValue; }
+
+	bool isCurveLookupEnabled() { return _curveLookupEnabled; }
+
+	/// If greater than 0, the keyframes of bone timelines are stored as 16-bit values when no value or time would be off by
+	/// more than this tolerance, and identical bezier curves in an animation are stored once. See Animation::quantize().
+	/// This saves little when the arena is enabled, since memory allocated from the arena is only freed with the skeleton
+	/// data. Default is 0.
+	void setQuantizeTolerance(float inValue) { _quantizeTolerance = inValue; }
+
+	float getQuantizeTolerance() { return _quantizeTolerance; }
+
+	/// The number of bytes saved by quantizing the animations of the last skeleton data read.
+	size_t getQuantizedBytesSaved() { return _quantizedBytesSaved; }
+
 	String &getError() { return _error; }
 
 private:
@@ -74,17 +111,37 @@ private:
 	Vector<LinkedMesh *> _linkedMeshes;
 	float _scale;
 	const bool _ownsLoader;
+	bool _arenaEnabled;
+	bool _curveLookupEnabled;
+	float _quantizeTolerance;
+	size_t _quantizedBytesSaved;
 	String _error;
 
 	static float toColor(const char *value, size_t index);
 
-	static void readCurve(Json *frame, CurveTimeline *timeline, size_t frameIndex);
+	bool readBones(JsonReader &reader, SkeletonData *skeletonData);
+
+	bool readSlots(JsonReader &reader, SkeletonData *skeletonData);
+
+	bool readConstraintBones(JsonReader &reader, JsonMap &constraintMap, Vector<BoneData *> &bones,
+		SkeletonData *skeletonData, const char *error);
+
+	bool readIkConstraints(JsonReader &reader, SkeletonData *skeletonData);
+
+	bool readTransformConstraints(JsonReader &reader, SkeletonData *skeletonData);
+
+	bool readPathConstraints(JsonReader &reader, SkeletonData *skeletonData);
+
+	bool readSkins(JsonReader &reader, SkeletonData *skeletonData);
+
+	Attachment *readAttachment(JsonReader &reader, Skin *skin, SlotData *slot, const String &skinAttachmentName,
+		SkeletonData *skeletonData);
 
-	Animation *readAnimation(Json *root, SkeletonData *skeletonData);
+	Animation *readAnimation(JsonReader &reader, const String &name, SkeletonData *skeletonData);
 
-	void readVertices(Json *attachmentMap, VertexAttachment *attachment, size_t verticesLength);
+	void readVertices(JsonReader &reader, JsonMap &attachmentMap, VertexAttachment *attachment, size_t verticesLength);
 
-	void setError(Json *root, const String &value1, const String &value2);
+	void setError(const String &value1, const String &value2);
 };
 }
 
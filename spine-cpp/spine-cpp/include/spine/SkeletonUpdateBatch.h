@@ -0,0 +1,106 @@
+/******************************************************************************
+ * Spine Runtimes License Agreement
+ * Last updated January 1, 2020. Replaces all prior versions.
+ *
+ * Copyright (c) 2013-2020, Esoteric Software LLC
+ *
+ * Integration of the Spine Runtimes into software or otherwise creating
+ * derivative works of the Spine Runtimes is permitted under the terms and
+ * conditions of Section 2 of the Spine Editor License Agreement:
+ * http://esotericsoftware.com/spine-editor-license
+ *
+ * Otherwise, it is permitted to integrate the Spine Runtimes into software
+ * or otherwise create derivative works of the Spine Runtimes (collectively,
+ * "Products"), provided that each user of the Products must obtain their own
+ * Spine Editor license and redistribution of the Products in any form must
+ * include this license and copyright notice.
+ *
+ * THE SPINE RUNTIMES ARE PROVIDED BY ESOTERIC SOFTWARE LLC "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL ESOTERIC SOFTWARE LLC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES,
+ * BUSINESS INTERRUPTION, OR LOSS OF USE, DATA, OR PROFITS) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THE SPINE RUNTIMES, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+#ifndef Spine_SkeletonUpdateBatch_h
+#define Spine_SkeletonUpdateBatch_h
+
+#include <spine/Vector.h>
+#include <spine/SpineObject.h>
+
+namespace spine {
+class AnimationState;
+
+class Skeleton;
+
+/// Updates many independent skeletons and animation states per frame, optionally spread across threads. For each item,
+/// AnimationState::update(), AnimationState::apply() and Skeleton::updateWorldTransform() are called.
+///
+/// Items must not share skeletons or animation states. They may share SkeletonData and AnimationStateData, which are only
+/// read during the update. The SpineExtension must be safe to call from multiple threads, which DefaultSpineExtension
+/// is and DebugExtension is not.
+///
+/// A frame is begin() on one thread, then run() on any number of threads, then end() on one thread once every run()
+/// has returned. The threads come from the caller's own job system. Each run() claims chunks of items from a shared
+/// counter until none are left, so threads that finish early take over the remaining work.
+///
+/// Events are queued per animation state while running and raised by end() on the calling thread, in item order, so
+/// listeners see the same sequence as when the items are updated one after another. Animations set by a listener take
+/// effect on the next frame.
+class SP_API SkeletonUpdateBatch : public SpineObject {
+public:
+	/// @param chunkSize The number of items a thread claims at once.
+	explicit SkeletonUpdateBatch(size_t chunkSize = 16);
+
+	~SkeletonUpdateBatch();
+
+	/// @param state May be NULL to only update the skeleton's world transform.
+	void add(AnimationState *state, Skeleton *skeleton, float delta);
+
+	void clear();
+
+	size_t size();
+
+	void setDelta(size_t index, float delta);
+
+	/// Prepares the items for a frame and loads animations that are loaded on demand and may be applied. Must not be
+	/// called while running.
+	void begin();
+
+	/// Updates items until all have been claimed. May be called from any number of threads between begin() and end().
+	void run();
+
+	/// Updates the items from start (inclusive) to end (exclusive), for job systems that partition the work themselves.
+	/// Ranges must not overlap and must not be mixed with run() in the same frame.
+	void runRange(size_t start, size_t end);
+
+	/// Raises the queued events. Must be called after every run() has returned.
+	void end();
+
+	/// Calls begin(), run() and end() on the calling thread.
+	void update();
+
+	size_t getChunkSize();
+
+	void setChunkSize(size_t inValue);
+
+private:
+	struct Item {
+		AnimationState *state;
+		Skeleton *skeleton;
+		float delta;
+	};
+
+	Vector<Item> _items;
+	size_t _chunkSize;
+	volatile long _next;
+	bool _running;
+};
+}
+
+#endif /* Spine_SkeletonUpdateBatch_h */
@@ -31,6 +31,7 @@
 #define Spine_Skin_h
 
 #include <spine/Vector.h>
+#include <spine/HashMap.h>
 #include <spine/SpineString.h>
 
 namespace spine {
@@ -108,9 +109,11 @@ public:
 
 	private:
 
-		int findInBucket(Vector <Entry> &, const String &attachmentName);
+		/// @return -1 if the slot has no attachment with the name.
+		int findInBucket(size_t slotIndex, const String &attachmentName);
 
 		Vector <Vector<Entry> > _buckets;
+		Vector <HashMap<String, int> > _indices; // Per slot, maps attachment names to indices in the slot's bucket.
 	};
 
 	explicit Skin(const String &name);
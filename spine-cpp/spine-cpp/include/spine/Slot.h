@@ -123,6 +123,7 @@ private:
 	int _attachmentState;
 	float _attachmentTime;
 	Vector<float> _deform;
+	Vector<float> _boneMatrices; // Scratch for VertexAttachment::computeWorldVertices.
 };
 }
 
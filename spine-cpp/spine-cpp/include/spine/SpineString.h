@@ -32,6 +32,7 @@
 
 #include <spine/SpineObject.h>
 #include <spine/Extension.h>
+#include <spine/Arena.h>
 
 #include <string.h>
 #include <stdio.h>
@@ -53,7 +54,7 @@ public:
 			_buffer = NULL;
 		} else {
 			_length = strlen(chars);
-			if (!own) {
+			if (!own && !isShared(chars)) {
 				_buffer = SpineExtension::calloc<char>(_length + 1, __FILE__, __LINE__);
 				memcpy((void *) _buffer, chars, _length + 1);
 			} else {
@@ -66,6 +67,9 @@ public:
 		if (!other._buffer) {
 			_length = 0;
 			_buffer = NULL;
+		} else if (isShared(other._buffer)) {
+			_length = other._length;
+			_buffer = other._buffer;
 		} else {
 			_length = other._length;
 			_buffer = SpineExtension::calloc<char>(other._length + 1, __FILE__, __LINE__);
@@ -124,6 +128,9 @@ public:
 		if (!other._buffer) {
 			_length = 0;
 			_buffer = NULL;
+		} else if (isShared(other._buffer)) {
+			_length = other._length;
+			_buffer = other._buffer;
 		} else {
 			_length = other._length;
 			_buffer = SpineExtension::calloc<char>(other._length + 1, __FILE__, __LINE__);
@@ -140,6 +147,9 @@ public:
 		if (!chars) {
 			_length = 0;
 			_buffer = NULL;
+		} else if (isShared(chars)) {
+			_length = strlen(chars);
+			_buffer = (char *) chars;
 		} else {
 			_length = strlen(chars);
 			_buffer = SpineExtension::calloc<char>(_length + 1, __FILE__, __LINE__);
@@ -153,7 +163,7 @@ public:
 		size_t thisLen = _length;
 		_length = _length + len;
 		bool same = chars == _buffer;
-		_buffer = SpineExtension::realloc(_buffer, _length + 1, __FILE__, __LINE__);
+		_buffer = grow(_buffer, thisLen, _length + 1);
 		memcpy((void *) (_buffer + thisLen), (void *) (same ? _buffer : chars), len + 1);
 		return *this;
 	}
@@ -163,7 +173,7 @@ public:
 		size_t thisLen = _length;
 		_length = _length + len;
 		bool same = other._buffer == _buffer;
-		_buffer = SpineExtension::realloc(_buffer, _length + 1, __FILE__, __LINE__);
+		_buffer = grow(_buffer, thisLen, _length + 1);
 		memcpy((void *) (_buffer + thisLen), (void *) (same ? _buffer : other._buffer), len + 1);
 		return *this;
 	}
@@ -205,6 +215,25 @@ public:
 private:
 	mutable size_t _length;
 	mutable char *_buffer;
+
+	/// Characters allocated by the current arena are shared instead of copied, since the copy would be allocated by the
+	/// same arena and live exactly as long. This makes loading with an arena free of string copies.
+	static bool isShared(const char *chars) {
+		Arena *arena = Arena::getCurrent();
+		return arena && arena->owns(chars);
+	}
+
+	/// Arena characters may be shared, so they must not be grown in place. Only the current arena grows its allocations
+	/// in place, see Arena::realloc(), so only its characters are copied here.
+	static char *grow(char *buffer, size_t length, size_t size) {
+		Arena *arena = Arena::getCurrent();
+		if (buffer && arena && arena->owns(buffer)) {
+			char *result = SpineExtension::alloc<char>(size, __FILE__, __LINE__);
+			memcpy(result, buffer, length + 1);
+			return result;
+		}
+		return SpineExtension::realloc(buffer, size, __FILE__, __LINE__);
+	}
 };
 }
 
@@ -41,6 +41,8 @@ class Skeleton;
 
 class Event;
 
+class Pose;
+
 class SP_API Timeline : public SpineObject {
 RTTI_DECL
 
@@ -63,6 +65,11 @@ public:
 	apply(Skeleton &skeleton, float lastTime, float time, Vector<Event *> *pEvents, float alpha, MixBlend blend,
 		MixDirection direction) = 0;
 
+	/// Sets the pose's value(s) for the specified time, as apply() would with an alpha of 1, MixBlend_Setup and
+	/// MixDirection_In for a skeleton in the setup pose. Does not change the timeline, so it can be called from multiple
+	/// threads. Timelines for values that are not part of a Pose do nothing.
+	virtual void sample(Pose &pose, float time);
+
 	virtual int getPropertyId() = 0;
 };
 }
@@ -52,11 +52,18 @@ namespace spine {
 
 		virtual void apply(Skeleton& skeleton, float lastTime, float time, Vector<Event*>* pEvents, float alpha, MixBlend blend, MixDirection direction);
 
+		virtual void sample(Pose& pose, float time);
+
 		virtual int getPropertyId();
 
 		/// Sets the time and value of the specified keyframe.
 		void setFrame(int frameIndex, float time, float x, float y);
 
+		int getBoneIndex();
+		void setBoneIndex(int inValue);
+
+		virtual size_t quantize(float tolerance, CurveTable& curveTable);
+
 	protected:
 		static const int PREV_TIME;
 		static const int PREV_X;
@@ -66,6 +73,17 @@ namespace spine {
 
 		Vector<float> _frames;
 		int _boneIndex;
+
+		/// For sample(): sets the keyed values at the time, not including the bone's setup values.
+		/// @return False if the time is before the first frame.
+		bool getValues(float time, float& x, float& y);
+
+	private:
+		template<typename T>
+		void applyFrames(T& frames, Skeleton& skeleton, float time, float alpha, MixBlend blend);
+
+		template<typename T>
+		bool getValues(T& frames, float time, float& x, float& y);
 	};
 }
 
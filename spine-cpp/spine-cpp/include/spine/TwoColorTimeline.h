@@ -33,6 +33,7 @@
 #include <spine/CurveTimeline.h>
 
 namespace spine {
+	class Color;
 
 	class SP_API TwoColorTimeline : public CurveTimeline {
 		friend class SkeletonBinary;
@@ -47,6 +48,8 @@ namespace spine {
 
 		virtual void apply(Skeleton& skeleton, float lastTime, float time, Vector<Event*>* pEvents, float alpha, MixBlend blend, MixDirection direction);
 
+		virtual void sample(Pose& pose, float time);
+
 		virtual int getPropertyId();
 
 		/// Sets the time and value of the specified keyframe.
@@ -74,6 +77,9 @@ namespace spine {
 
 		Vector<float> _frames; // time, r, g, b, a, r2, g2, b2, ...
 		int _slotIndex;
+
+		/// Sets the colors at the time, which must not be before the first frame.
+		void getValues(float time, Color& light, Color& dark);
 	};
 }
 
@@ -64,6 +64,14 @@ public:
 		_size = 0;
 	}
 
+	/// Clears the vector and frees its buffer.
+	inline void clearAndDeallocate() {
+		clear();
+		deallocate(_buffer);
+		_buffer = NULL;
+		_capacity = 0;
+	}
+
 	inline size_t getCapacity() const {
 		return _capacity;
 	}
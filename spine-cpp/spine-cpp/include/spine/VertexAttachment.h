@@ -77,6 +77,13 @@ namespace spine {
 
 		void copyTo(VertexAttachment* other);
 
+		/// If true and the runtime was compiled with SSE2 or NEON support, weighted vertices are transformed 4 at a time
+		/// using SIMD instructions. The results are identical to the scalar path. Defaults to true.
+		static void setSimdEnabled(bool inValue);
+
+		/// @return True if SIMD is enabled and supported by this build.
+		static bool isSimdEnabled();
+
 	protected:
 		Vector<size_t> _bones;
 		Vector<float> _vertices;
@@ -84,6 +91,8 @@ namespace spine {
 		VertexAttachment* _deformAttachment;
 
 	private:
+		static bool _simdEnabled;
+
 		const int _id;
 
 		static int getNextID();
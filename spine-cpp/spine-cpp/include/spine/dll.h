@@ -48,4 +48,42 @@
 #define SP_API
 #endif
 
+#if defined(_MSC_VER)
+#define SP_THREAD_LOCAL __declspec(thread)
+#elif defined(__GNUC__) || defined(__clang__)
+#define SP_THREAD_LOCAL __thread
+#else
+#define SP_THREAD_LOCAL
+#endif
+
+/* Adds value to the long pointed to, returning the previous value. Atomic where the compiler supports it. */
+#if defined(_MSC_VER)
+#include <intrin.h>
+#define SP_ATOMIC_ADD(pointer, value) _InterlockedExchangeAdd((volatile long *) (pointer), (long) (value))
+#elif defined(__GNUC__) || defined(__clang__)
+#define SP_ATOMIC_ADD(pointer, value) __sync_fetch_and_add((pointer), (value))
+#else
+#define SP_ATOMIC_ADD(pointer, value) ((*(pointer) += (value)) - (value))
+#endif
+
+/* Sets the long pointed to to value if it equals expected, returning the previous value. Atomic where the compiler
+ * supports it. */
+#if defined(_MSC_VER)
+#define SP_ATOMIC_CAS(pointer, expected, value) \
+	_InterlockedCompareExchange((volatile long *) (pointer), (long) (value), (long) (expected))
+#elif defined(__GNUC__) || defined(__clang__)
+#define SP_ATOMIC_CAS(pointer, expected, value) __sync_val_compare_and_swap((pointer), (expected), (value))
+#else
+#define SP_ATOMIC_CAS(pointer, expected, value) (*(pointer) == (expected) ? (*(pointer) = (value), (expected)) : *(pointer))
+#endif
+
+/* Orders the memory accesses before it with those after it, for data read without a lock. */
+#if defined(_MSC_VER)
+#define SP_MEMORY_BARRIER() do { long barrier = 0; _InterlockedExchange(&barrier, 0); } while (0)
+#elif defined(__GNUC__) || defined(__clang__)
+#define SP_MEMORY_BARRIER() __sync_synchronize()
+#else
+#define SP_MEMORY_BARRIER()
+#endif
+
 #endif /* SPINE_SHAREDLIB_H */
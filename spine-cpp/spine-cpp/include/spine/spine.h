@@ -33,15 +33,19 @@
 #include <spine/Animation.h>
 #include <spine/AnimationState.h>
 #include <spine/AnimationStateData.h>
+#include <spine/Arena.h>
+#include <spine/AsyncLoader.h>
 #include <spine/Atlas.h>
 #include <spine/AtlasAttachmentLoader.h>
 #include <spine/Attachment.h>
 #include <spine/AttachmentLoader.h>
 #include <spine/AttachmentTimeline.h>
 #include <spine/AttachmentType.h>
+#include <spine/BakedAnimation.h>
 #include <spine/BlendMode.h>
 #include <spine/Bone.h>
 #include <spine/BoneData.h>
+#include <spine/BoneTransforms.h>
 #include <spine/BoundingBoxAttachment.h>
 #include <spine/ClippingAttachment.h>
 #include <spine/Color.h>
@@ -60,8 +64,11 @@
 #include <spine/IkConstraint.h>
 #include <spine/IkConstraintData.h>
 #include <spine/IkConstraintTimeline.h>
+#include <spine/JobRunner.h>
 #include <spine/Json.h>
+#include <spine/JsonReader.h>
 #include <spine/LinkedMesh.h>
+#include <spine/LodLevel.h>
 #include <spine/MathUtil.h>
 #include <spine/MeshAttachment.h>
 #include <spine/MixBlend.h>
@@ -74,6 +81,7 @@
 #include <spine/PathConstraintSpacingTimeline.h>
 #include <spine/PointAttachment.h>
 #include <spine/Pool.h>
+#include <spine/Pose.h>
 #include <spine/PositionMode.h>
 #include <spine/RegionAttachment.h>
 #include <spine/RotateMode.h>
@@ -86,7 +94,9 @@
 #include <spine/SkeletonBounds.h>
 #include <spine/SkeletonClipping.h>
 #include <spine/SkeletonData.h>
+#include <spine/SkeletonDataCache.h>
 #include <spine/SkeletonJson.h>
+#include <spine/SkeletonUpdateBatch.h>
 #include <spine/Skin.h>
 #include <spine/Slot.h>
 #include <spine/SlotData.h>
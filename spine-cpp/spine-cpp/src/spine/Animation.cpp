@@ -32,6 +32,10 @@
 #endif
 
 #include <spine/Animation.h>
+#include <spine/Arena.h>
+#include <spine/AttachmentTimeline.h>
+#include <spine/CurveTimeline.h>
+#include <spine/Pose.h>
 #include <spine/Timeline.h>
 #include <spine/Skeleton.h>
 #include <spine/Event.h>
@@ -39,25 +43,53 @@
 #include <spine/ContainerUtil.h>
 
 #include <stdint.h>
+#include <string.h>
 
 using namespace spine;
 
+TimelineLoader::~TimelineLoader() {
+}
+
 Animation::Animation(const String &name, Vector<Timeline *> &timelines, float duration) :
 		_timelines(timelines),
+		_timelineBatches(),
 		_timelineIds(),
 		_duration(duration),
-		_name(name) {
+		_name(name),
+		_timelineLoader(NULL),
+		_loaded(true),
+		_loadFailed(false),
+		_quantizeTolerance(0),
+		_curveLookup(false),
+		_curveTable(NULL) {
 	assert(_name.length() > 0);
-	for (int i = 0; i < (int)timelines.size(); i++)
-		_timelineIds.put(timelines[i]->getPropertyId(), true);
+	updateTimelineBatches();
+}
+
+Animation::Animation(const String &name, float duration, TimelineLoader *timelineLoader) :
+		_timelines(),
+		_timelineBatches(),
+		_timelineIds(),
+		_duration(duration),
+		_name(name),
+		_timelineLoader(timelineLoader),
+		_loaded(false),
+		_loadFailed(false),
+		_quantizeTolerance(0),
+		_curveLookup(false),
+		_curveTable(NULL) {
+	assert(_name.length() > 0);
+	assert(timelineLoader);
 }
 
 bool Animation::hasTimeline(int id) {
+	if (!_loaded) load();
 	return _timelineIds.containsKey(id);
 }
 
 Animation::~Animation() {
 	ContainerUtil::cleanUpVectorOfPointers(_timelines);
+	delete _curveTable;
 }
 
 void Animation::apply(Skeleton &skeleton, float lastTime, float time, bool loop, Vector<Event *> *pEvents, float alpha,
@@ -70,19 +102,95 @@ void Animation::apply(Skeleton &skeleton, float lastTime, float time, bool loop,
 		}
 	}
 
+	if (!_loaded) load();
 	for (size_t i = 0, n = _timelines.size(); i < n; ++i) {
 		_timelines[i]->apply(skeleton, lastTime, time, pEvents, alpha, blend, direction);
 	}
 }
 
+void Animation::sample(Pose &pose, float time, bool loop) {
+	if (loop && _duration != 0) time = MathUtil::fmod(time, _duration);
+
+	if (!_loaded) load();
+	pose.setToSetupPose();
+	for (size_t i = 0, n = _timelines.size(); i < n; ++i)
+		_timelines[i]->sample(pose, time);
+}
+
+void Animation::sample(Vector<Pose *> &poses, Vector<float> &times, bool loop) {
+	assert(poses.size() == times.size());
+	if (!_loaded) load();
+	for (size_t i = 0, n = poses.size(); i < n; ++i)
+		poses[i]->setToSetupPose();
+	for (size_t i = 0, n = _timelines.size(); i < n; ++i) {
+		Timeline *timeline = _timelines[i];
+		for (size_t ii = 0, nn = poses.size(); ii < nn; ++ii) {
+			float time = times[ii];
+			if (loop && _duration != 0) time = MathUtil::fmod(time, _duration);
+			timeline->sample(*poses[ii], time);
+		}
+	}
+}
+
 const String &Animation::getName() {
 	return _name;
 }
 
 Vector<Timeline *> &Animation::getTimelines() {
+	if (!_loaded) load();
 	return _timelines;
 }
 
+Vector<TimelineBatch> &Animation::getTimelineBatches() {
+	if (!_loaded) load();
+	assert(_timelineBatches.size() ? _timelineBatches[_timelineBatches.size() - 1].end == _timelines.size() : _timelines.size() == 0);
+	return _timelineBatches;
+}
+
+void Animation::updateTimelineBatches() {
+	sortTimelines();
+	buildTimelineBatches();
+	_timelineIds.clear();
+	for (size_t i = 0, n = _timelines.size(); i < n; i++)
+		_timelineIds.put(_timelines[i]->getPropertyId(), true);
+}
+
+void Animation::sortTimelines() {
+	size_t count = _timelines.size();
+	if (count > 1) {
+		// Scratch for the sort, kept out of the arena of the loader that may be calling.
+		ArenaScope heapScope(NULL);
+
+		// Types in the order they first appear, after attachment timelines.
+		Vector<const RTTI *> types;
+		types.add(&AttachmentTimeline::rtti);
+		for (size_t i = 0; i < count; i++) {
+			const RTTI *type = &_timelines[i]->getRTTI();
+			if (!types.contains(type)) types.add(type);
+		}
+		Vector<Timeline *> sorted;
+		sorted.ensureCapacity(count);
+		for (size_t i = 0; i < types.size(); i++) {
+			for (size_t ii = 0; ii < count; ii++)
+				if (_timelines[ii]->getRTTI().isExactly(*types[i])) sorted.add(_timelines[ii]);
+		}
+		memcpy(_timelines.buffer(), sorted.buffer(), count * sizeof(Timeline *));
+	}
+}
+
+void Animation::buildTimelineBatches() {
+	_timelineBatches.clear();
+	for (size_t i = 0, n = _timelines.size(); i < n;) {
+		TimelineBatch batch;
+		batch.rtti = &_timelines[i]->getRTTI();
+		batch.start = i;
+		while (++i < n && _timelines[i]->getRTTI().isExactly(*batch.rtti)) {
+		}
+		batch.end = i;
+		_timelineBatches.add(batch);
+	}
+}
+
 float Animation::getDuration() {
 	return _duration;
 }
@@ -91,7 +199,95 @@ void Animation::setDuration(float inValue) {
 	_duration = inValue;
 }
 
-int Animation::binarySearch(Vector<float> &values, float target, int step) {
+bool Animation::isLoaded() {
+	return _loaded;
+}
+
+bool Animation::load() {
+	if (_loaded) return true;
+	if (_loadFailed) return false;
+
+	// Timelines must be freed by unload(), so they never come from an arena.
+	ArenaScope heapScope(NULL);
+	if (!_timelineLoader->loadTimelines(*this, _timelines)) {
+		ContainerUtil::cleanUpVectorOfPointers(_timelines);
+		_loadFailed = true;
+		return false;
+	}
+	updateTimelineBatches();
+	if (_curveLookup) buildTimelineCurveLookups();
+	if (_quantizeTolerance > 0) quantizeTimelines();
+	_loaded = true;
+	return true;
+}
+
+void Animation::unload() {
+	if (!_timelineLoader) return;
+	_loadFailed = false;
+	if (!_loaded) return;
+	ContainerUtil::cleanUpVectorOfPointers(_timelines);
+	_timelineBatches.clear();
+	if (_curveTable) _curveTable->clear();
+	_timelineIds.clear();
+	_loaded = false;
+}
+
+size_t Animation::quantize(float tolerance) {
+	_quantizeTolerance = tolerance;
+	return _loaded ? quantizeTimelines() : 0;
+}
+
+size_t Animation::quantizeTimelines() {
+	if (!_curveTable) _curveTable = new(__FILE__, __LINE__) CurveTable();
+	size_t saved = 0;
+	for (size_t i = 0, n = _timelines.size(); i < n; i++) {
+		if (_timelines[i]->getRTTI().instanceOf(CurveTimeline::rtti))
+			saved += static_cast<CurveTimeline *>(_timelines[i])->quantize(_quantizeTolerance, *_curveTable);
+	}
+	return saved;
+}
+
+void Animation::buildCurveLookup() {
+	_curveLookup = true;
+	if (_loaded) buildTimelineCurveLookups();
+}
+
+void Animation::buildTimelineCurveLookups() {
+	for (size_t i = 0, n = _timelines.size(); i < n; i++) {
+		if (_timelines[i]->getRTTI().instanceOf(CurveTimeline::rtti))
+			static_cast<CurveTimeline *>(_timelines[i])->buildCurveLookup();
+	}
+}
+
+static SP_THREAD_LOCAL int *frameCursor = NULL;
+
+void Animation::setFrameCursor(int *cursor) {
+	frameCursor = cursor;
+}
+
+int *Animation::getFrameCursor() {
+	return frameCursor;
+}
+
+/// Returns true if frame is what binarySearch would return: the first frame after the target, or the last frame.
+template<typename T>
+static inline bool isSearchResult(T &values, float target, int step, int frame) {
+	int last = (int)values.size() - step;
+	if (frame < step || frame > last) return false;
+	return (frame == step || values[frame - step] <= target) && (frame == last || values[frame] > target);
+}
+
+template<typename T>
+static int binarySearchFrames(T &values, float target, int step) {
+	int *cursor = frameCursor;
+	if (cursor) {
+		// Time usually moves forward a little, so check the last frame and the one after it.
+		int frame = *cursor;
+		if (isSearchResult(values, target, step, frame)) return frame;
+		frame += step;
+		if (isSearchResult(values, target, step, frame)) return *cursor = frame;
+	}
+
 	int low = 0;
 	int size = (int)values.size();
 	int high = size / step - 2;
@@ -106,13 +302,32 @@ int Animation::binarySearch(Vector<float> &values, float target, int step) {
 		else
 			high = current;
 
-		if (low == high) return (low + 1) * step;
+		if (low == high) {
+			if (cursor) *cursor = (low + 1) * step;
+			return (low + 1) * step;
+		}
 
 		current = (int) (static_cast<uint32_t>(low + high) >> 1);
 	}
 }
 
+int Animation::binarySearch(Vector<float> &values, float target, int step) {
+	return binarySearchFrames(values, target, step);
+}
+
+int Animation::binarySearch(QuantizedFrames &values, float target, int step) {
+	return binarySearchFrames(values, target, step);
+}
+
 int Animation::binarySearch(Vector<float> &values, float target) {
+	int *cursor = frameCursor;
+	if (cursor) {
+		int frame = *cursor;
+		if (isSearchResult(values, target, 1, frame)) return frame;
+		frame++;
+		if (isSearchResult(values, target, 1, frame)) return *cursor = frame;
+	}
+
 	int low = 0;
 	int size = (int)values.size();
 	int high = size - 2;
@@ -125,7 +340,10 @@ int Animation::binarySearch(Vector<float> &values, float target) {
 		else
 			high = current;
 
-		if (low == high) return (low + 1);
+		if (low == high) {
+			if (cursor) *cursor = low + 1;
+			return (low + 1);
+		}
 
 		current = (int) (static_cast<uint32_t>(low + high) >> 1);
 	}
@@ -41,15 +41,129 @@
 #include <spine/Bone.h>
 #include <spine/BoneData.h>
 #include <spine/AttachmentTimeline.h>
+#include <spine/ColorTimeline.h>
+#include <spine/DeformTimeline.h>
 #include <spine/DrawOrderTimeline.h>
 #include <spine/EventTimeline.h>
+#include <spine/IkConstraintTimeline.h>
+#include <spine/PathConstraintMixTimeline.h>
+#include <spine/PathConstraintPositionTimeline.h>
+#include <spine/PathConstraintSpacingTimeline.h>
+#include <spine/Pose.h>
+#include <spine/ScaleTimeline.h>
+#include <spine/ShearTimeline.h>
 #include <spine/Slot.h>
 #include <spine/SlotData.h>
+#include <spine/TransformConstraintTimeline.h>
+#include <spine/TranslateTimeline.h>
+#include <spine/TwoColorTimeline.h>
 
 #include <float.h>
 
 using namespace spine;
 
+namespace {
+/// The arguments to apply a batch of timelines with. Each timeline uses its own alpha and blend if given.
+struct BatchArgs {
+	Skeleton *skeleton;
+	float lastTime, time;
+	Vector<Event *> *events;
+	float alpha;
+	const float *alphas;
+	MixBlend blend;
+	const MixBlend *blends;
+	MixDirection direction;
+	int *cursors;
+	bool skipDeform, skipLowImportanceBones;
+	LodCounters *lodCounters;
+};
+}
+
+/// For LodLevel::skipLowImportanceBones, returns true if the bone is low importance and sets it to the setup pose.
+static bool isLowImportance(Skeleton &skeleton, int boneIndex) {
+	Bone *bone = skeleton.getBones()[boneIndex];
+	if (!bone->getData().isLowImportance()) return false;
+	bone->setToSetupPose();
+	return true;
+}
+
+static inline bool isLowImportance(Skeleton &skeleton, Timeline *timeline) {
+	SP_UNUSED(skeleton);
+	SP_UNUSED(timeline);
+	return false;
+}
+
+static inline bool isLowImportance(Skeleton &skeleton, RotateTimeline *timeline) {
+	return isLowImportance(skeleton, timeline->getBoneIndex());
+}
+
+static inline bool isLowImportance(Skeleton &skeleton, TranslateTimeline *timeline) {
+	return isLowImportance(skeleton, timeline->getBoneIndex());
+}
+
+/// Applies the timelines of a batch of type T, calling T::apply() directly.
+template<typename T>
+static void applyBatch(Vector<Timeline *> &timelines, const TimelineBatch &batch, const BatchArgs &args) {
+	for (size_t i = batch.start; i < batch.end; ++i) {
+		T *timeline = static_cast<T *>(timelines[i]);
+		if (args.skipLowImportanceBones && isLowImportance(*args.skeleton, timeline)) {
+			args.lodCounters->skippedTimelines++;
+			continue;
+		}
+		Animation::setFrameCursor(args.cursors ? args.cursors + i : NULL);
+		timeline->T::apply(*args.skeleton, args.lastTime, args.time, args.events,
+			args.alphas ? args.alphas[i] : args.alpha, args.blends ? args.blends[i] : args.blend, args.direction);
+	}
+}
+
+/// For LodLevel::skipDeform, clears the deform of the slots keyed by a batch of deform timelines.
+static void skipDeformBatch(Vector<Timeline *> &timelines, const TimelineBatch &batch, const BatchArgs &args) {
+	Vector<Slot *> &slots = args.skeleton->getSlots();
+	for (size_t i = batch.start; i < batch.end; ++i)
+		slots[static_cast<DeformTimeline *>(timelines[i])->getSlotIndex()]->getDeform().clear();
+	args.lodCounters->skippedTimelines += batch.end - batch.start;
+}
+
+static void applyBatch(Vector<Timeline *> &timelines, const TimelineBatch &batch, const BatchArgs &args) {
+	const RTTI *rtti = batch.rtti;
+	if (rtti == &RotateTimeline::rtti)
+		applyBatch<RotateTimeline>(timelines, batch, args);
+	else if (rtti == &TranslateTimeline::rtti)
+		applyBatch<TranslateTimeline>(timelines, batch, args);
+	else if (rtti == &ScaleTimeline::rtti)
+		applyBatch<ScaleTimeline>(timelines, batch, args);
+	else if (rtti == &ShearTimeline::rtti)
+		applyBatch<ShearTimeline>(timelines, batch, args);
+	else if (rtti == &ColorTimeline::rtti)
+		applyBatch<ColorTimeline>(timelines, batch, args);
+	else if (rtti == &TwoColorTimeline::rtti)
+		applyBatch<TwoColorTimeline>(timelines, batch, args);
+	else if (rtti == &DeformTimeline::rtti) {
+		if (args.skipDeform)
+			skipDeformBatch(timelines, batch, args);
+		else
+			applyBatch<DeformTimeline>(timelines, batch, args);
+	}
+	else if (rtti == &IkConstraintTimeline::rtti)
+		applyBatch<IkConstraintTimeline>(timelines, batch, args);
+	else if (rtti == &TransformConstraintTimeline::rtti)
+		applyBatch<TransformConstraintTimeline>(timelines, batch, args);
+	else if (rtti == &PathConstraintPositionTimeline::rtti)
+		applyBatch<PathConstraintPositionTimeline>(timelines, batch, args);
+	else if (rtti == &PathConstraintSpacingTimeline::rtti)
+		applyBatch<PathConstraintSpacingTimeline>(timelines, batch, args);
+	else if (rtti == &PathConstraintMixTimeline::rtti)
+		applyBatch<PathConstraintMixTimeline>(timelines, batch, args);
+	else {
+		// Other timeline types, including ones defined outside the runtime.
+		for (size_t i = batch.start; i < batch.end; ++i) {
+			Animation::setFrameCursor(args.cursors ? args.cursors + i : NULL);
+			timelines[i]->apply(*args.skeleton, args.lastTime, args.time, args.events,
+				args.alphas ? args.alphas[i] : args.alpha, args.blends ? args.blends[i] : args.blend, args.direction);
+		}
+	}
+}
+
 void dummyOnAnimationEventFunc(AnimationState *state, spine::EventType type, TrackEntry *entry, Event *event = NULL) {
 	SP_UNUSED(state);
 	SP_UNUSED(type);
@@ -183,6 +297,7 @@ void TrackEntry::reset() {
 	_timelineMode.clear();
 	_timelineHoldMix.clear();
 	_timelinesRotation.clear();
+	_timelineCursors.clear();
 
 	_listener = dummyOnAnimationEventFunc;
 	_listenerObject = NULL;
@@ -303,7 +418,8 @@ AnimationState::AnimationState(AnimationStateData *data) :
 		_listener(dummyOnAnimationEventFunc),
 		_listenerObject(NULL),
 		_unkeyedState(0),
-		_timeScale(1) {
+		_timeScale(1),
+		_frameCursorsEnabled(true) {
 }
 
 AnimationState::~AnimationState() {
@@ -394,6 +510,39 @@ void AnimationState::update(float delta) {
 }
 
 bool AnimationState::apply(Skeleton &skeleton) {
+	int interval = skeleton._lodLevel.updateInterval;
+	if (interval <= 1) return applyTracks(skeleton);
+
+	// Apply the timelines once per interval, then show the previous applied pose moving toward this one.
+	bool applied = false;
+	if (skeleton._lodStep == 0) {
+		Pose *from = skeleton._lodTo;
+		skeleton._lodTo = skeleton._lodFrom;
+		skeleton._lodFrom = from;
+		// Blends other than setup start from the pose last applied, not the interpolated one.
+		if (skeleton._lodPosed) skeleton.applyPose(*from);
+		applied = applyTracks(skeleton);
+		skeleton.getPose(*skeleton._lodTo);
+		if (!skeleton._lodPosed) {
+			from->set(*skeleton._lodTo);
+			skeleton._lodPosed = true;
+		}
+	} else {
+		for (size_t i = 0, n = _tracks.size(); i < n; ++i)
+			if (_tracks[i] != NULL && _tracks[i]->_delay <= 0) applied = true;
+		skeleton._lodCounters.interpolatedApplies++;
+	}
+	Pose &pose = *skeleton._lodPose;
+	pose.mix(*skeleton._lodFrom, *skeleton._lodTo, (float)skeleton._lodStep / interval);
+	// Deform is only applied with the timelines, and changing an attachment clears it, so keep the applied attachments.
+	for (size_t i = 0, n = pose.getSlotCount(); i < n; ++i)
+		pose.setAttachment(i, skeleton._lodTo->getAttachment(i));
+	skeleton.applyPose(pose);
+	skeleton._lodStep = (skeleton._lodStep + 1) % interval;
+	return applied;
+}
+
+bool AnimationState::applyTracks(Skeleton &skeleton) {
 	if (_animationsChanged) {
 		animationsChanged();
 	}
@@ -420,37 +569,60 @@ bool AnimationState::apply(Skeleton &skeleton) {
 
 		// apply current entry.
 		float animationLast = current._animationLast, animationTime = current.getAnimationTime();
-		size_t timelineCount = current._animation->_timelines.size();
-		Vector<Timeline *> &timelines = current._animation->_timelines;
+		Vector<Timeline *> &timelines = current._animation->getTimelines();
+		size_t timelineCount = timelines.size();
+		int *cursors = getFrameCursors(currentP, timelineCount);
+		Vector<TimelineBatch> &batches = current._animation->getTimelineBatches();
+		const LodLevel &lod = skeleton._lodLevel;
+		BatchArgs args = {&skeleton, animationLast, animationTime, &_events, mix, NULL, blend, NULL, MixDirection_In, cursors,
+			lod.skipDeform, lod.skipLowImportanceBones, &skeleton._lodCounters};
 		if ((i == 0 && mix == 1) || blend == MixBlend_Add) {
-			for (size_t ii = 0; ii < timelineCount; ++ii) {
-                Timeline *timeline = timelines[ii];
-                if (timeline->getRTTI().isExactly(AttachmentTimeline::rtti))
-                    applyAttachmentTimeline(static_cast<AttachmentTimeline *>(timeline), skeleton, animationTime, blend, true);
-                else
-                    timeline->apply(skeleton, animationLast, animationTime, &_events, mix, blend, MixDirection_In);
-            }
+			for (size_t ii = 0; ii < batches.size(); ++ii) {
+				TimelineBatch &batch = batches[ii];
+				if (batch.rtti != &AttachmentTimeline::rtti) {
+					applyBatch(timelines, batch, args);
+					continue;
+				}
+				for (size_t iii = batch.start; iii < batch.end; ++iii) {
+					Animation::setFrameCursor(cursors ? cursors + iii : NULL);
+					applyAttachmentTimeline(static_cast<AttachmentTimeline *>(timelines[iii]), skeleton, animationTime, blend, true);
+				}
+			}
 		} else {
 			Vector<int> &timelineMode = current._timelineMode;
+			_timelineBlends.setSize(timelineCount, MixBlend_Setup);
+			for (size_t ii = 0; ii < timelineCount; ++ii)
+				_timelineBlends[ii] = timelineMode[ii] == Subsequent ? blend : MixBlend_Setup;
+			args.blends = _timelineBlends.buffer();
 
 			bool firstFrame = current._timelinesRotation.size() == 0;
 			if (firstFrame) current._timelinesRotation.setSize(timelines.size() << 1, 0);
 			Vector<float> &timelinesRotation = current._timelinesRotation;
 
-			for (size_t ii = 0; ii < timelineCount; ++ii) {
-				Timeline *timeline = timelines[ii];
-				assert(timeline);
-
-				MixBlend timelineBlend = timelineMode[ii] == Subsequent ? blend : MixBlend_Setup;
-
-				if (timeline->getRTTI().isExactly(RotateTimeline::rtti))
-					applyRotateTimeline(static_cast<RotateTimeline *>(timeline), skeleton, animationTime, mix, timelineBlend, timelinesRotation, ii << 1, firstFrame);
-				else if (timeline->getRTTI().isExactly(AttachmentTimeline::rtti))
-                    applyAttachmentTimeline(static_cast<AttachmentTimeline *>(timeline), skeleton, animationTime, timelineBlend, true);
-				else
-					timeline->apply(skeleton, animationLast, animationTime, &_events, mix, timelineBlend, MixDirection_In);
+			for (size_t ii = 0; ii < batches.size(); ++ii) {
+				TimelineBatch &batch = batches[ii];
+				if (batch.rtti == &RotateTimeline::rtti) {
+					for (size_t iii = batch.start; iii < batch.end; ++iii) {
+						RotateTimeline *timeline = static_cast<RotateTimeline *>(timelines[iii]);
+						if (args.skipLowImportanceBones && isLowImportance(skeleton, timeline)) {
+							args.lodCounters->skippedTimelines++;
+							continue;
+						}
+						Animation::setFrameCursor(cursors ? cursors + iii : NULL);
+						applyRotateTimeline(timeline, skeleton, animationTime, mix, _timelineBlends[iii], timelinesRotation,
+							iii << 1, firstFrame);
+					}
+				} else if (batch.rtti == &AttachmentTimeline::rtti) {
+					for (size_t iii = batch.start; iii < batch.end; ++iii) {
+						Animation::setFrameCursor(cursors ? cursors + iii : NULL);
+						applyAttachmentTimeline(static_cast<AttachmentTimeline *>(timelines[iii]), skeleton, animationTime,
+							_timelineBlends[iii], true);
+					}
+				} else
+					applyBatch(timelines, batch, args);
 			}
 		}
+		Animation::setFrameCursor(NULL);
 
 		queueEvents(currentP, animationTime);
 		_events.clear();
@@ -650,6 +822,23 @@ void AnimationState::enableQueue() {
 	_queue->_drainDisabled = false;
 }
 
+void AnimationState::setFrameCursorsEnabled(bool inValue) {
+	_frameCursorsEnabled = inValue;
+}
+
+bool AnimationState::isFrameCursorsEnabled() {
+	return _frameCursorsEnabled;
+}
+
+int *AnimationState::getFrameCursors(TrackEntry *entry, size_t timelineCount) {
+	if (!_frameCursorsEnabled || timelineCount == 0) return NULL;
+	if (entry->_timelineCursors.size() != timelineCount) {
+		entry->_timelineCursors.clear();
+		entry->_timelineCursors.setSize(timelineCount, 0);
+	}
+	return entry->_timelineCursors.buffer();
+}
+
 Animation *AnimationState::getEmptyAnimation() {
 	static Vector<Timeline *> timelines;
 	static Animation ret(String("<empty>"), timelines, 0);
@@ -690,9 +879,8 @@ void AnimationState::applyRotateTimeline(RotateTimeline *rotateTimeline, Skeleto
 
 	Bone *bone = skeleton._bones[rotateTimeline->_boneIndex];
 	if (!bone->isActive()) return;
-	Vector<float>& frames = rotateTimeline->_frames;
 	float r1, r2;
-	if (time < frames[0]) {
+	if (!rotateTimeline->getRotation(time, bone->_data._rotation, r2)) {
 		switch (blend) {
 		case MixBlend_Setup:
 			bone->_rotation = bone->_data._rotation;
@@ -702,24 +890,8 @@ void AnimationState::applyRotateTimeline(RotateTimeline *rotateTimeline, Skeleto
 			r1 = bone->_rotation;
 			r2 = bone->_data._rotation;
 		}
-	} else {
+	} else
 		r1 = blend == MixBlend_Setup ? bone->_data._rotation : bone->_rotation;
-		if (time >= frames[frames.size() - RotateTimeline::ENTRIES]) {
-			// Time is after last frame.
-			r2 = bone->_data._rotation + frames[frames.size() + RotateTimeline::PREV_ROTATION];
-		} else {
-			// Interpolate between the previous frame and the current frame.
-			int frame = Animation::binarySearch(frames, time, RotateTimeline::ENTRIES);
-			float prevRotation = frames[frame + RotateTimeline::PREV_ROTATION];
-			float frameTime = frames[frame];
-			float percent = rotateTimeline->getCurvePercent((frame >> 1) - 1, 1 - (time - frameTime) / (frames[frame +
-				RotateTimeline::PREV_TIME] - frameTime));
-			r2 = frames[frame + RotateTimeline::ROTATION] - prevRotation;
-			r2 -= (16384 - (int) (16384.499999999996 - r2 / 360)) * 360;
-			r2 = prevRotation + r2 * percent + bone->_data._rotation;
-			r2 -= (16384 - (int) (16384.499999999996 - r2 / 360)) * 360;
-		}
-	}
 
 	// Mix between rotations using the direction of the shortest route on the first frame while detecting crosses.
 	float total, diff = r2 - r1;
@@ -804,13 +976,18 @@ float AnimationState::applyMixingFrom(TrackEntry *to, Skeleton &skeleton, MixBle
 	Vector<Event *> *eventBuffer = mix < from->_eventThreshold ? &_events : NULL;
 	bool attachments = mix < from->_attachmentThreshold, drawOrder = mix < from->_drawOrderThreshold;
 	float animationLast = from->_animationLast, animationTime = from->getAnimationTime();
-	Vector<Timeline *> &timelines = from->_animation->_timelines;
+	Vector<Timeline *> &timelines = from->_animation->getTimelines();
 	size_t timelineCount = timelines.size();
 	float alphaHold = from->_alpha * to->_interruptAlpha, alphaMix = alphaHold * (1 - mix);
+	int *cursors = getFrameCursors(from, timelineCount);
 
+	Vector<TimelineBatch> &batches = from->_animation->getTimelineBatches();
+	const LodLevel &lod = skeleton._lodLevel;
+	BatchArgs args = {&skeleton, animationLast, animationTime, eventBuffer, alphaMix, NULL, blend, NULL, MixDirection_Out, cursors,
+		lod.skipDeform, lod.skipLowImportanceBones, &skeleton._lodCounters};
 	if (blend == MixBlend_Add) {
-		for (size_t i = 0; i < timelineCount; i++)
-			timelines[i]->apply(skeleton, animationLast, animationTime, eventBuffer, alphaMix, blend, MixDirection_Out);
+		for (size_t i = 0; i < batches.size(); i++)
+			applyBatch(timelines, batches[i], args);
 	} else {
 		Vector<int> &timelineMode = from->_timelineMode;
 		Vector<TrackEntry *> &timelineHoldMix = from->_timelineHoldMix;
@@ -820,16 +997,15 @@ float AnimationState::applyMixingFrom(TrackEntry *to, Skeleton &skeleton, MixBle
 
 		Vector<float> &timelinesRotation = from->_timelinesRotation;
 
+		_timelineAlphas.setSize(timelineCount, 0);
+		_timelineBlends.setSize(timelineCount, MixBlend_Setup);
 		from->_totalAlpha = 0;
 		for (size_t i = 0; i < timelineCount; i++) {
-			Timeline *timeline = timelines[i];
-			MixDirection direction = MixDirection_Out;
 			MixBlend timelineBlend;
 			float alpha;
 			switch (timelineMode[i]) {
 				case Subsequent:
-					if (!drawOrder && (timeline->getRTTI().isExactly(DrawOrderTimeline::rtti))) continue;
-                    timelineBlend = blend;
+					timelineBlend = blend;
 					alpha = alphaMix;
 					break;
 				case First:
@@ -846,19 +1022,49 @@ float AnimationState::applyMixingFrom(TrackEntry *to, Skeleton &skeleton, MixBle
 					alpha = alphaHold * MathUtil::max(0.0f, 1.0f - holdMix->_mixTime / holdMix->_mixDuration);
 					break;
 			}
+			_timelineBlends[i] = timelineBlend;
+			_timelineAlphas[i] = alpha;
+			if (timelineMode[i] == Subsequent && !drawOrder && timelines[i]->getRTTI().isExactly(DrawOrderTimeline::rtti))
+				continue;
 			from->_totalAlpha += alpha;
-			if ((timeline->getRTTI().isExactly(RotateTimeline::rtti))) {
-				applyRotateTimeline((RotateTimeline*)timeline, skeleton, animationTime, alpha, timelineBlend, timelinesRotation, i << 1, firstFrame);
-			} else if (timeline->getRTTI().isExactly(AttachmentTimeline::rtti)) {
-                applyAttachmentTimeline(static_cast<AttachmentTimeline*>(timeline), skeleton, animationTime, timelineBlend, attachments);
-            } else {
-			    if (drawOrder && timeline->getRTTI().isExactly(DrawOrderTimeline::rtti) && timelineBlend == MixBlend_Setup)
-			        direction = MixDirection_In;
-			    timeline->apply(skeleton, animationLast, animationTime, eventBuffer, alpha, timelineBlend, direction);
-			}
+		}
+		args.alphas = _timelineAlphas.buffer();
+		args.blends = _timelineBlends.buffer();
+
+		for (size_t i = 0; i < batches.size(); i++) {
+			TimelineBatch &batch = batches[i];
+			if (batch.rtti == &RotateTimeline::rtti) {
+				for (size_t ii = batch.start; ii < batch.end; ii++) {
+					RotateTimeline *timeline = static_cast<RotateTimeline *>(timelines[ii]);
+					if (args.skipLowImportanceBones && isLowImportance(skeleton, timeline)) {
+						args.lodCounters->skippedTimelines++;
+						continue;
+					}
+					Animation::setFrameCursor(cursors ? cursors + ii : NULL);
+					applyRotateTimeline(timeline, skeleton, animationTime, _timelineAlphas[ii], _timelineBlends[ii],
+						timelinesRotation, ii << 1, firstFrame);
+				}
+			} else if (batch.rtti == &AttachmentTimeline::rtti) {
+				for (size_t ii = batch.start; ii < batch.end; ii++) {
+					Animation::setFrameCursor(cursors ? cursors + ii : NULL);
+					applyAttachmentTimeline(static_cast<AttachmentTimeline *>(timelines[ii]), skeleton, animationTime,
+						_timelineBlends[ii], attachments);
+				}
+			} else if (batch.rtti == &DrawOrderTimeline::rtti) {
+				for (size_t ii = batch.start; ii < batch.end; ii++) {
+					if (timelineMode[ii] == Subsequent && !drawOrder) continue;
+					MixDirection direction = drawOrder && _timelineBlends[ii] == MixBlend_Setup ? MixDirection_In : MixDirection_Out;
+					Animation::setFrameCursor(cursors ? cursors + ii : NULL);
+					timelines[ii]->apply(skeleton, animationLast, animationTime, eventBuffer, _timelineAlphas[ii], _timelineBlends[ii],
+						direction);
+				}
+			} else
+				applyBatch(timelines, batch, args);
 		}
 	}
 
+	Animation::setFrameCursor(NULL);
+
 	if (to->_mixDuration > 0) {
 		queueEvents(from, animationTime);
 	}
@@ -997,7 +1203,7 @@ void AnimationState::animationsChanged() {
 
 void AnimationState::computeHold(TrackEntry *entry) {
 	TrackEntry* to = entry->_mixingTo;
-	Vector<Timeline *> &timelines = entry->_animation->_timelines;
+	Vector<Timeline *> &timelines = entry->_animation->getTimelines();
 	size_t timelinesCount = timelines.size();
 	Vector<int> &timelineMode = entry->_timelineMode;
 	timelineMode.setSize(timelinesCount, 0);
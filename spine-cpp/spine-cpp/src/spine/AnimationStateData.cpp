@@ -81,5 +81,12 @@ AnimationStateData::AnimationPair::AnimationPair(Animation *a1, Animation *a2) :
 }
 
 bool AnimationStateData::AnimationPair::operator==(const AnimationPair &other) const {
+	if (_a1 == other._a1 && _a2 == other._a2) return true;
 	return _a1->_name == other._a1->_name && _a2->_name == other._a2->_name;
 }
+
+size_t AnimationStateData::AnimationPairHash::operator()(const AnimationPair &pair) const {
+	// Pairs are equal by animation names, so they must be hashed by name.
+	Hash<String> hash;
+	return hash(pair._a1->getName()) * 31 + hash(pair._a2->getName());
+}
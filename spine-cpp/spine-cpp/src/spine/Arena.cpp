@@ -0,0 +1,258 @@
+/******************************************************************************
+ * Spine Runtimes License Agreement
+ * Last updated January 1, 2020. Replaces all prior versions.
+ *
+ * Copyright (c) 2013-2020, Esoteric Software LLC
+ *
+ * Integration of the Spine Runtimes into software or otherwise creating
+ * derivative works of the Spine Runtimes is permitted under the terms and
+ * conditions of Section 2 of the Spine Editor License Agreement:
+ * http://esotericsoftware.com/spine-editor-license
+ *
+ * Otherwise, it is permitted to integrate the Spine Runtimes into software
+ * or otherwise create derivative works of the Spine Runtimes (collectively,
+ * "Products"), provided that each user of the Products must obtain their own
+ * Spine Editor license and redistribution of the Products in any form must
+ * include this license and copyright notice.
+ *
+ * THE SPINE RUNTIMES ARE PROVIDED BY ESOTERIC SOFTWARE LLC "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL ESOTERIC SOFTWARE LLC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES,
+ * BUSINESS INTERRUPTION, OR LOSS OF USE, DATA, OR PROFITS) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THE SPINE RUNTIMES, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+#ifdef SPINE_UE4
+#include "SpinePluginPrivatePCH.h"
+#endif
+
+#include <spine/Arena.h>
+#include <spine/Extension.h>
+
+#include <assert.h>
+#include <string.h>
+
+using namespace spine;
+
+// Each allocation is preceded by its size and aligned to 8 bytes.
+static const size_t ALIGNMENT = 8;
+static const size_t HEADER_SIZE = 8;
+
+static size_t align(size_t size) {
+	return (size + ALIGNMENT - 1) & ~(ALIGNMENT - 1);
+}
+
+static SP_THREAD_LOCAL Arena *currentArena = NULL;
+
+namespace {
+struct Range {
+	const char *start;
+	const char *end;
+};
+}
+
+// The address ranges of the blocks of all arenas, sorted by address. It is searched by every SpineExtension::free(), so it
+// is read without locking: changes are made under the lock while the sequence is odd, and a search that overlaps a change
+// is retried. The table is static so a search never reads freed memory. When it is full, arenas allocate from the heap.
+static const size_t REGISTRY_CAPACITY = 16 * 1024;
+static Range registry[REGISTRY_CAPACITY];
+static volatile long registrySize = 0;
+static volatile long registrySequence = 0;
+static volatile long registryLock = 0;
+
+namespace {
+class RegistryLock {
+public:
+	RegistryLock() {
+		while (SP_ATOMIC_CAS(&registryLock, 0, 1) != 0) {
+		}
+		SP_ATOMIC_ADD(&registrySequence, 1);
+	}
+
+	~RegistryLock() {
+		SP_ATOMIC_ADD(&registrySequence, 1);
+		SP_ATOMIC_CAS(&registryLock, 1, 0);
+	}
+};
+}
+
+static size_t findRange(const char *address) {
+	size_t low = 0, high = (size_t) registrySize;
+	if (high > REGISTRY_CAPACITY) high = REGISTRY_CAPACITY;
+	while (low < high) {
+		size_t middle = (low + high) >> 1;
+		if (registry[middle].start <= address) low = middle + 1;
+		else high = middle;
+	}
+	return low;
+}
+
+static bool registerRange(const char *start, const char *end) {
+	RegistryLock lock;
+	size_t size = (size_t) registrySize;
+	if (size == REGISTRY_CAPACITY) return false;
+	size_t index = findRange(start);
+	memmove(registry + index + 1, registry + index, (size - index) * sizeof(Range));
+	registry[index].start = start;
+	registry[index].end = end;
+	registrySize = (long) size + 1;
+	return true;
+}
+
+static void unregisterRange(const char *start) {
+	RegistryLock lock;
+	size_t size = (size_t) registrySize, index = findRange(start) - 1;
+	assert(registry[index].start == start);
+	memmove(registry + index, registry + index + 1, (size - index - 1) * sizeof(Range));
+	registrySize = (long) size - 1;
+}
+
+Arena::Arena(size_t blockSize) : _blocks(NULL), _blockSize(blockSize), _capacity(0), _used(0) {
+}
+
+Arena::~Arena() {
+	if (currentArena == this) currentArena = NULL;
+	SpineExtension *extension = SpineExtension::getInstance();
+	for (Block *block = _blocks; block;) {
+		Block *next = block->next;
+		unregisterRange(getData(block));
+		extension->_free(block, __FILE__, __LINE__);
+		block = next;
+	}
+}
+
+void *Arena::alloc(size_t size, bool clear) {
+	if (size == 0) return NULL;
+	size_t total = HEADER_SIZE + align(size);
+
+	Block *block = _blocks;
+	if (!block || block->used + total > block->size) {
+		if (total > _blockSize >> 2) {
+			// Large allocations get their own block so the current block's free space is not lost.
+			block = newBlock(total);
+			if (!block) return NULL;
+			if (_blocks) {
+				block->next = _blocks->next;
+				_blocks->next = block;
+			} else
+				_blocks = block;
+		} else {
+			block = newBlock(_blockSize);
+			if (!block) return NULL;
+			block->next = _blocks;
+			_blocks = block;
+		}
+	}
+
+	char *result = getData(block) + block->used + HEADER_SIZE;
+	*(size_t *) (result - HEADER_SIZE) = size;
+	block->used += total;
+	_used += total;
+	if (clear) memset(result, 0, size);
+	return result;
+}
+
+size_t Arena::getCapacity() {
+	return _capacity;
+}
+
+size_t Arena::getUsed() {
+	return _used;
+}
+
+Arena *Arena::getCurrent() {
+	return currentArena;
+}
+
+void Arena::setCurrent(Arena *inValue) {
+	currentArena = inValue;
+}
+
+bool Arena::owns(const void *ptr) {
+	const char *address = (const char *) ptr;
+	for (Block *block = _blocks; block; block = block->next) {
+		if (address >= getData(block) && address < getData(block) + block->size) return true;
+	}
+	return false;
+}
+
+bool Arena::contains(const void *ptr) {
+	// Memory can only be freed into an arena that is alive, so when no blocks are registered no pointer can be arena
+	// memory.
+	if (registrySize == 0) return false;
+	const char *address = (const char *) ptr;
+	while (true) {
+		long sequence = registrySequence;
+		SP_MEMORY_BARRIER();
+		if (sequence & 1) continue;
+		size_t index = findRange(address);
+		bool found = index > 0 && address < registry[index - 1].end;
+		SP_MEMORY_BARRIER();
+		if (registrySequence == sequence) return found;
+	}
+}
+
+void *Arena::realloc(void *ptr, size_t size, const char *file, int line) {
+	size_t oldSize = *(size_t *) ((char *) ptr - HEADER_SIZE);
+	if (size == 0) return NULL;
+	if (size <= oldSize) return ptr;
+
+	// Grow in place if this is the last allocation in a block of the current arena.
+	Arena *arena = currentArena;
+	Block *block = arena ? arena->findLast(ptr) : NULL;
+	size_t growth = align(size) - align(oldSize);
+	if (block && block->used + growth <= block->size) {
+		*(size_t *) ((char *) ptr - HEADER_SIZE) = size;
+		block->used += growth;
+		arena->_used += growth;
+		return ptr;
+	}
+
+	void *result = SpineExtension::alloc<char>(size, file, line);
+	memcpy(result, ptr, oldSize);
+	return result;
+}
+
+Arena::Block *Arena::newBlock(size_t size) {
+	SpineExtension *extension = SpineExtension::getInstance();
+	size_t headerSize = align(sizeof(Block));
+	Block *block = (Block *) extension->_alloc(headerSize + size, __FILE__, __LINE__);
+	if (!registerRange(getData(block), getData(block) + size)) {
+		extension->_free(block, __FILE__, __LINE__);
+		return NULL;
+	}
+	block->next = NULL;
+	block->size = size;
+	block->used = 0;
+	_capacity += headerSize + size;
+	return block;
+}
+
+Arena::Block *Arena::findLast(const void *ptr) {
+	const char *address = (const char *) ptr;
+	Block *block = _blocks;
+	for (int i = 0; i < 2 && block; i++, block = block->next) {
+		char *data = getData(block);
+		if (address < data || address >= data + block->used) continue;
+		size_t size = *(size_t *) (address - HEADER_SIZE);
+		return address + align(size) == data + block->used ? block : NULL;
+	}
+	return NULL;
+}
+
+char *Arena::getData(Block *block) {
+	return (char *) block + align(sizeof(Block));
+}
+
+ArenaScope::ArenaScope(Arena *arena) : _previous(Arena::getCurrent()) {
+	Arena::setCurrent(arena);
+}
+
+ArenaScope::~ArenaScope() {
+	Arena::setCurrent(_previous);
+}
@@ -0,0 +1,266 @@
+/******************************************************************************
+ * Spine Runtimes License Agreement
+ * Last updated January 1, 2020. Replaces all prior versions.
+ *
+ * Copyright (c) 2013-2020, Esoteric Software LLC
+ *
+ * Integration of the Spine Runtimes into software or otherwise creating
+ * derivative works of the Spine Runtimes is permitted under the terms and
+ * conditions of Section 2 of the Spine Editor License Agreement:
+ * http://esotericsoftware.com/spine-editor-license
+ *
+ * Otherwise, it is permitted to integrate the Spine Runtimes into software
+ * or otherwise create derivative works of the Spine Runtimes (collectively,
+ * "Products"), provided that each user of the Products must obtain their own
+ * Spine Editor license and redistribution of the Products in any form must
+ * include this license and copyright notice.
+ *
+ * THE SPINE RUNTIMES ARE PROVIDED BY ESOTERIC SOFTWARE LLC "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL ESOTERIC SOFTWARE LLC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES,
+ * BUSINESS INTERRUPTION, OR LOSS OF USE, DATA, OR PROFITS) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THE SPINE RUNTIMES, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+#ifdef SPINE_UE4
+#include "SpinePluginPrivatePCH.h"
+#endif
+
+#include <spine/AsyncLoader.h>
+
+#include <spine/Atlas.h>
+#include <spine/JobRunner.h>
+#include <spine/SkeletonBinary.h>
+#include <spine/SkeletonData.h>
+#include <spine/SkeletonJson.h>
+#include <spine/TextureLoader.h>
+
+using namespace spine;
+
+namespace spine {
+class AsyncLoadJob : public SpineObject, public Job {
+public:
+	explicit AsyncLoadJob(AsyncLoad &load) : _load(load) {
+	}
+
+	virtual void run(int index) {
+		SP_UNUSED(index);
+		_load.load();
+	}
+
+private:
+	AsyncLoad &_load;
+};
+}
+
+static void dummyOnAsyncLoadFunc(AsyncLoader *loader, AsyncLoad *load) {
+	SP_UNUSED(loader);
+	SP_UNUSED(load);
+}
+
+AsyncLoad::AsyncLoad(const String &path, TextureLoader *textureLoader, AsyncLoad *atlasLoad, float scale) : _path(path),
+	_state(State_Waiting), _references(1), _textureLoader(textureLoader), _atlasLoad(atlasLoad), _scale(scale),
+	_job(new(__FILE__, __LINE__) AsyncLoadJob(*this)), _atlas(NULL), _skeletonData(NULL), _error() {
+}
+
+AsyncLoad::~AsyncLoad() {
+	delete _job;
+	delete _skeletonData;
+	// The atlas does not know the texture loader, since its textures are only created once the load is done.
+	if (_atlas && _textureLoader && _state == State_Done) {
+		Vector<AtlasPage *> &pages = _atlas->getPages();
+		for (size_t i = 0; i < pages.size(); ++i)
+			_textureLoader->unload(pages[i]->getRendererObject());
+	}
+	delete _atlas;
+}
+
+const String &AsyncLoad::getPath() {
+	return _path;
+}
+
+bool AsyncLoad::isDone() {
+	return _state == State_Done;
+}
+
+Atlas *AsyncLoad::getAtlas() {
+	return _state == State_Done ? _atlas : NULL;
+}
+
+SkeletonData *AsyncLoad::getSkeletonData() {
+	return _state == State_Done ? _skeletonData : NULL;
+}
+
+const String &AsyncLoad::getError() {
+	return _error;
+}
+
+void AsyncLoad::load() {
+	if (!_atlasLoad) {
+		// Textures are created in AsyncLoader::update(), on the thread that calls it.
+		_atlas = new(__FILE__, __LINE__) Atlas(_path, NULL, false);
+		if (_atlas->getPages().size() == 0) {
+			delete _atlas;
+			_atlas = NULL;
+			_error = String("Unable to read atlas: ").append(_path);
+		}
+		return;
+	}
+
+	size_t length = _path.length();
+	if (length >= 5 && strcmp(_path.buffer() + length - 5, ".json") == 0) {
+		SkeletonJson json(_atlasLoad->_atlas);
+		json.setScale(_scale);
+		_skeletonData = json.readSkeletonDataFile(_path);
+		if (!_skeletonData) _error = json.getError();
+	} else {
+		SkeletonBinary binary(_atlasLoad->_atlas);
+		binary.setScale(_scale);
+		_skeletonData = binary.readSkeletonDataFile(_path);
+		if (!_skeletonData) _error = binary.getError();
+	}
+}
+
+size_t AsyncLoader::KeyHash::operator()(const Key &key) const {
+	union {
+		float f;
+		int i;
+	} scale;
+	scale.f = key.scale;
+	return Hash<String>()(key.path) ^ Hash<void *>()(key.owner) ^ Hash<int>()(scale.i);
+}
+
+AsyncLoader::AsyncLoader(JobRunner *jobRunner) : _jobRunner(jobRunner ? jobRunner : new(__FILE__, __LINE__) JobRunner()),
+	_ownsJobRunner(jobRunner == NULL), _listener(dummyOnAsyncLoadFunc), _listenerObject(NULL) {
+}
+
+AsyncLoader::~AsyncLoader() {
+	// The jobs that are running use the loads, so they must return first.
+	for (size_t i = 0; i < _loads.size(); ++i)
+		if (_loads[i]->_state == AsyncLoad::State_Running) _jobRunner->wait(*_loads[i]->_job);
+	// Skeleton data refers to the atlas it was loaded with, so it is deleted first.
+	size_t atlasCount = 0;
+	for (size_t i = 0; i < _loads.size(); ++i) {
+		if (_loads[i]->_atlasLoad)
+			delete _loads[i];
+		else
+			_loads[atlasCount++] = _loads[i];
+	}
+	for (size_t i = 0; i < atlasCount; ++i)
+		delete _loads[i];
+	if (_ownsJobRunner) delete _jobRunner;
+}
+
+AsyncLoad *AsyncLoader::loadAtlas(const String &path, TextureLoader *textureLoader) {
+	return addLoad(path, textureLoader, NULL, 1);
+}
+
+AsyncLoad *AsyncLoader::loadSkeletonData(const String &path, AsyncLoad *atlasLoad, float scale) {
+	assert(atlasLoad && !atlasLoad->_atlasLoad);
+	return addLoad(path, NULL, atlasLoad, scale);
+}
+
+AsyncLoad *AsyncLoader::addLoad(const String &path, TextureLoader *textureLoader, AsyncLoad *atlasLoad, float scale) {
+	Key key(path, scale, atlasLoad ? (void *) atlasLoad : (void *) textureLoader);
+	AsyncLoad **existing = _loadIndex.get(key);
+	if (existing) {
+		(*existing)->_references++;
+		return *existing;
+	}
+	AsyncLoad *load = new(__FILE__, __LINE__) AsyncLoad(path, textureLoader, atlasLoad, scale);
+	_loads.add(load);
+	_loadIndex.put(key, load);
+	if (atlasLoad) {
+		atlasLoad->_references++;
+		// If the atlas failed, update() fails this load so the listener is called for it.
+		if (atlasLoad->_state != AsyncLoad::State_Done || !atlasLoad->_atlas) return load;
+	}
+	start(load);
+	return load;
+}
+
+AsyncLoader::Key AsyncLoader::getKey(AsyncLoad *load) {
+	return Key(load->_path, load->_scale, load->_atlasLoad ? (void *) load->_atlasLoad : (void *) load->_textureLoader);
+}
+
+void AsyncLoader::start(AsyncLoad *load) {
+	load->_state = AsyncLoad::State_Running;
+	_jobRunner->start(*load->_job, 1);
+}
+
+void AsyncLoader::finish(AsyncLoad *load) {
+	Atlas *atlas = load->_atlas;
+	if (atlas && load->_textureLoader) {
+		Vector<AtlasPage *> &pages = atlas->getPages();
+		for (size_t i = 0; i < pages.size(); ++i)
+			load->_textureLoader->load(*pages[i], pages[i]->texturePath);
+	}
+	load->_state = AsyncLoad::State_Done;
+}
+
+void AsyncLoader::release(AsyncLoad *load) {
+	if (--load->_references > 0) return;
+	Key key = getKey(load);
+	AsyncLoad **indexed = _loadIndex.get(key);
+	if (indexed && *indexed == load) _loadIndex.remove(key);
+	// A running job still uses the load, so it is deleted by update() once the job returns.
+	if (load->_state == AsyncLoad::State_Running) return;
+	_loads.removeAt(_loads.indexOf(load));
+	AsyncLoad *atlasLoad = load->_atlasLoad;
+	delete load;
+	if (atlasLoad) release(atlasLoad);
+}
+
+void AsyncLoader::update() {
+	Vector<AsyncLoad *> done;
+	for (size_t i = 0; i < _loads.size(); ++i) {
+		AsyncLoad *load = _loads[i];
+		if (load->_state == AsyncLoad::State_Waiting && load->_atlasLoad->_state == AsyncLoad::State_Done) {
+			if (!load->_atlasLoad->_atlas) {
+				load->_error = String("Unable to load skeleton data without atlas: ").append(load->_atlasLoad->_path);
+				finish(load);
+				done.add(load);
+				continue;
+			}
+			start(load);
+		}
+		if (load->_state != AsyncLoad::State_Running || !_jobRunner->isDone(*load->_job)) continue;
+		finish(load);
+		done.add(load);
+	}
+
+	// The loads are referenced while the listener is called, since it may release them.
+	for (size_t i = 0; i < done.size(); ++i)
+		done[i]->_references++;
+	for (size_t i = 0; i < done.size(); ++i) {
+		AsyncLoad *load = done[i];
+		if (load->_references == 1) continue; // Released while its job was running.
+		if (!_listenerObject)
+			_listener(this, load);
+		else
+			_listenerObject->callback(this, load);
+	}
+	for (size_t i = 0; i < done.size(); ++i)
+		release(done[i]);
+}
+
+int AsyncLoader::getPendingCount() {
+	int count = 0;
+	for (size_t i = 0; i < _loads.size(); ++i)
+		if (_loads[i]->_state != AsyncLoad::State_Done) count++;
+	return count;
+}
+
+void AsyncLoader::setListener(AsyncLoadListener listener) {
+	_listener = listener;
+	_listenerObject = NULL;
+}
+
+void AsyncLoader::setListener(AsyncLoadListenerObject *listener) {
+	_listenerObject = listener;
+}
@@ -34,11 +34,18 @@
 #include <spine/Atlas.h>
 #include <spine/TextureLoader.h>
 #include <spine/ContainerUtil.h>
+#include <spine/MathUtil.h>
 
 #include <ctype.h>
+#include <stdio.h>
 
 using namespace spine;
 
+/// Binary atlases start with a zero byte, which a text atlas never has.
+static const unsigned char BINARY_MAGIC[4] = {0, 's', 'p', 'a'};
+
+static const int BINARY_VERSION = 1;
+
 Atlas::Atlas(const String &path, TextureLoader *textureLoader, bool createTexture) : _textureLoader(textureLoader) {
 	int dirLength;
 	char *dir;
@@ -55,12 +62,12 @@ Atlas::Atlas(const String &path, TextureLoader *textureLoader, bool createTextur
 	memcpy(dir, path.buffer(), dirLength);
 	dir[dirLength] = '\0';
 
-	data = SpineExtension::readFile(path, &length);
+	data = SpineExtension::mapFile(path, &length);
 	if (data) {
 		load(data, length, dir, createTexture);
+		SpineExtension::unmapFile(data, length);
 	}
 
-	SpineExtension::free(data, __FILE__, __LINE__);
 	SpineExtension::free(dir, __FILE__, __LINE__);
 }
 
@@ -76,53 +83,88 @@ Atlas::~Atlas() {
 		}
 	}
 	ContainerUtil::cleanUpVectorOfPointers(_pages);
-	ContainerUtil::cleanUpVectorOfPointers(_regions);
 }
 
 void Atlas::flipV() {
 	for (size_t i = 0, n = _regions.size(); i < n; ++i) {
-		AtlasRegion *regionP = _regions[i];
-		AtlasRegion &region = *regionP;
+		AtlasRegion &region = _regions[i];
 		region.v = 1 - region.v;
 		region.v2 = 1 - region.v2;
 	}
 }
 
 AtlasRegion *Atlas::findRegion(const String &name) {
+	if (_regionSlots.size()) {
+		size_t mask = _regionSlots.size() - 1;
+		for (size_t slot = Hash<String>()(name) & mask;; slot = (slot + 1) & mask) {
+			int index = _regionSlots[slot];
+			if (!index) break;
+			if (_regions[index - 1].name == name) return &_regions[index - 1];
+		}
+	}
+
+	// Region names may have been changed since loading.
 	for (size_t i = 0, n = _regions.size(); i < n; ++i)
-		if (_regions[i]->name == name) return _regions[i];
+		if (_regions[i].name == name) return &_regions[i];
 	return NULL;
 }
 
+void Atlas::indexRegions() {
+	size_t slotsCount = 16;
+	while (slotsCount < _regions.size() * 2)
+		slotsCount <<= 1;
+	_regionSlots.clear();
+	_regionSlots.ensureCapacity(slotsCount);
+	_regionSlots.setSize(slotsCount, 0);
+	size_t mask = slotsCount - 1;
+	for (size_t i = 0, n = _regions.size(); i < n; ++i) {
+		// Only the first region with a name is indexed.
+		size_t slot = Hash<String>()(_regions[i].name) & mask;
+		while (_regionSlots[slot] && !(_regions[_regionSlots[slot] - 1].name == _regions[i].name))
+			slot = (slot + 1) & mask;
+		if (!_regionSlots[slot]) _regionSlots[slot] = (int) i + 1;
+	}
+}
+
 Vector<AtlasPage*> &Atlas::getPages() {
 	return _pages;
 }
 
+Vector<AtlasRegion> &Atlas::getRegions() {
+	return _regions;
+}
+
 void Atlas::load(const char *begin, int length, const char *dir, bool createTexture) {
+	if (length >= 4 && memcmp(begin, BINARY_MAGIC, 4) == 0) {
+		loadBinary(begin, length, dir, createTexture);
+		return;
+	}
+
 	static const char *formatNames[] = {"", "Alpha", "Intensity", "LuminanceAlpha", "RGB565", "RGBA4444", "RGB888", "RGBA8888"};
 	static const char *textureFilterNames[] = {"", "Nearest", "Linear", "MipMap", "MipMapNearestNearest", "MipMapLinearNearest",
 		"MipMapNearestLinear", "MipMapLinearLinear"};
 
 	int count;
 	const char *end = begin + length;
-	int dirLength = (int) strlen(dir);
-	int needsSlash = dirLength > 0 && dir[dirLength - 1] != '/' && dir[dirLength - 1] != '\\';
 
 	AtlasPage *page = NULL;
 	Str str;
 	Str tuple[4];
 
+	/* Page and region names and blank lines are the only lines without a colon, so regions are stored without growing. */
+	count = 0;
+	for (const char *lineStart = begin, *lineEnd; lineStart < end; lineStart = lineEnd + 1) {
+		lineEnd = (const char *) memchr(lineStart, '\n', end - lineStart);
+		if (!lineEnd) lineEnd = end;
+		if (!memchr(lineStart, ':', lineEnd - lineStart)) count++;
+	}
+	_regions.ensureCapacity(count);
+
 	while (readLine(&begin, end, &str)) {
 		if (str.end - str.begin == 0) {
 			page = 0;
 		} else if (!page) {
-			char *name = mallocString(&str);
-			char *path = SpineExtension::calloc<char>(dirLength + needsSlash + strlen(name) + 1, __FILE__, __LINE__);
-			memcpy(path, dir, dirLength);
-			if (needsSlash) path[dirLength] = '/';
-			strcpy(path + dirLength + needsSlash, name);
-
-			page = new(__FILE__, __LINE__) AtlasPage(String(name, true));
+			page = new(__FILE__, __LINE__) AtlasPage(String(mallocString(&str), true));
 
 			int tupleVal = readTuple(&begin, end, tuple);
 			assert(tupleVal == 2);
@@ -155,17 +197,9 @@ void Atlas::load(const char *begin, int length, const char *dir, bool createText
 				}
 			}
 
-			if (createTexture) {
-				if (_textureLoader) _textureLoader->load(*page, String(path));
-				SpineExtension::free(path, __FILE__, __LINE__);
-			} else
-				page->texturePath = String(path, true);
-
-			_pages.add(page);
+			addPage(page, dir, createTexture);
 		} else {
-			AtlasRegion *region = new(__FILE__, __LINE__) AtlasRegion();
-
-			region->page = page;
+			AtlasRegion *region = &addRegion(page);
 			region->name = String(mallocString(&str), true);
 
 			readValue(&begin, end, &str);
@@ -182,15 +216,7 @@ void Atlas::load(const char *begin, int length, const char *dir, bool createText
 			region->width = toInt(tuple);
 			region->height = toInt(tuple + 1);
 
-			region->u = region->x / (float) page->width;
-			region->v = region->y / (float) page->height;
-			if (region->rotate) {
-				region->u2 = (region->x + region->height) / (float) page->width;
-				region->v2 = (region->y + region->width) / (float) page->height;
-			} else {
-				region->u2 = (region->x + region->width) / (float) page->width;
-				region->v2 = (region->y + region->height) / (float) page->height;
-			}
+			setUVs(*region);
 
 			count = readTuple(&begin, end, tuple);
 			assert(count);
@@ -228,24 +254,244 @@ void Atlas::load(const char *begin, int length, const char *dir, bool createText
 			readValue(&begin, end, &str);
 
 			region->index = toInt(&str);
+		}
+	}
+	indexRegions();
+}
+
+void Atlas::addPage(AtlasPage *page, const char *dir, bool createTexture) {
+	int dirLength = (int) strlen(dir);
+	int needsSlash = dirLength > 0 && dir[dirLength - 1] != '/' && dir[dirLength - 1] != '\\';
+	int nameLength = (int) page->name.length();
+	char *path = SpineExtension::calloc<char>(dirLength + needsSlash + nameLength + 1, __FILE__, __LINE__);
+	memcpy(path, dir, dirLength);
+	if (needsSlash) path[dirLength] = '/';
+	memcpy(path + dirLength + needsSlash, page->name.buffer(), nameLength + 1);
+
+	if (createTexture) {
+		if (_textureLoader) _textureLoader->load(*page, String(path));
+		SpineExtension::free(path, __FILE__, __LINE__);
+	} else
+		page->texturePath = String(path, true);
+
+	_pages.add(page);
+}
+
+AtlasRegion &Atlas::addRegion(AtlasPage *page) {
+	_regions.setSize(_regions.size() + 1, AtlasRegion());
+	AtlasRegion &region = _regions[_regions.size() - 1];
+	region.page = page;
+	return region;
+}
+
+void Atlas::setUVs(AtlasRegion &region) {
+	AtlasPage *page = region.page;
+	region.u = region.x / (float) page->width;
+	region.v = region.y / (float) page->height;
+	if (region.rotate) {
+		region.u2 = (region.x + region.height) / (float) page->width;
+		region.v2 = (region.y + region.width) / (float) page->height;
+	} else {
+		region.u2 = (region.x + region.width) / (float) page->width;
+		region.v2 = (region.y + region.height) / (float) page->height;
+	}
+}
 
-			_regions.add(region);
+bool Atlas::loadBinary(const char *begin, int length, const char *dir, bool createTexture) {
+	BinaryInput input;
+	input.cursor = (const unsigned char *) begin + 4;
+	input.end = (const unsigned char *) begin + length;
+	input.overflow = false;
+	if (readVarint(&input, true) != BINARY_VERSION) return false;
+
+	/* All names, each terminated by a zero byte. Names are offsets into them. */
+	int namesLength = readVarint(&input, true);
+	if (namesLength <= 0 || namesLength > input.end - input.cursor || input.cursor[namesLength - 1] != 0) return false;
+	const char *names = (const char *) input.cursor;
+	input.cursor += namesLength;
+
+	Vector<AtlasPage *> pages;
+	int pagesCount = readVarint(&input, true);
+	for (int i = 0; i < pagesCount && !input.overflow; ++i) {
+		int nameOffset = readVarint(&input, true);
+		if (nameOffset < 0 || nameOffset >= namesLength) break;
+		AtlasPage *page = new(__FILE__, __LINE__) AtlasPage(String(names + nameOffset));
+		pages.add(page);
+		page->width = readVarint(&input, true);
+		page->height = readVarint(&input, true);
+		page->format = (Format) readByte(&input);
+		page->minFilter = (TextureFilter) readByte(&input);
+		page->magFilter = (TextureFilter) readByte(&input);
+		page->uWrap = (TextureWrap) readByte(&input);
+		page->vWrap = (TextureWrap) readByte(&input);
+
+		int regionsCount = readVarint(&input, true);
+		if (regionsCount < 0 || regionsCount > input.end - input.cursor) break;
+		_regions.ensureCapacity(_regions.size() + regionsCount);
+		for (int ii = 0; ii < regionsCount; ++ii) {
+			nameOffset = readVarint(&input, true);
+			if (nameOffset < 0 || nameOffset >= namesLength) {
+				input.overflow = true;
+				break;
+			}
+			AtlasRegion &region = addRegion(page);
+			region.name = String(names + nameOffset);
+			region.x = readVarint(&input, true);
+			region.y = readVarint(&input, true);
+			region.width = readVarint(&input, true);
+			region.height = readVarint(&input, true);
+			region.degrees = readVarint(&input, true);
+			region.rotate = region.degrees == 90;
+			region.originalWidth = readVarint(&input, true);
+			region.originalHeight = readVarint(&input, true);
+			region.offsetX = (float) readVarint(&input, false);
+			region.offsetY = (float) readVarint(&input, false);
+			region.index = readVarint(&input, false);
+			setUVs(region);
+
+			/* 0: no splits, 1: splits, 2: splits and pads. */
+			unsigned char ninePatch = readByte(&input);
+			if (ninePatch > 0) {
+				region.splits.setSize(4, 0);
+				for (int iii = 0; iii < 4; ++iii)
+					region.splits[iii] = readVarint(&input, false);
+			}
+			if (ninePatch > 1) {
+				region.pads.setSize(4, 0);
+				for (int iii = 0; iii < 4; ++iii)
+					region.pads[iii] = readVarint(&input, false);
+			}
 		}
 	}
+
+	if (input.overflow || (int) pages.size() != pagesCount || input.cursor != input.end) {
+		ContainerUtil::cleanUpVectorOfPointers(pages);
+		_regions.clear();
+		return false;
+	}
+	for (size_t i = 0; i < pages.size(); ++i)
+		addPage(pages[i], dir, createTexture);
+	indexRegions();
+	return true;
 }
 
-void Atlas::trim(Str *str) {
-	while (isspace((unsigned char) *str->begin) && str->begin < str->end)
-		(str->begin)++;
+unsigned char Atlas::readByte(BinaryInput *input) {
+	if (input->cursor == input->end) {
+		input->overflow = true;
+		return 0;
+	}
+	return *input->cursor++;
+}
+
+int Atlas::readVarint(BinaryInput *input, bool optimizePositive) {
+	unsigned char b = readByte(input);
+	int value = b & 0x7F;
+	if (b & 0x80) {
+		b = readByte(input);
+		value |= (b & 0x7F) << 7;
+		if (b & 0x80) {
+			b = readByte(input);
+			value |= (b & 0x7F) << 14;
+			if (b & 0x80) {
+				b = readByte(input);
+				value |= (b & 0x7F) << 21;
+				if (b & 0x80) value |= (readByte(input) & 0x7F) << 28;
+			}
+		}
+	}
+	if (!optimizePositive) value = (((unsigned int) value >> 1) ^ -(value & 1));
+	return value;
+}
+
+void Atlas::writeVarint(Vector<unsigned char> &output, int value, bool optimizePositive) {
+	unsigned int bits = optimizePositive ? (unsigned int) value : ((unsigned int) value << 1) ^ (unsigned int) (value >> 31);
+	while (bits > 0x7F) {
+		output.add((unsigned char) ((bits & 0x7F) | 0x80));
+		bits >>= 7;
+	}
+	output.add((unsigned char) bits);
+}
 
-	if (str->begin == str->end) return;
+void Atlas::writeBinary(Vector<unsigned char> &output) {
+	Vector<unsigned char> names;
+	HashMap<String, int> nameOffsets;
+	Vector<int> pageNames, regionNames;
+	for (size_t i = 0, n = _pages.size() + _regions.size(); i < n; ++i) {
+		const String &name = i < _pages.size() ? _pages[i]->name : _regions[i - _pages.size()].name;
+		int *offset = nameOffsets.get(name);
+		if (!offset) {
+			nameOffsets.put(name, (int) names.size());
+			offset = nameOffsets.get(name);
+			for (size_t ii = 0; ii < name.length(); ++ii)
+				names.add((unsigned char) name.buffer()[ii]);
+			names.add(0);
+		}
+		(i < _pages.size() ? pageNames : regionNames).add(*offset);
+	}
 
-	str->end--;
+	output.clear();
+	for (int i = 0; i < 4; ++i)
+		output.add(BINARY_MAGIC[i]);
+	writeVarint(output, BINARY_VERSION, true);
+	writeVarint(output, (int) names.size(), true);
+	output.addAll(names);
+	writeVarint(output, (int) _pages.size(), true);
+	for (size_t i = 0; i < _pages.size(); ++i) {
+		AtlasPage *page = _pages[i];
+		writeVarint(output, pageNames[i], true);
+		writeVarint(output, page->width, true);
+		writeVarint(output, page->height, true);
+		output.add((unsigned char) page->format);
+		output.add((unsigned char) page->minFilter);
+		output.add((unsigned char) page->magFilter);
+		output.add((unsigned char) page->uWrap);
+		output.add((unsigned char) page->vWrap);
+
+		int regionsCount = 0;
+		for (size_t ii = 0; ii < _regions.size(); ++ii)
+			if (_regions[ii].page == page) regionsCount++;
+		writeVarint(output, regionsCount, true);
+		for (size_t ii = 0; ii < _regions.size(); ++ii) {
+			AtlasRegion &region = _regions[ii];
+			if (region.page != page) continue;
+			writeVarint(output, regionNames[ii], true);
+			writeVarint(output, region.x, true);
+			writeVarint(output, region.y, true);
+			writeVarint(output, region.width, true);
+			writeVarint(output, region.height, true);
+			writeVarint(output, region.degrees, true);
+			writeVarint(output, region.originalWidth, true);
+			writeVarint(output, region.originalHeight, true);
+			writeVarint(output, (int) region.offsetX, false);
+			writeVarint(output, (int) region.offsetY, false);
+			writeVarint(output, region.index, false);
+			unsigned char ninePatch = region.splits.size() == 4 ? (region.pads.size() == 4 ? 2 : 1) : 0;
+			output.add(ninePatch);
+			for (int iii = 0; ninePatch > 0 && iii < 4; ++iii)
+				writeVarint(output, region.splits[iii], false);
+			for (int iii = 0; ninePatch > 1 && iii < 4; ++iii)
+				writeVarint(output, region.pads[iii], false);
+		}
+	}
+}
 
-	while (((unsigned char)*str->end == '\r') && str->end >= str->begin)
-		str->end--;
+bool Atlas::writeBinaryFile(const String &path) {
+	Vector<unsigned char> output;
+	writeBinary(output);
+	FILE *file = fopen(path.buffer(), "wb");
+	if (!file) return false;
+	bool written = fwrite(output.buffer(), 1, output.size(), file) == output.size();
+	if (fclose(file) != 0) written = false;
+	return written;
+}
+
+void Atlas::trim(Str *str) {
+	// The data may be a mapped file that is not NUL terminated, so nothing at or past end is read.
+	while (str->begin < str->end && isspace((unsigned char) *str->begin))
+		(str->begin)++;
 
-	str->end++;
+	while (str->end > str->begin && str->end[-1] == '\r')
+		str->end--;
 }
 
 int Atlas::readLine(const char **begin, const char *end, Str *str) {
@@ -266,15 +512,13 @@ int Atlas::readLine(const char **begin, const char *end, Str *str) {
 }
 
 int Atlas::beginPast(Str *str, char c) {
-	const char *begin = str->begin;
-	while (true) {
-		char lastSkippedChar = *begin;
-		if (begin == str->end) return 0;
-		begin++;
-		if (lastSkippedChar == c) break;
+	for (const char *begin = str->begin; begin != str->end;) {
+		if (*begin++ == c) {
+			str->begin = begin;
+			return 1;
+		}
 	}
-	str->begin = begin;
-	return 1;
+	return 0;
 }
 
 int Atlas::readValue(const char **begin, const char *end, Str *str) {
@@ -293,7 +537,7 @@ int Atlas::readTuple(const char **begin, const char *end, Str tuple[]) {
 	for (i = 0; i < 3; ++i) {
 		tuple[i].begin = str.begin;
 		if (!beginPast(&str, ',')) break;
-		tuple[i].end = str.begin - 2;
+		tuple[i].end = str.begin - 1;
 		trim(&tuple[i]);
 	}
 
@@ -325,5 +569,10 @@ int Atlas::equals(Str *str, const char *other) {
 }
 
 int Atlas::toInt(Str *str) {
-	return (int) strtol(str->begin, (char **) &str->end, 10);
+	// The data is not null terminated, e.g. when memory mapped, so strtol must not read past the value.
+	char buffer[32];
+	size_t length = MathUtil::min((size_t) (str->end - str->begin), sizeof(buffer) - 1);
+	memcpy(buffer, str->begin, length);
+	buffer[length] = '\0';
+	return (int) strtol(buffer, NULL, 10);
 }
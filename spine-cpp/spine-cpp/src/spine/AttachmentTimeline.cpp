@@ -38,6 +38,7 @@
 
 #include <spine/Animation.h>
 #include <spine/Bone.h>
+#include <spine/Pose.h>
 #include <spine/TimelineType.h>
 #include <spine/Slot.h>
 #include <spine/SlotData.h>
@@ -100,6 +101,20 @@ void AttachmentTimeline::apply(Skeleton &skeleton, float lastTime, float time, V
 	slot.setAttachment(attachmentName->length() == 0 ? NULL : skeleton.getAttachment(_slotIndex, *attachmentName));
 }
 
+void AttachmentTimeline::sample(Pose &pose, float time) {
+	if (time < _frames[0]) return;
+
+	size_t frameIndex;
+	if (time >= _frames[_frames.size() - 1]) {
+		// Time is after last frame.
+		frameIndex = _frames.size() - 1;
+	} else {
+		frameIndex = Animation::binarySearch(_frames, time, 1) - 1;
+	}
+
+	pose.setAttachment(_slotIndex, pose.findAttachment(_slotIndex, _attachmentNames[frameIndex]));
+}
+
 int AttachmentTimeline::getPropertyId() {
 	return ((int) TimelineType_Attachment << 24) + _slotIndex;
 }
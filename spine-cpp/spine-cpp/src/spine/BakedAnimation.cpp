@@ -0,0 +1,300 @@
+/******************************************************************************
+ * Spine Runtimes License Agreement
+ * Last updated January 1, 2020. Replaces all prior versions.
+ *
+ * Copyright (c) 2013-2020, Esoteric Software LLC
+ *
+ * Integration of the Spine Runtimes into software or otherwise creating
+ * derivative works of the Spine Runtimes is permitted under the terms and
+ * conditions of Section 2 of the Spine Editor License Agreement:
+ * http://esotericsoftware.com/spine-editor-license
+ *
+ * Otherwise, it is permitted to integrate the Spine Runtimes into software
+ * or otherwise create derivative works of the Spine Runtimes (collectively,
+ * "Products"), provided that each user of the Products must obtain their own
+ * Spine Editor license and redistribution of the Products in any form must
+ * include this license and copyright notice.
+ *
+ * THE SPINE RUNTIMES ARE PROVIDED BY ESOTERIC SOFTWARE LLC "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL ESOTERIC SOFTWARE LLC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES,
+ * BUSINESS INTERRUPTION, OR LOSS OF USE, DATA, OR PROFITS) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THE SPINE RUNTIMES, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+#ifdef SPINE_UE4
+#include "SpinePluginPrivatePCH.h"
+#endif
+
+#include <spine/BakedAnimation.h>
+
+#include <spine/Animation.h>
+#include <spine/Bone.h>
+#include <spine/DrawOrderTimeline.h>
+#include <spine/MathUtil.h>
+#include <spine/Skeleton.h>
+#include <spine/SkeletonData.h>
+#include <spine/Slot.h>
+#include <spine/SlotData.h>
+
+using namespace spine;
+
+static int computeFrameCount(float duration, float sampleRate) {
+	float intervals = duration * sampleRate;
+	int frameCount = (int) intervals;
+	if (frameCount < intervals) frameCount++;
+	return MathUtil::max(frameCount + 1, 2);
+}
+
+BakedAnimation::BakedAnimation(SkeletonData &skeletonData, Animation &animation, float sampleRate, bool quantize,
+	size_t memoryBudget, Skin *skin
+) : _skeletonData(skeletonData),
+	_animation(animation),
+	_sampleRate(sampleRate),
+	_frameCount(0),
+	_quantize(quantize),
+	_drawOrder(false),
+	_maxError(0),
+	_boneCount(skeletonData.getBones().size()),
+	_slotCount(skeletonData.getSlots().size()) {
+	assert(sampleRate > 0);
+
+	Vector<Timeline *> &timelines = animation.getTimelines();
+	for (size_t i = 0; i < timelines.size(); i++)
+		if (timelines[i]->getRTTI().isExactly(DrawOrderTimeline::rtti)) _drawOrder = true;
+
+	if (memoryBudget > 0) {
+		float duration = animation.getDuration();
+		int frameCount = computeFrameCount(duration, _sampleRate);
+		while (frameCount > 2) {
+			size_t size = computeMemorySize(frameCount);
+			if (size <= memoryBudget) break;
+			_sampleRate *= MathUtil::min((float) memoryBudget / size, 0.95f);
+			frameCount = computeFrameCount(duration, _sampleRate);
+		}
+	}
+
+	bake(skin);
+	measureError(skin);
+}
+
+BakedAnimation::~BakedAnimation() {
+}
+
+void BakedAnimation::apply(Skeleton &skeleton, float time, bool loop) {
+	float duration = _animation.getDuration();
+	if (loop && duration != 0) time = MathUtil::fmod(time, duration);
+	time = MathUtil::clamp(time, 0, duration);
+
+	int frame = MathUtil::min((int) (time * _sampleRate), _frameCount - 2);
+	float frameTime = frame / _sampleRate, nextTime = MathUtil::min((frame + 1) / _sampleRate, duration);
+	float alpha = nextTime > frameTime ? MathUtil::clamp((time - frameTime) / (nextTime - frameTime), 0, 1) : 0;
+
+	Vector<Bone *> &bones = skeleton.getBones();
+	for (size_t i = 0; i < _boneCount; i++) {
+		Bone *bone = bones[i];
+		if (!bone->isActive()) continue;
+		float values[TRANSFORM_ENTRIES];
+		for (int ii = 0; ii < TRANSFORM_ENTRIES; ii++) {
+			size_t index = i * TRANSFORM_ENTRIES + ii;
+			float value = getTransform(frame, index);
+			values[ii] = value + (getTransform(frame + 1, index) - value) * alpha;
+		}
+		bone->updateWorldTransform(values[0], values[1], values[2], values[3], values[4], values[5], values[6]);
+	}
+
+	// Attachments and draw order are stepped, colors are interpolated.
+	int stepFrame = alpha >= 1 ? frame + 1 : frame;
+	Vector<Slot *> &slots = skeleton.getSlots();
+	for (size_t i = 0; i < _slotCount; i++) {
+		Slot *slot = slots[i];
+		Attachment *attachment = _attachments[_slotAttachments[stepFrame * _slotCount + i]];
+		if (slot->getAttachment() != attachment) slot->setAttachment(attachment);
+
+		float color[4];
+		for (int ii = 0; ii < 4; ii++) {
+			size_t index = i * 4 + ii;
+			float value = getColor(frame, index);
+			color[ii] = value + (getColor(frame + 1, index) - value) * alpha;
+		}
+		slot->getColor().set(color[0], color[1], color[2], color[3]);
+	}
+	if (_drawOrder) {
+		Vector<Slot *> &drawOrder = skeleton.getDrawOrder();
+		for (size_t i = 0; i < _slotCount; i++)
+			drawOrder[i] = slots[_drawOrders[stepFrame * _slotCount + i]];
+	}
+}
+
+Animation &BakedAnimation::getAnimation() {
+	return _animation;
+}
+
+float BakedAnimation::getSampleRate() {
+	return _sampleRate;
+}
+
+int BakedAnimation::getFrameCount() {
+	return _frameCount;
+}
+
+bool BakedAnimation::isQuantized() {
+	return _quantize;
+}
+
+size_t BakedAnimation::getMemorySize() {
+	return _transforms.size() * sizeof(float) + _quantizedTransforms.size() * sizeof(unsigned short) +
+		_transformRanges.size() * sizeof(float) + _attachments.size() * sizeof(Attachment *) +
+		_slotAttachments.size() * sizeof(unsigned short) + _colors.size() * sizeof(float) +
+		_quantizedColors.size() + _drawOrders.size() * sizeof(unsigned short);
+}
+
+float BakedAnimation::getMaxError() {
+	return _maxError;
+}
+
+void BakedAnimation::bake(Skin *skin) {
+	float duration = _animation.getDuration();
+	_frameCount = computeFrameCount(duration, _sampleRate);
+
+	Skeleton skeleton(&_skeletonData);
+	skeleton.setSkin(skin);
+
+	Vector<float> transforms;
+	transforms.setSize(_frameCount * _boneCount * TRANSFORM_ENTRIES, 0);
+	_colors.setSize(_frameCount * _slotCount * 4, 0);
+	_slotAttachments.setSize(_frameCount * _slotCount, 0);
+	if (_drawOrder) _drawOrders.setSize(_frameCount * _slotCount, 0);
+	_attachments.add(NULL);
+
+	for (int frame = 0; frame < _frameCount; frame++) {
+		float time = MathUtil::min(frame / _sampleRate, duration);
+		skeleton.setToSetupPose();
+		_animation.apply(skeleton, time, time, false, NULL, 1, MixBlend_Setup, MixDirection_In);
+		skeleton.updateWorldTransform();
+
+		Vector<Bone *> &bones = skeleton.getBones();
+		for (size_t i = 0; i < _boneCount; i++) {
+			Bone *bone = bones[i];
+			if (!bone->_appliedValid) bone->updateAppliedTransform();
+			float *values = &transforms[(frame * _boneCount + i) * TRANSFORM_ENTRIES];
+			values[0] = bone->_ax;
+			values[1] = bone->_ay;
+			values[2] = bone->_arotation;
+			values[3] = bone->_ascaleX;
+			values[4] = bone->_ascaleY;
+			values[5] = bone->_ashearX;
+			values[6] = bone->_ashearY;
+			if (frame > 0) {
+				// Keep angles continuous so interpolating between samples takes the shortest path.
+				float *previous = values - _boneCount * TRANSFORM_ENTRIES;
+				for (int ii = 2; ii < TRANSFORM_ENTRIES; ii += ii == 2 ? 3 : 1) {
+					while (values[ii] - previous[ii] > 180) values[ii] -= 360;
+					while (values[ii] - previous[ii] < -180) values[ii] += 360;
+				}
+			}
+		}
+
+		Vector<Slot *> &slots = skeleton.getSlots();
+		for (size_t i = 0; i < _slotCount; i++) {
+			Slot *slot = slots[i];
+			int index = _attachments.indexOf(slot->getAttachment());
+			if (index == -1) {
+				index = (int) _attachments.size();
+				_attachments.add(slot->getAttachment());
+			}
+			_slotAttachments[frame * _slotCount + i] = (unsigned short) index;
+
+			Color &color = slot->getColor();
+			float *colors = &_colors[(frame * _slotCount + i) * 4];
+			colors[0] = color.r;
+			colors[1] = color.g;
+			colors[2] = color.b;
+			colors[3] = color.a;
+		}
+		if (_drawOrder) {
+			Vector<Slot *> &drawOrder = skeleton.getDrawOrder();
+			for (size_t i = 0; i < _slotCount; i++)
+				_drawOrders[frame * _slotCount + i] = (unsigned short) drawOrder[i]->getData().getIndex();
+		}
+	}
+
+	if (!_quantize) {
+		_transforms.clearAndAddAll(transforms);
+		return;
+	}
+
+	// Store each bone transform value as a fraction of its range.
+	size_t valueCount = _boneCount * TRANSFORM_ENTRIES;
+	_transformRanges.setSize(valueCount * 2, 0);
+	_quantizedTransforms.setSize(transforms.size(), 0);
+	for (size_t i = 0; i < valueCount; i++) {
+		float min = transforms[i], max = transforms[i];
+		for (int frame = 1; frame < _frameCount; frame++) {
+			float value = transforms[frame * valueCount + i];
+			min = MathUtil::min(min, value);
+			max = MathUtil::max(max, value);
+		}
+		float step = (max - min) / 65535;
+		_transformRanges[i * 2] = min;
+		_transformRanges[i * 2 + 1] = step;
+		for (int frame = 0; frame < _frameCount; frame++) {
+			size_t index = frame * valueCount + i;
+			_quantizedTransforms[index] = step > 0 ? (unsigned short) ((transforms[index] - min) / step + 0.5f) : 0;
+		}
+	}
+	_quantizedColors.setSize(_colors.size(), 0);
+	for (size_t i = 0; i < _colors.size(); i++)
+		_quantizedColors[i] = (unsigned char) (MathUtil::clamp(_colors[i], 0, 1) * 255 + 0.5f);
+	_colors.clear();
+}
+
+void BakedAnimation::measureError(Skin *skin) {
+	float duration = _animation.getDuration();
+	Skeleton live(&_skeletonData), baked(&_skeletonData);
+	live.setSkin(skin);
+	baked.setSkin(skin);
+
+	_maxError = 0;
+	for (int frame = 0; frame < _frameCount - 1; frame++) {
+		float time = (MathUtil::min(frame / _sampleRate, duration) + MathUtil::min((frame + 1) / _sampleRate, duration)) / 2;
+		live.setToSetupPose();
+		_animation.apply(live, time, time, false, NULL, 1, MixBlend_Setup, MixDirection_In);
+		live.updateWorldTransform();
+		apply(baked, time, false);
+
+		for (size_t i = 0; i < _boneCount; i++) {
+			Bone *liveBone = live.getBones()[i], *bakedBone = baked.getBones()[i];
+			if (!liveBone->isActive()) continue;
+			float x = liveBone->getWorldX() - bakedBone->getWorldX(), y = liveBone->getWorldY() - bakedBone->getWorldY();
+			_maxError = MathUtil::max(_maxError, MathUtil::sqrt(x * x + y * y));
+		}
+	}
+}
+
+size_t BakedAnimation::computeMemorySize(int frameCount) {
+	size_t transformSize = _quantize ? sizeof(unsigned short) : sizeof(float);
+	size_t colorSize = _quantize ? 1 : sizeof(float);
+	size_t size = frameCount * _boneCount * TRANSFORM_ENTRIES * transformSize;
+	if (_quantize) size += _boneCount * TRANSFORM_ENTRIES * 2 * sizeof(float);
+	size += frameCount * _slotCount * (sizeof(unsigned short) + 4 * colorSize);
+	if (_drawOrder) size += frameCount * _slotCount * sizeof(unsigned short);
+	return size;
+}
+
+float BakedAnimation::getTransform(int frame, size_t index) {
+	size_t i = frame * _boneCount * TRANSFORM_ENTRIES + index;
+	if (_quantize) return _transformRanges[index * 2] + _quantizedTransforms[i] * _transformRanges[index * 2 + 1];
+	return _transforms[i];
+}
+
+float BakedAnimation::getColor(int frame, size_t index) {
+	size_t i = frame * _slotCount * 4 + index;
+	if (_quantize) return _quantizedColors[i] / 255.0f;
+	return _colors[i];
+}
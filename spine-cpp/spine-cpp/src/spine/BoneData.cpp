@@ -50,7 +50,8 @@ BoneData::BoneData(int index, const String &name, BoneData *parent) :
 		_shearX(0),
 		_shearY(0),
 		_transformMode(TransformMode_Normal),
-		_skinRequired(false) {
+		_skinRequired(false),
+		_lowImportance(false) {
 	assert(index >= 0);
 	assert(_name.length() > 0);
 }
@@ -146,3 +147,11 @@ bool BoneData::isSkinRequired() {
 void BoneData::setSkinRequired(bool inValue) {
 	_skinRequired = inValue;
 }
+
+bool BoneData::isLowImportance() {
+	return _lowImportance;
+}
+
+void BoneData::setLowImportance(bool inValue) {
+	_lowImportance = inValue;
+}
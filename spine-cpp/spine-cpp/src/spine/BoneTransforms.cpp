@@ -0,0 +1,372 @@
+/******************************************************************************
+ * Spine Runtimes License Agreement
+ * Last updated January 1, 2020. Replaces all prior versions.
+ *
+ * Copyright (c) 2013-2020, Esoteric Software LLC
+ *
+ * Integration of the Spine Runtimes into software or otherwise creating
+ * derivative works of the Spine Runtimes is permitted under the terms and
+ * conditions of Section 2 of the Spine Editor License Agreement:
+ * http://esotericsoftware.com/spine-editor-license
+ *
+ * Otherwise, it is permitted to integrate the Spine Runtimes into software
+ * or otherwise create derivative works of the Spine Runtimes (collectively,
+ * "Products"), provided that each user of the Products must obtain their own
+ * Spine Editor license and redistribution of the Products in any form must
+ * include this license and copyright notice.
+ *
+ * THE SPINE RUNTIMES ARE PROVIDED BY ESOTERIC SOFTWARE LLC "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL ESOTERIC SOFTWARE LLC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES,
+ * BUSINESS INTERRUPTION, OR LOSS OF USE, DATA, OR PROFITS) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THE SPINE RUNTIMES, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+#ifdef SPINE_UE4
+#include "SpinePluginPrivatePCH.h"
+#endif
+
+#include <spine/BoneTransforms.h>
+
+#include <spine/Skeleton.h>
+#include <spine/Bone.h>
+#include <spine/BoneData.h>
+#include <spine/IkConstraint.h>
+#include <spine/TransformConstraint.h>
+#include <spine/PathConstraint.h>
+#include <spine/TransformMode.h>
+#include <spine/MathUtil.h>
+
+using namespace spine;
+
+static inline bool sameBits(float a, float b) {
+	return memcmp(&a, &b, sizeof(float)) == 0;
+}
+
+BoneTransforms::BoneTransforms(Skeleton &skeleton) : _skeleton(skeleton) {
+	updateCache();
+}
+
+BoneTransforms::~BoneTransforms() {
+}
+
+void BoneTransforms::updateCache() {
+	Vector<Bone *> &bones = _skeleton._bones;
+	size_t n = bones.size();
+
+	_parents.setSize(n, -1);
+	_transformModes.setSize(n, TransformMode_Normal);
+	_x.setSize(n, 0);
+	_y.setSize(n, 0);
+	_rotation.setSize(n, 0);
+	_scaleX.setSize(n, 0);
+	_scaleY.setSize(n, 0);
+	_shearX.setSize(n, 0);
+	_shearY.setSize(n, 0);
+	_ax.setSize(n, 0);
+	_ay.setSize(n, 0);
+	_arotation.setSize(n, 0);
+	_ascaleX.setSize(n, 0);
+	_ascaleY.setSize(n, 0);
+	_ashearX.setSize(n, 0);
+	_ashearY.setSize(n, 0);
+	_a.setSize(n, 1);
+	_b.setSize(n, 0);
+	_c.setSize(n, 0);
+	_d.setSize(n, 1);
+	_worldX.setSize(n, 0);
+	_worldY.setSize(n, 0);
+	_la.setSize(n, 0);
+	_lb.setSize(n, 0);
+	_lc.setSize(n, 0);
+	_ld.setSize(n, 0);
+	_cacheRotation.setSize(n, 0);
+	_cacheScaleX.setSize(n, 0);
+	_cacheScaleY.setSize(n, 0);
+	_cacheShearX.setSize(n, 0);
+	_cacheShearY.setSize(n, 0);
+	_cacheValid.setSize(n, false);
+
+	for (size_t i = 0; i < n; ++i) {
+		Bone *bone = bones[i];
+		_parents[i] = bone->_parent == NULL ? -1 : bone->_parent->_data.getIndex();
+		_transformModes[i] = bone->_data.getTransformMode();
+		_cacheValid[i] = false;
+		readWorld((int) i);
+	}
+
+	_program.clear();
+	_constraints.clear();
+	_constraintBones.clear();
+	_constraintBonesStart.clear();
+
+	Vector<Updatable *> &updateCache = _skeleton._updateCache;
+	for (size_t i = 0, nn = updateCache.size(); i < nn; ++i) {
+		Updatable *updatable = updateCache[i];
+		if (updatable->getRTTI().isExactly(Bone::rtti)) {
+			_program.add(static_cast<Bone *>(updatable)->_data.getIndex());
+			continue;
+		}
+
+		_program.add(-(int) _constraints.size() - 1);
+		_constraints.add(updatable);
+		_constraintBonesStart.add((int) _constraintBones.size());
+
+		Vector<Bone *> *constrained = NULL;
+		if (updatable->getRTTI().isExactly(IkConstraint::rtti))
+			constrained = &static_cast<IkConstraint *>(updatable)->getBones();
+		else if (updatable->getRTTI().isExactly(TransformConstraint::rtti))
+			constrained = &static_cast<TransformConstraint *>(updatable)->getBones();
+		else if (updatable->getRTTI().isExactly(PathConstraint::rtti))
+			constrained = &static_cast<PathConstraint *>(updatable)->getBones();
+
+		if (constrained) {
+			for (size_t ii = 0, nnn = constrained->size(); ii < nnn; ++ii)
+				_constraintBones.add((*constrained)[ii]->_data.getIndex());
+		} else {
+			// Unknown updatable, any bone may have been changed.
+			for (size_t ii = 0; ii < n; ++ii)
+				_constraintBones.add((int) ii);
+		}
+	}
+	_constraintBonesStart.add((int) _constraintBones.size());
+}
+
+void BoneTransforms::updateWorldTransform() {
+	Vector<Bone *> &resetBones = _skeleton._updateCacheReset;
+	for (size_t i = 0, n = resetBones.size(); i < n; ++i) {
+		Bone &bone = *resetBones[i];
+		bone._ax = bone._x;
+		bone._ay = bone._y;
+		bone._arotation = bone._rotation;
+		bone._ascaleX = bone._scaleX;
+		bone._ascaleY = bone._scaleY;
+		bone._ashearX = bone._shearX;
+		bone._ashearY = bone._shearY;
+		bone._appliedValid = true;
+	}
+
+	for (int i = 0, n = (int) _skeleton._bones.size(); i < n; ++i)
+		readLocal(i);
+
+	float sx = _skeleton.getScaleX(), sy = _skeleton.getScaleY();
+	bool lod = _skeleton._lodLevel.constraintThreshold > 0;
+	int *program = _program.buffer();
+	size_t written = 0;
+	for (size_t p = 0, n = _program.size(); p < n; ++p) {
+		int op = program[p];
+		if (op >= 0) {
+			updateBone(op, sx, sy);
+			continue;
+		}
+
+		int constraint = -op - 1;
+		if (lod && _skeleton.isLodSkipped(*_constraints[constraint])) continue;
+
+		// Constraints read and write Bone objects, so bring them up to date first.
+		for (; written < p; ++written)
+			if (program[written] >= 0) writeBone(program[written]);
+		written = p + 1;
+
+		_constraints[constraint]->update();
+		for (int i = _constraintBonesStart[constraint], nn = _constraintBonesStart[constraint + 1]; i < nn; ++i)
+			readWorld(_constraintBones[i]);
+	}
+	for (size_t n = _program.size(); written < n; ++written)
+		if (program[written] >= 0) writeBone(program[written]);
+}
+
+void BoneTransforms::updateBone(int i, float sx, float sy) {
+	float x = _x[i], y = _y[i], rotation = _rotation[i], scaleX = _scaleX[i], scaleY = _scaleY[i];
+	float shearX = _shearX[i], shearY = _shearY[i];
+	int parent = _parents[i];
+
+	_ax[i] = x;
+	_ay[i] = y;
+	_arotation[i] = rotation;
+	_ascaleX[i] = scaleX;
+	_ascaleY[i] = scaleY;
+	_ashearX[i] = shearX;
+	_ashearY[i] = shearY;
+
+	int mode = parent == -1 ? (int) TransformMode_Normal : _transformModes[i];
+	float la = 0, lb = 0, lc = 0, ld = 0;
+	if (mode == TransformMode_Normal || mode == TransformMode_OnlyTranslation) {
+		if (_cacheValid[i] && sameBits(_cacheRotation[i], rotation) && sameBits(_cacheShearX[i], shearX) &&
+			sameBits(_cacheShearY[i], shearY) && sameBits(_cacheScaleX[i], scaleX) && sameBits(_cacheScaleY[i], scaleY)) {
+			la = _la[i];
+			lb = _lb[i];
+			lc = _lc[i];
+			ld = _ld[i];
+		} else {
+			float rotationY = rotation + 90 + shearY;
+			la = MathUtil::cosDeg(rotation + shearX) * scaleX;
+			lb = MathUtil::cosDeg(rotationY) * scaleY;
+			lc = MathUtil::sinDeg(rotation + shearX) * scaleX;
+			ld = MathUtil::sinDeg(rotationY) * scaleY;
+			_la[i] = la;
+			_lb[i] = lb;
+			_lc[i] = lc;
+			_ld[i] = ld;
+			_cacheRotation[i] = rotation;
+			_cacheShearX[i] = shearX;
+			_cacheShearY[i] = shearY;
+			_cacheScaleX[i] = scaleX;
+			_cacheScaleY[i] = scaleY;
+			_cacheValid[i] = true;
+		}
+	}
+
+	if (parent == -1) { /* Root bone. */
+		_a[i] = la * sx;
+		_b[i] = lb * sx;
+		_c[i] = lc * sy;
+		_d[i] = ld * sy;
+		_worldX[i] = x * sx + _skeleton._x;
+		_worldY[i] = y * sy + _skeleton._y;
+		return;
+	}
+
+	float pa = _a[parent], pb = _b[parent], pc = _c[parent], pd = _d[parent];
+	_worldX[i] = pa * x + pb * y + _worldX[parent];
+	_worldY[i] = pc * x + pd * y + _worldY[parent];
+
+	switch (mode) {
+	case TransformMode_Normal: {
+		_a[i] = pa * la + pb * lc;
+		_b[i] = pa * lb + pb * ld;
+		_c[i] = pc * la + pd * lc;
+		_d[i] = pc * lb + pd * ld;
+		return;
+	}
+	case TransformMode_OnlyTranslation: {
+		_a[i] = la * sx;
+		_b[i] = lb * sx;
+		_c[i] = lc * sy;
+		_d[i] = ld * sy;
+		return;
+	}
+	case TransformMode_NoRotationOrReflection: {
+		float s = pa * pa + pc * pc;
+		float prx, rx, ry;
+		if (s > 0.0001f) {
+			s = MathUtil::abs(pa * pd - pb * pc) / s;
+			pb = pc * s;
+			pd = pa * s;
+			prx = MathUtil::atan2(pc, pa) * MathUtil::Rad_Deg;
+		} else {
+			pa = 0;
+			pc = 0;
+			prx = 90 - MathUtil::atan2(pd, pb) * MathUtil::Rad_Deg;
+		}
+		rx = rotation + shearX - prx;
+		ry = rotation + shearY - prx + 90;
+		la = MathUtil::cosDeg(rx) * scaleX;
+		lb = MathUtil::cosDeg(ry) * scaleY;
+		lc = MathUtil::sinDeg(rx) * scaleX;
+		ld = MathUtil::sinDeg(ry) * scaleY;
+		_a[i] = pa * la - pb * lc;
+		_b[i] = pa * lb - pb * ld;
+		_c[i] = pc * la + pd * lc;
+		_d[i] = pc * lb + pd * ld;
+		return;
+	}
+	case TransformMode_NoScale:
+	case TransformMode_NoScaleOrReflection: {
+		float cosine = MathUtil::cosDeg(rotation);
+		float sine = MathUtil::sinDeg(rotation);
+		float za = (pa * cosine + pb * sine) / sx;
+		float zc = (pc * cosine + pd * sine) / sy;
+		float s = MathUtil::sqrt(za * za + zc * zc);
+		if (s > 0.00001f) s = 1 / s;
+		za *= s;
+		zc *= s;
+		s = MathUtil::sqrt(za * za + zc * zc);
+		if (mode == TransformMode_NoScale && (pa * pd - pb * pc < 0) != ((sx < 0) != (sy < 0))) s = -s;
+		float r = MathUtil::Pi / 2 + MathUtil::atan2(zc, za);
+		float zb = MathUtil::cos(r) * s;
+		float zd = MathUtil::sin(r) * s;
+		la = MathUtil::cosDeg(shearX) * scaleX;
+		lb = MathUtil::cosDeg(90 + shearY) * scaleY;
+		lc = MathUtil::sinDeg(shearX) * scaleX;
+		ld = MathUtil::sinDeg(90 + shearY) * scaleY;
+		_a[i] = (za * la + zb * lc) * sx;
+		_b[i] = (za * lb + zb * ld) * sx;
+		_c[i] = (zc * la + zd * lc) * sy;
+		_d[i] = (zc * lb + zd * ld) * sy;
+		return;
+	}
+	}
+}
+
+void BoneTransforms::readLocal(int i) {
+	Bone &bone = *_skeleton._bones[i];
+	_x[i] = bone._x;
+	_y[i] = bone._y;
+	_rotation[i] = bone._rotation;
+	_scaleX[i] = bone._scaleX;
+	_scaleY[i] = bone._scaleY;
+	_shearX[i] = bone._shearX;
+	_shearY[i] = bone._shearY;
+}
+
+void BoneTransforms::readWorld(int i) {
+	Bone &bone = *_skeleton._bones[i];
+	_a[i] = bone._a;
+	_b[i] = bone._b;
+	_c[i] = bone._c;
+	_d[i] = bone._d;
+	_worldX[i] = bone._worldX;
+	_worldY[i] = bone._worldY;
+}
+
+void BoneTransforms::writeBone(int i) {
+	Bone &bone = *_skeleton._bones[i];
+	bone._ax = _ax[i];
+	bone._ay = _ay[i];
+	bone._arotation = _arotation[i];
+	bone._ascaleX = _ascaleX[i];
+	bone._ascaleY = _ascaleY[i];
+	bone._ashearX = _ashearX[i];
+	bone._ashearY = _ashearY[i];
+	bone._appliedValid = true;
+	bone._a = _a[i];
+	bone._b = _b[i];
+	bone._c = _c[i];
+	bone._d = _d[i];
+	bone._worldX = _worldX[i];
+	bone._worldY = _worldY[i];
+}
+
+size_t BoneTransforms::getBoneCount() {
+	return _parents.size();
+}
+
+Vector<float> &BoneTransforms::getA() {
+	return _a;
+}
+
+Vector<float> &BoneTransforms::getB() {
+	return _b;
+}
+
+Vector<float> &BoneTransforms::getC() {
+	return _c;
+}
+
+Vector<float> &BoneTransforms::getD() {
+	return _d;
+}
+
+Vector<float> &BoneTransforms::getWorldX() {
+	return _worldX;
+}
+
+Vector<float> &BoneTransforms::getWorldY() {
+	return _worldY;
+}
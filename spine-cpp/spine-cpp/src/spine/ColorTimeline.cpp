@@ -38,6 +38,7 @@
 
 #include <spine/Animation.h>
 #include <spine/Bone.h>
+#include <spine/Pose.h>
 #include <spine/TimelineType.h>
 #include <spine/Slot.h>
 #include <spine/SlotData.h>
@@ -86,29 +87,9 @@ void ColorTimeline::apply(Skeleton &skeleton, float lastTime, float time, Vector
 		return;
 	}
 
-	float r, g, b, a;
-	if (time >= _frames[_frames.size() - ENTRIES]) {
-		// Time is after last frame.
-		size_t i = _frames.size();
-		r = _frames[i + PREV_R];
-		g = _frames[i + PREV_G];
-		b = _frames[i + PREV_B];
-		a = _frames[i + PREV_A];
-	} else {
-		// Interpolate between the previous frame and the current frame.
-		size_t frame = (size_t)Animation::binarySearch(_frames, time, ENTRIES);
-		r = _frames[frame + PREV_R];
-		g = _frames[frame + PREV_G];
-		b = _frames[frame + PREV_B];
-		a = _frames[frame + PREV_A];
-		float frameTime = _frames[frame];
-		float percent = getCurvePercent(frame / ENTRIES - 1, 1 - (time - frameTime) / (_frames[frame + PREV_TIME] - frameTime));
-
-		r += (_frames[frame + R] - r) * percent;
-		g += (_frames[frame + G] - g) * percent;
-		b += (_frames[frame + B] - b) * percent;
-		a += (_frames[frame + A] - a) * percent;
-	}
+	Color value;
+	getValues(time, value);
+	float r = value.r, g = value.g, b = value.b, a = value.a;
 
 	if (alpha == 1) {
 		slot.getColor().set(r, g, b, a);
@@ -119,6 +100,32 @@ void ColorTimeline::apply(Skeleton &skeleton, float lastTime, float time, Vector
 	}
 }
 
+void ColorTimeline::sample(Pose &pose, float time) {
+	if (time < _frames[0]) return;
+	getValues(time, pose.getColor(_slotIndex));
+}
+
+void ColorTimeline::getValues(float time, Color &color) {
+	if (time >= _frames[_frames.size() - ENTRIES]) {
+		// Time is after last frame.
+		size_t i = _frames.size();
+		color.set(_frames[i + PREV_R], _frames[i + PREV_G], _frames[i + PREV_B], _frames[i + PREV_A]);
+		return;
+	}
+
+	// Interpolate between the previous frame and the current frame.
+	size_t frame = (size_t)Animation::binarySearch(_frames, time, ENTRIES);
+	float r = _frames[frame + PREV_R];
+	float g = _frames[frame + PREV_G];
+	float b = _frames[frame + PREV_B];
+	float a = _frames[frame + PREV_A];
+	float frameTime = _frames[frame];
+	float percent = getCurvePercent(frame / ENTRIES - 1, 1 - (time - frameTime) / (_frames[frame + PREV_TIME] - frameTime));
+
+	color.set(r + (_frames[frame + R] - r) * percent, g + (_frames[frame + G] - g) * percent,
+		b + (_frames[frame + B] - b) * percent, a + (_frames[frame + A] - a) * percent);
+}
+
 int ColorTimeline::getPropertyId() {
 	return ((int) TimelineType_Color << 24) + _slotIndex;
 }
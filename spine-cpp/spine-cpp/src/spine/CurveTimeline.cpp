@@ -35,6 +35,8 @@
 
 #include <spine/MathUtil.h>
 
+#include <string.h>
+
 using namespace spine;
 
 RTTI_IMPL(CurveTimeline, Timeline)
@@ -42,9 +44,76 @@ RTTI_IMPL(CurveTimeline, Timeline)
 const float CurveTimeline::LINEAR = 0;
 const float CurveTimeline::STEPPED = 1;
 const float CurveTimeline::BEZIER = 2;
+const float CurveTimeline::LOOKUP = 3;
 const int CurveTimeline::BEZIER_SIZE = 10 * 2 - 1;
 
-CurveTimeline::CurveTimeline(int frameCount) {
+int CurveTable::add(const float *samples) {
+	unsigned int hash = 2166136261u;
+	const unsigned char *bytes = (const unsigned char *) samples;
+	for (size_t i = 0, n = SAMPLES * sizeof(float); i < n; i++) {
+		hash ^= bytes[i];
+		hash *= 16777619u;
+	}
+	int *existing = _index.get((int) hash);
+	if (existing && memcmp(getSamples(*existing), samples, SAMPLES * sizeof(float)) == 0) return *existing;
+
+	int index = (int) size();
+	_samples.ensureCapacity(_samples.size() + SAMPLES);
+	for (int i = 0; i < SAMPLES; i++)
+		_samples.add(samples[i]);
+	if (!existing) _index.put((int) hash, index);
+	return index;
+}
+
+void CurveTable::clear() {
+	_samples.clearAndDeallocate();
+	_index.clear();
+}
+
+QuantizedFrames::QuantizedFrames() : _entries(1) {
+}
+
+bool QuantizedFrames::set(Vector<float> &frames, int entries, float tolerance) {
+	size_t count = frames.size();
+	_entries = entries;
+	_offsets.setSize(entries, 0);
+	_steps.setSize(entries, 0);
+	for (int entry = 0; entry < entries; entry++) {
+		float min = frames[entry], max = min;
+		for (size_t i = entry + entries; i < count; i += entries) {
+			if (frames[i] < min) min = frames[i];
+			if (frames[i] > max) max = frames[i];
+		}
+		_offsets[entry] = min;
+		_steps[entry] = (max - min) / 65535;
+	}
+
+	_values.ensureCapacity(count);
+	_values.setSize(count, 0);
+	bool quantized = true;
+	for (size_t i = 0; i < count && quantized; i++) {
+		size_t entry = i % entries;
+		float value = frames[i], step = _steps[entry];
+		int q = step > 0 ? (int) ((value - _offsets[entry]) / step + 0.5f) : 0;
+		q = q < 0 ? 0 : (q > 65535 ? 65535 : q);
+		_values[i] = (unsigned short) q;
+		// Times must stay distinct, else the percent between two frames can't be computed.
+		if (MathUtil::abs((*this)[i] - value) > tolerance || (entry == 0 && i > 0 && _values[i] <= _values[i - entries]))
+			quantized = false;
+	}
+	if (!quantized) {
+		_values.clearAndDeallocate();
+		_offsets.clearAndDeallocate();
+		_steps.clearAndDeallocate();
+	}
+	return quantized;
+}
+
+size_t QuantizedFrames::getMemory() {
+	return _values.size() * sizeof(unsigned short) + (_offsets.size() + _steps.size()) * sizeof(float);
+}
+
+CurveTimeline::CurveTimeline(int frameCount) : _curveTable(NULL) {
 	assert(frameCount > 0);
 
 	_curves.setSize((frameCount - 1) * BEZIER_SIZE, 0);
@@ -54,18 +123,22 @@ CurveTimeline::~CurveTimeline() {
 }
 
 size_t CurveTimeline::getFrameCount() {
+	if (_curveTable) return _curveIndices.size() + 1;
 	return _curves.size() / BEZIER_SIZE + 1;
 }
 
 void CurveTimeline::setLinear(size_t frameIndex) {
+	assert(!_curveTable);
 	_curves[frameIndex * BEZIER_SIZE] = LINEAR;
 }
 
 void CurveTimeline::setStepped(size_t frameIndex) {
+	assert(!_curveTable);
 	_curves[frameIndex * BEZIER_SIZE] = STEPPED;
 }
 
 void CurveTimeline::setCurve(size_t frameIndex, float cx1, float cy1, float cx2, float cy2) {
+	assert(!_curveTable);
 	float tmpx = (-cx1 * 2 + cx2) * 0.03f, tmpy = (-cy1 * 2 + cy2) * 0.03f;
 	float dddfx = ((cx1 - cx2) * 3 + 1) * 0.006f, dddfy = ((cy1 - cy2) * 3 + 1) * 0.006f;
 	float ddfx = tmpx * 2 + dddfx, ddfy = tmpy * 2 + dddfy;
@@ -87,8 +160,50 @@ void CurveTimeline::setCurve(size_t frameIndex, float cx1, float cy1, float cx2,
 	}
 }
 
+/// @param curve The x, y samples of a bezier curve.
+static float getBezierPercent(const float *curve, float percent) {
+	int i = 0;
+	float x = 0;
+	for (int n = CurveTable::SAMPLES; i < n; i += 2) {
+		x = curve[i];
+		if (x >= percent) {
+			float prevX, prevY;
+			if (i == 0) {
+				prevX = 0;
+				prevY = 0;
+			} else {
+				prevX = curve[i - 2];
+				prevY = curve[i - 1];
+			}
+			return prevY + (curve[i + 1] - prevY) * (percent - prevX) / (x - prevX);
+		}
+	}
+
+	float y = curve[i - 1];
+
+	return y + (1 - y) * (percent - x) / (1 - x); // Last point is 1,1.
+}
+
+/// @param curve The values of a bezier curve at evenly spaced times, see CurveTimeline::buildCurveLookup().
+static inline float getLookupPercent(const float *curve, float percent) {
+	float x = percent * (CurveTable::SAMPLES + 1);
+	int i = (int) x;
+	if (i > CurveTable::SAMPLES) return 1;
+	float prevY = i == 0 ? 0 : curve[i - 1], y = i == CurveTable::SAMPLES ? 1 : curve[i];
+	return prevY + (y - prevY) * (x - i);
+}
+
 float CurveTimeline::getCurvePercent(size_t frameIndex, float percent) {
 	percent = MathUtil::clamp(percent, 0, 1);
+	if (_curveTable) {
+		int index = _curveIndices[frameIndex];
+		if (index == (int) LINEAR) return percent;
+		if (index == (int) STEPPED) return 0;
+		index -= (int) BEZIER;
+		const float *curve = _curveTable->getSamples(index >> 1);
+		return index & 1 ? getLookupPercent(curve, percent) : getBezierPercent(curve, percent);
+	}
+
 	size_t i = frameIndex * BEZIER_SIZE;
 	float type = _curves[i];
 
@@ -100,28 +215,103 @@ float CurveTimeline::getCurvePercent(size_t frameIndex, float percent) {
 		return 0;
 	}
 
-	i++;
-	float x = 0;
-	for (size_t start = i, n = i + BEZIER_SIZE - 1; i < n; i += 2) {
-		x = _curves[i];
-		if (x >= percent) {
-			float prevX, prevY;
-			if (i == start) {
-				prevX = 0;
-				prevY = 0;
-			} else {
-				prevX = _curves[i - 2];
-				prevY = _curves[i - 1];
+	if (type == LOOKUP) {
+		return getLookupPercent(_curves.buffer() + i + 1, percent);
+	}
+
+	return getBezierPercent(_curves.buffer() + i + 1, percent);
+}
+
+float CurveTimeline::getCurveType(size_t frameIndex) {
+	if (_curveTable) return MathUtil::min((float) _curveIndices[frameIndex], BEZIER);
+	return MathUtil::min(_curves[frameIndex * BEZIER_SIZE], BEZIER);
+}
+
+size_t CurveTimeline::quantize(float tolerance, CurveTable &curveTable) {
+	SP_UNUSED(tolerance);
+	SP_UNUSED(curveTable);
+	return 0;
+}
+
+bool CurveTimeline::isQuantized() {
+	return _curveTable != NULL;
+}
+
+/// Returns the x or y of a bezier curve from 0,0 to 1,1 at time t.
+static inline float getBezierValue(float c1, float c2, float t) {
+	float u = 1 - t;
+	return 3 * u * u * t * c1 + 3 * u * t * t * c2 + t * t * t;
+}
+
+int CurveTimeline::buildCurveLookup() {
+	if (_curveTable) return 0;
+	int count = 0;
+	float lookup[CurveTable::SAMPLES];
+	for (size_t i = 0, n = _curves.size(); i < n; i += BEZIER_SIZE) {
+		if (_curves[i] != BEZIER) continue;
+		float *curve = _curves.buffer() + i + 1;
+
+		// setCurve() sampled the curve at times 0.1, 0.2, ..., so the control handles are found from the samples at 0.3
+		// and 0.6: value - t^3 = 3u^2t * c1 + 3ut^2 * c2, with u = 1 - t.
+		float a1 = 3 * 0.7f * 0.7f * 0.3f, b1 = 3 * 0.7f * 0.3f * 0.3f;
+		float a2 = 3 * 0.4f * 0.4f * 0.6f, b2 = 3 * 0.4f * 0.6f * 0.6f;
+		float det = a1 * b2 - a2 * b1;
+		float x1 = curve[4] - 0.3f * 0.3f * 0.3f, y1 = curve[5] - 0.3f * 0.3f * 0.3f;
+		float x2 = curve[10] - 0.6f * 0.6f * 0.6f, y2 = curve[11] - 0.6f * 0.6f * 0.6f;
+		float cx1 = (x1 * b2 - x2 * b1) / det, cx2 = (a1 * x2 - a2 * x1) / det;
+		float cy1 = (y1 * b2 - y2 * b1) / det, cy2 = (a1 * y2 - a2 * y1) / det;
+
+		for (int ii = 0; ii < CurveTable::SAMPLES; ii++) {
+			// x increases with t when the control handles' x are within 0..1, so t is found by bisection.
+			float x = (ii + 1) / (float) (CurveTable::SAMPLES + 1), low = 0, high = 1;
+			for (int iii = 0; iii < 24; iii++) {
+				float t = (low + high) * 0.5f;
+				if (getBezierValue(cx1, cx2, t) < x)
+					low = t;
+				else
+					high = t;
 			}
-			return prevY + (_curves[i + 1] - prevY) * (percent - prevX) / (x - prevX);
+			lookup[ii] = getBezierValue(cy1, cy2, (low + high) * 0.5f);
 		}
-	}
 
-	float y = _curves[i - 1];
+		// Keep the samples if they are closer to the curve.
+		float samplesError = 0, lookupError = 0;
+		for (int ii = 1; ii < 64; ii++) {
+			float t = ii / 64.0f, x = getBezierValue(cx1, cx2, t), y = getBezierValue(cy1, cy2, t);
+			samplesError = MathUtil::max(samplesError, MathUtil::abs(getBezierPercent(curve, x) - y));
+			lookupError = MathUtil::max(lookupError, MathUtil::abs(getLookupPercent(lookup, x) - y));
+		}
+		if (lookupError > samplesError) continue;
 
-	return y + (1 - y) * (percent - x) / (1 - x); // Last point is 1,1.
+		_curves[i] = LOOKUP;
+		memcpy(curve, lookup, sizeof(lookup));
+		count++;
+	}
+	return count;
 }
 
-float CurveTimeline::getCurveType(size_t frameIndex) {
-	return _curves[frameIndex * BEZIER_SIZE];
+size_t CurveTimeline::quantizeFrames(Vector<float> &frames, int entries, float tolerance, CurveTable &curveTable) {
+	size_t curveCount = _curves.size() / BEZIER_SIZE;
+	if (_curveTable || curveTable.size() + curveCount > (65535 - (size_t) BEZIER) / 2) return 0;
+	if (!_quantizedFrames.set(frames, entries, tolerance)) return 0;
+
+	size_t tableSize = curveTable.size();
+	_curveIndices.ensureCapacity(curveCount);
+	_curveIndices.setSize(curveCount, 0);
+	for (size_t i = 0; i < curveCount; i++) {
+		float type = _curves[i * BEZIER_SIZE];
+		if (type == BEZIER || type == LOOKUP) {
+			int index = curveTable.add(_curves.buffer() + i * BEZIER_SIZE + 1);
+			_curveIndices[i] = (unsigned short) (BEZIER + index * 2 + (type == LOOKUP));
+		} else
+			_curveIndices[i] = (unsigned short) type;
+	}
+
+	size_t saved = (frames.size() + _curves.size()) * sizeof(float);
+	size_t used = _quantizedFrames.getMemory() + _curveIndices.size() * sizeof(unsigned short) +
+		(curveTable.size() - tableSize) * CurveTable::SAMPLES * sizeof(float);
+	frames.clearAndDeallocate();
+	_curves.clearAndDeallocate();
+	_curveTable = &curveTable;
+	return saved > used ? saved - used : 0;
 }
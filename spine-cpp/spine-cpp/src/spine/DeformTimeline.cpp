@@ -44,20 +44,21 @@
 #include <spine/Bone.h>
 #include <spine/SlotData.h>
 
+#include <string.h>
+
 using namespace spine;
 
 RTTI_IMPL(DeformTimeline, CurveTimeline)
 
 DeformTimeline::DeformTimeline(int frameCount) : CurveTimeline(frameCount), _slotIndex(0), _attachment(NULL) {
 	_frames.ensureCapacity(frameCount);
-	_frameVertices.ensureCapacity(frameCount);
-
 	_frames.setSize(frameCount, 0);
-
-	for (int i = 0; i < frameCount; ++i) {
-		Vector<float> vec;
-		_frameVertices.add(vec);
-	}
+	_vertexStarts.ensureCapacity(frameCount);
+	_vertexStarts.setSize(frameCount, 0);
+	_vertexEnds.ensureCapacity(frameCount);
+	_vertexEnds.setSize(frameCount, 0);
+	_vertexOffsets.ensureCapacity(frameCount);
+	_vertexOffsets.setSize(frameCount, 0);
 }
 
 void DeformTimeline::apply(Skeleton &skeleton, float lastTime, float time, Vector<Event *> *pEvents, float alpha,
@@ -86,8 +87,7 @@ void DeformTimeline::apply(Skeleton &skeleton, float lastTime, float time, Vecto
 		blend = MixBlend_Setup;
 	}
 
-	Vector< Vector<float> > &frameVertices = _frameVertices;
-	size_t vertexCount = frameVertices[0].size();
+	size_t vertexCount = getVertexCount();
 
 	Vector<float> &frames = _frames;
 	if (time < _frames[0]) {
@@ -121,143 +121,82 @@ void DeformTimeline::apply(Skeleton &skeleton, float lastTime, float time, Vecto
 	}
 
 	deformArray.setSize(vertexCount, 0);
-	Vector<float> &deform = deformArray;
+	float *deform = deformArray.buffer();
+	// Unweighted vertex positions, or NULL for weighted deform offsets, which are 0 in the setup pose.
+	const float *setup = attachment->getBones().size() == 0 ? attachment->getVertices().buffer() : NULL;
 
+	int prevFrame, frame;
+	float percent;
 	if (time >= frames[frames.size() - 1]) { // Time is after last frame.
-		Vector<float> &lastVertices = frameVertices[frames.size() - 1];
-		if (alpha == 1) {
-			if (blend == MixBlend_Add) {
-				VertexAttachment *vertexAttachment = static_cast<VertexAttachment*>(slotAttachment);
-				if (vertexAttachment->getBones().size() == 0) {
-					// Unweighted vertex positions, no alpha.
-					Vector<float> &setupVertices = vertexAttachment->getVertices();
-					for (size_t i = 0; i < vertexCount; i++)
-						deform[i] += lastVertices[i] - setupVertices[i];
-				} else {
-					// Weighted deform offsets, no alpha.
-					for (size_t i = 0; i < vertexCount; i++)
-						deform[i] += lastVertices[i];
-				}
-			} else {
-				// Vertex positions or deform offsets, no alpha.
-				memcpy(deform.buffer(), lastVertices.buffer(), vertexCount * sizeof(float));
-			}
+		prevFrame = frame = (int) frames.size() - 1;
+		percent = 0;
+	} else {
+		// Interpolate between the previous frame and the current frame.
+		frame = Animation::binarySearch(frames, time);
+		prevFrame = frame - 1;
+		float frameTime = frames[frame];
+		percent = getCurvePercent(frame - 1, 1 - (time - frameTime) / (frames[frame - 1] - frameTime));
+	}
+
+	// Both frames are the setup pose outside the vertices either of them changes, so only that range is interpolated.
+	int prevStart = _vertexStarts[prevFrame], prevEnd = _vertexEnds[prevFrame];
+	int nextStart = _vertexStarts[frame], nextEnd = _vertexEnds[frame];
+	const float *prevVertices = _vertices.buffer() + _vertexOffsets[prevFrame];
+	const float *nextVertices = _vertices.buffer() + _vertexOffsets[frame];
+	size_t start, end;
+	if (prevStart == prevEnd) {
+		start = nextStart;
+		end = nextEnd;
+	} else if (nextStart == nextEnd) {
+		start = prevStart;
+		end = prevEnd;
+	} else {
+		start = MathUtil::min(prevStart, nextStart);
+		end = MathUtil::max(prevEnd, nextEnd);
+	}
+
+	bool add = blend == MixBlend_Add, mix = alpha != 1 && (blend == MixBlend_First || blend == MixBlend_Replace);
+	if (mix) {
+		// Vertex positions or deform offsets, with alpha.
+		for (size_t i = 0; i < vertexCount; i++) {
+			if (i == start) i = end;
+			if (i == vertexCount) break;
+			deform[i] += ((setup ? setup[i] : 0) - deform[i]) * alpha;
+		}
+	} else if (!add) {
+		// Setting the setup pose, with or without alpha, gives the setup pose.
+		if (setup) {
+			memcpy(deform, setup, start * sizeof(float));
+			memcpy(deform + end, setup + end, (vertexCount - end) * sizeof(float));
 		} else {
-			switch (blend) {
-			case MixBlend_Setup: {
-				VertexAttachment *vertexAttachment = static_cast<VertexAttachment *>(slotAttachment);
-				if (vertexAttachment->getBones().size() == 0) {
-					// Unweighted vertex positions, with alpha.
-					Vector<float> &setupVertices = vertexAttachment->getVertices();
-					for (size_t i = 0; i < vertexCount; i++) {
-						float setup = setupVertices[i];
-						deform[i] = setup + (lastVertices[i] - setup) * alpha;
-					}
-				} else {
-					// Weighted deform offsets, with alpha.
-					for (size_t i = 0; i < vertexCount; i++)
-						deform[i] = lastVertices[i] * alpha;
-				}
-				break;
-			}
-			case MixBlend_First:
-			case MixBlend_Replace:
-				// Vertex positions or deform offsets, with alpha.
-				for (size_t i = 0; i < vertexCount; i++)
-					deform[i] += (lastVertices[i] - deform[i]) * alpha;
-				break;
-			case MixBlend_Add:
-				VertexAttachment *vertexAttachment = static_cast<VertexAttachment *>(slotAttachment);
-				if (vertexAttachment->getBones().size() == 0) {
-					// Unweighted vertex positions, no alpha.
-					Vector<float> &setupVertices = vertexAttachment->getVertices();
-					for (size_t i = 0; i < vertexCount; i++)
-						deform[i] += (lastVertices[i] - setupVertices[i]) * alpha;
-				} else {
-					// Weighted deform offsets, alpha.
-					for (size_t i = 0; i < vertexCount; i++)
-						deform[i] += lastVertices[i] * alpha;
-				}
-			}
+			memset(deform, 0, start * sizeof(float));
+			memset(deform + end, 0, (vertexCount - end) * sizeof(float));
 		}
-		return;
 	}
 
-	// Interpolate between the previous frame and the current frame.
-	int frame = Animation::binarySearch(frames, time);
-	Vector<float> &prevVertices = frameVertices[frame - 1];
-	Vector<float> &nextVertices = frameVertices[frame];
-	float frameTime = frames[frame];
-	float percent = getCurvePercent(frame - 1, 1 - (time - frameTime) / (frames[frame - 1] - frameTime));
-
-	if (alpha == 1) {
-		if (blend == MixBlend_Add) {
-			VertexAttachment *vertexAttachment = static_cast<VertexAttachment *>(slotAttachment);
-			if (vertexAttachment->getBones().size() == 0) {
-				// Unweighted vertex positions, no alpha.
-				Vector<float> &setupVertices = vertexAttachment->getVertices();
-				for (size_t i = 0; i < vertexCount; i++) {
-					float prev = prevVertices[i];
-					deform[i] += prev + (nextVertices[i] - prev) * percent - setupVertices[i];
-				}
-			} else {
-				// Weighted deform offsets, no alpha.
-				for (size_t i = 0; i < vertexCount; i++) {
-					float prev = prevVertices[i];
-					deform[i] += prev + (nextVertices[i] - prev) * percent;
-				}
-			}
-		} else {
+	for (size_t i = start; i < end; i++) {
+		float base = setup ? setup[i] : 0;
+		float prev = (int) i >= prevStart && (int) i < prevEnd ? prevVertices[i - prevStart] : base;
+		float next = (int) i >= nextStart && (int) i < nextEnd ? nextVertices[i - nextStart] : base;
+		float value = prev + (next - prev) * percent;
+		if (add) {
+			// Unweighted vertex positions or weighted deform offsets, relative to the setup pose.
+			if (setup)
+				deform[i] += (value - base) * alpha;
+			else
+				deform[i] += value * alpha;
+		} else if (alpha == 1) {
 			// Vertex positions or deform offsets, no alpha.
-			for (size_t i = 0; i < vertexCount; i++) {
-				float prev = prevVertices[i];
-				deform[i] = prev + (nextVertices[i] - prev) * percent;
-			}
-		}
-	} else {
-		switch (blend) {
-		case MixBlend_Setup: {
-			VertexAttachment *vertexAttachment = static_cast<VertexAttachment *>(slotAttachment);
-			if (vertexAttachment->getBones().size() == 0) {
-				// Unweighted vertex positions, with alpha.
-				Vector<float> &setupVertices = vertexAttachment->getVertices();
-				for (size_t i = 0; i < vertexCount; i++) {
-					float prev = prevVertices[i], setup = setupVertices[i];
-					deform[i] = setup + (prev + (nextVertices[i] - prev) * percent - setup) * alpha;
-				}
-			} else {
-				// Weighted deform offsets, with alpha.
-				for (size_t i = 0; i < vertexCount; i++) {
-					float prev = prevVertices[i];
-					deform[i] = (prev + (nextVertices[i] - prev) * percent) * alpha;
-				}
-			}
-			break;
-		}
-		case MixBlend_First:
-		case MixBlend_Replace:
+			deform[i] = value;
+		} else if (mix) {
 			// Vertex positions or deform offsets, with alpha.
-			for (size_t i = 0; i < vertexCount; i++) {
-				float prev = prevVertices[i];
-				deform[i] += (prev + (nextVertices[i] - prev) * percent - deform[i]) * alpha;
-			}
-			break;
-		case MixBlend_Add:
-			VertexAttachment *vertexAttachment = static_cast<VertexAttachment *>(slotAttachment);
-			if (vertexAttachment->getBones().size() == 0) {
-				// Unweighted vertex positions, with alpha.
-				Vector<float> &setupVertices = vertexAttachment->getVertices();
-				for (size_t i = 0; i < vertexCount; i++) {
-					float prev = prevVertices[i];
-					deform[i] += (prev + (nextVertices[i] - prev) * percent - setupVertices[i]) * alpha;
-				}
-			} else {
-				// Weighted deform offsets, with alpha.
-				for (size_t i = 0; i < vertexCount; i++) {
-					float prev = prevVertices[i];
-					deform[i] += (prev + (nextVertices[i] - prev) * percent) * alpha;
-				}
-			}
+			deform[i] += (value - deform[i]) * alpha;
+		} else if (setup) {
+			// Unweighted vertex positions, with alpha.
+			deform[i] = base + (value - base) * alpha;
+		} else {
+			// Weighted deform offsets, with alpha.
+			deform[i] = value * alpha;
 		}
 	}
 }
@@ -268,9 +207,43 @@ int DeformTimeline::getPropertyId() {
 }
 
 void DeformTimeline::setFrame(int frameIndex, float time, Vector<float> &vertices) {
+	assert(_attachment != NULL && vertices.size() == getVertexCount());
 	_frames[frameIndex] = time;
-	_frameVertices[frameIndex].clear();
-	_frameVertices[frameIndex].addAll(vertices);
+	Vector<float> &setupVertices = _attachment->_vertices;
+	bool weighted = _attachment->_bones.size() > 0;
+	int start = 0, end = (int) vertices.size();
+	while (start < end && vertices[start] == (weighted ? 0 : setupVertices[start]))
+		start++;
+	while (end > start && vertices[end - 1] == (weighted ? 0 : setupVertices[end - 1]))
+		end--;
+	setVertices(frameIndex, vertices.buffer() + start, start, end);
+}
+
+void DeformTimeline::setFrame(int frameIndex, float time, Vector<float> &vertices, int start) {
+	assert(_attachment != NULL && start >= 0 && start + vertices.size() <= getVertexCount());
+	_frames[frameIndex] = time;
+	setVertices(frameIndex, vertices.buffer(), start, start + (int) vertices.size());
+}
+
+void DeformTimeline::setVertices(int frameIndex, const float *vertices, int start, int end) {
+	int count = end - start, offset = -1;
+	if (count == 0) start = end = 0;
+	for (size_t i = 0, n = _frames.size(); i < n && count > 0; i++) {
+		if ((int) i != frameIndex && _vertexStarts[i] == start && _vertexEnds[i] == end &&
+			memcmp(_vertices.buffer() + _vertexOffsets[i], vertices, count * sizeof(float)) == 0) {
+			offset = _vertexOffsets[i];
+			break;
+		}
+	}
+	if (offset == -1) {
+		offset = (int) _vertices.size();
+		_vertices.ensureCapacity(offset + count);
+		_vertices.setSize(offset + count, 0);
+		if (count) memcpy(_vertices.buffer() + offset, vertices, count * sizeof(float));
+	}
+	_vertexStarts[frameIndex] = start;
+	_vertexEnds[frameIndex] = end;
+	_vertexOffsets[frameIndex] = offset;
 }
 
 int DeformTimeline::getSlotIndex() {
@@ -285,8 +258,23 @@ Vector<float> &DeformTimeline::getFrames() {
 	return _frames;
 }
 
-Vector<Vector<float> > &DeformTimeline::getVertices() {
-	return _frameVertices;
+size_t DeformTimeline::getVertexCount() {
+	assert(_attachment != NULL);
+	Vector<float> &vertices = _attachment->_vertices;
+	return _attachment->_bones.size() > 0 ? vertices.size() / 3 * 2 : vertices.size();
+}
+
+void DeformTimeline::getFrameVertices(int frameIndex, Vector<float> &vertices) {
+	size_t vertexCount = getVertexCount();
+	vertices.ensureCapacity(vertexCount);
+	vertices.setSize(vertexCount, 0);
+	if (_attachment->_bones.size() > 0)
+		memset(vertices.buffer(), 0, vertexCount * sizeof(float));
+	else
+		memcpy(vertices.buffer(), _attachment->_vertices.buffer(), vertexCount * sizeof(float));
+	int start = _vertexStarts[frameIndex], end = _vertexEnds[frameIndex];
+	if (end > start)
+		memcpy(vertices.buffer() + start, _vertices.buffer() + _vertexOffsets[frameIndex], (end - start) * sizeof(float));
 }
 
 VertexAttachment *DeformTimeline::getAttachment() {
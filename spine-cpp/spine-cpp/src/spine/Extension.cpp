@@ -31,11 +31,26 @@
 #include "SpinePluginPrivatePCH.h"
 #endif
 
+#include <spine/Arena.h>
 #include <spine/Extension.h>
 #include <spine/SpineString.h>
 
 #include <assert.h>
 
+#if defined(_WIN32)
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#define SPINE_MAP_FILE_WIN32
+#elif defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define SPINE_MAP_FILE_POSIX
+#endif
+
 using namespace spine;
 
 SpineExtension *SpineExtension::_instance = NULL;
@@ -56,6 +71,39 @@ SpineExtension *SpineExtension::getInstance() {
 SpineExtension::~SpineExtension() {
 }
 
+void *SpineExtension::allocate(size_t size, bool clear, const char *file, int line) {
+	Arena *arena = Arena::getCurrent();
+	if (arena) {
+		void *result = arena->alloc(size, clear);
+		if (result) return result;
+	}
+	return clear ? getInstance()->_calloc(size, file, line) : getInstance()->_alloc(size, file, line);
+}
+
+void *SpineExtension::reallocate(void *ptr, size_t size, const char *file, int line) {
+	if (!ptr && Arena::getCurrent()) {
+		void *result = Arena::getCurrent()->alloc(size, false);
+		if (result) return result;
+	}
+	if (ptr && Arena::contains(ptr)) return Arena::realloc(ptr, size, file, line);
+	return getInstance()->_realloc(ptr, size, file, line);
+}
+
+void SpineExtension::deallocate(void *ptr, const char *file, int line) {
+	if (Arena::contains(ptr)) return;
+	getInstance()->_free(ptr, file, line);
+}
+
+const char *SpineExtension::_mapFile(const String &path, int *length) {
+	return _readFile(path, length);
+}
+
+void SpineExtension::_unmapFile(const char *data, int length) {
+	SP_UNUSED(length);
+
+	SpineExtension::free(data, __FILE__, __LINE__);
+}
+
 SpineExtension::SpineExtension() {
 }
 
@@ -123,5 +171,50 @@ char *DefaultSpineExtension::_readFile(const String &path, int *length) {
 	return data;
 }
 
+const char *DefaultSpineExtension::_mapFile(const String &path, int *length) {
+#if defined(SPINE_MAP_FILE_POSIX)
+	*length = 0;
+	int file = open(path.buffer(), O_RDONLY);
+	if (file == -1) return NULL;
+	struct stat info;
+	void *data = MAP_FAILED;
+	if (fstat(file, &info) == 0 && info.st_size > 0) data = mmap(NULL, (size_t) info.st_size, PROT_READ, MAP_PRIVATE, file, 0);
+	close(file);
+	if (data == MAP_FAILED) return NULL;
+	*length = (int) info.st_size;
+	return (const char *) data;
+#elif defined(SPINE_MAP_FILE_WIN32)
+	*length = 0;
+	HANDLE file = CreateFileA(path.buffer(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+	if (file == INVALID_HANDLE_VALUE) return NULL;
+	LARGE_INTEGER size;
+	void *data = NULL;
+	if (GetFileSizeEx(file, &size) && size.QuadPart > 0) {
+		HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+		if (mapping) {
+			data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+			CloseHandle(mapping);
+		}
+	}
+	CloseHandle(file);
+	if (!data) return NULL;
+	*length = (int) size.QuadPart;
+	return (const char *) data;
+#else
+	return SpineExtension::_mapFile(path, length);
+#endif
+}
+
+void DefaultSpineExtension::_unmapFile(const char *data, int length) {
+#if defined(SPINE_MAP_FILE_POSIX)
+	munmap((void *) data, (size_t) length);
+#elif defined(SPINE_MAP_FILE_WIN32)
+	SP_UNUSED(length);
+	UnmapViewOfFile(data);
+#else
+	SpineExtension::_unmapFile(data, length);
+#endif
+}
+
 DefaultSpineExtension::DefaultSpineExtension() : SpineExtension() {
 }
@@ -0,0 +1,430 @@
+/******************************************************************************
+ * Spine Runtimes License Agreement
+ * Last updated January 1, 2020. Replaces all prior versions.
+ *
+ * Copyright (c) 2013-2020, Esoteric Software LLC
+ *
+ * Integration of the Spine Runtimes into software or otherwise creating
+ * derivative works of the Spine Runtimes is permitted under the terms and
+ * conditions of Section 2 of the Spine Editor License Agreement:
+ * http://esotericsoftware.com/spine-editor-license
+ *
+ * Otherwise, it is permitted to integrate the Spine Runtimes into software
+ * or otherwise create derivative works of the Spine Runtimes (collectively,
+ * "Products"), provided that each user of the Products must obtain their own
+ * Spine Editor license and redistribution of the Products in any form must
+ * include this license and copyright notice.
+ *
+ * THE SPINE RUNTIMES ARE PROVIDED BY ESOTERIC SOFTWARE LLC "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL ESOTERIC SOFTWARE LLC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES,
+ * BUSINESS INTERRUPTION, OR LOSS OF USE, DATA, OR PROFITS) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THE SPINE RUNTIMES, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+#ifdef SPINE_UE4
+#include "SpinePluginPrivatePCH.h"
+#endif
+
+#include <spine/JsonReader.h>
+#include <spine/Arena.h>
+#include <spine/Extension.h>
+#include <spine/Json.h>
+
+#include <stdio.h>
+#include <string.h>
+
+using namespace spine;
+
+static const char *END = "";
+
+static const unsigned char firstByteMark[7] = {0x00, 0x00, 0xC0, 0xE0, 0xF0, 0xF8, 0xFC};
+
+static char toLower(char c) {
+	return c >= 'A' && c <= 'Z' ? (char) (c + ('a' - 'A')) : c;
+}
+
+JsonReader::JsonReader(const char *json) : _cursor(json ? json : END), _error(NULL), _key(NULL), _keyCapacity(0),
+	_keyHash(0), _string(NULL), _stringCapacity(0) {
+}
+
+JsonReader::~JsonReader() {
+	if (_key) SpineExtension::free(_key, __FILE__, __LINE__);
+	if (_string) SpineExtension::free(_string, __FILE__, __LINE__);
+}
+
+int JsonReader::peek() {
+	skipWhitespace();
+	switch (*_cursor) {
+	case '{':
+		return Json::JSON_OBJECT;
+	case '[':
+		return Json::JSON_ARRAY;
+	case '\"':
+		return Json::JSON_STRING;
+	case 't':
+		return Json::JSON_TRUE;
+	case 'f':
+		return Json::JSON_FALSE;
+	case 'n':
+		return Json::JSON_NULL;
+	case '-':
+	case '0':
+	case '1':
+	case '2':
+	case '3':
+	case '4':
+	case '5':
+	case '6':
+	case '7':
+	case '8':
+	case '9':
+		return Json::JSON_NUMBER;
+	default:
+		return -1;
+	}
+}
+
+bool JsonReader::beginObject() {
+	skipWhitespace();
+	if (*_cursor == '{') {
+		_cursor++;
+		return true;
+	}
+	skipValue();
+	return false;
+}
+
+bool JsonReader::nextKey() {
+	skipWhitespace();
+	if (*_cursor == '}') {
+		_cursor++;
+		return false;
+	}
+	if (*_cursor == ',') {
+		_cursor++;
+		skipWhitespace();
+	}
+	if (!parseString(_key, _keyCapacity)) return false;
+	_keyHash = hash(_key);
+	skipWhitespace();
+	if (*_cursor != ':') {
+		fail(_cursor);
+		return false;
+	}
+	_cursor++;
+	return true;
+}
+
+const char *JsonReader::getKey() {
+	return _key;
+}
+
+unsigned int JsonReader::getKeyHash() {
+	return _keyHash;
+}
+
+bool JsonReader::isKey(const char *name) {
+	const char *key = _key;
+	if (!key) return false;
+	while (*key && toLower(*key) == toLower(*name)) {
+		key++;
+		name++;
+	}
+	return toLower(*key) == toLower(*name);
+}
+
+bool JsonReader::beginArray() {
+	skipWhitespace();
+	if (*_cursor == '[') {
+		_cursor++;
+		return true;
+	}
+	skipValue();
+	return false;
+}
+
+bool JsonReader::nextValue() {
+	skipWhitespace();
+	if (*_cursor == ']') {
+		_cursor++;
+		return false;
+	}
+	if (*_cursor == ',') {
+		_cursor++;
+		skipWhitespace();
+	}
+	if (!*_cursor) {
+		fail(_cursor);
+		return false;
+	}
+	return true;
+}
+
+int JsonReader::peekArraySize() {
+	const char *start = _cursor;
+	int size = 0;
+	if (beginArray()) {
+		while (nextValue()) {
+			skipValue();
+			size++;
+		}
+	}
+	if (!_error) _cursor = start;
+	return size;
+}
+
+const char *JsonReader::readString() {
+	skipWhitespace();
+	if (*_cursor != '\"') {
+		skipValue();
+		return NULL;
+	}
+	return parseString(_string, _stringCapacity) ? _string : NULL;
+}
+
+float JsonReader::readFloat() {
+	float result = 0;
+	int intValue;
+	if (peek() == Json::JSON_NUMBER) {
+		parseNumber(result, intValue);
+		return result;
+	}
+	skipValue();
+	return 0;
+}
+
+int JsonReader::readInt() {
+	float floatValue;
+	int result = 0;
+	int type = peek();
+	if (type == Json::JSON_NUMBER) {
+		parseNumber(floatValue, result);
+		return result;
+	}
+	skipValue();
+	return type == Json::JSON_TRUE ? 1 : 0;
+}
+
+bool JsonReader::readBoolean() {
+	float result = 0;
+	int intValue;
+	int type = peek();
+	if (type == Json::JSON_STRING) {
+		const char *value = readString();
+		return value && strcmp(value, "true") == 0;
+	}
+	if (type == Json::JSON_NUMBER) {
+		parseNumber(result, intValue);
+		return result != 0;
+	}
+	skipValue();
+	return type == Json::JSON_TRUE;
+}
+
+void JsonReader::skipValue() {
+	skipWhitespace();
+	const char *value = _cursor;
+	switch (*value) {
+	case '\"':
+	case '{':
+	case '[': {
+		// Strings and containers are scanned without unescaping or nesting more than a depth count.
+		int depth = 0;
+		do {
+			char c = *value++;
+			if (c == '\"') {
+				while (*value != '\"') {
+					if (!*value) {
+						fail(value);
+						return;
+					}
+					if (*value == '\\' && value[1]) value++;
+					value++;
+				}
+				value++;
+			} else if (c == '{' || c == '[')
+				depth++;
+			else if (c == '}' || c == ']')
+				depth--;
+			else if (!c) {
+				fail(value - 1);
+				return;
+			}
+		} while (depth > 0);
+		_cursor = value;
+		return;
+	}
+	case 't':
+		skipLiteral("true");
+		return;
+	case 'f':
+		skipLiteral("false");
+		return;
+	case 'n':
+		skipLiteral("null");
+		return;
+	default: {
+		float floatValue;
+		int intValue;
+		parseNumber(floatValue, intValue);
+	}
+	}
+}
+
+const char *JsonReader::getPosition() {
+	return _cursor;
+}
+
+void JsonReader::setPosition(const char *inValue) {
+	if (!_error) _cursor = inValue;
+}
+
+const char *JsonReader::getError() {
+	return _error;
+}
+
+unsigned int JsonReader::hash(const char *value) {
+	// FNV-1a.
+	unsigned int result = 2166136261u;
+	for (; *value; value++) {
+		result ^= (unsigned char) toLower(*value);
+		result *= 16777619u;
+	}
+	return result;
+}
+
+void JsonReader::skipWhitespace() {
+	while (*_cursor && (unsigned char) *_cursor <= 32)
+		_cursor++;
+}
+
+void JsonReader::fail(const char *at) {
+	if (!_error) _error = at;
+	_cursor = END;
+}
+
+bool JsonReader::parseString(char *&buffer, size_t &capacity) {
+	const char *ptr = _cursor + 1;
+	if (*_cursor != '\"') {
+		fail(_cursor);
+		return false;
+	}
+
+	// Unescaped strings are never longer than their escaped form.
+	while (*ptr != '\"' && *ptr) {
+		if (*ptr++ == '\\' && *ptr) ptr++;
+	}
+	if (!*ptr) {
+		fail(_cursor);
+		return false;
+	}
+	size_t length = (size_t) (ptr - _cursor);
+	if (length > capacity) {
+		// The buffers are temporary, so they must not come from the arena.
+		ArenaScope heapScope(NULL);
+		capacity = length + (length >> 1);
+		buffer = SpineExtension::realloc(buffer, capacity, __FILE__, __LINE__);
+	}
+
+	char *ptr2 = buffer;
+	ptr = _cursor + 1;
+	unsigned uc, uc2;
+	while (*ptr != '\"') {
+		if (*ptr != '\\') {
+			*ptr2++ = *ptr++;
+			continue;
+		}
+		ptr++;
+		switch (*ptr) {
+		case 'b':
+			*ptr2++ = '\b';
+			break;
+		case 'f':
+			*ptr2++ = '\f';
+			break;
+		case 'n':
+			*ptr2++ = '\n';
+			break;
+		case 'r':
+			*ptr2++ = '\r';
+			break;
+		case 't':
+			*ptr2++ = '\t';
+			break;
+		case 'u': {
+			/* transcode utf16 to utf8. */
+			if (sscanf(ptr + 1, "%4x", &uc) != 1) uc = 0;
+			ptr += 4;
+			if ((uc >= 0xDC00 && uc <= 0xDFFF) || uc == 0) break;
+
+			if (uc >= 0xD800 && uc <= 0xDBFF) /* UTF16 surrogate pairs. */ {
+				if (ptr[1] != '\\' || ptr[2] != 'u') break;
+				if (sscanf(ptr + 3, "%4x", &uc2) != 1) uc2 = 0;
+				ptr += 6;
+				if (uc2 < 0xDC00 || uc2 > 0xDFFF) break;
+				uc = 0x10000 + (((uc & 0x3FF) << 10) | (uc2 & 0x3FF));
+			}
+
+			int len = 4;
+			if (uc < 0x80)
+				len = 1;
+			else if (uc < 0x800)
+				len = 2;
+			else if (uc < 0x10000)
+				len = 3;
+			ptr2 += len;
+			switch (len) {
+			case 4:
+				*--ptr2 = (char) ((uc | 0x80) & 0xBF);
+				uc >>= 6;
+				/* fallthrough */
+			case 3:
+				*--ptr2 = (char) ((uc | 0x80) & 0xBF);
+				uc >>= 6;
+				/* fallthrough */
+			case 2:
+				*--ptr2 = (char) ((uc | 0x80) & 0xBF);
+				uc >>= 6;
+				/* fallthrough */
+			case 1:
+				*--ptr2 = (char) (uc | firstByteMark[len]);
+			}
+			ptr2 += len;
+			break;
+		}
+		default:
+			*ptr2++ = *ptr;
+			break;
+		}
+		ptr++;
+	}
+	*ptr2 = 0;
+	_cursor = ptr + 1;
+	return true;
+}
+
+bool JsonReader::parseNumber(float &floatValue, int &intValue) {
+	const char *end = Json::parseNumber(_cursor, floatValue, intValue);
+	if (!end) {
+		fail(_cursor);
+		return false;
+	}
+	_cursor = end;
+	return true;
+}
+
+bool JsonReader::skipLiteral(const char *literal) {
+	size_t length = strlen(literal);
+	if (strncmp(_cursor, literal, length) != 0) {
+		fail(_cursor);
+		return false;
+	}
+	_cursor += length;
+	return true;
+}
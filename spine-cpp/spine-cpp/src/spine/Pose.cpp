@@ -0,0 +1,173 @@
+/******************************************************************************
+ * Spine Runtimes License Agreement
+ * Last updated January 1, 2020. Replaces all prior versions.
+ *
+ * Copyright (c) 2013-2020, Esoteric Software LLC
+ *
+ * Integration of the Spine Runtimes into software or otherwise creating
+ * derivative works of the Spine Runtimes is permitted under the terms and
+ * conditions of Section 2 of the Spine Editor License Agreement:
+ * http://esotericsoftware.com/spine-editor-license
+ *
+ * Otherwise, it is permitted to integrate the Spine Runtimes into software
+ * or otherwise create derivative works of the Spine Runtimes (collectively,
+ * "Products"), provided that each user of the Products must obtain their own
+ * Spine Editor license and redistribution of the Products in any form must
+ * include this license and copyright notice.
+ *
+ * THE SPINE RUNTIMES ARE PROVIDED BY ESOTERIC SOFTWARE LLC "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL ESOTERIC SOFTWARE LLC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES,
+ * BUSINESS INTERRUPTION, OR LOSS OF USE, DATA, OR PROFITS) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THE SPINE RUNTIMES, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+#ifdef SPINE_UE4
+#include "SpinePluginPrivatePCH.h"
+#endif
+
+#include <spine/Pose.h>
+
+#include <spine/BoneData.h>
+#include <spine/SkeletonData.h>
+#include <spine/Skin.h>
+#include <spine/SlotData.h>
+
+#include <string.h>
+
+using namespace spine;
+
+Pose::Pose(SkeletonData &skeletonData, Skin *skin) : _skeletonData(skeletonData), _skin(skin) {
+	_transforms.setSize(skeletonData.getBones().size() * TRANSFORM_ENTRIES, 0);
+	size_t slotCount = skeletonData.getSlots().size();
+	_attachments.setSize(slotCount, NULL);
+	_setupAttachments.setSize(slotCount, NULL);
+	_colors.setSize(slotCount, Color());
+	for (size_t i = 0; i < slotCount; i++)
+		_setupAttachments[i] = findAttachment(i, skeletonData.getSlots()[i]->getAttachmentName());
+	setToSetupPose();
+}
+
+Pose::~Pose() {
+}
+
+void Pose::setToSetupPose() {
+	Vector<BoneData *> &bones = _skeletonData.getBones();
+	for (size_t i = 0, n = bones.size(); i < n; i++) {
+		BoneData *data = bones[i];
+		float *values = &_transforms[i * TRANSFORM_ENTRIES];
+		values[X] = data->getX();
+		values[Y] = data->getY();
+		values[ROTATION] = data->getRotation();
+		values[SCALE_X] = data->getScaleX();
+		values[SCALE_Y] = data->getScaleY();
+		values[SHEAR_X] = data->getShearX();
+		values[SHEAR_Y] = data->getShearY();
+	}
+
+	Vector<SlotData *> &slots = _skeletonData.getSlots();
+	for (size_t i = 0, n = slots.size(); i < n; i++)
+		_colors[i].set(slots[i]->getColor());
+	if (_attachments.size() > 0)
+		memcpy(_attachments.buffer(), _setupAttachments.buffer(), _attachments.size() * sizeof(Attachment *));
+}
+
+void Pose::set(Pose &pose) {
+	assert(&pose._skeletonData == &_skeletonData);
+	if (&pose == this) return;
+	if (_transforms.size() > 0)
+		memcpy(_transforms.buffer(), pose._transforms.buffer(), _transforms.size() * sizeof(float));
+	for (size_t i = 0, n = _attachments.size(); i < n; i++) {
+		_attachments[i] = pose._attachments[i];
+		_colors[i] = pose._colors[i];
+	}
+}
+
+void Pose::mix(Pose &from, Pose &to, float alpha) {
+	assert(&from._skeletonData == &_skeletonData && &to._skeletonData == &_skeletonData);
+	for (size_t i = 0, n = _transforms.size(); i < n; i += TRANSFORM_ENTRIES) {
+		float *values = &_transforms[i], *fromValues = &from._transforms[i], *toValues = &to._transforms[i];
+		for (int ii = 0; ii < TRANSFORM_ENTRIES; ii++) {
+			float value = fromValues[ii], delta = toValues[ii] - value;
+			if (ii == ROTATION) delta -= (16384 - (int)(16384.499999999996 - delta / 360)) * 360;
+			values[ii] = value + delta * alpha;
+		}
+	}
+
+	Pose &attachments = alpha >= 0.5f ? to : from;
+	for (size_t i = 0, n = _colors.size(); i < n; i++) {
+		_attachments[i] = attachments._attachments[i];
+		Color &fromColor = from._colors[i], &toColor = to._colors[i];
+		_colors[i].set(fromColor.r + (toColor.r - fromColor.r) * alpha, fromColor.g + (toColor.g - fromColor.g) * alpha,
+			fromColor.b + (toColor.b - fromColor.b) * alpha, fromColor.a + (toColor.a - fromColor.a) * alpha);
+	}
+}
+
+void Pose::add(Pose &pose, float alpha) {
+	assert(&pose._skeletonData == &_skeletonData);
+	Vector<BoneData *> &bones = _skeletonData.getBones();
+	for (size_t i = 0, n = bones.size(); i < n; i++) {
+		BoneData *data = bones[i];
+		float *values = &_transforms[i * TRANSFORM_ENTRIES], *poseValues = &pose._transforms[i * TRANSFORM_ENTRIES];
+		float r = poseValues[ROTATION] - data->getRotation();
+		r -= (16384 - (int)(16384.499999999996 - r / 360)) * 360;
+		values[X] += (poseValues[X] - data->getX()) * alpha;
+		values[Y] += (poseValues[Y] - data->getY()) * alpha;
+		values[ROTATION] += r * alpha;
+		values[SCALE_X] += (poseValues[SCALE_X] - data->getScaleX()) * alpha;
+		values[SCALE_Y] += (poseValues[SCALE_Y] - data->getScaleY()) * alpha;
+		values[SHEAR_X] += (poseValues[SHEAR_X] - data->getShearX()) * alpha;
+		values[SHEAR_Y] += (poseValues[SHEAR_Y] - data->getShearY()) * alpha;
+	}
+}
+
+SkeletonData &Pose::getSkeletonData() {
+	return _skeletonData;
+}
+
+Skin *Pose::getSkin() {
+	return _skin;
+}
+
+size_t Pose::getBoneCount() {
+	return _transforms.size() / TRANSFORM_ENTRIES;
+}
+
+size_t Pose::getSlotCount() {
+	return _attachments.size();
+}
+
+float *Pose::getBoneTransform(size_t boneIndex) {
+	return &_transforms[boneIndex * TRANSFORM_ENTRIES];
+}
+
+Vector<float> &Pose::getTransforms() {
+	return _transforms;
+}
+
+Attachment *Pose::getAttachment(size_t slotIndex) {
+	return _attachments[slotIndex];
+}
+
+void Pose::setAttachment(size_t slotIndex, Attachment *attachment) {
+	_attachments[slotIndex] = attachment;
+}
+
+Attachment *Pose::findAttachment(size_t slotIndex, const String &attachmentName) {
+	if (attachmentName.isEmpty()) return NULL;
+	if (_skin) {
+		Attachment *attachment = _skin->getAttachment(slotIndex, attachmentName);
+		if (attachment) return attachment;
+	}
+	Skin *defaultSkin = _skeletonData.getDefaultSkin();
+	return defaultSkin ? defaultSkin->getAttachment(slotIndex, attachmentName) : NULL;
+}
+
+Color &Pose::getColor(size_t slotIndex) {
+	return _colors[slotIndex];
+}
@@ -34,12 +34,20 @@
 #include <spine/RTTI.h>
 #include <spine/SpineString.h>
 
+#include <assert.h>
+
 using namespace spine;
 
-RTTI::RTTI(const char *className) : _className(className), _pBaseRTTI(NULL) {
+// Static storage is zero initialized before any constructor runs, so this is valid during static initialization.
+const RTTI *RTTI::_all = NULL;
+
+RTTI::RTTI(const char *className) : _className(className), _pBaseRTTI(NULL), _depth(0), _next(NULL) {
+	registerInstance();
 }
 
-RTTI::RTTI(const char *className, const RTTI &baseRTTI) : _className(className), _pBaseRTTI(&baseRTTI) {
+RTTI::RTTI(const char *className, const RTTI &baseRTTI) : _className(className), _pBaseRTTI(&baseRTTI), _depth(0),
+	_next(NULL) {
+	registerInstance();
 }
 
 const char *RTTI::getClassName() const {
@@ -47,14 +55,42 @@ const char *RTTI::getClassName() const {
 }
 
 bool RTTI::isExactly(const RTTI &rtti) const {
-	return !strcmp(this->_className, rtti._className);
+	return this == &rtti;
 }
 
 bool RTTI::instanceOf(const RTTI &rtti) const {
-	const RTTI *pCompare = this;
-	while (pCompare) {
-		if (!strcmp(pCompare->_className, rtti._className)) return true;
-		pCompare = pCompare->_pBaseRTTI;
-	}
+	if (this == &rtti) return true;
+	if (_depth && rtti._depth) return rtti._depth <= _depth && _ancestors[rtti._depth - 1] == &rtti;
+
+	// Not resolved yet, only during static initialization.
+	for (const RTTI *pCompare = _pBaseRTTI; pCompare; pCompare = pCompare->_pBaseRTTI)
+		if (pCompare == &rtti) return true;
 	return false;
 }
+
+void RTTI::registerInstance() {
+	for (int i = 0; i < MAX_DEPTH; i++)
+		_ancestors[i] = NULL;
+	_next = _all;
+	_all = this;
+
+	// Instances are constructed in an unspecified order across translation units. Each new instance may complete the
+	// base chain of instances constructed before it.
+	for (const RTTI *rtti = _all; rtti; rtti = rtti->_next)
+		if (!rtti->_depth) rtti->resolve();
+}
+
+void RTTI::resolve() const {
+	int depth = 0;
+	for (const RTTI *rtti = this; rtti; rtti = rtti->_pBaseRTTI) {
+		// A base that has not been constructed yet is still zero initialized.
+		if (!rtti->_className) return;
+		depth++;
+	}
+	assert(depth <= MAX_DEPTH);
+
+	const RTTI *rtti = this;
+	for (int i = depth - 1; i >= 0; i--, rtti = rtti->_pBaseRTTI)
+		_ancestors[i] = rtti;
+	_depth = depth;
+}
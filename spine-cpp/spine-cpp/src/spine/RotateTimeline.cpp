@@ -38,7 +38,9 @@
 
 #include <spine/Bone.h>
 #include <spine/BoneData.h>
+#include <spine/SkeletonData.h>
 #include <spine/Animation.h>
+#include <spine/Pose.h>
 #include <spine/TimelineType.h>
 
 using namespace spine;
@@ -56,10 +58,18 @@ void RotateTimeline::apply(Skeleton &skeleton, float lastTime, float time, Vecto
 	SP_UNUSED(pEvents);
 	SP_UNUSED(direction);
 
+	if (isQuantized())
+		applyFrames(_quantizedFrames, skeleton, time, alpha, blend);
+	else
+		applyFrames(_frames, skeleton, time, alpha, blend);
+}
+
+template<typename T>
+void RotateTimeline::applyFrames(T &frames, Skeleton &skeleton, float time, float alpha, MixBlend blend) {
 	Bone *bone = skeleton.getBones()[_boneIndex];
 	if (!bone->_active) return;
 
-	if (time < _frames[0]) {
+	if (time < frames[0]) {
 		switch (blend) {
 		case MixBlend_Setup: {
 			bone->_rotation = bone->_data._rotation;
@@ -78,8 +88,8 @@ void RotateTimeline::apply(Skeleton &skeleton, float lastTime, float time, Vecto
 		return;
 	}
 
-	if (time >= _frames[_frames.size() - ENTRIES]) {
-		float r = _frames[_frames.size() + PREV_ROTATION];
+	if (time >= frames[frames.size() - ENTRIES]) {
+		float r = frames[frames.size() + PREV_ROTATION];
 		switch (blend) {
 			case MixBlend_Setup:
 				bone->_rotation = bone->_data._rotation + r * alpha;
@@ -96,12 +106,12 @@ void RotateTimeline::apply(Skeleton &skeleton, float lastTime, float time, Vecto
 	}
 
 	// Interpolate between the previous frame and the current frame.
-	int frame = Animation::binarySearch(_frames, time, ENTRIES);
-	float prevRotation = _frames[frame + PREV_ROTATION];
-	float frameTime = _frames[frame];
+	int frame = Animation::binarySearch(frames, time, ENTRIES);
+	float prevRotation = frames[frame + PREV_ROTATION];
+	float frameTime = frames[frame];
 	float percent = getCurvePercent((frame >> 1) - 1,
-		1 - (time - frameTime) / (_frames[frame + PREV_TIME] - frameTime));
-	float r = _frames[frame + ROTATION] - prevRotation;
+		1 - (time - frameTime) / (frames[frame + PREV_TIME] - frameTime));
+	float r = frames[frame + ROTATION] - prevRotation;
 	r = prevRotation + (r - (16384 - (int)(16384.499999999996 - r / 360)) * 360) * percent;
 	switch (blend) {
 		case MixBlend_Setup:
@@ -116,6 +126,50 @@ void RotateTimeline::apply(Skeleton &skeleton, float lastTime, float time, Vecto
 	}
 }
 
+void RotateTimeline::sample(Pose &pose, float time) {
+	if (isQuantized())
+		sampleFrames(_quantizedFrames, pose, time);
+	else
+		sampleFrames(_frames, pose, time);
+}
+
+template<typename T>
+void RotateTimeline::sampleFrames(T &frames, Pose &pose, float time) {
+	float *values = pose.getBoneTransform(_boneIndex);
+	getRotation(frames, time, pose.getSkeletonData().getBones()[_boneIndex]->_rotation, values[Pose::ROTATION]);
+}
+
+size_t RotateTimeline::quantize(float tolerance, CurveTable &curveTable) {
+	return quantizeFrames(_frames, ENTRIES, tolerance, curveTable);
+}
+
+bool RotateTimeline::getRotation(float time, float setupRotation, float &rotation) {
+	if (isQuantized()) return getRotation(_quantizedFrames, time, setupRotation, rotation);
+	return getRotation(_frames, time, setupRotation, rotation);
+}
+
+template<typename T>
+bool RotateTimeline::getRotation(T &frames, float time, float setupRotation, float &rotation) {
+	if (time < frames[0]) return false;
+
+	if (time >= frames[frames.size() - ENTRIES]) {
+		// Time is after last frame.
+		rotation = setupRotation + frames[frames.size() + PREV_ROTATION];
+		return true;
+	}
+
+	// Interpolate between the previous frame and the current frame.
+	int frame = Animation::binarySearch(frames, time, ENTRIES);
+	float prevRotation = frames[frame + PREV_ROTATION];
+	float frameTime = frames[frame];
+	float percent = getCurvePercent((frame >> 1) - 1, 1 - (time - frameTime) / (frames[frame + PREV_TIME] - frameTime));
+	float r = frames[frame + ROTATION] - prevRotation;
+	r -= (16384 - (int) (16384.499999999996 - r / 360)) * 360;
+	r = prevRotation + r * percent + setupRotation;
+	rotation = r - (16384 - (int) (16384.499999999996 - r / 360)) * 360;
+	return true;
+}
+
 int RotateTimeline::getPropertyId() {
 	return ((int) TimelineType_Rotate << 24) + _boneIndex;
 }
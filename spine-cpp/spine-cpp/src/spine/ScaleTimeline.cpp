@@ -40,6 +40,8 @@
 #include <spine/SlotData.h>
 #include <spine/Bone.h>
 #include <spine/BoneData.h>
+#include <spine/Pose.h>
+#include <spine/SkeletonData.h>
 
 using namespace spine;
 
@@ -54,12 +56,22 @@ void ScaleTimeline::apply(Skeleton &skeleton, float lastTime, float time, Vector
 	SP_UNUSED(lastTime);
 	SP_UNUSED(pEvents);
 
+	if (isQuantized())
+		applyFrames(_quantizedFrames, skeleton, time, alpha, blend, direction);
+	else
+		applyFrames(_frames, skeleton, time, alpha, blend, direction);
+}
+
+template<typename T>
+void ScaleTimeline::applyFrames(T &frames, Skeleton &skeleton, float time, float alpha, MixBlend blend,
+	MixDirection direction
+) {
 	Bone *boneP = skeleton._bones[_boneIndex];
 	Bone &bone = *boneP;
 
 	if (!bone._active) return;
 
-	if (time < _frames[0]) {
+	if (time < frames[0]) {
 		switch (blend) {
 		case MixBlend_Setup:
 			bone._scaleX = bone._data._scaleX;
@@ -74,21 +86,21 @@ void ScaleTimeline::apply(Skeleton &skeleton, float lastTime, float time, Vector
 	}
 
 	float x, y;
-	if (time >= _frames[_frames.size() - ENTRIES]) {
+	if (time >= frames[frames.size() - ENTRIES]) {
 		// Time is after last frame.
-		x = _frames[_frames.size() + PREV_X] * bone._data._scaleX;
-		y = _frames[_frames.size() + PREV_Y] * bone._data._scaleY;
+		x = frames[frames.size() + PREV_X] * bone._data._scaleX;
+		y = frames[frames.size() + PREV_Y] * bone._data._scaleY;
 	} else {
 		// Interpolate between the previous frame and the current frame.
-		int frame = Animation::binarySearch(_frames, time, ENTRIES);
-		x = _frames[frame + PREV_X];
-		y = _frames[frame + PREV_Y];
-		float frameTime = _frames[frame];
+		int frame = Animation::binarySearch(frames, time, ENTRIES);
+		x = frames[frame + PREV_X];
+		y = frames[frame + PREV_Y];
+		float frameTime = frames[frame];
 		float percent = getCurvePercent(frame / ENTRIES - 1,
-			1 - (time - frameTime) / (_frames[frame + PREV_TIME] - frameTime));
+			1 - (time - frameTime) / (frames[frame + PREV_TIME] - frameTime));
 
-		x = (x + (_frames[frame + X] - x) * percent) * bone._data._scaleX;
-		y = (y + (_frames[frame + Y] - y) * percent) * bone._data._scaleY;
+		x = (x + (frames[frame + X] - x) * percent) * bone._data._scaleX;
+		y = (y + (frames[frame + Y] - y) * percent) * bone._data._scaleY;
 	}
 
 	if (alpha == 1) {
@@ -148,6 +160,15 @@ void ScaleTimeline::apply(Skeleton &skeleton, float lastTime, float time, Vector
 	}
 }
 
+void ScaleTimeline::sample(Pose &pose, float time) {
+	float x, y;
+	if (!getValues(time, x, y)) return;
+	BoneData *data = pose.getSkeletonData().getBones()[_boneIndex];
+	float *values = pose.getBoneTransform(_boneIndex);
+	values[Pose::SCALE_X] = x * data->_scaleX;
+	values[Pose::SCALE_Y] = y * data->_scaleY;
+}
+
 int ScaleTimeline::getPropertyId() {
 	return ((int) TimelineType_Scale << 24) + _boneIndex;
 }
@@ -40,6 +40,8 @@
 #include <spine/SlotData.h>
 #include <spine/Bone.h>
 #include <spine/BoneData.h>
+#include <spine/Pose.h>
+#include <spine/SkeletonData.h>
 
 using namespace spine;
 
@@ -55,11 +57,19 @@ void ShearTimeline::apply(Skeleton &skeleton, float lastTime, float time, Vector
 	SP_UNUSED(pEvents);
 	SP_UNUSED(direction);
 
+	if (isQuantized())
+		applyFrames(_quantizedFrames, skeleton, time, alpha, blend);
+	else
+		applyFrames(_frames, skeleton, time, alpha, blend);
+}
+
+template<typename T>
+void ShearTimeline::applyFrames(T &frames, Skeleton &skeleton, float time, float alpha, MixBlend blend) {
 	Bone *boneP = skeleton._bones[_boneIndex];
 	Bone &bone = *boneP;
 	if (!bone._active) return;
 
-	if (time < _frames[0]) {
+	if (time < frames[0]) {
 		switch (blend) {
 		case MixBlend_Setup:
 			bone._shearX = bone._data._shearX;
@@ -74,21 +84,21 @@ void ShearTimeline::apply(Skeleton &skeleton, float lastTime, float time, Vector
 	}
 
 	float x, y;
-	if (time >= _frames[_frames.size() - ENTRIES]) {
+	if (time >= frames[frames.size() - ENTRIES]) {
 		// Time is after last frame.
-		x = _frames[_frames.size() + PREV_X];
-		y = _frames[_frames.size() + PREV_Y];
+		x = frames[frames.size() + PREV_X];
+		y = frames[frames.size() + PREV_Y];
 	} else {
 		// Interpolate between the previous frame and the current frame.
-		int frame = Animation::binarySearch(_frames, time, ENTRIES);
-		x = _frames[frame + PREV_X];
-		y = _frames[frame + PREV_Y];
-		float frameTime = _frames[frame];
+		int frame = Animation::binarySearch(frames, time, ENTRIES);
+		x = frames[frame + PREV_X];
+		y = frames[frame + PREV_Y];
+		float frameTime = frames[frame];
 		float percent = getCurvePercent(frame / ENTRIES - 1,
-			1 - (time - frameTime) / (_frames[frame + PREV_TIME] - frameTime));
+			1 - (time - frameTime) / (frames[frame + PREV_TIME] - frameTime));
 
-		x = x + (_frames[frame + X] - x) * percent;
-		y = y + (_frames[frame + Y] - y) * percent;
+		x = x + (frames[frame + X] - x) * percent;
+		y = y + (frames[frame + Y] - y) * percent;
 	}
 
 	switch (blend) {
@@ -107,6 +117,15 @@ void ShearTimeline::apply(Skeleton &skeleton, float lastTime, float time, Vector
 	}
 }
 
+void ShearTimeline::sample(Pose &pose, float time) {
+	float x, y;
+	if (!getValues(time, x, y)) return;
+	BoneData *data = pose.getSkeletonData().getBones()[_boneIndex];
+	float *values = pose.getBoneTransform(_boneIndex);
+	values[Pose::SHEAR_X] = data->_shearX + x;
+	values[Pose::SHEAR_Y] = data->_shearY + y;
+}
+
 int ShearTimeline::getPropertyId() {
 	return ((int) TimelineType_Shear << 24) + _boneIndex;
 }
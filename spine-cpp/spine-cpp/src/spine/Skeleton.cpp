@@ -35,8 +35,10 @@
 
 #include <spine/SkeletonData.h>
 #include <spine/Bone.h>
+#include <spine/BoneTransforms.h>
 #include <spine/Slot.h>
 #include <spine/IkConstraint.h>
+#include <spine/Pose.h>
 #include <spine/PathConstraint.h>
 #include <spine/TransformConstraint.h>
 #include <spine/Skin.h>
@@ -59,6 +61,12 @@ using namespace spine;
 
 Skeleton::Skeleton(SkeletonData *skeletonData) :
 		_data(skeletonData),
+		_boneTransforms(NULL),
+		_lodFrom(NULL),
+		_lodTo(NULL),
+		_lodPose(NULL),
+		_lodStep(0),
+		_lodPosed(false),
 		_skin(NULL),
 		_color(1, 1, 1, 1),
 		_time(0),
@@ -130,6 +138,10 @@ Skeleton::~Skeleton() {
 	ContainerUtil::cleanUpVectorOfPointers(_ikConstraints);
 	ContainerUtil::cleanUpVectorOfPointers(_transformConstraints);
 	ContainerUtil::cleanUpVectorOfPointers(_pathConstraints);
+	delete _boneTransforms;
+	delete _lodFrom;
+	delete _lodTo;
+	delete _lodPose;
 }
 
 void Skeleton::updateCache() {
@@ -195,6 +207,8 @@ void Skeleton::updateCache() {
 	for (i = 0; i < n; ++i) {
 		sortBone(_bones[i]);
 	}
+
+	if (_boneTransforms) _boneTransforms->updateCache();
 }
 
 void Skeleton::printUpdateCache() {
@@ -213,6 +227,11 @@ void Skeleton::printUpdateCache() {
 }
 
 void Skeleton::updateWorldTransform() {
+	if (_boneTransforms) {
+		_boneTransforms->updateWorldTransform();
+		return;
+	}
+
 	for (size_t i = 0, n = _updateCacheReset.size(); i < n; ++i) {
 		Bone *boneP = _updateCacheReset[i];
 		Bone &bone = *boneP;
@@ -226,11 +245,36 @@ void Skeleton::updateWorldTransform() {
 		bone._appliedValid = true;
 	}
 
+	if (_lodLevel.constraintThreshold > 0) {
+		for (size_t i = 0, n = _updateCache.size(); i < n; ++i)
+			if (!isLodSkipped(*_updateCache[i])) _updateCache[i]->update();
+		return;
+	}
+
 	for (size_t i = 0, n = _updateCache.size(); i < n; ++i) {
 		_updateCache[i]->update();
 	}
 }
 
+bool Skeleton::isLodSkipped(Updatable &updatable) {
+	const RTTI &rtti = updatable.getRTTI();
+	float mix;
+	if (rtti.isExactly(IkConstraint::rtti))
+		mix = static_cast<IkConstraint &>(updatable).getMix();
+	else if (rtti.isExactly(TransformConstraint::rtti)) {
+		TransformConstraint &constraint = static_cast<TransformConstraint &>(updatable);
+		mix = MathUtil::max(MathUtil::max(constraint.getRotateMix(), constraint.getTranslateMix()),
+			MathUtil::max(constraint.getScaleMix(), constraint.getShearMix()));
+	} else if (rtti.isExactly(PathConstraint::rtti)) {
+		PathConstraint &constraint = static_cast<PathConstraint &>(updatable);
+		mix = MathUtil::max(constraint.getRotateMix(), constraint.getTranslateMix());
+	} else
+		return false;
+	if (mix >= _lodLevel.constraintThreshold) return false;
+	_lodCounters.skippedConstraints++;
+	return true;
+}
+
 void Skeleton::setToSetupPose() {
 	setBonesToSetupPose();
 	setSlotsToSetupPose();
@@ -286,20 +330,68 @@ void Skeleton::setSlotsToSetupPose() {
 	}
 }
 
+void Skeleton::applyPose(Pose &pose) {
+	assert(&pose.getSkeletonData() == _data);
+	for (size_t i = 0, n = _bones.size(); i < n; ++i) {
+		Bone &bone = *_bones[i];
+		float *values = pose.getBoneTransform(i);
+		bone._x = values[Pose::X];
+		bone._y = values[Pose::Y];
+		bone._rotation = values[Pose::ROTATION];
+		bone._scaleX = values[Pose::SCALE_X];
+		bone._scaleY = values[Pose::SCALE_Y];
+		bone._shearX = values[Pose::SHEAR_X];
+		bone._shearY = values[Pose::SHEAR_Y];
+	}
+
+	for (size_t i = 0, n = _slots.size(); i < n; ++i) {
+		Slot &slot = *_slots[i];
+		Attachment *attachment = pose.getAttachment(i);
+		if (slot._attachment != attachment) slot.setAttachment(attachment);
+		slot._color.set(pose.getColor(i));
+	}
+}
+
+void Skeleton::getPose(Pose &pose) {
+	assert(&pose.getSkeletonData() == _data);
+	for (size_t i = 0, n = _bones.size(); i < n; ++i) {
+		Bone &bone = *_bones[i];
+		float *values = pose.getBoneTransform(i);
+		values[Pose::X] = bone._x;
+		values[Pose::Y] = bone._y;
+		values[Pose::ROTATION] = bone._rotation;
+		values[Pose::SCALE_X] = bone._scaleX;
+		values[Pose::SCALE_Y] = bone._scaleY;
+		values[Pose::SHEAR_X] = bone._shearX;
+		values[Pose::SHEAR_Y] = bone._shearY;
+	}
+
+	for (size_t i = 0, n = _slots.size(); i < n; ++i) {
+		Slot &slot = *_slots[i];
+		pose.setAttachment(i, slot._attachment);
+		pose.getColor(i).set(slot._color);
+	}
+}
+
 Bone *Skeleton::findBone(const String &boneName) {
-	return ContainerUtil::findWithDataName(_bones, boneName);
+	int index = findBoneIndex(boneName);
+	return index == -1 ? NULL : _bones[index];
 }
 
 int Skeleton::findBoneIndex(const String &boneName) {
-	return ContainerUtil::findIndexWithDataName(_bones, boneName);
+	// Bones are created in the same order as the skeleton data's bones.
+	int index = _data->findBoneIndex(boneName);
+	return index < (int) _bones.size() ? index : -1;
 }
 
 Slot *Skeleton::findSlot(const String &slotName) {
-	return ContainerUtil::findWithDataName(_slots, slotName);
+	int index = findSlotIndex(slotName);
+	return index == -1 ? NULL : _slots[index];
 }
 
 int Skeleton::findSlotIndex(const String &slotName) {
-	return ContainerUtil::findIndexWithDataName(_slots, slotName);
+	int index = _data->findSlotIndex(slotName);
+	return index < (int) _slots.size() ? index : -1;
 }
 
 void Skeleton::setSkin(const String &skinName) {
@@ -352,20 +444,19 @@ Attachment *Skeleton::getAttachment(int slotIndex, const String &attachmentName)
 void Skeleton::setAttachment(const String &slotName, const String &attachmentName) {
 	assert(slotName.length() > 0);
 
-	for (size_t i = 0, n = _slots.size(); i < n; ++i) {
+	int i = findSlotIndex(slotName);
+	if (i != -1) {
 		Slot *slot = _slots[i];
-		if (slot->_data.getName() == slotName) {
-			Attachment *attachment = NULL;
-			if (attachmentName.length() > 0) {
-				attachment = getAttachment(i, attachmentName);
+		Attachment *attachment = NULL;
+		if (attachmentName.length() > 0) {
+			attachment = getAttachment(i, attachmentName);
 
-				assert(attachment != NULL);
-			}
+			assert(attachment != NULL);
+		}
 
-			slot->setAttachment(attachment);
+		slot->setAttachment(attachment);
 
-			return;
-		}
+		return;
 	}
 
 	printf("Slot not found: %s", slotName.buffer());
@@ -376,39 +467,22 @@ void Skeleton::setAttachment(const String &slotName, const String &attachmentNam
 IkConstraint *Skeleton::findIkConstraint(const String &constraintName) {
 	assert(constraintName.length() > 0);
 
-	for (size_t i = 0, n = _ikConstraints.size(); i < n; ++i) {
-		IkConstraint *ikConstraint = _ikConstraints[i];
-		if (ikConstraint->_data.getName() == constraintName) {
-			return ikConstraint;
-		}
-	}
-	return NULL;
+	int index = _data->findIkConstraintIndex(constraintName);
+	return index != -1 && index < (int) _ikConstraints.size() ? _ikConstraints[index] : NULL;
 }
 
 TransformConstraint *Skeleton::findTransformConstraint(const String &constraintName) {
 	assert(constraintName.length() > 0);
 
-	for (size_t i = 0, n = _transformConstraints.size(); i < n; ++i) {
-		TransformConstraint *transformConstraint = _transformConstraints[i];
-		if (transformConstraint->_data.getName() == constraintName) {
-			return transformConstraint;
-		}
-	}
-
-	return NULL;
+	int index = _data->findTransformConstraintIndex(constraintName);
+	return index != -1 && index < (int) _transformConstraints.size() ? _transformConstraints[index] : NULL;
 }
 
 PathConstraint *Skeleton::findPathConstraint(const String &constraintName) {
 	assert(constraintName.length() > 0);
 
-	for (size_t i = 0, n = _pathConstraints.size(); i < n; ++i) {
-		PathConstraint *constraint = _pathConstraints[i];
-		if (constraint->_data.getName() == constraintName) {
-			return constraint;
-		}
-	}
-
-	return NULL;
+	int index = _data->findPathConstraintIndex(constraintName);
+	return index != -1 && index < (int) _pathConstraints.size() ? _pathConstraints[index] : NULL;
 }
 
 void Skeleton::update(float delta) {
@@ -499,6 +573,54 @@ Vector<TransformConstraint *> &Skeleton::getTransformConstraints() {
 	return _transformConstraints;
 }
 
+bool Skeleton::isBoneTransformsEnabled() {
+	return _boneTransforms != NULL;
+}
+
+void Skeleton::setBoneTransformsEnabled(bool inValue) {
+	if (inValue == (_boneTransforms != NULL)) return;
+	if (inValue) {
+		_boneTransforms = new(__FILE__, __LINE__) BoneTransforms(*this);
+	} else {
+		delete _boneTransforms;
+		_boneTransforms = NULL;
+	}
+}
+
+BoneTransforms *Skeleton::getBoneTransforms() {
+	return _boneTransforms;
+}
+
+const LodLevel &Skeleton::getLodLevel() {
+	return _lodLevel;
+}
+
+void Skeleton::setLodLevel(const LodLevel &inValue) {
+	bool interpolate = inValue.updateInterval > 1;
+	if (interpolate != (_lodLevel.updateInterval > 1)) {
+		_lodStep = 0;
+		_lodPosed = false;
+	}
+	_lodLevel = inValue;
+	if (interpolate) {
+		if (!_lodPose) {
+			_lodFrom = new(__FILE__, __LINE__) Pose(*_data);
+			_lodTo = new(__FILE__, __LINE__) Pose(*_data);
+			_lodPose = new(__FILE__, __LINE__) Pose(*_data);
+		}
+		if (_lodStep >= _lodLevel.updateInterval) _lodStep = 0;
+	} else if (_lodPose) {
+		delete _lodFrom;
+		delete _lodTo;
+		delete _lodPose;
+		_lodFrom = _lodTo = _lodPose = NULL;
+	}
+}
+
+LodCounters &Skeleton::getLodCounters() {
+	return _lodCounters;
+}
+
 Skin *Skeleton::getSkin() {
 	return _skin;
 }
@@ -73,6 +73,7 @@
 #include <spine/DrawOrderTimeline.h>
 #include <spine/EventTimeline.h>
 #include <spine/Event.h>
+#include <spine/JobRunner.h>
 
 using namespace spine;
 
@@ -94,16 +95,25 @@ const int SkeletonBinary::CURVE_STEPPED = 1;
 const int SkeletonBinary::CURVE_BEZIER = 2;
 
 SkeletonBinary::SkeletonBinary(Atlas *atlasArray) : _attachmentLoader(
-		new(__FILE__, __LINE__) AtlasAttachmentLoader(atlasArray)), _error(), _scale(1), _ownsLoader(true) {
+		new(__FILE__, __LINE__) AtlasAttachmentLoader(atlasArray)), _error(), _scale(1), _ownsLoader(true), _arenaEnabled(false),
+		_lazyAnimationsEnabled(false), _jobRunner(NULL), _curveLookupEnabled(false), _quantizeTolerance(0),
+		_quantizedBytesSaved(0) {
 
 }
 
 SkeletonBinary::SkeletonBinary(AttachmentLoader *attachmentLoader) : _attachmentLoader(attachmentLoader), _error(),
-	_scale(1), _ownsLoader(false)
+	_scale(1), _ownsLoader(false), _arenaEnabled(false), _lazyAnimationsEnabled(false),
+	_jobRunner(NULL), _curveLookupEnabled(false), _quantizeTolerance(0), _quantizedBytesSaved(0)
 {
 	assert(_attachmentLoader != NULL);
 }
 
+SkeletonBinary::SkeletonBinary(float scale) : _attachmentLoader(NULL), _error(), _scale(scale), _ownsLoader(false),
+	_arenaEnabled(false), _lazyAnimationsEnabled(false), _jobRunner(NULL), _curveLookupEnabled(false), _quantizeTolerance(0),
+	_quantizedBytesSaved(0)
+{
+}
+
 SkeletonBinary::~SkeletonBinary() {
 	ContainerUtil::cleanUpVectorOfPointers(_linkedMeshes);
 	_linkedMeshes.clear();
@@ -122,6 +132,7 @@ SkeletonData *SkeletonBinary::readSkeletonData(const unsigned char *binary, cons
 	_linkedMeshes.clear();
 
 	skeletonData = new(__FILE__, __LINE__) SkeletonData();
+	ArenaScope arenaScope(_arenaEnabled ? &skeletonData->getArena() : Arena::getCurrent());
 
 	char *skeletonData_hash = readString(input);
 	skeletonData->_hash.own(skeletonData_hash);
@@ -273,16 +284,24 @@ SkeletonData *SkeletonBinary::readSkeletonData(const unsigned char *binary, cons
 		skeletonData->_pathConstraints[i] = data;
 	}
 
-	/* Default skin. */
-	Skin* defaultSkin = readSkin(input, true, skeletonData, nonessential);
-	if (defaultSkin) {
-		skeletonData->_defaultSkin = defaultSkin;
-		skeletonData->_skins.add(defaultSkin);
-	}
+	if (_jobRunner) {
+		if (!readSkinsParallel(input, skeletonData, nonessential)) {
+			delete input;
+			delete skeletonData;
+			return NULL;
+		}
+	} else {
+		/* Default skin. */
+		Skin* defaultSkin = readSkin(input, true, skeletonData, nonessential);
+		if (defaultSkin) {
+			skeletonData->_defaultSkin = defaultSkin;
+			skeletonData->_skins.add(defaultSkin);
+		}
 
-	/* Skins. */
-	for (size_t i = 0, n = (size_t)readVarint(input, true); i < n; ++i)
-		skeletonData->_skins.add(readSkin(input, false, skeletonData, nonessential));
+		/* Skins. */
+		for (size_t i = 0, n = (size_t)readVarint(input, true); i < n; ++i)
+			skeletonData->_skins.add(readSkin(input, false, skeletonData, nonessential));
+	}
 
 	/* Linked meshes. */
 	for (int i = 0, n = _linkedMeshes.size(); i < n; ++i) {
@@ -328,6 +347,26 @@ SkeletonData *SkeletonBinary::readSkeletonData(const unsigned char *binary, cons
 	}
 
 	/* Animations. */
+	if (_lazyAnimationsEnabled) {
+		if (!readLazyAnimations(input, skeletonData)) {
+			delete input;
+			delete skeletonData;
+			return NULL;
+		}
+		delete input;
+		prepareSkeletonData(skeletonData);
+		return skeletonData;
+	}
+	if (_jobRunner) {
+		if (!readAnimationsParallel(input, skeletonData)) {
+			delete input;
+			delete skeletonData;
+			return NULL;
+		}
+		delete input;
+		prepareSkeletonData(skeletonData);
+		return skeletonData;
+	}
 	int animationsCount = readVarint(input, true);
 	skeletonData->_animations.setSize(animationsCount, 0);
 	for (int i = 0; i < animationsCount; ++i) {
@@ -342,19 +381,31 @@ SkeletonData *SkeletonBinary::readSkeletonData(const unsigned char *binary, cons
 	}
 
 	delete input;
+	prepareSkeletonData(skeletonData);
 	return skeletonData;
 }
 
+void SkeletonBinary::prepareSkeletonData(SkeletonData *skeletonData) {
+	skeletonData->updateNameIndices();
+	_quantizedBytesSaved = 0;
+	for (size_t i = 0; i < skeletonData->_animations.size(); ++i) {
+		Animation *animation = skeletonData->_animations[i];
+		if (_curveLookupEnabled) animation->buildCurveLookup();
+		if (_quantizeTolerance > 0) _quantizedBytesSaved += animation->quantize(_quantizeTolerance);
+	}
+}
+
 SkeletonData *SkeletonBinary::readSkeletonDataFile(const String &path) {
 	int length;
 	SkeletonData *skeletonData;
-	const char *binary = SpineExtension::readFile(path.buffer(), &length);
+	const char *binary = SpineExtension::mapFile(path.buffer(), &length);
 	if (length == 0 || !binary) {
+		if (binary) SpineExtension::unmapFile(binary, length);
 		setError("Unable to read skeleton file: ", path.buffer());
 		return NULL;
 	}
 	skeletonData = readSkeletonData((unsigned char *) binary, length);
-	SpineExtension::free(binary, __FILE__, __LINE__);
+	SpineExtension::unmapFile(binary, length);
 	return skeletonData;
 }
 
@@ -364,6 +415,7 @@ void SkeletonBinary::setError(const char *value1, const char *value2) {
 	strcpy(message, value1);
 	length = (int) strlen(value1);
 	if (value2) strncat(message + length, value2, 255 - length);
+	ArenaScope heapScope(NULL);
 	_error = String(message);
 }
 
@@ -380,7 +432,7 @@ char *SkeletonBinary::readString(DataInput *input) {
 
 char* SkeletonBinary::readStringRef(DataInput* input, SkeletonData* skeletonData) {
 	int index = readVarint(input, true);
-	return index == 0 ? nullptr : skeletonData->_strings[index - 1];
+	return index == 0 ? NULL : skeletonData->_strings[index - 1];
 }
 
 float SkeletonBinary::readFloat(DataInput *input) {
@@ -553,6 +605,8 @@ Attachment *SkeletonBinary::readAttachment(DataInput *input, Skin *skin, int slo
 			mesh->_height = readFloat(input) * _scale;
 		}
 
+		// Linked meshes are owned by this loader, not the skeleton data, so they must not use its arena.
+		ArenaScope heapScope(NULL);
 		LinkedMesh *linkedMesh = new(__FILE__, __LINE__) LinkedMesh(mesh, String(skinName), slotIndex,
 																	String(parent), inheritDeform);
 		_linkedMeshes.add(linkedMesh);
@@ -659,10 +713,431 @@ void SkeletonBinary::readShortArray(DataInput *input, Vector<unsigned short> &ar
 	}
 }
 
+namespace spine {
+/// Decodes the timelines of lazily loaded animations from a copy of the binary's animation section.
+class BinaryTimelineLoader : public TimelineLoader {
+public:
+	BinaryTimelineLoader(SkeletonData &skeletonData, float scale) :
+		_skeletonData(skeletonData), _binary(scale), _data(NULL), _length(0) {
+	}
+
+	virtual ~BinaryTimelineLoader() {
+		SpineExtension::free(_data, __FILE__, __LINE__);
+	}
+
+	void setData(const unsigned char *data, size_t length) {
+		_data = SpineExtension::alloc<unsigned char>(length, __FILE__, __LINE__);
+		memcpy(_data, data, length);
+		_length = length;
+	}
+
+	void addAnimation(Animation *animation, size_t offset) {
+		_offsets.put(animation, offset);
+	}
+
+	virtual bool loadTimelines(Animation &animation, Vector<Timeline *> &timelines) {
+		size_t *offset = _offsets.get(&animation);
+		if (!offset) return false;
+		SkeletonBinary::DataInput input;
+		input.cursor = _data + *offset;
+		input.end = _data + _length;
+		float duration = 0;
+		return _binary.readTimelines(&input, &_skeletonData, timelines, duration);
+	}
+
+private:
+	SkeletonData &_skeletonData;
+	SkeletonBinary _binary;
+	unsigned char *_data;
+	size_t _length;
+	HashMap<Animation *, size_t> _offsets;
+};
+}
+
+bool SkeletonBinary::readLazyAnimations(DataInput *input, SkeletonData *skeletonData) {
+	int animationsCount = readVarint(input, true);
+	skeletonData->_animations.setSize(animationsCount, 0);
+
+	BinaryTimelineLoader *loader = new(__FILE__, __LINE__) BinaryTimelineLoader(*skeletonData, _scale);
+	skeletonData->_timelineLoader = loader;
+	const unsigned char *start = input->cursor;
+	for (int i = 0; i < animationsCount; ++i) {
+		String name(readString(input), true);
+		size_t offset = (size_t) (input->cursor - start);
+		float duration = 0;
+		if (!skipTimelines(input, skeletonData, duration)) {
+			setError("Invalid animation: ", name.buffer());
+			return false;
+		}
+		Animation *animation = new(__FILE__, __LINE__) Animation(name, duration, loader);
+		loader->addAnimation(animation, offset);
+		skeletonData->_animations[i] = animation;
+	}
+	loader->setData(start, (size_t) (input->cursor - start));
+	return true;
+}
+
+float SkeletonBinary::skipCurveFrames(DataInput *input, int frameCount, int valueBytes) {
+	float time = 0;
+	for (int frameIndex = 0; frameIndex < frameCount; ++frameIndex) {
+		time = readFloat(input);
+		input->cursor += valueBytes;
+		if (frameIndex < frameCount - 1 && readByte(input) == CURVE_BEZIER) input->cursor += 16;
+	}
+	return time;
+}
+
+bool SkeletonBinary::skipTimelines(DataInput *input, SkeletonData *skeletonData, float &duration) {
+	// Slot timelines.
+	for (int i = 0, n = readVarint(input, true); i < n; ++i) {
+		readVarint(input, true);
+		for (int ii = 0, nn = readVarint(input, true); ii < nn; ++ii) {
+			unsigned char timelineType = readByte(input);
+			int frameCount = readVarint(input, true);
+			float time = 0;
+			switch (timelineType) {
+				case SLOT_ATTACHMENT:
+					for (int frameIndex = 0; frameIndex < frameCount; ++frameIndex) {
+						time = readFloat(input);
+						readVarint(input, true);
+					}
+					break;
+				case SLOT_COLOR:
+					time = skipCurveFrames(input, frameCount, 4);
+					break;
+				case SLOT_TWO_COLOR:
+					time = skipCurveFrames(input, frameCount, 8);
+					break;
+				default:
+					return false;
+			}
+			duration = MathUtil::max(duration, time);
+		}
+	}
+
+	// Bone timelines.
+	for (int i = 0, n = readVarint(input, true); i < n; ++i) {
+		readVarint(input, true);
+		for (int ii = 0, nn = readVarint(input, true); ii < nn; ++ii) {
+			unsigned char timelineType = readByte(input);
+			int frameCount = readVarint(input, true);
+			if (timelineType == BONE_ROTATE)
+				duration = MathUtil::max(duration, skipCurveFrames(input, frameCount, 4));
+			else if (timelineType == BONE_TRANSLATE || timelineType == BONE_SCALE || timelineType == BONE_SHEAR)
+				duration = MathUtil::max(duration, skipCurveFrames(input, frameCount, 8));
+			else
+				return false;
+		}
+	}
+
+	// IK timelines: mix, softness, bend direction, compress and stretch.
+	for (int i = 0, n = readVarint(input, true); i < n; ++i) {
+		readVarint(input, true);
+		int frameCount = readVarint(input, true);
+		duration = MathUtil::max(duration, skipCurveFrames(input, frameCount, 11));
+	}
+
+	// Transform constraint timelines.
+	for (int i = 0, n = readVarint(input, true); i < n; ++i) {
+		readVarint(input, true);
+		int frameCount = readVarint(input, true);
+		duration = MathUtil::max(duration, skipCurveFrames(input, frameCount, 16));
+	}
+
+	// Path constraint timelines.
+	for (int i = 0, n = readVarint(input, true); i < n; ++i) {
+		readVarint(input, true);
+		for (int ii = 0, nn = readVarint(input, true); ii < nn; ++ii) {
+			int timelineType = readSByte(input);
+			int frameCount = readVarint(input, true);
+			if (timelineType == PATH_POSITION || timelineType == PATH_SPACING)
+				duration = MathUtil::max(duration, skipCurveFrames(input, frameCount, 4));
+			else if (timelineType == PATH_MIX)
+				duration = MathUtil::max(duration, skipCurveFrames(input, frameCount, 8));
+			else
+				return false;
+		}
+	}
+
+	// Deform timelines. Their attachments are checked like when the timelines are read, so a missing attachment fails
+	// loading the skeleton data instead of leaving the animation without timelines when it is loaded on demand.
+	for (int i = 0, n = readVarint(input, true); i < n; ++i) {
+		int skinIndex = readVarint(input, true);
+		if (skinIndex < 0 || skinIndex >= (int) skeletonData->_skins.size()) return false;
+		Skin *skin = skeletonData->_skins[skinIndex];
+		for (int ii = 0, nn = readVarint(input, true); ii < nn; ++ii) {
+			int slotIndex = readVarint(input, true);
+			for (int iii = 0, nnn = readVarint(input, true); iii < nnn; iii++) {
+				const char *attachmentName = readStringRef(input, skeletonData);
+				if (!attachmentName || !skin->getAttachment(slotIndex, String(attachmentName))) return false;
+				int frameCount = readVarint(input, true);
+				float time = 0;
+				for (int frameIndex = 0; frameIndex < frameCount; ++frameIndex) {
+					time = readFloat(input);
+					int end = readVarint(input, true);
+					if (end != 0) {
+						readVarint(input, true);
+						input->cursor += end * 4;
+					}
+					if (frameIndex < frameCount - 1 && readByte(input) == CURVE_BEZIER) input->cursor += 16;
+				}
+				duration = MathUtil::max(duration, time);
+			}
+		}
+	}
+
+	// Draw order timeline.
+	for (int i = 0, n = readVarint(input, true); i < n; ++i) {
+		duration = MathUtil::max(duration, readFloat(input));
+		for (int ii = 0, nn = readVarint(input, true); ii < nn; ++ii) {
+			readVarint(input, true);
+			readVarint(input, true);
+		}
+	}
+
+	// Event timeline.
+	for (int i = 0, n = readVarint(input, true); i < n; ++i) {
+		duration = MathUtil::max(duration, readFloat(input));
+		EventData *eventData = skeletonData->_events[readVarint(input, true)];
+		readVarint(input, false);
+		readFloat(input);
+		if (readBoolean(input)) {
+			int length = readVarint(input, true);
+			input->cursor += length > 0 ? length - 1 : 0;
+		}
+		if (!eventData->_audioPath.isEmpty()) input->cursor += 8;
+	}
+	return input->cursor <= input->end;
+}
+
+namespace spine {
+/// Decodes skins or animations of a binary, one per job. Each job has its own SkeletonBinary as scratch for errors and
+/// linked meshes, so the results can be merged in the serial order afterward.
+class BinarySectionJob : public Job {
+public:
+	BinarySectionJob(SkeletonBinary &binary, SkeletonData *skeletonData, Vector<const unsigned char *> &starts,
+		const unsigned char *end, bool animations, bool nonessential
+	) : _skeletonData(skeletonData), _starts(starts), _end(end), _animations(animations), _nonessential(nonessential) {
+		for (size_t i = 0; i < starts.size(); i++) {
+			SkeletonBinary *scratch;
+			if (animations)
+				scratch = new(__FILE__, __LINE__) SkeletonBinary(binary._scale);
+			else {
+				scratch = new(__FILE__, __LINE__) SkeletonBinary(binary._attachmentLoader);
+				scratch->_scale = binary._scale;
+			}
+			_binaries.add(scratch);
+		}
+		_results.setSize(starts.size(), NULL);
+	}
+
+	virtual ~BinarySectionJob() {
+		ContainerUtil::cleanUpVectorOfPointers(_binaries);
+	}
+
+	virtual void run(int index) {
+		// Other threads must not allocate from the arena, so all jobs use the heap for the same results everywhere.
+		ArenaScope heapScope(NULL);
+		SkeletonBinary::DataInput input;
+		input.cursor = _starts[index];
+		input.end = _end;
+		SkeletonBinary &binary = *_binaries[index];
+		if (_animations) {
+			String name(binary.readString(&input), true);
+			_results[index] = binary.readAnimation(name, &input, _skeletonData);
+		} else
+			_results[index] = binary.readSkin(&input, index == 0, _skeletonData, _nonessential);
+	}
+
+	Vector<SkeletonBinary *> _binaries;
+	Vector<void *> _results;
+
+private:
+	SkeletonData *_skeletonData;
+	Vector<const unsigned char *> &_starts;
+	const unsigned char *_end;
+	bool _animations;
+	bool _nonessential;
+};
+}
+
+bool SkeletonBinary::readSkinsParallel(DataInput *input, SkeletonData *skeletonData, bool nonessential) {
+	// Find where each skin starts. The default skin comes first.
+	Vector<const unsigned char *> starts;
+	starts.add(input->cursor);
+	if (!skipSkin(input, true, nonessential)) {
+		setError("Invalid default skin.", NULL);
+		return false;
+	}
+	for (int i = 0, n = readVarint(input, true); i < n; ++i) {
+		starts.add(input->cursor);
+		if (!skipSkin(input, false, nonessential)) {
+			setError("Invalid skin.", NULL);
+			return false;
+		}
+	}
+
+	BinarySectionJob job(*this, skeletonData, starts, input->end, false, nonessential);
+	_jobRunner->run(job, (int) starts.size());
+
+	// Merge in the serial order, so the skins and the order linked meshes are resolved match a serial read.
+	bool failed = false;
+	for (size_t i = 0; i < starts.size(); i++) {
+		SkeletonBinary *scratch = job._binaries[i];
+		Skin *skin = (Skin *) job._results[i];
+		if (!failed && !scratch->_error.isEmpty()) {
+			failed = true;
+			setError(scratch->_error.buffer(), NULL);
+		}
+		if (failed) {
+			delete skin;
+			continue;
+		}
+		_linkedMeshes.addAll(scratch->_linkedMeshes);
+		scratch->_linkedMeshes.clear();
+		if (!skin) continue;
+		if (i == 0) skeletonData->_defaultSkin = skin;
+		skeletonData->_skins.add(skin);
+	}
+	return !failed;
+}
+
+bool SkeletonBinary::readAnimationsParallel(DataInput *input, SkeletonData *skeletonData) {
+	int animationsCount = readVarint(input, true);
+	skeletonData->_animations.setSize(animationsCount, 0);
+	Vector<const unsigned char *> starts;
+	for (int i = 0; i < animationsCount; ++i) {
+		starts.add(input->cursor);
+		int nameLength = readVarint(input, true);
+		input->cursor += nameLength > 0 ? nameLength - 1 : 0;
+		float duration = 0;
+		if (!skipTimelines(input, skeletonData, duration)) {
+			setError("Invalid animation.", NULL);
+			return false;
+		}
+	}
+
+	BinarySectionJob job(*this, skeletonData, starts, input->end, true, false);
+	_jobRunner->run(job, animationsCount);
+
+	bool failed = false;
+	for (int i = 0; i < animationsCount; ++i) {
+		Animation *animation = (Animation *) job._results[i];
+		if (!animation && !failed) {
+			failed = true;
+			setError(job._binaries[i]->_error.buffer(), NULL);
+		}
+		skeletonData->_animations[i] = animation;
+	}
+	return !failed;
+}
+
+bool SkeletonBinary::skipSkin(DataInput *input, bool defaultSkin, bool nonessential) {
+	int slotCount;
+	if (defaultSkin)
+		slotCount = readVarint(input, true);
+	else {
+		readVarint(input, true);
+		// Bones, IK, transform and path constraints.
+		for (int i = 0; i < 4; i++)
+			for (int ii = 0, nn = readVarint(input, true); ii < nn; ii++)
+				readVarint(input, true);
+		slotCount = readVarint(input, true);
+	}
+	for (int i = 0; i < slotCount; ++i) {
+		readVarint(input, true);
+		for (int ii = 0, nn = readVarint(input, true); ii < nn; ++ii) {
+			readVarint(input, true);
+			if (!skipAttachment(input, nonessential)) return false;
+		}
+	}
+	return input->cursor <= input->end;
+}
+
+bool SkeletonBinary::skipAttachment(DataInput *input, bool nonessential) {
+	readVarint(input, true);
+	switch (static_cast<AttachmentType>(readByte(input))) {
+	case AttachmentType_Region:
+		readVarint(input, true);
+		input->cursor += 7 * 4 + 4;
+		break;
+	case AttachmentType_Boundingbox:
+		skipVertices(input, readVarint(input, true));
+		if (nonessential) input->cursor += 4;
+		break;
+	case AttachmentType_Mesh: {
+		readVarint(input, true);
+		input->cursor += 4;
+		int vertexCount = readVarint(input, true);
+		input->cursor += vertexCount * 2 * 4;
+		input->cursor += readVarint(input, true) * 2;
+		skipVertices(input, vertexCount);
+		readVarint(input, true);
+		if (nonessential) {
+			input->cursor += readVarint(input, true) * 2;
+			input->cursor += 8;
+		}
+		break;
+	}
+	case AttachmentType_Linkedmesh:
+		readVarint(input, true);
+		input->cursor += 4;
+		readVarint(input, true);
+		readVarint(input, true);
+		input->cursor += 1;
+		if (nonessential) input->cursor += 8;
+		break;
+	case AttachmentType_Path: {
+		input->cursor += 2;
+		int vertexCount = readVarint(input, true);
+		skipVertices(input, vertexCount);
+		input->cursor += vertexCount / 3 * 4;
+		if (nonessential) input->cursor += 4;
+		break;
+	}
+	case AttachmentType_Point:
+		input->cursor += 12;
+		if (nonessential) input->cursor += 4;
+		break;
+	case AttachmentType_Clipping:
+		readVarint(input, true);
+		skipVertices(input, readVarint(input, true));
+		if (nonessential) input->cursor += 4;
+		break;
+	default:
+		return false;
+	}
+	return true;
+}
+
+void SkeletonBinary::skipVertices(DataInput *input, int vertexCount) {
+	if (!readBoolean(input)) {
+		input->cursor += vertexCount * 2 * 4;
+		return;
+	}
+	for (int i = 0; i < vertexCount; ++i) {
+		for (int ii = 0, nn = readVarint(input, true); ii < nn; ++ii) {
+			readVarint(input, true);
+			input->cursor += 12;
+		}
+	}
+}
+
 Animation *SkeletonBinary::readAnimation(const String &name, DataInput *input, SkeletonData *skeletonData) {
+	// The animation copies the timelines, so the vector is kept on the heap instead of being stranded in the arena. Heap
+	// memory stays on the heap when it grows.
 	Vector<Timeline *> timelines;
-	float scale = _scale;
+	{
+		ArenaScope heapScope(NULL);
+		timelines.ensureCapacity(16);
+	}
 	float duration = 0;
+	if (!readTimelines(input, skeletonData, timelines, duration)) return NULL;
+	return new(__FILE__, __LINE__) Animation(String(name), timelines, duration);
+}
+
+bool SkeletonBinary::readTimelines(DataInput *input, SkeletonData *skeletonData, Vector<Timeline *> &timelines, float &duration) {
+	float scale = _scale;
 
 	// Slot timelines.
 	for (int i = 0, n = readVarint(input, true); i < n; ++i) {
@@ -725,7 +1200,7 @@ Animation *SkeletonBinary::readAnimation(const String &name, DataInput *input, S
 				default: {
 					ContainerUtil::cleanUpVectorOfPointers(timelines);
 					setError("Invalid timeline type for a slot: ", skeletonData->_slots[slotIndex]->_name.buffer());
-					return NULL;
+					return false;
 				}
 			}
 		}
@@ -781,7 +1256,7 @@ Animation *SkeletonBinary::readAnimation(const String &name, DataInput *input, S
 				default: {
 					ContainerUtil::cleanUpVectorOfPointers(timelines);
 					setError("Invalid timeline type for a bone: ", skeletonData->_bones[boneIndex]->_name.buffer());
-					return NULL;
+					return false;
 				}
 			}
 		}
@@ -889,14 +1364,13 @@ Animation *SkeletonBinary::readAnimation(const String &name, DataInput *input, S
 				if (!baseAttachment) {
 					ContainerUtil::cleanUpVectorOfPointers(timelines);
 					setError("Attachment not found: ", attachmentName);
-					return NULL;
+					return false;
 				}
 
 				VertexAttachment *attachment = static_cast<VertexAttachment *>(baseAttachment);
 
 				bool weighted = attachment->_bones.size() > 0;
 				Vector<float> &vertices = attachment->_vertices;
-				size_t deformLength = weighted ? vertices.size() / 3 * 2 : vertices.size();
 
 				size_t frameCount = (size_t)readVarint(input, true);
 
@@ -904,37 +1378,33 @@ Animation *SkeletonBinary::readAnimation(const String &name, DataInput *input, S
 				timeline->_slotIndex = slotIndex;
 				timeline->_attachment = attachment;
 
+				// setFrame() copies the vertices, so they are read into heap scratch.
+				Vector<float> deform;
 				for (size_t frameIndex = 0; frameIndex < frameCount; ++frameIndex) {
 					float time = readFloat(input);
-					Vector<float> deform;
-					size_t end = (size_t)readVarint(input, true);
-					if (end == 0) {
-						if (weighted) {
-							deform.setSize(deformLength, 0);
-							for (size_t iiii = 0; iiii < deformLength; ++iiii)
-								deform[iiii] = 0;
-						} else {
-							deform.clearAndAddAll(vertices);
+					size_t start = 0, end = (size_t)readVarint(input, true);
+					deform.clear();
+					if (end != 0) {
+						start = (size_t)readVarint(input, true);
+						{
+							ArenaScope heapScope(NULL);
+							deform.setSize(end, 0);
 						}
-					} else {
-						deform.setSize(deformLength, 0);
-						size_t start = (size_t)readVarint(input, true);
-						end += start;
 						if (scale == 1) {
-							for (size_t v = start; v < end; ++v)
+							for (size_t v = 0; v < end; ++v)
 								deform[v] = readFloat(input);
 						} else {
-							for (size_t v = start; v < end; ++v)
+							for (size_t v = 0; v < end; ++v)
 								deform[v] = readFloat(input) * scale;
 						}
 
 						if (!weighted) {
-							for (size_t v = 0, vn = deform.size(); v < vn; ++v)
-								deform[v] += vertices[v];
+							for (size_t v = 0; v < end; ++v)
+								deform[v] += vertices[start + v];
 						}
 					}
 
-					timeline->setFrame(frameIndex, time, deform);
+					timeline->setFrame(frameIndex, time, deform, (int) start);
 					if (frameIndex < frameCount - 1) readCurve(input, frameIndex, timeline);
 				}
 
@@ -1014,7 +1484,7 @@ Animation *SkeletonBinary::readAnimation(const String &name, DataInput *input, S
 		duration = MathUtil::max(duration, timeline->_frames[eventCount - 1]);
 	}
 
-	return new(__FILE__, __LINE__) Animation(String(name), timelines, duration);
+	return true;
 }
 
 void SkeletonBinary::readCurve(DataInput *input, int frameIndex, CurveTimeline *timeline) {
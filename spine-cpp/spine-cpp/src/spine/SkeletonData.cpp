@@ -47,6 +47,7 @@
 using namespace spine;
 
 SkeletonData::SkeletonData() :
+		_arena(),
 		_name(),
 		_defaultSkin(NULL),
 		_x(0),
@@ -55,6 +56,7 @@ SkeletonData::SkeletonData() :
 		_height(0),
 		_version(),
 		_hash(),
+		_timelineLoader(NULL),
 		_fps(0),
 		_imagesPath() {
 }
@@ -68,6 +70,7 @@ SkeletonData::~SkeletonData() {
 
 	ContainerUtil::cleanUpVectorOfPointers(_events);
 	ContainerUtil::cleanUpVectorOfPointers(_animations);
+	delete _timelineLoader;
 	ContainerUtil::cleanUpVectorOfPointers(_ikConstraints);
 	ContainerUtil::cleanUpVectorOfPointers(_transformConstraints);
 	ContainerUtil::cleanUpVectorOfPointers(_pathConstraints);
@@ -76,48 +79,73 @@ SkeletonData::~SkeletonData() {
 	}
 }
 
+template<typename T>
+static T *findWithIndex(NameIndex<T> &index, Vector<T *> &items, const String &name) {
+	int i = index.find(items, name);
+	return i == -1 ? NULL : items[i];
+}
+
 BoneData *SkeletonData::findBone(const String &boneName) {
-	return ContainerUtil::findWithName(_bones, boneName);
+	return findWithIndex(_boneIndex, _bones, boneName);
 }
 
 int SkeletonData::findBoneIndex(const String &boneName) {
-	return ContainerUtil::findIndexWithName(_bones, boneName);
+	return _boneIndex.find(_bones, boneName);
 }
 
 SlotData *SkeletonData::findSlot(const String &slotName) {
-	return ContainerUtil::findWithName(_slots, slotName);
+	return findWithIndex(_slotIndex, _slots, slotName);
 }
 
 int SkeletonData::findSlotIndex(const String &slotName) {
-	return ContainerUtil::findIndexWithName(_slots, slotName);
+	return _slotIndex.find(_slots, slotName);
 }
 
 Skin *SkeletonData::findSkin(const String &skinName) {
-	return ContainerUtil::findWithName(_skins, skinName);
+	return findWithIndex(_skinIndex, _skins, skinName);
 }
 
 spine::EventData *SkeletonData::findEvent(const String &eventDataName) {
-	return ContainerUtil::findWithName(_events, eventDataName);
+	return findWithIndex(_eventIndex, _events, eventDataName);
 }
 
 Animation *SkeletonData::findAnimation(const String &animationName) {
-	return ContainerUtil::findWithName(_animations, animationName);
+	return findWithIndex(_animationIndex, _animations, animationName);
 }
 
 IkConstraintData *SkeletonData::findIkConstraint(const String &constraintName) {
-	return ContainerUtil::findWithName(_ikConstraints, constraintName);
+	return findWithIndex(_ikConstraintIndex, _ikConstraints, constraintName);
+}
+
+int SkeletonData::findIkConstraintIndex(const String &constraintName) {
+	return _ikConstraintIndex.find(_ikConstraints, constraintName);
 }
 
 TransformConstraintData *SkeletonData::findTransformConstraint(const String &constraintName) {
-	return ContainerUtil::findWithName(_transformConstraints, constraintName);
+	return findWithIndex(_transformConstraintIndex, _transformConstraints, constraintName);
+}
+
+int SkeletonData::findTransformConstraintIndex(const String &constraintName) {
+	return _transformConstraintIndex.find(_transformConstraints, constraintName);
 }
 
 PathConstraintData *SkeletonData::findPathConstraint(const String &constraintName) {
-	return ContainerUtil::findWithName(_pathConstraints, constraintName);
+	return findWithIndex(_pathConstraintIndex, _pathConstraints, constraintName);
 }
 
 int SkeletonData::findPathConstraintIndex(const String &pathConstraintName) {
-	return ContainerUtil::findIndexWithName(_pathConstraints, pathConstraintName);
+	return _pathConstraintIndex.find(_pathConstraints, pathConstraintName);
+}
+
+void SkeletonData::updateNameIndices() {
+	_boneIndex.update(_bones);
+	_slotIndex.update(_slots);
+	_skinIndex.update(_skins);
+	_eventIndex.update(_events);
+	_animationIndex.update(_animations);
+	_ikConstraintIndex.update(_ikConstraints);
+	_transformConstraintIndex.update(_transformConstraints);
+	_pathConstraintIndex.update(_pathConstraints);
 }
 
 const String &SkeletonData::getName() {
@@ -240,3 +268,7 @@ float SkeletonData::getFps() {
 void SkeletonData::setFps(float inValue) {
 	_fps = inValue;
 }
+
+Arena &SkeletonData::getArena() {
+	return _arena;
+}
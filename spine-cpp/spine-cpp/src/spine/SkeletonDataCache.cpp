@@ -0,0 +1,235 @@
+/******************************************************************************
+ * Spine Runtimes License Agreement
+ * Last updated January 1, 2020. Replaces all prior versions.
+ *
+ * Copyright (c) 2013-2020, Esoteric Software LLC
+ *
+ * Integration of the Spine Runtimes into software or otherwise creating
+ * derivative works of the Spine Runtimes is permitted under the terms and
+ * conditions of Section 2 of the Spine Editor License Agreement:
+ * http://esotericsoftware.com/spine-editor-license
+ *
+ * Otherwise, it is permitted to integrate the Spine Runtimes into software
+ * or otherwise create derivative works of the Spine Runtimes (collectively,
+ * "Products"), provided that each user of the Products must obtain their own
+ * Spine Editor license and redistribution of the Products in any form must
+ * include this license and copyright notice.
+ *
+ * THE SPINE RUNTIMES ARE PROVIDED BY ESOTERIC SOFTWARE LLC "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL ESOTERIC SOFTWARE LLC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES,
+ * BUSINESS INTERRUPTION, OR LOSS OF USE, DATA, OR PROFITS) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THE SPINE RUNTIMES, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+#ifdef SPINE_UE4
+#include "SpinePluginPrivatePCH.h"
+#endif
+
+#include <spine/SkeletonDataCache.h>
+
+#include <spine/Atlas.h>
+#include <spine/SkeletonBinary.h>
+#include <spine/SkeletonData.h>
+#include <spine/SkeletonJson.h>
+
+using namespace spine;
+
+size_t SkeletonDataCache::KeyHash::operator()(const Key &key) const {
+	union {
+		float f;
+		int i;
+	} scale;
+	scale.f = key.scale;
+	return Hash<String>()(key.path) ^ Hash<void *>()(key.owner) ^ Hash<int>()(scale.i);
+}
+
+SkeletonDataCache::SkeletonDataCache(size_t memoryBudget) : _memoryBudget(memoryBudget), _memoryUsed(0), _useCount(0),
+	_hits(0), _misses(0), _evictions(0) {
+}
+
+SkeletonDataCache::~SkeletonDataCache() {
+	// Skeleton data refers to its atlas, so it is deleted first.
+	Vector<Entry *> atlasEntries;
+	HashMap<Key, Entry *, KeyHash>::Entries entries = _entries.getEntries();
+	while (entries.hasNext()) {
+		Entry *entry = entries.next().value;
+		if (entry->atlas)
+			atlasEntries.add(entry);
+		else {
+			delete entry->skeletonData;
+			delete entry;
+		}
+	}
+	for (size_t i = 0; i < atlasEntries.size(); ++i) {
+		delete atlasEntries[i]->atlas;
+		delete atlasEntries[i];
+	}
+}
+
+Atlas *SkeletonDataCache::acquireAtlas(const String &path, TextureLoader *textureLoader) {
+	Key key(path, 0, textureLoader);
+	Entry *entry = acquire(key);
+	if (entry) return entry->atlas;
+
+	Atlas *atlas = new(__FILE__, __LINE__) Atlas(path, textureLoader);
+	if (atlas->getPages().size() == 0) {
+		delete atlas;
+		_error = String("Unable to read atlas: ").append(path);
+		return NULL;
+	}
+	entry = new(__FILE__, __LINE__) Entry(key);
+	entry->atlas = atlas;
+	entry->memory = sizeof(Atlas) + atlas->getRegions().size() * sizeof(AtlasRegion);
+	Vector<AtlasPage *> &pages = atlas->getPages();
+	for (size_t i = 0; i < pages.size(); ++i)
+		entry->memory += sizeof(AtlasPage) + (size_t) pages[i]->width * pages[i]->height * 4;
+	add(entry, atlas);
+	return atlas;
+}
+
+SkeletonData *SkeletonDataCache::acquireSkeletonData(const String &path, Atlas *atlas, float scale) {
+	Key key(path, scale, atlas);
+	Entry *entry = acquire(key);
+	if (entry) return entry->skeletonData;
+
+	int length = 0;
+	const char *data = SpineExtension::mapFile(path, &length);
+	if (!data || length == 0) {
+		if (data) SpineExtension::unmapFile(data, length);
+		_error = String("Unable to read skeleton file: ").append(path);
+		return NULL;
+	}
+	SkeletonData *skeletonData;
+	size_t pathLength = path.length();
+	if (pathLength >= 5 && strcmp(path.buffer() + pathLength - 5, ".json") == 0) {
+		SkeletonJson json(atlas);
+		json.setScale(scale);
+		skeletonData = json.readSkeletonData(data, length);
+		if (!skeletonData) _error = json.getError();
+	} else {
+		SkeletonBinary binary(atlas);
+		binary.setScale(scale);
+		skeletonData = binary.readSkeletonData((const unsigned char *) data, length);
+		if (!skeletonData) _error = binary.getError();
+	}
+	SpineExtension::unmapFile(data, length);
+	if (!skeletonData) return NULL;
+
+	entry = new(__FILE__, __LINE__) Entry(key);
+	entry->skeletonData = skeletonData;
+	entry->memory = sizeof(SkeletonData) + length;
+	Entry **atlasEntry = _entriesByObject.get(atlas);
+	if (atlasEntry) {
+		entry->atlasEntry = *atlasEntry;
+		(*atlasEntry)->references++;
+	}
+	add(entry, skeletonData);
+	return skeletonData;
+}
+
+void SkeletonDataCache::release(Atlas *atlas) {
+	release((void *) atlas);
+}
+
+void SkeletonDataCache::release(SkeletonData *skeletonData) {
+	release((void *) skeletonData);
+}
+
+void SkeletonDataCache::evictUnused() {
+	size_t memoryBudget = _memoryBudget;
+	_memoryBudget = 0;
+	trim();
+	_memoryBudget = memoryBudget;
+}
+
+void SkeletonDataCache::setMemoryBudget(size_t inValue) {
+	_memoryBudget = inValue;
+	trim();
+}
+
+size_t SkeletonDataCache::getMemoryBudget() {
+	return _memoryBudget;
+}
+
+size_t SkeletonDataCache::getMemoryUsed() {
+	return _memoryUsed;
+}
+
+int SkeletonDataCache::getHits() {
+	return _hits;
+}
+
+int SkeletonDataCache::getMisses() {
+	return _misses;
+}
+
+int SkeletonDataCache::getEvictions() {
+	return _evictions;
+}
+
+const String &SkeletonDataCache::getError() {
+	return _error;
+}
+
+SkeletonDataCache::Entry *SkeletonDataCache::acquire(const Key &key) {
+	_error = "";
+	Entry **existing = _entries.get(key);
+	if (!existing) {
+		_misses++;
+		return NULL;
+	}
+	_hits++;
+	(*existing)->references++;
+	(*existing)->lastUse = ++_useCount;
+	return *existing;
+}
+
+void SkeletonDataCache::add(Entry *entry, void *object) {
+	entry->lastUse = ++_useCount;
+	_entries.put(entry->key, entry);
+	_entriesByObject.put(object, entry);
+	_memoryUsed += entry->memory;
+	trim();
+}
+
+void SkeletonDataCache::release(void *object) {
+	Entry **entry = _entriesByObject.get(object);
+	assert(entry && (*entry)->references > 0);
+	if (!entry) return;
+	if (--(*entry)->references == 0) trim();
+}
+
+void SkeletonDataCache::trim() {
+	while (_memoryUsed > _memoryBudget) {
+		// Least recently used first. Deleting skeleton data can leave its atlas unreferenced, so search again each time.
+		Entry *oldest = NULL;
+		HashMap<Key, Entry *, KeyHash>::Entries entries = _entries.getEntries();
+		while (entries.hasNext()) {
+			Entry *entry = entries.next().value;
+			if (entry->references == 0 && (!oldest || entry->lastUse < oldest->lastUse)) oldest = entry;
+		}
+		if (!oldest) break;
+		evict(oldest);
+	}
+}
+
+void SkeletonDataCache::evict(Entry *entry) {
+	_evictions++;
+	_memoryUsed -= entry->memory;
+	_entries.remove(entry->key);
+	if (entry->atlas) {
+		_entriesByObject.remove(entry->atlas);
+		delete entry->atlas;
+	} else {
+		_entriesByObject.remove(entry->skeletonData);
+		delete entry->skeletonData;
+		if (entry->atlasEntry) entry->atlasEntry->references--;
+	}
+	delete entry;
+}
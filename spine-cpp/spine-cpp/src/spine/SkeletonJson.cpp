@@ -36,6 +36,7 @@
 #include <spine/CurveTimeline.h>
 #include <spine/VertexAttachment.h>
 #include <spine/Json.h>
+#include <spine/JsonReader.h>
 #include <spine/SkeletonData.h>
 #include <spine/Atlas.h>
 #include <spine/AtlasAttachmentLoader.h>
@@ -80,12 +81,340 @@
 
 using namespace spine;
 
+/// The keys of the skeleton JSON that are read.
+enum Key {
+	Key_Unknown,
+	Key_Skeleton,
+	Key_Hash,
+	Key_Spine,
+	Key_X,
+	Key_Y,
+	Key_Width,
+	Key_Height,
+	Key_Fps,
+	Key_Audio,
+	Key_Images,
+	Key_Bones,
+	Key_Name,
+	Key_Parent,
+	Key_Length,
+	Key_Rotation,
+	Key_ScaleX,
+	Key_ScaleY,
+	Key_ShearX,
+	Key_ShearY,
+	Key_Transform,
+	Key_Skin,
+	Key_Slots,
+	Key_Bone,
+	Key_Color,
+	Key_Dark,
+	Key_Attachment,
+	Key_Blend,
+	Key_Ik,
+	Key_Order,
+	Key_Target,
+	Key_Mix,
+	Key_Softness,
+	Key_BendPositive,
+	Key_Compress,
+	Key_Stretch,
+	Key_Uniform,
+	Key_Local,
+	Key_Relative,
+	Key_RotateMix,
+	Key_TranslateMix,
+	Key_ScaleMix,
+	Key_ShearMix,
+	Key_Path,
+	Key_PositionMode,
+	Key_SpacingMode,
+	Key_RotateMode,
+	Key_Position,
+	Key_Spacing,
+	Key_Skins,
+	Key_Attachments,
+	Key_Type,
+	Key_Triangles,
+	Key_Uvs,
+	Key_Vertices,
+	Key_Hull,
+	Key_Edges,
+	Key_Deform,
+	Key_Lengths,
+	Key_Closed,
+	Key_ConstantSpeed,
+	Key_VertexCount,
+	Key_End,
+	Key_Events,
+	Key_Int,
+	Key_Float,
+	Key_String,
+	Key_Volume,
+	Key_Balance,
+	Key_Animations,
+	Key_Time,
+	Key_Curve,
+	Key_C2,
+	Key_C3,
+	Key_C4,
+	Key_Light,
+	Key_Angle,
+	Key_Offset,
+	Key_DrawOrder,
+	Key_Offsets,
+	Key_Slot,
+	Key_Rotate,
+	Key_Translate,
+	Key_Scale,
+	Key_Shear,
+	Key_TwoColor,
+	Key_Count
+};
+
+static const char *KEY_NAMES[Key_Count] = {
+	"", "skeleton", "hash", "spine", "x", "y", "width", "height", "fps", "audio", "images", "bones", "name", "parent",
+	"length", "rotation", "scaleX", "scaleY", "shearX", "shearY", "transform", "skin", "slots", "bone", "color", "dark",
+	"attachment", "blend", "ik", "order", "target", "mix", "softness", "bendPositive", "compress", "stretch", "uniform",
+	"local", "relative", "rotateMix", "translateMix", "scaleMix", "shearMix", "path", "positionMode", "spacingMode",
+	"rotateMode", "position", "spacing", "skins", "attachments", "type", "triangles", "uvs", "vertices", "hull",
+	"edges", "deform", "lengths", "closed", "constantSpeed", "vertexCount", "end", "events", "int", "float", "string",
+	"volume", "balance", "animations", "time", "curve", "c2", "c3", "c4", "light", "angle", "offset", "drawOrder",
+	"offsets", "slot", "rotate", "translate", "scale", "shear", "twoColor"
+};
+
+/// Returns the last key read, or Key_Unknown if it is not read by this runtime. Keys are dispatched on their hash and
+/// then compared, so unknown keys never alias known ones.
+static Key getKey(JsonReader &reader) {
+	Key key;
+	switch (reader.getKeyHash()) {
+	case 0xb14c976eu: key = Key_Skeleton; break;
+	case 0xcec577d1u: key = Key_Hash; break;
+	case 0xc7d0cb34u: key = Key_Spine; break;
+	case 0xfd0c5087u: key = Key_X; break;
+	case 0xfc0c4ef4u: key = Key_Y; break;
+	case 0x95876e1fu: key = Key_Width; break;
+	case 0xd5bdbb42u: key = Key_Height; break;
+	case 0xbdd34aa8u: key = Key_Fps; break;
+	case 0xe0613999u: key = Key_Audio; break;
+	case 0xd1d746abu: key = Key_Images; break;
+	case 0xa113bfb4u: key = Key_Bones; break;
+	case 0x8d39bde6u: key = Key_Name; break;
+	case 0xeacdfcfdu: key = Key_Parent; break;
+	case 0x83d03615u: key = Key_Length; break;
+	case 0x21ac415fu: key = Key_Rotation; break;
+	case 0x9ce1222bu: key = Key_ScaleX; break;
+	case 0x9be12098u: key = Key_ScaleY; break;
+	case 0x2406778au: key = Key_ShearX; break;
+	case 0x2506791du: key = Key_ShearY; break;
+	case 0xe1ad931bu: key = Key_Transform; break;
+	case 0x336b65b8u: key = Key_Skin; break;
+	case 0x3cfec826u: key = Key_Slots; break;
+	case 0xdb90e18fu: key = Key_Bone; break;
+	case 0x3d7e6258u: key = Key_Color; break;
+	case 0xde776945u: key = Key_Dark; break;
+	case 0xa5cb7c68u: key = Key_Attachment; break;
+	case 0x0bbc40d8u: key = Key_Blend; break;
+	case 0x4638827du: key = Key_Ik; break;
+	case 0x732c1097u: key = Key_Order; break;
+	case 0x32608848u: key = Key_Target; break;
+	case 0xd78f5b61u: key = Key_Mix; break;
+	case 0x8958bcdau: key = Key_Softness; break;
+	case 0xfa25f7f1u: key = Key_BendPositive; break;
+	case 0xa7f88d8du: key = Key_Compress; break;
+	case 0xd32ade2au: key = Key_Stretch; break;
+	case 0xde375a53u: key = Key_Uniform; break;
+	case 0x9c436708u: key = Key_Local; break;
+	case 0xfc82911du: key = Key_Relative; break;
+	case 0x8ae04054u: key = Key_RotateMix; break;
+	case 0xcc223831u: key = Key_TranslateMix; break;
+	case 0x8318f8adu: key = Key_ScaleMix; break;
+	case 0xcb693340u: key = Key_ShearMix; break;
+	case 0x84874d36u: key = Key_Path; break;
+	case 0xd1a30ad1u: key = Key_PositionMode; break;
+	case 0xaaf25645u: key = Key_SpacingMode; break;
+	case 0xe8b4a9d1u: key = Key_RotateMode; break;
+	case 0x934f4e0au: key = Key_Position; break;
+	case 0xc8d3a9feu: key = Key_Spacing; break;
+	case 0xbd113e91u: key = Key_Skins; break;
+	case 0x1a545e81u: key = Key_Attachments; break;
+	case 0x5127f14du: key = Key_Type; break;
+	case 0xd8a57342u: key = Key_Triangles; break;
+	case 0x3599de33u: key = Key_Uvs; break;
+	case 0x7c20c98eu: key = Key_Vertices; break;
+	case 0x6ea478b6u: key = Key_Hull; break;
+	case 0x3596845du: key = Key_Edges; break;
+	case 0xb5712a54u: key = Key_Deform; break;
+	case 0xe6c5a292u: key = Key_Lengths; break;
+	case 0xebee50c5u: key = Key_Closed; break;
+	case 0xc1970a60u: key = Key_ConstantSpeed; break;
+	case 0x066759deu: key = Key_VertexCount; break;
+	case 0x6a8e75aau: key = Key_End; break;
+	case 0x12d8e384u: key = Key_Events; break;
+	case 0x95e97e5eu: key = Key_Int; break;
+	case 0xa6c45d85u: key = Key_Float; break;
+	case 0x17c16538u: key = Key_String; break;
+	case 0x2ee0698fu: key = Key_Volume; break;
+	case 0x989a92ebu: key = Key_Balance; break;
+	case 0xcf15f26au: key = Key_Animations; break;
+	case 0x5d3c9be4u: key = Key_Time; break;
+	case 0x99380614u: key = Key_Curve; break;
+	case 0x8529db20u: key = Key_C2; break;
+	case 0x8629dcb3u: key = Key_C3; break;
+	case 0x8b29e492u: key = Key_C4; break;
+	case 0xe29d1e2fu: key = Key_Light; break;
+	case 0xad544418u: key = Key_Angle; break;
+	case 0x14c8d3cau: key = Key_Offset; break;
+	case 0x02fa7455u: key = Key_DrawOrder; break;
+	case 0x71254c3bu: key = Key_Offsets; break;
+	case 0x70954771u: key = Key_Slot; break;
+	case 0xa5f4fd0au: key = Key_Rotate; break;
+	case 0xad0ecfd5u: key = Key_Translate; break;
+	case 0x82971c71u: key = Key_Scale; break;
+	case 0xf1c308f6u: key = Key_Shear; break;
+	case 0xfa0001acu: key = Key_TwoColor; break;
+	default: return Key_Unknown;
+	}
+	return reader.isKey(KEY_NAMES[key]) ? key : Key_Unknown;
+}
+
+namespace spine {
+/// The values of a JSON object by key, for objects whose values are read in a fixed order like with Json::getItem(),
+/// without building the object. Indexing skips over the values once and each key is found with a single hash switch.
+/// The reader is left at the end of the object after each value is read.
+class JsonMap {
+public:
+	/// Indexes the object that is the reader's next value.
+	explicit JsonMap(JsonReader &reader) : _reader(reader) {
+		memset(_values, 0, sizeof(_values));
+		if (reader.beginObject()) {
+			while (reader.nextKey()) {
+				Key key = getKey(reader);
+				if (key != Key_Unknown) _values[key] = reader.getPosition();
+				reader.skipValue();
+			}
+		}
+		_end = reader.getPosition();
+	}
+
+	~JsonMap() {
+		_reader.setPosition(_end);
+	}
+
+	bool has(Key key) {
+		return _values[key] != NULL;
+	}
+
+	/// Moves the reader to the value of the key and returns true, or returns false if the object does not have the key.
+	bool seek(Key key) {
+		_reader.setPosition(_values[key] ? _values[key] : _end);
+		return _values[key] != NULL;
+	}
+
+	/// Enters the array value of the key, whose values must then be read with JsonReader::nextValue().
+	bool beginArray(Key key) {
+		return seek(key) && _reader.beginArray();
+	}
+
+	int getType(Key key) {
+		int type = seek(key) ? _reader.peek() : -1;
+		_reader.setPosition(_end);
+		return type;
+	}
+
+	int getSize(Key key) {
+		int size = seek(key) ? _reader.peekArraySize() : 0;
+		_reader.setPosition(_end);
+		return size;
+	}
+
+	/// The returned string is only valid until the reader reads another string.
+	const char *getString(Key key, const char *defaultValue) {
+		const char *value = seek(key) ? _reader.readString() : defaultValue;
+		_reader.setPosition(_end);
+		return value;
+	}
+
+	float getFloat(Key key, float defaultValue) {
+		float value = seek(key) ? _reader.readFloat() : defaultValue;
+		_reader.setPosition(_end);
+		return value;
+	}
+
+	int getInt(Key key, int defaultValue) {
+		int value = seek(key) ? _reader.readInt() : defaultValue;
+		_reader.setPosition(_end);
+		return value;
+	}
+
+	bool getBoolean(Key key, bool defaultValue) {
+		bool value = seek(key) ? _reader.readBoolean() : defaultValue;
+		_reader.setPosition(_end);
+		return value;
+	}
+
+private:
+	JsonReader &_reader;
+	const char *_values[Key_Count];
+	const char *_end;
+};
+}
+
+/// The curve of a timeline frame, which is set once all of the frame's values are read.
+struct FrameCurve {
+	bool set, stepped;
+	float c1, c2, c3, c4;
+
+	FrameCurve() : set(false), stepped(false), c1(0), c2(0), c3(1), c4(1) {
+	}
+};
+
+/// Reads the value of a frame's key if it is part of the frame's curve.
+static bool readCurve(JsonReader &reader, Key key, FrameCurve &curve) {
+	switch (key) {
+	case Key_Curve:
+		curve.set = true;
+		if (reader.peek() == Json::JSON_STRING) {
+			const char *value = reader.readString();
+			curve.stepped = value && strcmp(value, "stepped") == 0;
+		} else
+			curve.c1 = reader.readFloat();
+		return true;
+	case Key_C2:
+		curve.c2 = reader.readFloat();
+		return true;
+	case Key_C3:
+		curve.c3 = reader.readFloat();
+		return true;
+	case Key_C4:
+		curve.c4 = reader.readFloat();
+		return true;
+	default:
+		return false;
+	}
+}
+
+/// The start of the text where the JSON is malformed.
+static String getErrorText(JsonReader &reader) {
+	char *text = SpineExtension::calloc<char>(33, __FILE__, __LINE__);
+	strncpy(text, reader.getError(), 32);
+	return String(text, true);
+}
+
+static void setCurve(CurveTimeline *timeline, size_t frameIndex, const FrameCurve &curve) {
+	if (!curve.set) return;
+	if (curve.stepped)
+		timeline->setStepped(frameIndex);
+	else
+		timeline->setCurve(frameIndex, curve.c1, curve.c2, curve.c3, curve.c4);
+}
+
 SkeletonJson::SkeletonJson(Atlas *atlas) : _attachmentLoader(new(__FILE__, __LINE__) AtlasAttachmentLoader(atlas)),
-	_scale(1), _ownsLoader(true)
+	_scale(1), _ownsLoader(true), _arenaEnabled(false), _curveLookupEnabled(false), _quantizeTolerance(0), _quantizedBytesSaved(0)
 {}
 
 SkeletonJson::SkeletonJson(AttachmentLoader *attachmentLoader) : _attachmentLoader(attachmentLoader), _scale(1),
-	_ownsLoader(false)
+	_ownsLoader(false), _arenaEnabled(false), _curveLookupEnabled(false), _quantizeTolerance(0), _quantizedBytesSaved(0)
 {
 	assert(_attachmentLoader != NULL);
 }
@@ -97,14 +426,19 @@ SkeletonJson::~SkeletonJson() {
 }
 
 SkeletonData *SkeletonJson::readSkeletonDataFile(const String &path) {
-	int length;
+	int length = 0;
 	SkeletonData *skeletonData;
-	const char *json = SpineExtension::readFile(path, &length);
-	if (length == 0 || !json) {
-		setError(NULL, "Unable to read skeleton file: ", path);
+	char *json = SpineExtension::readFile(path, &length);
+	if (!json || length == 0) {
+		if (json) SpineExtension::free(json, __FILE__, __LINE__);
+		setError("Unable to read skeleton file: ", path);
 		return NULL;
 	}
 
+	// readFile() does not terminate the text, which the JsonReader needs to stop at the end of truncated input.
+	json = SpineExtension::realloc(json, length + 1, __FILE__, __LINE__);
+	json[length] = 0;
+
 	skeletonData = readSkeletonData(json);
 
 	SpineExtension::free(json, __FILE__, __LINE__);
@@ -112,618 +446,594 @@ SkeletonData *SkeletonJson::readSkeletonDataFile(const String &path) {
 	return skeletonData;
 }
 
+SkeletonData *SkeletonJson::readSkeletonData(const char *json, int length) {
+	char *terminated = SpineExtension::alloc<char>(length + 1, __FILE__, __LINE__);
+	memcpy(terminated, json, length);
+	terminated[length] = 0;
+	SkeletonData *skeletonData = readSkeletonData(terminated);
+	SpineExtension::free(terminated, __FILE__, __LINE__);
+	return skeletonData;
+}
+
 SkeletonData *SkeletonJson::readSkeletonData(const char *json) {
-	int i, ii;
 	SkeletonData *skeletonData;
-	Json *root, *skeleton, *bones, *boneMap, *ik, *transform, *path, *slots, *skins, *animations, *events;
 
 	_error = "";
 	_linkedMeshes.clear();
 
-	root = new(__FILE__, __LINE__) Json(json);
-
-	if (!root) {
-		setError(NULL, "Invalid skeleton JSON: ", Json::getError());
+	// The JSON is read without building a Json tree. The sections are read in the order they depend on each other,
+	// whatever their order in the JSON.
+	JsonReader reader(json);
+	JsonMap root(reader);
+	if (reader.getError()) {
+		setError("Invalid skeleton JSON: ", getErrorText(reader));
 		return NULL;
 	}
 
 	skeletonData = new(__FILE__, __LINE__) SkeletonData();
+	ArenaScope arenaScope(_arenaEnabled ? &skeletonData->getArena() : Arena::getCurrent());
 
-	skeleton = Json::getItem(root, "skeleton");
-	if (skeleton) {
-		skeletonData->_hash = Json::getString(skeleton, "hash", 0);
-		skeletonData->_version = Json::getString(skeleton, "spine", 0);
+	if (root.seek(Key_Skeleton)) {
+		JsonMap skeleton(reader);
+		skeletonData->_hash = skeleton.getString(Key_Hash, 0);
+		skeletonData->_version = skeleton.getString(Key_Spine, 0);
 		if ("3.8.75" == skeletonData->_version) {
-            delete skeletonData;
-            setError(root, "Unsupported skeleton data, please export with a newer version of Spine.", "");
-            return NULL;
-        }
-		skeletonData->_x = Json::getFloat(skeleton, "x", 0);
-		skeletonData->_y = Json::getFloat(skeleton, "y", 0);
-		skeletonData->_width = Json::getFloat(skeleton, "width", 0);
-		skeletonData->_height = Json::getFloat(skeleton, "height", 0);
-		skeletonData->_fps = Json::getFloat(skeleton, "fps", 30);
-		skeletonData->_audioPath = Json::getString(skeleton, "audio", 0);
-		skeletonData->_imagesPath = Json::getString(skeleton, "images", 0);
+			delete skeletonData;
+			setError("Unsupported skeleton data, please export with a newer version of Spine.", "");
+			return NULL;
+		}
+		skeletonData->_x = skeleton.getFloat(Key_X, 0);
+		skeletonData->_y = skeleton.getFloat(Key_Y, 0);
+		skeletonData->_width = skeleton.getFloat(Key_Width, 0);
+		skeletonData->_height = skeleton.getFloat(Key_Height, 0);
+		skeletonData->_fps = skeleton.getFloat(Key_Fps, 30);
+		skeletonData->_audioPath = skeleton.getString(Key_Audio, 0);
+		skeletonData->_imagesPath = skeleton.getString(Key_Images, 0);
+	}
+
+	if ((root.seek(Key_Bones) && !readBones(reader, skeletonData)) ||
+		(root.seek(Key_Slots) && !readSlots(reader, skeletonData)) ||
+		(root.seek(Key_Ik) && !readIkConstraints(reader, skeletonData)) ||
+		(root.seek(Key_Transform) && !readTransformConstraints(reader, skeletonData)) ||
+		(root.seek(Key_Path) && !readPathConstraints(reader, skeletonData)) ||
+		(root.seek(Key_Skins) && !readSkins(reader, skeletonData))) {
+		delete skeletonData;
+		return NULL;
 	}
 
-	/* Bones. */
-	bones = Json::getItem(root, "bones");
-	skeletonData->_bones.setSize(bones->_size, 0);
-	int bonesCount = 0;
-	for (boneMap = bones->_child, i = 0; boneMap; boneMap = boneMap->_next, ++i) {
-		BoneData *data;
-		const char *transformMode;
+	/* Linked meshes. */
+	for (int i = 0, n = _linkedMeshes.size(); i < n; ++i) {
+		LinkedMesh *linkedMesh = _linkedMeshes[i];
+		Skin *skin = linkedMesh->_skin.length() == 0 ? skeletonData->getDefaultSkin() : skeletonData->findSkin(linkedMesh->_skin);
+		if (skin == NULL) {
+			delete skeletonData;
+			setError("Skin not found: ", linkedMesh->_skin.buffer());
+			return NULL;
+		}
+		Attachment *parent = skin->getAttachment(linkedMesh->_slotIndex, linkedMesh->_parent);
+		if (parent == NULL) {
+			delete skeletonData;
+			setError("Parent mesh not found: ", linkedMesh->_parent.buffer());
+			return NULL;
+		}
+		linkedMesh->_mesh->_deformAttachment = linkedMesh->_inheritDeform ? static_cast<VertexAttachment*>(parent) : linkedMesh->_mesh;
+		linkedMesh->_mesh->setParentMesh(static_cast<MeshAttachment *>(parent));
+		linkedMesh->_mesh->updateUVs();
+		_attachmentLoader->configureAttachment(linkedMesh->_mesh);
+	}
+	ContainerUtil::cleanUpVectorOfPointers(_linkedMeshes);
+	_linkedMeshes.clear();
+
+	/* Events. */
+	if (root.seek(Key_Events) && reader.beginObject()) {
+		while (reader.nextKey()) {
+			EventData *eventData = new(__FILE__, __LINE__) EventData(String(reader.getKey()));
+			skeletonData->_events.add(eventData);
+			JsonMap eventMap(reader);
+			eventData->_intValue = eventMap.getInt(Key_Int, 0);
+			eventData->_floatValue = eventMap.getFloat(Key_Float, 0);
+			eventData->_stringValue = eventMap.getString(Key_String, 0);
+			eventData->_audioPath = eventMap.getString(Key_Audio, 0);
+			if (!eventData->_audioPath.isEmpty()) {
+				eventData->_volume = eventMap.getFloat(Key_Volume, 1);
+				eventData->_balance = eventMap.getFloat(Key_Balance, 0);
+			}
+		}
+	}
+
+	/* Animations. */
+	if (root.seek(Key_Animations) && reader.beginObject()) {
+		while (reader.nextKey()) {
+			Animation *animation = readAnimation(reader, String(reader.getKey()), skeletonData);
+			if (!animation) {
+				delete skeletonData;
+				return NULL;
+			}
+			skeletonData->_animations.add(animation);
+		}
+	}
+
+	if (reader.getError()) {
+		delete skeletonData;
+		setError("Invalid skeleton JSON: ", getErrorText(reader));
+		return NULL;
+	}
+
+	skeletonData->updateNameIndices();
+	_quantizedBytesSaved = 0;
+	for (size_t i = 0; i < skeletonData->_animations.size(); ++i) {
+		Animation *animation = skeletonData->_animations[i];
+		if (_curveLookupEnabled) animation->buildCurveLookup();
+		if (_quantizeTolerance > 0) _quantizedBytesSaved += animation->quantize(_quantizeTolerance);
+	}
+	return skeletonData;
+}
+
+bool SkeletonJson::readBones(JsonReader &reader, SkeletonData *skeletonData) {
+	skeletonData->_bones.setSize(reader.peekArraySize(), 0);
+	if (!reader.beginArray()) return true;
+	for (int i = 0; reader.nextValue(); ++i) {
+		JsonMap boneMap(reader);
 
 		BoneData *parent = 0;
-		const char *parentName = Json::getString(boneMap, "parent", 0);
+		const char *parentName = boneMap.getString(Key_Parent, 0);
 		if (parentName) {
 			parent = skeletonData->findBone(parentName);
 			if (!parent) {
-				delete skeletonData;
-				setError(root, "Parent bone not found: ", parentName);
-				return NULL;
+				setError("Parent bone not found: ", parentName);
+				return false;
 			}
 		}
 
-		data = new(__FILE__, __LINE__) BoneData(bonesCount, Json::getString(boneMap, "name", 0), parent);
-
-		data->_length = Json::getFloat(boneMap, "length", 0) * _scale;
-		data->_x = Json::getFloat(boneMap, "x", 0) * _scale;
-		data->_y = Json::getFloat(boneMap, "y", 0) * _scale;
-		data->_rotation = Json::getFloat(boneMap, "rotation", 0);
-		data->_scaleX = Json::getFloat(boneMap, "scaleX", 1);
-		data->_scaleY = Json::getFloat(boneMap, "scaleY", 1);
-		data->_shearX = Json::getFloat(boneMap, "shearX", 0);
-		data->_shearY = Json::getFloat(boneMap, "shearY", 0);
-		transformMode = Json::getString(boneMap, "transform", "normal");
+		BoneData *data = new(__FILE__, __LINE__) BoneData(i, boneMap.getString(Key_Name, 0), parent);
+		skeletonData->_bones[i] = data;
+
+		data->_length = boneMap.getFloat(Key_Length, 0) * _scale;
+		data->_x = boneMap.getFloat(Key_X, 0) * _scale;
+		data->_y = boneMap.getFloat(Key_Y, 0) * _scale;
+		data->_rotation = boneMap.getFloat(Key_Rotation, 0);
+		data->_scaleX = boneMap.getFloat(Key_ScaleX, 1);
+		data->_scaleY = boneMap.getFloat(Key_ScaleY, 1);
+		data->_shearX = boneMap.getFloat(Key_ShearX, 0);
+		data->_shearY = boneMap.getFloat(Key_ShearY, 0);
+		const char *transformMode = boneMap.getString(Key_Transform, "normal");
 		data->_transformMode = TransformMode_Normal;
 		if (strcmp(transformMode, "normal") == 0) data->_transformMode = TransformMode_Normal;
 		else if (strcmp(transformMode, "onlyTranslation") == 0) data->_transformMode = TransformMode_OnlyTranslation;
 		else if (strcmp(transformMode, "noRotationOrReflection") == 0) data->_transformMode = TransformMode_NoRotationOrReflection;
 		else if (strcmp(transformMode, "noScale") == 0) data->_transformMode = TransformMode_NoScale;
 		else if (strcmp(transformMode, "noScaleOrReflection") == 0) data->_transformMode = TransformMode_NoScaleOrReflection;
-		data->_skinRequired = Json::getBoolean(boneMap, "skin", false);
-
-		skeletonData->_bones[i] = data;
-		bonesCount++;
+		data->_skinRequired = boneMap.getBoolean(Key_Skin, false);
 	}
+	return true;
+}
 
-	/* Slots. */
-	slots = Json::getItem(root, "slots");
-	if (slots) {
-		Json *slotMap;
-		skeletonData->_slots.ensureCapacity(slots->_size);
-		skeletonData->_slots.setSize(slots->_size, 0);
-		for (slotMap = slots->_child, i = 0; slotMap; slotMap = slotMap->_next, ++i) {
-			SlotData *data;
-			const char *color;
-			const char *dark;
-			Json *item;
-
-			const char *boneName = Json::getString(slotMap, "bone", 0);
-			BoneData *boneData = skeletonData->findBone(boneName);
-			if (!boneData) {
-				delete skeletonData;
-				setError(root, "Slot bone not found: ", boneName);
-				return NULL;
-			}
+bool SkeletonJson::readSlots(JsonReader &reader, SkeletonData *skeletonData) {
+	skeletonData->_slots.setSize(reader.peekArraySize(), 0);
+	if (!reader.beginArray()) return true;
+	for (int i = 0; reader.nextValue(); ++i) {
+		JsonMap slotMap(reader);
+
+		const char *boneName = slotMap.getString(Key_Bone, 0);
+		BoneData *boneData = skeletonData->findBone(boneName);
+		if (!boneData) {
+			setError("Slot bone not found: ", boneName);
+			return false;
+		}
 
-			data = new(__FILE__, __LINE__) SlotData(i, Json::getString(slotMap, "name", 0), *boneData);
+		SlotData *data = new(__FILE__, __LINE__) SlotData(i, slotMap.getString(Key_Name, 0), *boneData);
+		skeletonData->_slots[i] = data;
 
-			color = Json::getString(slotMap, "color", 0);
-			if (color) {
-				Color &c = data->getColor();
-				c.r = toColor(color, 0);
-				c.g = toColor(color, 1);
-				c.b = toColor(color, 2);
-				c.a = toColor(color, 3);
-			}
+		const char *color = slotMap.getString(Key_Color, 0);
+		if (color) {
+			Color &c = data->getColor();
+			c.r = toColor(color, 0);
+			c.g = toColor(color, 1);
+			c.b = toColor(color, 2);
+			c.a = toColor(color, 3);
+		}
 
-			dark = Json::getString(slotMap, "dark", 0);
-			if (dark) {
-				Color &darkColor = data->getDarkColor();
-				darkColor.r = toColor(dark, 0);
-				darkColor.g = toColor(dark, 1);
-				darkColor.b = toColor(dark, 2);
-				darkColor.a = 1;
-				data->setHasDarkColor(true);
-			}
+		const char *dark = slotMap.getString(Key_Dark, 0);
+		if (dark) {
+			Color &darkColor = data->getDarkColor();
+			darkColor.r = toColor(dark, 0);
+			darkColor.g = toColor(dark, 1);
+			darkColor.b = toColor(dark, 2);
+			darkColor.a = 1;
+			data->setHasDarkColor(true);
+		}
 
-			item = Json::getItem(slotMap, "attachment");
-			if (item) data->setAttachmentName(item->_valueString);
+		if (slotMap.has(Key_Attachment)) data->setAttachmentName(slotMap.getString(Key_Attachment, 0));
 
-			item = Json::getItem(slotMap, "blend");
-			if (item) {
-				if (strcmp(item->_valueString, "additive") == 0) data->_blendMode = BlendMode_Additive;
-				else if (strcmp(item->_valueString, "multiply") == 0) data->_blendMode = BlendMode_Multiply;
-				else if (strcmp(item->_valueString, "screen") == 0) data->_blendMode = BlendMode_Screen;
-			}
+		const char *blend = slotMap.getString(Key_Blend, 0);
+		if (blend) {
+			if (strcmp(blend, "additive") == 0) data->_blendMode = BlendMode_Additive;
+			else if (strcmp(blend, "multiply") == 0) data->_blendMode = BlendMode_Multiply;
+			else if (strcmp(blend, "screen") == 0) data->_blendMode = BlendMode_Screen;
+		}
+	}
+	return true;
+}
 
-			skeletonData->_slots[i] = data;
+bool SkeletonJson::readConstraintBones(JsonReader &reader, JsonMap &constraintMap, Vector<BoneData *> &bones,
+	SkeletonData *skeletonData, const char *error
+) {
+	bones.setSize(constraintMap.getSize(Key_Bones), 0);
+	if (!constraintMap.beginArray(Key_Bones)) return true;
+	for (size_t i = 0; reader.nextValue(); ++i) {
+		const char *boneName = reader.readString();
+		bones[i] = skeletonData->findBone(boneName);
+		if (!bones[i]) {
+			setError(error, boneName);
+			return false;
 		}
 	}
+	return true;
+}
 
-	/* IK constraints. */
-	ik = Json::getItem(root, "ik");
-	if (ik) {
-		Json *constraintMap;
-		skeletonData->_ikConstraints.ensureCapacity(ik->_size);
-		skeletonData->_ikConstraints.setSize(ik->_size, 0);
-		for (constraintMap = ik->_child, i = 0; constraintMap; constraintMap = constraintMap->_next, ++i) {
-			const char *targetName;
-
-			IkConstraintData *data = new(__FILE__, __LINE__) IkConstraintData(Json::getString(constraintMap, "name", 0));
-			data->setOrder(Json::getInt(constraintMap, "order", 0));
-			data->setSkinRequired(Json::getBoolean(constraintMap, "skin", false));
-
-			boneMap = Json::getItem(constraintMap, "bones");
-			data->_bones.ensureCapacity(boneMap->_size);
-			data->_bones.setSize(boneMap->_size, 0);
-			for (boneMap = boneMap->_child, ii = 0; boneMap; boneMap = boneMap->_next, ++ii) {
-				data->_bones[ii] = skeletonData->findBone(boneMap->_valueString);
-				if (!data->_bones[ii]) {
-					delete skeletonData;
-					setError(root, "IK bone not found: ", boneMap->_valueString);
-					return NULL;
-				}
-			}
+bool SkeletonJson::readIkConstraints(JsonReader &reader, SkeletonData *skeletonData) {
+	skeletonData->_ikConstraints.setSize(reader.peekArraySize(), 0);
+	if (!reader.beginArray()) return true;
+	for (int i = 0; reader.nextValue(); ++i) {
+		JsonMap constraintMap(reader);
 
-			targetName = Json::getString(constraintMap, "target", 0);
-			data->_target = skeletonData->findBone(targetName);
-			if (!data->_target) {
-				delete skeletonData;
-				setError(root, "Target bone not found: ", targetName);
-				return NULL;
-			}
+		IkConstraintData *data = new(__FILE__, __LINE__) IkConstraintData(constraintMap.getString(Key_Name, 0));
+		skeletonData->_ikConstraints[i] = data;
+		data->setOrder(constraintMap.getInt(Key_Order, 0));
+		data->setSkinRequired(constraintMap.getBoolean(Key_Skin, false));
 
-			data->_mix = Json::getFloat(constraintMap, "mix", 1);
-			data->_softness = Json::getFloat(constraintMap, "softness", 0) * _scale;
-			data->_bendDirection = Json::getInt(constraintMap, "bendPositive", 1) ? 1 : -1;
-			data->_compress = Json::getInt(constraintMap, "compress", 0) ? true: false;
-			data->_stretch = Json::getInt(constraintMap, "stretch", 0) ? true: false;
-			data->_uniform = Json::getInt(constraintMap, "uniform", 0) ? true: false;
+		if (!readConstraintBones(reader, constraintMap, data->_bones, skeletonData, "IK bone not found: ")) return false;
 
-			skeletonData->_ikConstraints[i] = data;
+		const char *targetName = constraintMap.getString(Key_Target, 0);
+		data->_target = skeletonData->findBone(targetName);
+		if (!data->_target) {
+			setError("Target bone not found: ", targetName);
+			return false;
 		}
+
+		data->_mix = constraintMap.getFloat(Key_Mix, 1);
+		data->_softness = constraintMap.getFloat(Key_Softness, 0) * _scale;
+		data->_bendDirection = constraintMap.getInt(Key_BendPositive, 1) ? 1 : -1;
+		data->_compress = constraintMap.getInt(Key_Compress, 0) ? true : false;
+		data->_stretch = constraintMap.getInt(Key_Stretch, 0) ? true : false;
+		data->_uniform = constraintMap.getInt(Key_Uniform, 0) ? true : false;
 	}
+	return true;
+}
 
-	/* Transform constraints. */
-	transform = Json::getItem(root, "transform");
-	if (transform) {
-		Json *constraintMap;
-		skeletonData->_transformConstraints.ensureCapacity(transform->_size);
-		skeletonData->_transformConstraints.setSize(transform->_size, 0);
-		for (constraintMap = transform->_child, i = 0; constraintMap; constraintMap = constraintMap->_next, ++i) {
-			const char *name;
-
-			TransformConstraintData *data = new(__FILE__, __LINE__) TransformConstraintData(Json::getString(constraintMap, "name", 0));
-			data->setOrder(Json::getInt(constraintMap, "order", 0));
-			data->setSkinRequired(Json::getBoolean(constraintMap, "skin", false));
-
-			boneMap = Json::getItem(constraintMap, "bones");
-			data->_bones.ensureCapacity(boneMap->_size);
-			data->_bones.setSize(boneMap->_size, 0);
-			for (boneMap = boneMap->_child, ii = 0; boneMap; boneMap = boneMap->_next, ++ii) {
-				data->_bones[ii] = skeletonData->findBone(boneMap->_valueString);
-				if (!data->_bones[ii]) {
-					delete skeletonData;
-					setError(root, "Transform bone not found: ", boneMap->_valueString);
-					return NULL;
-				}
-			}
+bool SkeletonJson::readTransformConstraints(JsonReader &reader, SkeletonData *skeletonData) {
+	skeletonData->_transformConstraints.setSize(reader.peekArraySize(), 0);
+	if (!reader.beginArray()) return true;
+	for (int i = 0; reader.nextValue(); ++i) {
+		JsonMap constraintMap(reader);
 
-			name = Json::getString(constraintMap, "target", 0);
-			data->_target = skeletonData->findBone(name);
-			if (!data->_target) {
-				delete skeletonData;
-				setError(root, "Target bone not found: ", name);
-				return NULL;
-			}
+		TransformConstraintData *data = new(__FILE__, __LINE__) TransformConstraintData(constraintMap.getString(Key_Name, 0));
+		skeletonData->_transformConstraints[i] = data;
+		data->setOrder(constraintMap.getInt(Key_Order, 0));
+		data->setSkinRequired(constraintMap.getBoolean(Key_Skin, false));
+
+		if (!readConstraintBones(reader, constraintMap, data->_bones, skeletonData, "Transform bone not found: ")) return false;
 
-			data->_local = Json::getInt(constraintMap, "local", 0) ? true : false;
-			data->_relative = Json::getInt(constraintMap, "relative", 0) ? true : false;
-			data->_offsetRotation = Json::getFloat(constraintMap, "rotation", 0);
-			data->_offsetX = Json::getFloat(constraintMap, "x", 0) * _scale;
-			data->_offsetY = Json::getFloat(constraintMap, "y", 0) * _scale;
-			data->_offsetScaleX = Json::getFloat(constraintMap, "scaleX", 0);
-			data->_offsetScaleY = Json::getFloat(constraintMap, "scaleY", 0);
-			data->_offsetShearY = Json::getFloat(constraintMap, "shearY", 0);
-
-			data->_rotateMix = Json::getFloat(constraintMap, "rotateMix", 1);
-			data->_translateMix = Json::getFloat(constraintMap, "translateMix", 1);
-			data->_scaleMix = Json::getFloat(constraintMap, "scaleMix", 1);
-			data->_shearMix = Json::getFloat(constraintMap, "shearMix", 1);
-
-			skeletonData->_transformConstraints[i] = data;
+		const char *name = constraintMap.getString(Key_Target, 0);
+		data->_target = skeletonData->findBone(name);
+		if (!data->_target) {
+			setError("Target bone not found: ", name);
+			return false;
 		}
+
+		data->_local = constraintMap.getInt(Key_Local, 0) ? true : false;
+		data->_relative = constraintMap.getInt(Key_Relative, 0) ? true : false;
+		data->_offsetRotation = constraintMap.getFloat(Key_Rotation, 0);
+		data->_offsetX = constraintMap.getFloat(Key_X, 0) * _scale;
+		data->_offsetY = constraintMap.getFloat(Key_Y, 0) * _scale;
+		data->_offsetScaleX = constraintMap.getFloat(Key_ScaleX, 0);
+		data->_offsetScaleY = constraintMap.getFloat(Key_ScaleY, 0);
+		data->_offsetShearY = constraintMap.getFloat(Key_ShearY, 0);
+
+		data->_rotateMix = constraintMap.getFloat(Key_RotateMix, 1);
+		data->_translateMix = constraintMap.getFloat(Key_TranslateMix, 1);
+		data->_scaleMix = constraintMap.getFloat(Key_ScaleMix, 1);
+		data->_shearMix = constraintMap.getFloat(Key_ShearMix, 1);
 	}
+	return true;
+}
 
-	/* Path constraints */
-	path = Json::getItem(root, "path");
-	if (path) {
-		Json *constraintMap;
-		skeletonData->_pathConstraints.ensureCapacity(path->_size);
-		skeletonData->_pathConstraints.setSize(path->_size, 0);
-		for (constraintMap = path->_child, i = 0; constraintMap; constraintMap = constraintMap->_next, ++i) {
-			const char *name;
-			const char *item;
-
-			PathConstraintData *data = new(__FILE__, __LINE__) PathConstraintData(Json::getString(constraintMap, "name", 0));
-			data->setOrder(Json::getInt(constraintMap, "order", 0));
-			data->setSkinRequired(Json::getBoolean(constraintMap, "skin", false));
-
-			boneMap = Json::getItem(constraintMap, "bones");
-			data->_bones.ensureCapacity(boneMap->_size);
-			data->_bones.setSize(boneMap->_size, 0);
-			for (boneMap = boneMap->_child, ii = 0; boneMap; boneMap = boneMap->_next, ++ii) {
-				data->_bones[ii] = skeletonData->findBone(boneMap->_valueString);
-				if (!data->_bones[ii]) {
-					delete skeletonData;
-					setError(root, "Path bone not found: ", boneMap->_valueString);
-					return NULL;
-				}
-			}
+bool SkeletonJson::readPathConstraints(JsonReader &reader, SkeletonData *skeletonData) {
+	skeletonData->_pathConstraints.setSize(reader.peekArraySize(), 0);
+	if (!reader.beginArray()) return true;
+	for (int i = 0; reader.nextValue(); ++i) {
+		JsonMap constraintMap(reader);
 
-			name = Json::getString(constraintMap, "target", 0);
-			data->_target = skeletonData->findSlot(name);
-			if (!data->_target) {
-				delete skeletonData;
-				setError(root, "Target slot not found: ", name);
-				return NULL;
-			}
+		PathConstraintData *data = new(__FILE__, __LINE__) PathConstraintData(constraintMap.getString(Key_Name, 0));
+		skeletonData->_pathConstraints[i] = data;
+		data->setOrder(constraintMap.getInt(Key_Order, 0));
+		data->setSkinRequired(constraintMap.getBoolean(Key_Skin, false));
 
-			item = Json::getString(constraintMap, "positionMode", "percent");
-			if (strcmp(item, "fixed") == 0) {
-				data->_positionMode = PositionMode_Fixed;
-			} else if (strcmp(item, "percent") == 0) {
-				data->_positionMode = PositionMode_Percent;
-			}
+		if (!readConstraintBones(reader, constraintMap, data->_bones, skeletonData, "Path bone not found: ")) return false;
+
+		const char *name = constraintMap.getString(Key_Target, 0);
+		data->_target = skeletonData->findSlot(name);
+		if (!data->_target) {
+			setError("Target slot not found: ", name);
+			return false;
+		}
 
-			item = Json::getString(constraintMap, "spacingMode", "length");
-			if (strcmp(item, "length") == 0) data->_spacingMode = SpacingMode_Length;
-			else if (strcmp(item, "fixed") == 0) data->_spacingMode = SpacingMode_Fixed;
-			else if (strcmp(item, "percent") == 0) data->_spacingMode = SpacingMode_Percent;
-
-			item = Json::getString(constraintMap, "rotateMode", "tangent");
-			if (strcmp(item, "tangent") == 0) data->_rotateMode = RotateMode_Tangent;
-			else if (strcmp(item, "chain") == 0) data->_rotateMode = RotateMode_Chain;
-			else if (strcmp(item, "chainScale") == 0) data->_rotateMode = RotateMode_ChainScale;
-
-			data->_offsetRotation = Json::getFloat(constraintMap, "rotation", 0);
-			data->_position = Json::getFloat(constraintMap, "position", 0);
-			if (data->_positionMode == PositionMode_Fixed) data->_position *= _scale;
-			data->_spacing = Json::getFloat(constraintMap, "spacing", 0);
-			if (data->_spacingMode == SpacingMode_Length || data->_spacingMode == SpacingMode_Fixed) data->_spacing *= _scale;
-			data->_rotateMix = Json::getFloat(constraintMap, "rotateMix", 1);
-			data->_translateMix = Json::getFloat(constraintMap, "translateMix", 1);
-
-			skeletonData->_pathConstraints[i] = data;
+		const char *item = constraintMap.getString(Key_PositionMode, "percent");
+		if (strcmp(item, "fixed") == 0) {
+			data->_positionMode = PositionMode_Fixed;
+		} else if (strcmp(item, "percent") == 0) {
+			data->_positionMode = PositionMode_Percent;
 		}
+
+		item = constraintMap.getString(Key_SpacingMode, "length");
+		if (strcmp(item, "length") == 0) data->_spacingMode = SpacingMode_Length;
+		else if (strcmp(item, "fixed") == 0) data->_spacingMode = SpacingMode_Fixed;
+		else if (strcmp(item, "percent") == 0) data->_spacingMode = SpacingMode_Percent;
+
+		item = constraintMap.getString(Key_RotateMode, "tangent");
+		if (strcmp(item, "tangent") == 0) data->_rotateMode = RotateMode_Tangent;
+		else if (strcmp(item, "chain") == 0) data->_rotateMode = RotateMode_Chain;
+		else if (strcmp(item, "chainScale") == 0) data->_rotateMode = RotateMode_ChainScale;
+
+		data->_offsetRotation = constraintMap.getFloat(Key_Rotation, 0);
+		data->_position = constraintMap.getFloat(Key_Position, 0);
+		if (data->_positionMode == PositionMode_Fixed) data->_position *= _scale;
+		data->_spacing = constraintMap.getFloat(Key_Spacing, 0);
+		if (data->_spacingMode == SpacingMode_Length || data->_spacingMode == SpacingMode_Fixed) data->_spacing *= _scale;
+		data->_rotateMix = constraintMap.getFloat(Key_RotateMix, 1);
+		data->_translateMix = constraintMap.getFloat(Key_TranslateMix, 1);
 	}
+	return true;
+}
 
-	/* Skins. */
-	skins = Json::getItem(root, "skins");
-	if (skins) {
-		Json *skinMap;
-		skeletonData->_skins.ensureCapacity(skins->_size);
-		skeletonData->_skins.setSize(skins->_size, 0);
-		int skinsIndex = 0;
-		for (skinMap = skins->_child, i = 0; skinMap; skinMap = skinMap->_next, ++i) {
-			Json *attachmentsMap;
-			Json *curves;
-
-			Skin *skin = new(__FILE__, __LINE__) Skin(Json::getString(skinMap, "name", ""));
-
-			Json *item = Json::getItem(skinMap, "bones");
-			if (item) {
-				for (item = item->_child; item; item = item->_next) {
-					BoneData* data = skeletonData->findBone(item->_valueString);
-					if (!data) {
-						delete skeletonData;
-						setError(root, String("Skin bone not found: "), item->_valueString);
-						return NULL;
-					}
-					skin->getBones().add(data);
+bool SkeletonJson::readSkins(JsonReader &reader, SkeletonData *skeletonData) {
+	skeletonData->_skins.setSize(reader.peekArraySize(), 0);
+	if (!reader.beginArray()) return true;
+	for (int i = 0; reader.nextValue(); ++i) {
+		JsonMap skinMap(reader);
+
+		Skin *skin = new(__FILE__, __LINE__) Skin(skinMap.getString(Key_Name, ""));
+		skeletonData->_skins[i] = skin;
+		if (skin->getName() == "default") skeletonData->_defaultSkin = skin;
+
+		if (skinMap.beginArray(Key_Bones)) {
+			while (reader.nextValue()) {
+				const char *name = reader.readString();
+				BoneData *data = skeletonData->findBone(name);
+				if (!data) {
+					setError("Skin bone not found: ", name);
+					return false;
 				}
+				skin->getBones().add(data);
 			}
+		}
 
-			item = Json::getItem(skinMap, "ik");
-			if (item) {
-				for (item = item->_child; item; item = item->_next) {
-					IkConstraintData* data = skeletonData->findIkConstraint(item->_valueString);
-					if (!data) {
-						delete skeletonData;
-						setError(root, String("Skin IK constraint not found: "), item->_valueString);
-						return NULL;
-					}
-					skin->getConstraints().add(data);
+		if (skinMap.beginArray(Key_Ik)) {
+			while (reader.nextValue()) {
+				const char *name = reader.readString();
+				IkConstraintData *data = skeletonData->findIkConstraint(name);
+				if (!data) {
+					setError("Skin IK constraint not found: ", name);
+					return false;
 				}
+				skin->getConstraints().add(data);
 			}
+		}
 
-			item = Json::getItem(skinMap, "transform");
-			if (item) {
-				for (item = item->_child; item; item = item->_next) {
-					TransformConstraintData* data = skeletonData->findTransformConstraint(item->_valueString);
-					if (!data) {
-						delete skeletonData;
-						setError(root, String("Skin transform constraint not found: "), item->_valueString);
-						return NULL;
-					}
-					skin->getConstraints().add(data);
+		if (skinMap.beginArray(Key_Transform)) {
+			while (reader.nextValue()) {
+				const char *name = reader.readString();
+				TransformConstraintData *data = skeletonData->findTransformConstraint(name);
+				if (!data) {
+					setError("Skin transform constraint not found: ", name);
+					return false;
 				}
+				skin->getConstraints().add(data);
 			}
+		}
 
-			item = Json::getItem(skinMap, "path");
-			if (item) {
-				for (item = item->_child; item; item = item->_next) {
-					PathConstraintData* data = skeletonData->findPathConstraint(item->_valueString);
-					if (!data) {
-						delete skeletonData;
-						setError(root, String("Skin path constraint not found: "), item->_valueString);
-						return NULL;
-					}
-					skin->getConstraints().add(data);
+		if (skinMap.beginArray(Key_Path)) {
+			while (reader.nextValue()) {
+				const char *name = reader.readString();
+				PathConstraintData *data = skeletonData->findPathConstraint(name);
+				if (!data) {
+					setError("Skin path constraint not found: ", name);
+					return false;
 				}
+				skin->getConstraints().add(data);
 			}
+		}
 
-			skeletonData->_skins[skinsIndex++] = skin;
-			if (strcmp(Json::getString(skinMap, "name", ""), "default") == 0) {
-				skeletonData->_defaultSkin = skin;
+		if (!skinMap.seek(Key_Attachments) || !reader.beginObject()) continue;
+		while (reader.nextKey()) {
+			SlotData *slot = skeletonData->findSlot(reader.getKey());
+			if (!slot) {
+				setError("Skin slot not found: ", reader.getKey());
+				return false;
 			}
+			if (!reader.beginObject()) continue;
+			while (reader.nextKey()) {
+				String skinAttachmentName(reader.getKey());
+				Attachment *attachment = readAttachment(reader, skin, slot, skinAttachmentName, skeletonData);
+				if (!attachment) return false;
+				skin->setAttachment(slot->getIndex(), skinAttachmentName, attachment);
+			}
+		}
+	}
+	return true;
+}
 
-			for (attachmentsMap = Json::getItem(skinMap, "attachments")->_child; attachmentsMap; attachmentsMap = attachmentsMap->_next) {
-				SlotData* slot = skeletonData->findSlot(attachmentsMap->_name);
-				Json *attachmentMap;
-
-				for (attachmentMap = attachmentsMap->_child; attachmentMap; attachmentMap = attachmentMap->_next) {
-					Attachment *attachment = NULL;
-					const char *skinAttachmentName = attachmentMap->_name;
-					const char *attachmentName = Json::getString(attachmentMap, "name", skinAttachmentName);
-					const char *attachmentPath = Json::getString(attachmentMap, "path", attachmentName);
-					const char *color;
-					Json *entry;
-
-					const char *typeString = Json::getString(attachmentMap, "type", "region");
-					AttachmentType type;
-					if (strcmp(typeString, "region") == 0) type = AttachmentType_Region;
-					else if (strcmp(typeString, "mesh") == 0) type = AttachmentType_Mesh;
-					else if (strcmp(typeString, "linkedmesh") == 0) type = AttachmentType_Linkedmesh;
-					else if (strcmp(typeString, "boundingbox") == 0) type = AttachmentType_Boundingbox;
-					else if (strcmp(typeString, "path") == 0) type = AttachmentType_Path;
-					else if (strcmp(typeString, "clipping") == 0) type = AttachmentType_Clipping;
-					else if (strcmp(typeString, "point") == 0) type = AttachmentType_Point;
-					else {
-						delete skeletonData;
-						setError(root, "Unknown attachment type: ", typeString);
-						return NULL;
-					}
+Attachment *SkeletonJson::readAttachment(JsonReader &reader, Skin *skin, SlotData *slot, const String &skinAttachmentName,
+	SkeletonData *skeletonData
+) {
+	JsonMap attachmentMap(reader);
+	Attachment *attachment = NULL;
+	String attachmentName(attachmentMap.getString(Key_Name, skinAttachmentName.buffer()));
+	String attachmentPath(attachmentMap.getString(Key_Path, attachmentName.buffer()));
+	const char *color;
+
+	const char *typeString = attachmentMap.getString(Key_Type, "region");
+	AttachmentType type;
+	if (strcmp(typeString, "region") == 0) type = AttachmentType_Region;
+	else if (strcmp(typeString, "mesh") == 0) type = AttachmentType_Mesh;
+	else if (strcmp(typeString, "linkedmesh") == 0) type = AttachmentType_Linkedmesh;
+	else if (strcmp(typeString, "boundingbox") == 0) type = AttachmentType_Boundingbox;
+	else if (strcmp(typeString, "path") == 0) type = AttachmentType_Path;
+	else if (strcmp(typeString, "clipping") == 0) type = AttachmentType_Clipping;
+	else if (strcmp(typeString, "point") == 0) type = AttachmentType_Point;
+	else {
+		setError("Unknown attachment type: ", typeString);
+		return NULL;
+	}
 
-					switch (type) {
-						case AttachmentType_Region: {
-							attachment = _attachmentLoader->newRegionAttachment(*skin, attachmentName, attachmentPath);
-							if (!attachment) {
-								delete skeletonData;
-								setError(root, "Error reading attachment: ", skinAttachmentName);
-								return NULL;
-							}
+	switch (type) {
+		case AttachmentType_Region: {
+			attachment = _attachmentLoader->newRegionAttachment(*skin, attachmentName, attachmentPath);
+			if (!attachment) {
+				setError("Error reading attachment: ", skinAttachmentName);
+				return NULL;
+			}
 
-							RegionAttachment *region = static_cast<RegionAttachment *>(attachment);
-							region->_path = attachmentPath;
-
-							region->_x = Json::getFloat(attachmentMap, "x", 0) * _scale;
-							region->_y = Json::getFloat(attachmentMap, "y", 0) * _scale;
-							region->_scaleX = Json::getFloat(attachmentMap, "scaleX", 1);
-							region->_scaleY = Json::getFloat(attachmentMap, "scaleY", 1);
-							region->_rotation = Json::getFloat(attachmentMap, "rotation", 0);
-							region->_width = Json::getFloat(attachmentMap, "width", 32) * _scale;
-							region->_height = Json::getFloat(attachmentMap, "height", 32) * _scale;
-
-							color = Json::getString(attachmentMap, "color", 0);
-							if (color) {
-								region->getColor().r = toColor(color, 0);
-								region->getColor().g = toColor(color, 1);
-								region->getColor().b = toColor(color, 2);
-								region->getColor().a = toColor(color, 3);
-							}
+			RegionAttachment *region = static_cast<RegionAttachment *>(attachment);
+			region->_path = attachmentPath;
 
-							region->updateOffset();
-							_attachmentLoader->configureAttachment(region);
-							break;
-						}
-						case AttachmentType_Mesh:
-						case AttachmentType_Linkedmesh: {
-							attachment = _attachmentLoader->newMeshAttachment(*skin, attachmentName, attachmentPath);
-
-							if (!attachment) {
-								delete skeletonData;
-								setError(root, "Error reading attachment: ", skinAttachmentName);
-								return NULL;
-							}
+			region->_x = attachmentMap.getFloat(Key_X, 0) * _scale;
+			region->_y = attachmentMap.getFloat(Key_Y, 0) * _scale;
+			region->_scaleX = attachmentMap.getFloat(Key_ScaleX, 1);
+			region->_scaleY = attachmentMap.getFloat(Key_ScaleY, 1);
+			region->_rotation = attachmentMap.getFloat(Key_Rotation, 0);
+			region->_width = attachmentMap.getFloat(Key_Width, 32) * _scale;
+			region->_height = attachmentMap.getFloat(Key_Height, 32) * _scale;
 
-							MeshAttachment *mesh = static_cast<MeshAttachment *>(attachment);
-							mesh->_path = attachmentPath;
+			color = attachmentMap.getString(Key_Color, 0);
+			if (color) {
+				region->getColor().r = toColor(color, 0);
+				region->getColor().g = toColor(color, 1);
+				region->getColor().b = toColor(color, 2);
+				region->getColor().a = toColor(color, 3);
+			}
 
-							color = Json::getString(attachmentMap, "color", 0);
-							if (color) {
-								mesh->getColor().r = toColor(color, 0);
-								mesh->getColor().g = toColor(color, 1);
-								mesh->getColor().b = toColor(color, 2);
-								mesh->getColor().a = toColor(color, 3);
-							}
+			region->updateOffset();
+			_attachmentLoader->configureAttachment(region);
+			break;
+		}
+		case AttachmentType_Mesh:
+		case AttachmentType_Linkedmesh: {
+			attachment = _attachmentLoader->newMeshAttachment(*skin, attachmentName, attachmentPath);
 
-							mesh->_width = Json::getFloat(attachmentMap, "width", 32) * _scale;
-							mesh->_height = Json::getFloat(attachmentMap, "height", 32) * _scale;
-
-							entry = Json::getItem(attachmentMap, "parent");
-							if (!entry) {
-								int verticesLength;
-								entry = Json::getItem(attachmentMap, "triangles");
-								mesh->_triangles.ensureCapacity(entry->_size);
-								mesh->_triangles.setSize(entry->_size, 0);
-								for (entry = entry->_child, ii = 0; entry; entry = entry->_next, ++ii)
-									mesh->_triangles[ii] = (unsigned short) entry->_valueInt;
-
-								entry = Json::getItem(attachmentMap, "uvs");
-								verticesLength = entry->_size;
-								mesh->_regionUVs.ensureCapacity(verticesLength);
-								mesh->_regionUVs.setSize(verticesLength, 0);
-								for (entry = entry->_child, ii = 0; entry; entry = entry->_next, ++ii)
-									mesh->_regionUVs[ii] = entry->_valueFloat;
-
-								readVertices(attachmentMap, mesh, verticesLength);
-
-								mesh->updateUVs();
-
-								mesh->_hullLength = Json::getInt(attachmentMap, "hull", 0);
-
-								entry = Json::getItem(attachmentMap, "edges");
-								if (entry) {
-									mesh->_edges.ensureCapacity(entry->_size);
-									mesh->_edges.setSize(entry->_size, 0);
-									for (entry = entry->_child, ii = 0; entry; entry = entry->_next, ++ii)
-										mesh->_edges[ii] = entry->_valueInt;
-								}
-								_attachmentLoader->configureAttachment(mesh);
-							} else {
-								bool inheritDeform = Json::getInt(attachmentMap, "deform", 1) ? true : false;
-								LinkedMesh *linkedMesh = new(__FILE__, __LINE__) LinkedMesh(mesh,
-									String(Json::getString(attachmentMap, "skin", 0)), slot->getIndex(), String(entry->_valueString),
-									inheritDeform);
-								_linkedMeshes.add(linkedMesh);
-							}
-							break;
-						}
-						case AttachmentType_Boundingbox: {
-							attachment = _attachmentLoader->newBoundingBoxAttachment(*skin, attachmentName);
+			if (!attachment) {
+				setError("Error reading attachment: ", skinAttachmentName);
+				return NULL;
+			}
 
-							BoundingBoxAttachment *box = static_cast<BoundingBoxAttachment *>(attachment);
+			MeshAttachment *mesh = static_cast<MeshAttachment *>(attachment);
+			mesh->_path = attachmentPath;
 
-							int vertexCount = Json::getInt(attachmentMap, "vertexCount", 0) << 1;
-							readVertices(attachmentMap, box, vertexCount);
-							_attachmentLoader->configureAttachment(attachment);
-							break;
-						}
-						case AttachmentType_Path: {
-							attachment = _attachmentLoader->newPathAttachment(*skin, attachmentName);
+			color = attachmentMap.getString(Key_Color, 0);
+			if (color) {
+				mesh->getColor().r = toColor(color, 0);
+				mesh->getColor().g = toColor(color, 1);
+				mesh->getColor().b = toColor(color, 2);
+				mesh->getColor().a = toColor(color, 3);
+			}
 
-							PathAttachment *pathAttatchment = static_cast<PathAttachment *>(attachment);
+			mesh->_width = attachmentMap.getFloat(Key_Width, 32) * _scale;
+			mesh->_height = attachmentMap.getFloat(Key_Height, 32) * _scale;
 
-							int vertexCount = 0;
-							pathAttatchment->_closed = Json::getInt(attachmentMap, "closed", 0) ? true : false;
-							pathAttatchment->_constantSpeed = Json::getInt(attachmentMap, "constantSpeed", 1) ? true : false;
-							vertexCount = Json::getInt(attachmentMap, "vertexCount", 0);
-							readVertices(attachmentMap, pathAttatchment, vertexCount << 1);
+			if (!attachmentMap.has(Key_Parent)) {
+				size_t i;
+				mesh->_triangles.setSize(attachmentMap.getSize(Key_Triangles), 0);
+				if (attachmentMap.beginArray(Key_Triangles)) {
+					for (i = 0; reader.nextValue(); ++i)
+						mesh->_triangles[i] = (unsigned short) reader.readInt();
+				}
 
-							pathAttatchment->_lengths.ensureCapacity(vertexCount / 3);
-							pathAttatchment->_lengths.setSize(vertexCount / 3, 0);
+				int verticesLength = attachmentMap.getSize(Key_Uvs);
+				mesh->_regionUVs.setSize(verticesLength, 0);
+				if (attachmentMap.beginArray(Key_Uvs)) {
+					for (i = 0; reader.nextValue(); ++i)
+						mesh->_regionUVs[i] = reader.readFloat();
+				}
 
-							curves = Json::getItem(attachmentMap, "lengths");
-							for (curves = curves->_child, ii = 0; curves; curves = curves->_next, ++ii)
-								pathAttatchment->_lengths[ii] = curves->_valueFloat * _scale;
-							_attachmentLoader->configureAttachment(attachment);
-							break;
-						}
-						case AttachmentType_Point: {
-							attachment = _attachmentLoader->newPointAttachment(*skin, attachmentName);
+				readVertices(reader, attachmentMap, mesh, verticesLength);
 
-							PointAttachment *point = static_cast<PointAttachment *>(attachment);
+				mesh->updateUVs();
 
-							point->_x = Json::getFloat(attachmentMap, "x", 0) * _scale;
-							point->_y = Json::getFloat(attachmentMap, "y", 0) * _scale;
-							point->_rotation = Json::getFloat(attachmentMap, "rotation", 0);
-							_attachmentLoader->configureAttachment(attachment);
-							break;
-						}
-						case AttachmentType_Clipping: {
-							attachment = _attachmentLoader->newClippingAttachment(*skin, attachmentName);
-
-							ClippingAttachment *clip = static_cast<ClippingAttachment *>(attachment);
-
-							int vertexCount = 0;
-							const char *end = Json::getString(attachmentMap, "end", 0);
-							if (end) clip->_endSlot = skeletonData->findSlot(end);
-							vertexCount = Json::getInt(attachmentMap, "vertexCount", 0) << 1;
-							readVertices(attachmentMap, clip, vertexCount);
-							_attachmentLoader->configureAttachment(attachment);
-							break;
-						}
-					}
+				mesh->_hullLength = attachmentMap.getInt(Key_Hull, 0);
 
-					skin->setAttachment(slot->getIndex(), skinAttachmentName, attachment);
+				if (attachmentMap.has(Key_Edges)) {
+					mesh->_edges.setSize(attachmentMap.getSize(Key_Edges), 0);
+					attachmentMap.beginArray(Key_Edges);
+					for (i = 0; reader.nextValue(); ++i)
+						mesh->_edges[i] = (unsigned short) reader.readInt();
 				}
+				_attachmentLoader->configureAttachment(mesh);
+			} else {
+				bool inheritDeform = attachmentMap.getInt(Key_Deform, 1) ? true : false;
+				// Linked meshes are owned by this loader, not the skeleton data, so they must not use its arena.
+				ArenaScope heapScope(NULL);
+				String parent(attachmentMap.getString(Key_Parent, 0));
+				LinkedMesh *linkedMesh = new(__FILE__, __LINE__) LinkedMesh(mesh,
+					String(attachmentMap.getString(Key_Skin, 0)), slot->getIndex(), parent, inheritDeform);
+				_linkedMeshes.add(linkedMesh);
 			}
+			break;
 		}
-	}
+		case AttachmentType_Boundingbox: {
+			attachment = _attachmentLoader->newBoundingBoxAttachment(*skin, attachmentName);
 
-	/* Linked meshes. */
-	int n = _linkedMeshes.size();
-	for (i = 0; i < n; ++i) {
-		LinkedMesh *linkedMesh = _linkedMeshes[i];
-		Skin *skin = linkedMesh->_skin.length() == 0 ? skeletonData->getDefaultSkin() : skeletonData->findSkin(linkedMesh->_skin);
-		if (skin == NULL) {
-			delete skeletonData;
-			setError(root, "Skin not found: ", linkedMesh->_skin.buffer());
-			return NULL;
-		}
-		Attachment *parent = skin->getAttachment(linkedMesh->_slotIndex, linkedMesh->_parent);
-		if (parent == NULL) {
-			delete skeletonData;
-			setError(root, "Parent mesh not found: ", linkedMesh->_parent.buffer());
-			return NULL;
-		}
-		linkedMesh->_mesh->_deformAttachment = linkedMesh->_inheritDeform ? static_cast<VertexAttachment*>(parent) : linkedMesh->_mesh;
-		linkedMesh->_mesh->setParentMesh(static_cast<MeshAttachment *>(parent));
-		linkedMesh->_mesh->updateUVs();
-		_attachmentLoader->configureAttachment(linkedMesh->_mesh);
-	}
-	ContainerUtil::cleanUpVectorOfPointers(_linkedMeshes);
-	_linkedMeshes.clear();
+			BoundingBoxAttachment *box = static_cast<BoundingBoxAttachment *>(attachment);
 
-	/* Events. */
-	events = Json::getItem(root, "events");
-	if (events) {
-		Json *eventMap;
-		skeletonData->_events.ensureCapacity(events->_size);
-		skeletonData->_events.setSize(events->_size, 0);
-		for (eventMap = events->_child, i = 0; eventMap; eventMap = eventMap->_next, ++i) {
-			EventData *eventData = new(__FILE__, __LINE__) EventData(String(eventMap->_name));
-
-			eventData->_intValue = Json::getInt(eventMap, "int", 0);
-			eventData->_floatValue = Json::getFloat(eventMap, "float", 0);
-			const char *stringValue = Json::getString(eventMap, "string", 0);
-			eventData->_stringValue = stringValue;
-			const char *audioPath = Json::getString(eventMap, "audio", 0);
-			eventData->_audioPath = audioPath;
-			if (audioPath) {
-				eventData->_volume = Json::getFloat(eventMap, "volume", 1);
-				eventData->_balance = Json::getFloat(eventMap, "balance", 0);
-			}
-			skeletonData->_events[i] = eventData;
+			int vertexCount = attachmentMap.getInt(Key_VertexCount, 0) << 1;
+			readVertices(reader, attachmentMap, box, vertexCount);
+			_attachmentLoader->configureAttachment(attachment);
+			break;
 		}
-	}
+		case AttachmentType_Path: {
+			attachment = _attachmentLoader->newPathAttachment(*skin, attachmentName);
 
-	/* Animations. */
-	animations = Json::getItem(root, "animations");
-	if (animations) {
-		Json *animationMap;
-		skeletonData->_animations.ensureCapacity(animations->_size);
-		skeletonData->_animations.setSize(animations->_size, 0);
-		int animationsIndex = 0;
-		for (animationMap = animations->_child; animationMap; animationMap = animationMap->_next) {
-			Animation *animation = readAnimation(animationMap, skeletonData);
-			if (!animation) {
-				delete skeletonData;
-				delete root;
-				return NULL;
+			PathAttachment *pathAttatchment = static_cast<PathAttachment *>(attachment);
+
+			int vertexCount = 0;
+			pathAttatchment->_closed = attachmentMap.getInt(Key_Closed, 0) ? true : false;
+			pathAttatchment->_constantSpeed = attachmentMap.getInt(Key_ConstantSpeed, 1) ? true : false;
+			vertexCount = attachmentMap.getInt(Key_VertexCount, 0);
+			readVertices(reader, attachmentMap, pathAttatchment, vertexCount << 1);
+
+			pathAttatchment->_lengths.setSize(vertexCount / 3, 0);
+			if (attachmentMap.beginArray(Key_Lengths)) {
+				for (size_t i = 0; reader.nextValue(); ++i)
+					pathAttatchment->_lengths[i] = reader.readFloat() * _scale;
 			}
-			skeletonData->_animations[animationsIndex++] = animation;
+			_attachmentLoader->configureAttachment(attachment);
+			break;
 		}
-	}
+		case AttachmentType_Point: {
+			attachment = _attachmentLoader->newPointAttachment(*skin, attachmentName);
 
-	delete root;
+			PointAttachment *point = static_cast<PointAttachment *>(attachment);
 
-	return skeletonData;
+			point->_x = attachmentMap.getFloat(Key_X, 0) * _scale;
+			point->_y = attachmentMap.getFloat(Key_Y, 0) * _scale;
+			point->_rotation = attachmentMap.getFloat(Key_Rotation, 0);
+			_attachmentLoader->configureAttachment(attachment);
+			break;
+		}
+		case AttachmentType_Clipping: {
+			attachment = _attachmentLoader->newClippingAttachment(*skin, attachmentName);
+
+			ClippingAttachment *clip = static_cast<ClippingAttachment *>(attachment);
+
+			int vertexCount = 0;
+			const char *end = attachmentMap.getString(Key_End, 0);
+			if (end) clip->_endSlot = skeletonData->findSlot(end);
+			vertexCount = attachmentMap.getInt(Key_VertexCount, 0) << 1;
+			readVertices(reader, attachmentMap, clip, vertexCount);
+			_attachmentLoader->configureAttachment(attachment);
+			break;
+		}
+	}
+	return attachment;
 }
 
 float SkeletonJson::toColor(const char *value, size_t index) {
@@ -731,7 +1041,7 @@ float SkeletonJson::toColor(const char *value, size_t index) {
 	char *error;
 	int color;
 
-	if (index >= strlen(value) / 2) return -1;
+	if (!value || index >= strlen(value) / 2) return -1;
 
 	value += index * 2;
 
@@ -744,179 +1054,207 @@ float SkeletonJson::toColor(const char *value, size_t index) {
 	return color / (float) 255;
 }
 
-void SkeletonJson::readCurve(Json *frame, CurveTimeline *timeline, size_t frameIndex) {
-	Json *curve = Json::getItem(frame, "curve");
-	if (!curve) return;
-	if (curve->_type == Json::JSON_STRING && strcmp(curve->_valueString, "stepped") == 0)
-		timeline->setStepped(frameIndex);
-	else {
-		float c1 = Json::getFloat(frame, "curve", 0);
-		float c2 = Json::getFloat(frame, "c2", 0);
-		float c3 = Json::getFloat(frame, "c3", 1);
-		float c4 = Json::getFloat(frame, "c4", 1);
-		timeline->setCurve(frameIndex, c1, c2, c3, c4);
-	}
-}
-
-Animation *SkeletonJson::readAnimation(Json *root, SkeletonData *skeletonData) {
+Animation *SkeletonJson::readAnimation(JsonReader &reader, const String &name, SkeletonData *skeletonData) {
+	// The animation copies the timelines, so the vector is kept on the heap instead of being stranded in the arena. Heap
+	// memory stays on the heap when it grows.
 	Vector<Timeline *> timelines;
+	{
+		ArenaScope heapScope(NULL);
+		timelines.ensureCapacity(16);
+	}
 	float duration = 0;
-
 	size_t frameIndex;
-	Json *valueMap;
-	int timelinesCount = 0;
-
-	Json *bones = Json::getItem(root, "bones");
-	Json *slots = Json::getItem(root, "slots");
-	Json *ik = Json::getItem(root, "ik");
-	Json *transform = Json::getItem(root, "transform");
-	Json *paths = Json::getItem(root, "path");
-	Json *deform = Json::getItem(root, "deform");
-	Json *drawOrder = Json::getItem(root, "drawOrder");
-	Json *events = Json::getItem(root, "events");
-	Json *boneMap, *slotMap, *constraintMap;
-	if (!drawOrder) drawOrder = Json::getItem(root, "draworder");
-
-	for (boneMap = bones ? bones->_child : NULL; boneMap; boneMap = boneMap->_next)
-		timelinesCount += boneMap->_size;
-
-	for (slotMap = slots ? slots->_child : NULL; slotMap; slotMap = slotMap->_next)
-		timelinesCount += slotMap->_size;
 
-	timelinesCount += ik ? ik->_size : 0;
-	timelinesCount += transform ? transform->_size : 0;
-
-	for (constraintMap = paths ? paths->_child : NULL; constraintMap; constraintMap = constraintMap->_next)
-		timelinesCount += constraintMap->_size;
-
-	for (constraintMap = deform ? deform->_child : NULL; constraintMap; constraintMap = constraintMap->_next)
-		for (slotMap = constraintMap->_child; slotMap; slotMap = slotMap->_next)
-			timelinesCount += slotMap->_size;
-
-	if (drawOrder) ++timelinesCount;
-
-	if (events) ++timelinesCount;
+	// Timelines are created in the same order regardless of the order of the animation's keys.
+	JsonMap root(reader);
 
 	/** Slot timelines. */
-	for (slotMap = slots ? slots->_child : 0; slotMap; slotMap = slotMap->_next) {
-		Json *timelineMap;
-
-		int slotIndex = skeletonData->findSlotIndex(slotMap->_name);
-		if (slotIndex == -1) {
-			ContainerUtil::cleanUpVectorOfPointers(timelines);
-			setError(NULL, "Slot not found: ", slotMap->_name);
-			return NULL;
-		}
-
-		for (timelineMap = slotMap->_child; timelineMap; timelineMap = timelineMap->_next) {
-			if (strcmp(timelineMap->_name, "attachment") == 0) {
-				AttachmentTimeline *timeline = new(__FILE__, __LINE__) AttachmentTimeline(timelineMap->_size);
-
-				timeline->_slotIndex = slotIndex;
-
-				for (valueMap = timelineMap->_child, frameIndex = 0; valueMap; valueMap = valueMap->_next, ++frameIndex) {
-					Json *name = Json::getItem(valueMap, "name");
-					String attachmentName = name->_type == Json::JSON_NULL ? "" : name->_valueString;
-					timeline->setFrame(frameIndex, Json::getFloat(valueMap, "time", 0), attachmentName);
-				}
-				timelines.add(timeline);
-				timelinesCount++;
-				duration = MathUtil::max(duration, timeline->_frames[timelineMap->_size - 1]);
-
-			} else if (strcmp(timelineMap->_name, "color") == 0) {
-				ColorTimeline *timeline = new(__FILE__, __LINE__) ColorTimeline(timelineMap->_size);
-
-				timeline->_slotIndex = slotIndex;
-
-				for (valueMap = timelineMap->_child, frameIndex = 0; valueMap; valueMap = valueMap->_next, ++frameIndex) {
-					const char *s = Json::getString(valueMap, "color", 0);
-					timeline->setFrame(frameIndex, Json::getFloat(valueMap, "time", 0), toColor(s, 0), toColor(s, 1),
-						toColor(s, 2), toColor(s, 3));
-					readCurve(valueMap, timeline, frameIndex);
+	if (root.seek(Key_Slots) && reader.beginObject()) {
+		while (reader.nextKey()) {
+			int slotIndex = skeletonData->findSlotIndex(reader.getKey());
+			if (slotIndex == -1) {
+				ContainerUtil::cleanUpVectorOfPointers(timelines);
+				setError("Slot not found: ", reader.getKey());
+				return NULL;
+			}
+			if (!reader.beginObject()) continue;
+			while (reader.nextKey()) {
+				Key timelineName = getKey(reader);
+				if (timelineName != Key_Attachment && timelineName != Key_Color && timelineName != Key_TwoColor) {
+					ContainerUtil::cleanUpVectorOfPointers(timelines);
+					setError("Invalid timeline type for a slot: ", reader.getKey());
+					return NULL;
 				}
-				timelines.add(timeline);
-				timelinesCount++;
-				duration = MathUtil::max(duration, timeline->_frames[(timelineMap->_size - 1) * ColorTimeline::ENTRIES]);
-
-			} else if (strcmp(timelineMap->_name, "twoColor") == 0) {
-				TwoColorTimeline *timeline = new(__FILE__, __LINE__) TwoColorTimeline(timelineMap->_size);
-
-				timeline->_slotIndex = slotIndex;
+				int frameCount = reader.peekArraySize();
+				if (!reader.beginArray() || frameCount == 0) continue;
+
+				if (timelineName == Key_Attachment) {
+					AttachmentTimeline *timeline = new(__FILE__, __LINE__) AttachmentTimeline(frameCount);
+					timeline->_slotIndex = slotIndex;
+					for (frameIndex = 0; reader.nextValue(); ++frameIndex) {
+						float time = 0;
+						String attachmentName;
+						if (reader.beginObject()) {
+							while (reader.nextKey()) {
+								switch (getKey(reader)) {
+								case Key_Time:
+									time = reader.readFloat();
+									break;
+								case Key_Name: {
+									const char *value = reader.readString();
+									attachmentName = value ? value : "";
+									break;
+								}
+								default:
+									reader.skipValue();
+								}
+							}
+						}
+						timeline->setFrame(frameIndex, time, attachmentName);
+					}
+					timelines.add(timeline);
+					duration = MathUtil::max(duration, timeline->_frames[frameCount - 1]);
+
+				} else if (timelineName == Key_Color) {
+					ColorTimeline *timeline = new(__FILE__, __LINE__) ColorTimeline(frameCount);
+					timeline->_slotIndex = slotIndex;
+					for (frameIndex = 0; reader.nextValue(); ++frameIndex) {
+						float time = 0, r = -1, g = -1, b = -1, a = -1;
+						FrameCurve curve;
+						if (reader.beginObject()) {
+							while (reader.nextKey()) {
+								Key key = getKey(reader);
+								if (key == Key_Time)
+									time = reader.readFloat();
+								else if (key == Key_Color) {
+									const char *s = reader.readString();
+									r = toColor(s, 0);
+									g = toColor(s, 1);
+									b = toColor(s, 2);
+									a = toColor(s, 3);
+								} else if (!readCurve(reader, key, curve))
+									reader.skipValue();
+							}
+						}
+						timeline->setFrame(frameIndex, time, r, g, b, a);
+						setCurve(timeline, frameIndex, curve);
+					}
+					timelines.add(timeline);
+					duration = MathUtil::max(duration, timeline->_frames[(frameCount - 1) * ColorTimeline::ENTRIES]);
 
-				for (valueMap = timelineMap->_child, frameIndex = 0; valueMap; valueMap = valueMap->_next, ++frameIndex) {
-					const char *s = Json::getString(valueMap, "light", 0);
-					const char *ds = Json::getString(valueMap, "dark", 0);
-					timeline->setFrame(frameIndex, Json::getFloat(valueMap, "time", 0), toColor(s, 0), toColor(s, 1),
-						toColor(s, 2), toColor(s, 3), toColor(ds, 0), toColor(ds, 1), toColor(ds, 2));
-					readCurve(valueMap, timeline, frameIndex);
+				} else {
+					TwoColorTimeline *timeline = new(__FILE__, __LINE__) TwoColorTimeline(frameCount);
+					timeline->_slotIndex = slotIndex;
+					for (frameIndex = 0; reader.nextValue(); ++frameIndex) {
+						float time = 0, r = -1, g = -1, b = -1, a = -1, r2 = -1, g2 = -1, b2 = -1;
+						FrameCurve curve;
+						if (reader.beginObject()) {
+							while (reader.nextKey()) {
+								Key key = getKey(reader);
+								if (key == Key_Time)
+									time = reader.readFloat();
+								else if (key == Key_Light) {
+									const char *s = reader.readString();
+									r = toColor(s, 0);
+									g = toColor(s, 1);
+									b = toColor(s, 2);
+									a = toColor(s, 3);
+								} else if (key == Key_Dark) {
+									const char *ds = reader.readString();
+									r2 = toColor(ds, 0);
+									g2 = toColor(ds, 1);
+									b2 = toColor(ds, 2);
+								} else if (!readCurve(reader, key, curve))
+									reader.skipValue();
+							}
+						}
+						timeline->setFrame(frameIndex, time, r, g, b, a, r2, g2, b2);
+						setCurve(timeline, frameIndex, curve);
+					}
+					timelines.add(timeline);
+					duration = MathUtil::max(duration, timeline->_frames[(frameCount - 1) * TwoColorTimeline::ENTRIES]);
 				}
-				timelines.add(timeline);
-				timelinesCount++;
-				duration = MathUtil::max(duration,
-										 timeline->_frames[(timelineMap->_size - 1) * TwoColorTimeline::ENTRIES]);
-			} else {
-				ContainerUtil::cleanUpVectorOfPointers(timelines);
-				setError(NULL, "Invalid timeline type for a slot: ", timelineMap->_name);
-				return NULL;
 			}
 		}
 	}
 
 	/** Bone timelines. */
-	for (boneMap = bones ? bones->_child : 0; boneMap; boneMap = boneMap->_next) {
-		Json *timelineMap;
-
-		int boneIndex = skeletonData->findBoneIndex(boneMap->_name);
-		if (boneIndex == -1) {
-			ContainerUtil::cleanUpVectorOfPointers(timelines);
-			setError(NULL, "Bone not found: ", boneMap->_name);
-			return NULL;
-		}
-
-		for (timelineMap = boneMap->_child; timelineMap; timelineMap = timelineMap->_next) {
-			if (strcmp(timelineMap->_name, "rotate") == 0) {
-				RotateTimeline *timeline = new(__FILE__, __LINE__) RotateTimeline(timelineMap->_size);
-
-				timeline->_boneIndex = boneIndex;
-
-				for (valueMap = timelineMap->_child, frameIndex = 0; valueMap; valueMap = valueMap->_next, ++frameIndex) {
-					timeline->setFrame(frameIndex, Json::getFloat(valueMap, "time", 0), Json::getFloat(valueMap, "angle", 0));
-					readCurve(valueMap, timeline, frameIndex);
-				}
-				timelines.add(timeline);
-				timelinesCount++;
-				duration = MathUtil::max(duration, timeline->_frames[(timelineMap->_size - 1) * RotateTimeline::ENTRIES]);
-			} else {
-				int isScale = strcmp(timelineMap->_name, "scale") == 0;
-				int isTranslate = strcmp(timelineMap->_name, "translate") == 0;
-				int isShear = strcmp(timelineMap->_name, "shear") == 0;
-				if (isScale || isTranslate || isShear) {
-					float timelineScale = isTranslate ? _scale : 1;
+	if (root.seek(Key_Bones) && reader.beginObject()) {
+		while (reader.nextKey()) {
+			int boneIndex = skeletonData->findBoneIndex(reader.getKey());
+			if (boneIndex == -1) {
+				ContainerUtil::cleanUpVectorOfPointers(timelines);
+				setError("Bone not found: ", reader.getKey());
+				return NULL;
+			}
+			if (!reader.beginObject()) continue;
+			while (reader.nextKey()) {
+				Key timelineName = getKey(reader);
+				if (timelineName == Key_Rotate) {
+					int frameCount = reader.peekArraySize();
+					if (!reader.beginArray() || frameCount == 0) continue;
+					RotateTimeline *timeline = new(__FILE__, __LINE__) RotateTimeline(frameCount);
+					timeline->_boneIndex = boneIndex;
+					for (frameIndex = 0; reader.nextValue(); ++frameIndex) {
+						float time = 0, angle = 0;
+						FrameCurve curve;
+						if (reader.beginObject()) {
+							while (reader.nextKey()) {
+								Key key = getKey(reader);
+								if (key == Key_Time)
+									time = reader.readFloat();
+								else if (key == Key_Angle)
+									angle = reader.readFloat();
+								else if (!readCurve(reader, key, curve))
+									reader.skipValue();
+							}
+						}
+						timeline->setFrame(frameIndex, time, angle);
+						setCurve(timeline, frameIndex, curve);
+					}
+					timelines.add(timeline);
+					duration = MathUtil::max(duration, timeline->_frames[(frameCount - 1) * RotateTimeline::ENTRIES]);
+				} else if (timelineName == Key_Scale || timelineName == Key_Translate || timelineName == Key_Shear) {
+					int frameCount = reader.peekArraySize();
+					if (!reader.beginArray() || frameCount == 0) continue;
+					float timelineScale = timelineName == Key_Translate ? _scale : 1;
 					float defaultValue = 0;
-					TranslateTimeline *timeline = 0;
-					if (isScale) {
-						timeline = new(__FILE__, __LINE__) ScaleTimeline(timelineMap->_size);
+					TranslateTimeline *timeline;
+					if (timelineName == Key_Scale) {
+						timeline = new(__FILE__, __LINE__) ScaleTimeline(frameCount);
 						defaultValue = 1;
-					} else if (isTranslate) {
-						timeline = new(__FILE__, __LINE__) TranslateTimeline(timelineMap->_size);
-					} else if (isShear) {
-						timeline = new(__FILE__, __LINE__) ShearTimeline(timelineMap->_size);
+					} else if (timelineName == Key_Translate) {
+						timeline = new(__FILE__, __LINE__) TranslateTimeline(frameCount);
+					} else {
+						timeline = new(__FILE__, __LINE__) ShearTimeline(frameCount);
 					}
 					timeline->_boneIndex = boneIndex;
 
-					for (valueMap = timelineMap->_child, frameIndex = 0; valueMap; valueMap = valueMap->_next, ++frameIndex) {
-						timeline->setFrame(frameIndex, Json::getFloat(valueMap, "time", 0),
-							Json::getFloat(valueMap, "x", defaultValue) * timelineScale,
-							Json::getFloat(valueMap, "y", defaultValue) * timelineScale);
-						readCurve(valueMap, timeline, frameIndex);
+					for (frameIndex = 0; reader.nextValue(); ++frameIndex) {
+						float time = 0, x = defaultValue, y = defaultValue;
+						FrameCurve curve;
+						if (reader.beginObject()) {
+							while (reader.nextKey()) {
+								Key key = getKey(reader);
+								if (key == Key_Time)
+									time = reader.readFloat();
+								else if (key == Key_X)
+									x = reader.readFloat();
+								else if (key == Key_Y)
+									y = reader.readFloat();
+								else if (!readCurve(reader, key, curve))
+									reader.skipValue();
+							}
+						}
+						timeline->setFrame(frameIndex, time, x * timelineScale, y * timelineScale);
+						setCurve(timeline, frameIndex, curve);
 					}
 
 					timelines.add(timeline);
-					timelinesCount++;
-					duration = MathUtil::max(duration, timeline->_frames[(timelineMap->_size - 1) * TranslateTimeline::ENTRIES]);
+					duration = MathUtil::max(duration, timeline->_frames[(frameCount - 1) * TranslateTimeline::ENTRIES]);
 				} else {
 					ContainerUtil::cleanUpVectorOfPointers(timelines);
-					setError(NULL, "Invalid timeline type for a bone: ", timelineMap->_name);
+					setError("Invalid timeline type for a bone: ", reader.getKey());
 					return NULL;
 				}
 			}
@@ -924,274 +1262,377 @@ Animation *SkeletonJson::readAnimation(Json *root, SkeletonData *skeletonData) {
 	}
 
 	/** IK constraint timelines. */
-	for (constraintMap = ik ? ik->_child : 0; constraintMap; constraintMap = constraintMap->_next) {
-		IkConstraintData *constraint = skeletonData->findIkConstraint(constraintMap->_name);
-		IkConstraintTimeline *timeline = new(__FILE__, __LINE__) IkConstraintTimeline(constraintMap->_size);
-
-		for (frameIndex = 0; frameIndex < skeletonData->_ikConstraints.size(); ++frameIndex) {
-			if (constraint == skeletonData->_ikConstraints[frameIndex]) {
-				timeline->_ikConstraintIndex = frameIndex;
-				break;
+	if (root.seek(Key_Ik) && reader.beginObject()) {
+		while (reader.nextKey()) {
+			IkConstraintData *constraint = skeletonData->findIkConstraint(reader.getKey());
+			int frameCount = reader.peekArraySize();
+			if (!reader.beginArray() || frameCount == 0) continue;
+			IkConstraintTimeline *timeline = new(__FILE__, __LINE__) IkConstraintTimeline(frameCount);
+
+			for (frameIndex = 0; frameIndex < skeletonData->_ikConstraints.size(); ++frameIndex) {
+				if (constraint == skeletonData->_ikConstraints[frameIndex]) {
+					timeline->_ikConstraintIndex = frameIndex;
+					break;
+				}
 			}
+			for (frameIndex = 0; reader.nextValue(); ++frameIndex) {
+				float time = 0, mix = 1, softness = 0;
+				int bendPositive = 1, compress = 0, stretch = 0;
+				FrameCurve curve;
+				if (reader.beginObject()) {
+					while (reader.nextKey()) {
+						Key key = getKey(reader);
+						if (key == Key_Time)
+							time = reader.readFloat();
+						else if (key == Key_Mix)
+							mix = reader.readFloat();
+						else if (key == Key_Softness)
+							softness = reader.readFloat();
+						else if (key == Key_BendPositive)
+							bendPositive = reader.readInt();
+						else if (key == Key_Compress)
+							compress = reader.readInt();
+						else if (key == Key_Stretch)
+							stretch = reader.readInt();
+						else if (!readCurve(reader, key, curve))
+							reader.skipValue();
+					}
+				}
+				timeline->setFrame(frameIndex, time, mix, softness * _scale, bendPositive ? 1 : -1, compress ? true : false,
+					stretch ? true : false);
+				setCurve(timeline, frameIndex, curve);
+			}
+			timelines.add(timeline);
+			duration = MathUtil::max(duration, timeline->_frames[(frameCount - 1) * IkConstraintTimeline::ENTRIES]);
 		}
-		for (valueMap = constraintMap->_child, frameIndex = 0; valueMap; valueMap = valueMap->_next, ++frameIndex) {
-			timeline->setFrame(frameIndex, Json::getFloat(valueMap, "time", 0), Json::getFloat(valueMap, "mix", 1),
-				Json::getFloat(valueMap, "softness", 0) * _scale, Json::getInt(valueMap, "bendPositive", 1) ? 1 : -1,
-				Json::getInt(valueMap, "compress", 0) ? true : false, Json::getInt(valueMap, "stretch", 0) ? true : false);
-			readCurve(valueMap, timeline, frameIndex);
-		}
-		timelines.add(timeline);
-		timelinesCount++;
-		duration = MathUtil::max(duration, timeline->_frames[(constraintMap->_size - 1) * IkConstraintTimeline::ENTRIES]);
 	}
 
 	/** Transform constraint timelines. */
-	for (constraintMap = transform ? transform->_child : 0; constraintMap; constraintMap = constraintMap->_next) {
-		TransformConstraintData *constraint = skeletonData->findTransformConstraint(constraintMap->_name);
-		TransformConstraintTimeline *timeline = new(__FILE__, __LINE__) TransformConstraintTimeline(constraintMap->_size);
-
-		for (frameIndex = 0; frameIndex < skeletonData->_transformConstraints.size(); ++frameIndex) {
-			if (constraint == skeletonData->_transformConstraints[frameIndex]) {
-				timeline->_transformConstraintIndex = frameIndex;
-				break;
+	if (root.seek(Key_Transform) && reader.beginObject()) {
+		while (reader.nextKey()) {
+			TransformConstraintData *constraint = skeletonData->findTransformConstraint(reader.getKey());
+			int frameCount = reader.peekArraySize();
+			if (!reader.beginArray() || frameCount == 0) continue;
+			TransformConstraintTimeline *timeline = new(__FILE__, __LINE__) TransformConstraintTimeline(frameCount);
+
+			for (frameIndex = 0; frameIndex < skeletonData->_transformConstraints.size(); ++frameIndex) {
+				if (constraint == skeletonData->_transformConstraints[frameIndex]) {
+					timeline->_transformConstraintIndex = frameIndex;
+					break;
+				}
 			}
+			for (frameIndex = 0; reader.nextValue(); ++frameIndex) {
+				float time = 0, rotateMix = 1, translateMix = 1, scaleMix = 1, shearMix = 1;
+				FrameCurve curve;
+				if (reader.beginObject()) {
+					while (reader.nextKey()) {
+						Key key = getKey(reader);
+						if (key == Key_Time)
+							time = reader.readFloat();
+						else if (key == Key_RotateMix)
+							rotateMix = reader.readFloat();
+						else if (key == Key_TranslateMix)
+							translateMix = reader.readFloat();
+						else if (key == Key_ScaleMix)
+							scaleMix = reader.readFloat();
+						else if (key == Key_ShearMix)
+							shearMix = reader.readFloat();
+						else if (!readCurve(reader, key, curve))
+							reader.skipValue();
+					}
+				}
+				timeline->setFrame(frameIndex, time, rotateMix, translateMix, scaleMix, shearMix);
+				setCurve(timeline, frameIndex, curve);
+			}
+			timelines.add(timeline);
+			duration = MathUtil::max(duration, timeline->_frames[(frameCount - 1) * TransformConstraintTimeline::ENTRIES]);
 		}
-		for (valueMap = constraintMap->_child, frameIndex = 0; valueMap; valueMap = valueMap->_next, ++frameIndex) {
-			timeline->setFrame(frameIndex, Json::getFloat(valueMap, "time", 0),
-				Json::getFloat(valueMap, "rotateMix", 1), Json::getFloat(valueMap, "translateMix", 1),
-				Json::getFloat(valueMap, "scaleMix", 1), Json::getFloat(valueMap, "shearMix", 1));
-			readCurve(valueMap, timeline, frameIndex);
-		}
-		timelines.add(timeline);
-		timelinesCount++;
-		duration = MathUtil::max(duration, timeline->_frames[(constraintMap->_size - 1) * TransformConstraintTimeline::ENTRIES]);
 	}
 
 	/** Path constraint timelines. */
-	for (constraintMap = paths ? paths->_child : 0; constraintMap; constraintMap = constraintMap->_next) {
-		size_t constraintIndex = 0, i;
-		Json *timelineMap;
-
-		PathConstraintData *data = skeletonData->findPathConstraint(constraintMap->_name);
-		if (!data) {
-			ContainerUtil::cleanUpVectorOfPointers(timelines);
-			setError(NULL, "Path constraint not found: ", constraintMap->_name);
-			return NULL;
-		}
+	if (root.seek(Key_Path) && reader.beginObject()) {
+		while (reader.nextKey()) {
+			size_t constraintIndex = 0, i;
 
-		for (i = 0; i < skeletonData->_pathConstraints.size(); i++) {
-			if (skeletonData->_pathConstraints[i] == data) {
-				constraintIndex = i;
-				break;
+			PathConstraintData *data = skeletonData->findPathConstraint(reader.getKey());
+			if (!data) {
+				ContainerUtil::cleanUpVectorOfPointers(timelines);
+				setError("Path constraint not found: ", reader.getKey());
+				return NULL;
 			}
-		}
 
-		for (timelineMap = constraintMap->_child; timelineMap; timelineMap = timelineMap->_next) {
-			const char *timelineName = timelineMap->_name;
-			if (strcmp(timelineName, "position") == 0 || strcmp(timelineName, "spacing") == 0) {
-				PathConstraintPositionTimeline *timeline;
-				float timelineScale = 1;
-				if (strcmp(timelineName, "spacing") == 0) {
-					timeline = new(__FILE__, __LINE__) PathConstraintSpacingTimeline(timelineMap->_size);
+			for (i = 0; i < skeletonData->_pathConstraints.size(); i++) {
+				if (skeletonData->_pathConstraints[i] == data) {
+					constraintIndex = i;
+					break;
+				}
+			}
 
-					if (data->_spacingMode == SpacingMode_Length || data->_spacingMode == SpacingMode_Fixed) {
-						timelineScale = _scale;
-					}
-				} else {
-					timeline = new(__FILE__, __LINE__) PathConstraintPositionTimeline(timelineMap->_size);
+			if (!reader.beginObject()) continue;
+			while (reader.nextKey()) {
+				Key timelineName = getKey(reader);
+				int frameCount = reader.peekArraySize();
+				if (timelineName == Key_Position || timelineName == Key_Spacing) {
+					if (!reader.beginArray() || frameCount == 0) continue;
+					PathConstraintPositionTimeline *timeline;
+					float timelineScale = 1;
+					if (timelineName == Key_Spacing) {
+						timeline = new(__FILE__, __LINE__) PathConstraintSpacingTimeline(frameCount);
+
+						if (data->_spacingMode == SpacingMode_Length || data->_spacingMode == SpacingMode_Fixed) {
+							timelineScale = _scale;
+						}
+					} else {
+						timeline = new(__FILE__, __LINE__) PathConstraintPositionTimeline(frameCount);
 
-					if (data->_positionMode == PositionMode_Fixed) {
-						timelineScale = _scale;
+						if (data->_positionMode == PositionMode_Fixed) {
+							timelineScale = _scale;
+						}
 					}
-				}
 
-				timeline->_pathConstraintIndex = constraintIndex;
-				for (valueMap = timelineMap->_child, frameIndex = 0; valueMap; valueMap = valueMap->_next, ++frameIndex) {
-					timeline->setFrame(frameIndex, Json::getFloat(valueMap, "time", 0),
-						Json::getFloat(valueMap, timelineName, 0) * timelineScale);
-					readCurve(valueMap, timeline, frameIndex);
-				}
-				timelines.add(timeline);
-				timelinesCount++;
-				duration = MathUtil::max(duration, timeline->_frames[(timelineMap->_size - 1) *
-																	 PathConstraintPositionTimeline::ENTRIES]);
-			} else if (strcmp(timelineName, "mix") == 0) {
-				PathConstraintMixTimeline *timeline = new(__FILE__, __LINE__) PathConstraintMixTimeline(timelineMap->_size);
-				timeline->_pathConstraintIndex = constraintIndex;
-				for (valueMap = timelineMap->_child, frameIndex = 0; valueMap; valueMap = valueMap->_next, ++frameIndex) {
-					timeline->setFrame(frameIndex, Json::getFloat(valueMap, "time", 0),
-						Json::getFloat(valueMap, "rotateMix", 1),
-						Json::getFloat(valueMap, "translateMix", 1));
-					readCurve(valueMap, timeline, frameIndex);
-				}
-				timelines.add(timeline);
-				timelinesCount++;
-				duration = MathUtil::max(duration, timeline->_frames[(timelineMap->_size - 1) * PathConstraintMixTimeline::ENTRIES]);
+					timeline->_pathConstraintIndex = constraintIndex;
+					for (frameIndex = 0; reader.nextValue(); ++frameIndex) {
+						float time = 0, value = 0;
+						FrameCurve curve;
+						if (reader.beginObject()) {
+							while (reader.nextKey()) {
+								Key key = getKey(reader);
+								if (key == Key_Time)
+									time = reader.readFloat();
+								else if (key == timelineName)
+									value = reader.readFloat();
+								else if (!readCurve(reader, key, curve))
+									reader.skipValue();
+							}
+						}
+						timeline->setFrame(frameIndex, time, value * timelineScale);
+						setCurve(timeline, frameIndex, curve);
+					}
+					timelines.add(timeline);
+					duration = MathUtil::max(duration, timeline->_frames[(frameCount - 1) *
+																		 PathConstraintPositionTimeline::ENTRIES]);
+				} else if (timelineName == Key_Mix) {
+					if (!reader.beginArray() || frameCount == 0) continue;
+					PathConstraintMixTimeline *timeline = new(__FILE__, __LINE__) PathConstraintMixTimeline(frameCount);
+					timeline->_pathConstraintIndex = constraintIndex;
+					for (frameIndex = 0; reader.nextValue(); ++frameIndex) {
+						float time = 0, rotateMix = 1, translateMix = 1;
+						FrameCurve curve;
+						if (reader.beginObject()) {
+							while (reader.nextKey()) {
+								Key key = getKey(reader);
+								if (key == Key_Time)
+									time = reader.readFloat();
+								else if (key == Key_RotateMix)
+									rotateMix = reader.readFloat();
+								else if (key == Key_TranslateMix)
+									translateMix = reader.readFloat();
+								else if (!readCurve(reader, key, curve))
+									reader.skipValue();
+							}
+						}
+						timeline->setFrame(frameIndex, time, rotateMix, translateMix);
+						setCurve(timeline, frameIndex, curve);
+					}
+					timelines.add(timeline);
+					duration = MathUtil::max(duration, timeline->_frames[(frameCount - 1) * PathConstraintMixTimeline::ENTRIES]);
+				} else
+					reader.skipValue();
 			}
 		}
 	}
 
 	/** Deform timelines. */
-	for (constraintMap = deform ? deform->_child : NULL; constraintMap; constraintMap = constraintMap->_next) {
-		Skin *skin = skeletonData->findSkin(constraintMap->_name);
-		for (slotMap = constraintMap->_child; slotMap; slotMap = slotMap->_next) {
-			int slotIndex = skeletonData->findSlotIndex(slotMap->_name);
-			Json *timelineMap;
-			for (timelineMap = slotMap->_child; timelineMap; timelineMap = timelineMap->_next) {
-				DeformTimeline *timeline;
-				int weighted, deformLength;
-
-				Attachment *baseAttachment = skin->getAttachment(slotIndex, timelineMap->_name);
-
-				if (!baseAttachment) {
-					ContainerUtil::cleanUpVectorOfPointers(timelines);
-					setError(NULL, "Attachment not found: ", timelineMap->_name);
-					return NULL;
-				}
-
-				VertexAttachment *attachment = static_cast<VertexAttachment *>(baseAttachment);
-
-				weighted = attachment->_bones.size() != 0;
-				Vector<float> &verts = attachment->_vertices;
-				deformLength = weighted ? verts.size() / 3 * 2 : verts.size();
-
-				timeline = new(__FILE__, __LINE__) DeformTimeline(timelineMap->_size);
-
-				timeline->_slotIndex = slotIndex;
-				timeline->_attachment = attachment;
-
-				for (valueMap = timelineMap->_child, frameIndex = 0; valueMap; valueMap = valueMap->_next, ++frameIndex) {
-					Json *vertices = Json::getItem(valueMap, "vertices");
-					Vector<float> deformed;
-					if (!vertices) {
-						if (weighted) {
-							deformed.setSize(deformLength, 0);
-						} else {
-							deformed.clearAndAddAll(attachment->_vertices);
-						}
-					} else {
-						int v, start = Json::getInt(valueMap, "offset", 0);
-						Json *vertex;
-						deformed.setSize(deformLength, 0);
-						if (_scale == 1) {
-							for (vertex = vertices->_child, v = start; vertex; vertex = vertex->_next, ++v) {
-								deformed[v] = vertex->_valueFloat;
-							}
-						} else {
-							for (vertex = vertices->_child, v = start; vertex; vertex = vertex->_next, ++v) {
-								deformed[v] = vertex->_valueFloat * _scale;
+	if (root.seek(Key_Deform) && reader.beginObject()) {
+		// setFrame() copies the vertices, so they are read into heap scratch.
+		Vector<float> vertices;
+		{
+			ArenaScope heapScope(NULL);
+			vertices.ensureCapacity(64);
+		}
+		while (reader.nextKey()) {
+			Skin *skin = skeletonData->findSkin(reader.getKey());
+			if (!skin) {
+				ContainerUtil::cleanUpVectorOfPointers(timelines);
+				setError("Skin not found: ", reader.getKey());
+				return NULL;
+			}
+			if (!reader.beginObject()) continue;
+			while (reader.nextKey()) {
+				int slotIndex = skeletonData->findSlotIndex(reader.getKey());
+				if (!reader.beginObject()) continue;
+				while (reader.nextKey()) {
+					Attachment *baseAttachment = skin->getAttachment(slotIndex, reader.getKey());
+					if (!baseAttachment) {
+						ContainerUtil::cleanUpVectorOfPointers(timelines);
+						setError("Attachment not found: ", reader.getKey());
+						return NULL;
+					}
+					int frameCount = reader.peekArraySize();
+					if (!reader.beginArray() || frameCount == 0) continue;
+
+					VertexAttachment *attachment = static_cast<VertexAttachment *>(baseAttachment);
+
+					bool weighted = attachment->_bones.size() != 0;
+					Vector<float> &verts = attachment->_vertices;
+
+					DeformTimeline *timeline = new(__FILE__, __LINE__) DeformTimeline(frameCount);
+
+					timeline->_slotIndex = slotIndex;
+					timeline->_attachment = attachment;
+
+					for (frameIndex = 0; reader.nextValue(); ++frameIndex) {
+						float time = 0;
+						int start = 0;
+						bool hasVertices = false;
+						FrameCurve curve;
+						vertices.clear();
+						if (reader.beginObject()) {
+							while (reader.nextKey()) {
+								Key key = getKey(reader);
+								if (key == Key_Time)
+									time = reader.readFloat();
+								else if (key == Key_Offset)
+									start = reader.readInt();
+								else if (key == Key_Vertices) {
+									hasVertices = true;
+									if (reader.beginArray()) {
+										while (reader.nextValue())
+											vertices.add(reader.readFloat());
+									}
+								} else if (!readCurve(reader, key, curve))
+									reader.skipValue();
 							}
 						}
+
+						if (!hasVertices) start = 0;
+						if (_scale != 1) {
+							for (size_t v = 0; v < vertices.size(); ++v)
+								vertices[v] *= _scale;
+						}
 						if (!weighted) {
-							Vector<float> &verticesAttachment = attachment->_vertices;
-							for (v = 0; v < deformLength; ++v) {
-								deformed[v] += verticesAttachment[v];
-							}
+							for (size_t v = 0; v < vertices.size(); ++v)
+								vertices[v] += verts[start + v];
 						}
+						timeline->setFrame(frameIndex, time, vertices, start);
+						setCurve(timeline, frameIndex, curve);
 					}
-					timeline->setFrame(frameIndex, Json::getFloat(valueMap, "time", 0), deformed);
-					readCurve(valueMap, timeline, frameIndex);
-				}
 
-				timelines.add(timeline);
-				timelinesCount++;
-				duration = MathUtil::max(duration, timeline->_frames[timelineMap->_size - 1]);
+					timelines.add(timeline);
+					duration = MathUtil::max(duration, timeline->_frames[frameCount - 1]);
+				}
 			}
 		}
 	}
 
 	/** Draw order timeline. */
-	if (drawOrder) {
-		DrawOrderTimeline *timeline = new(__FILE__, __LINE__) DrawOrderTimeline(drawOrder->_size);
+	int frameCount = root.getSize(Key_DrawOrder);
+	if (frameCount > 0 && root.beginArray(Key_DrawOrder)) {
+		DrawOrderTimeline *timeline = new(__FILE__, __LINE__) DrawOrderTimeline(frameCount);
+		timelines.add(timeline);
 
-		for (valueMap = drawOrder->_child, frameIndex = 0; valueMap; valueMap = valueMap->_next, ++frameIndex) {
+		for (frameIndex = 0; reader.nextValue(); ++frameIndex) {
 			int ii;
+			float time = 0;
 			Vector<int> drawOrder2;
-			Json *offsets = Json::getItem(valueMap, "offsets");
-			if (offsets) {
-				Json *offsetMap;
-				Vector<int> unchanged;
-				unchanged.ensureCapacity(skeletonData->_slots.size() - offsets->_size);
-				unchanged.setSize(skeletonData->_slots.size() - offsets->_size, 0);
-				size_t originalIndex = 0, unchangedIndex = 0;
-
-				drawOrder2.ensureCapacity(skeletonData->_slots.size());
-				drawOrder2.setSize(skeletonData->_slots.size(), 0);
-				for (ii = (int)skeletonData->_slots.size() - 1; ii >= 0; --ii)
-					drawOrder2[ii] = -1;
-
-				for (offsetMap = offsets->_child; offsetMap; offsetMap = offsetMap->_next) {
-					int slotIndex = skeletonData->findSlotIndex(Json::getString(offsetMap, "slot", 0));
-					if (slotIndex == -1) {
-						ContainerUtil::cleanUpVectorOfPointers(timelines);
-						setError(NULL, "Slot not found: ", Json::getString(offsetMap, "slot", 0));
-						return NULL;
+			if (reader.beginObject()) {
+				while (reader.nextKey()) {
+					Key key = getKey(reader);
+					if (key == Key_Time) {
+						time = reader.readFloat();
+						continue;
+					}
+					int offsetsCount = reader.peekArraySize();
+					if (key != Key_Offsets || !reader.beginArray()) {
+						reader.skipValue();
+						continue;
 					}
-					/* Collect unchanged items. */
-					while (originalIndex != (size_t)slotIndex)
+					Vector<int> unchanged;
+					unchanged.setSize(skeletonData->_slots.size() - offsetsCount, 0);
+					size_t originalIndex = 0, unchangedIndex = 0;
+
+					drawOrder2.setSize(skeletonData->_slots.size(), 0);
+					for (ii = (int)skeletonData->_slots.size() - 1; ii >= 0; --ii)
+						drawOrder2[ii] = -1;
+
+					while (reader.nextValue()) {
+						JsonMap offsetMap(reader);
+						const char *slotName = offsetMap.getString(Key_Slot, 0);
+						int slotIndex = skeletonData->findSlotIndex(slotName);
+						if (slotIndex == -1) {
+							ContainerUtil::cleanUpVectorOfPointers(timelines);
+							setError("Slot not found: ", slotName);
+							return NULL;
+						}
+						/* Collect unchanged items. */
+						while (originalIndex != (size_t)slotIndex)
+							unchanged[unchangedIndex++] = originalIndex++;
+						/* Set changed items. */
+						drawOrder2[originalIndex + offsetMap.getInt(Key_Offset, 0)] = originalIndex;
+						originalIndex++;
+					}
+					/* Collect remaining unchanged items. */
+					while (originalIndex < skeletonData->_slots.size())
 						unchanged[unchangedIndex++] = originalIndex++;
-					/* Set changed items. */
-					drawOrder2[originalIndex + Json::getInt(offsetMap, "offset", 0)] = originalIndex;
-					originalIndex++;
+					/* Fill in unchanged items. */
+					for (ii = (int)skeletonData->_slots.size() - 1; ii >= 0; ii--)
+						if (drawOrder2[ii] == -1) drawOrder2[ii] = unchanged[--unchangedIndex];
 				}
-				/* Collect remaining unchanged items. */
-				while (originalIndex < skeletonData->_slots.size())
-					unchanged[unchangedIndex++] = originalIndex++;
-				/* Fill in unchanged items. */
-				for (ii = (int)skeletonData->_slots.size() - 1; ii >= 0; ii--)
-					if (drawOrder2[ii] == -1) drawOrder2[ii] = unchanged[--unchangedIndex];
 			}
-			timeline->setFrame(frameIndex, Json::getFloat(valueMap, "time", 0), drawOrder2);
+			timeline->setFrame(frameIndex, time, drawOrder2);
 		}
-		timelines.add(timeline);
-		timelinesCount++;
-		duration = MathUtil::max(duration, timeline->_frames[drawOrder->_size - 1]);
+		duration = MathUtil::max(duration, timeline->_frames[frameCount - 1]);
 	}
 
 	/** Event timeline. */
-	if (events) {
-		EventTimeline *timeline = new(__FILE__, __LINE__) EventTimeline(events->_size);
+	frameCount = root.getSize(Key_Events);
+	if (frameCount > 0 && root.beginArray(Key_Events)) {
+		EventTimeline *timeline = new(__FILE__, __LINE__) EventTimeline(frameCount);
+		timelines.add(timeline);
 
-		for (valueMap = events->_child, frameIndex = 0; valueMap; valueMap = valueMap->_next, ++frameIndex) {
-			Event *event;
-			EventData *eventData = skeletonData->findEvent(Json::getString(valueMap, "name", 0));
+		for (frameIndex = 0; reader.nextValue(); ++frameIndex) {
+			JsonMap valueMap(reader);
+			const char *eventName = valueMap.getString(Key_Name, 0);
+			EventData *eventData = skeletonData->findEvent(eventName);
 			if (!eventData) {
 				ContainerUtil::cleanUpVectorOfPointers(timelines);
-				setError(NULL, "Event not found: ", Json::getString(valueMap, "name", 0));
+				setError("Event not found: ", eventName);
 				return NULL;
 			}
 
-			event = new(__FILE__, __LINE__) Event(Json::getFloat(valueMap, "time", 0), *eventData);
-			event->_intValue = Json::getInt(valueMap, "int", eventData->_intValue);
-			event->_floatValue = Json::getFloat(valueMap, "float", eventData->_floatValue);
-			event->_stringValue = Json::getString(valueMap, "string", eventData->_stringValue.buffer());
+			Event *event = new(__FILE__, __LINE__) Event(valueMap.getFloat(Key_Time, 0), *eventData);
+			event->_intValue = valueMap.getInt(Key_Int, eventData->_intValue);
+			event->_floatValue = valueMap.getFloat(Key_Float, eventData->_floatValue);
+			event->_stringValue = valueMap.getString(Key_String, eventData->_stringValue.buffer());
 			if (!eventData->_audioPath.isEmpty()) {
-				event->_volume = Json::getFloat(valueMap, "volume", 1);
-				event->_balance = Json::getFloat(valueMap, "balance", 0);
+				event->_volume = valueMap.getFloat(Key_Volume, 1);
+				event->_balance = valueMap.getFloat(Key_Balance, 0);
 			}
 			timeline->setFrame(frameIndex, event);
 		}
-		timelines.add(timeline);
-		timelinesCount++;
-		duration = MathUtil::max(duration, timeline->_frames[events->_size - 1]);
+		duration = MathUtil::max(duration, timeline->_frames[frameCount - 1]);
 	}
 
-	return new(__FILE__, __LINE__) Animation(String(root->_name), timelines, duration);
+	return new(__FILE__, __LINE__) Animation(name, timelines, duration);
 }
 
-void SkeletonJson::readVertices(Json *attachmentMap, VertexAttachment *attachment, size_t verticesLength) {
-	Json *entry;
+void SkeletonJson::readVertices(JsonReader &reader, JsonMap &attachmentMap, VertexAttachment *attachment,
+	size_t verticesLength
+) {
 	size_t i, n, nn, entrySize;
 	Vector<float> vertices;
 
 	attachment->setWorldVerticesLength(verticesLength);
 
-	entry = Json::getItem(attachmentMap, "vertices");
-	entrySize = entry->_size;
-	vertices.ensureCapacity(entrySize);
+	// The vertices are copied to the attachment, so they are read into heap scratch.
+	Arena *arena = Arena::getCurrent();
+	ArenaScope heapScope(NULL);
+	entrySize = attachmentMap.getSize(Key_Vertices);
 	vertices.setSize(entrySize, 0);
-	for (entry = entry->_child, i = 0; entry; entry = entry->_next, ++i)
-		vertices[i] = entry->_valueFloat;
+	if (attachmentMap.beginArray(Key_Vertices)) {
+		for (i = 0; reader.nextValue(); ++i)
+			vertices[i] = reader.readFloat();
+	}
 
 	if (verticesLength == entrySize) {
 		if (_scale != 1) {
@@ -1199,6 +1640,7 @@ void SkeletonJson::readVertices(Json *attachmentMap, VertexAttachment *attachmen
 				vertices[i] *= _scale;
 		}
 
+		ArenaScope arenaScope(arena);
 		attachment->getVertices().clearAndAddAll(vertices);
 		return;
 	}
@@ -1218,11 +1660,12 @@ void SkeletonJson::readVertices(Json *attachmentMap, VertexAttachment *attachmen
 		}
 	}
 
+	ArenaScope arenaScope(arena);
 	attachment->getVertices().clearAndAddAll(bonesAndWeights._vertices);
 	attachment->getBones().clearAndAddAll(bonesAndWeights._bones);
 }
 
-void SkeletonJson::setError(Json *root, const String &value1, const String &value2) {
+void SkeletonJson::setError(const String &value1, const String &value2) {
+	ArenaScope heapScope(NULL);
 	_error = String(value1).append(value2);
-	delete root;
 }
@@ -0,0 +1,144 @@
+/******************************************************************************
+ * Spine Runtimes License Agreement
+ * Last updated January 1, 2020. Replaces all prior versions.
+ *
+ * Copyright (c) 2013-2020, Esoteric Software LLC
+ *
+ * Integration of the Spine Runtimes into software or otherwise creating
+ * derivative works of the Spine Runtimes is permitted under the terms and
+ * conditions of Section 2 of the Spine Editor License Agreement:
+ * http://esotericsoftware.com/spine-editor-license
+ *
+ * Otherwise, it is permitted to integrate the Spine Runtimes into software
+ * or otherwise create derivative works of the Spine Runtimes (collectively,
+ * "Products"), provided that each user of the Products must obtain their own
+ * Spine Editor license and redistribution of the Products in any form must
+ * include this license and copyright notice.
+ *
+ * THE SPINE RUNTIMES ARE PROVIDED BY ESOTERIC SOFTWARE LLC "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL ESOTERIC SOFTWARE LLC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES,
+ * BUSINESS INTERRUPTION, OR LOSS OF USE, DATA, OR PROFITS) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THE SPINE RUNTIMES, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+#ifdef SPINE_UE4
+#include "SpinePluginPrivatePCH.h"
+#endif
+
+#include <spine/SkeletonUpdateBatch.h>
+
+#include <spine/Animation.h>
+#include <spine/AnimationState.h>
+#include <spine/MathUtil.h>
+#include <spine/Skeleton.h>
+
+#include <assert.h>
+
+using namespace spine;
+
+SkeletonUpdateBatch::SkeletonUpdateBatch(size_t chunkSize) : _chunkSize(chunkSize), _next(0), _running(false) {
+	assert(chunkSize > 0);
+}
+
+SkeletonUpdateBatch::~SkeletonUpdateBatch() {
+}
+
+void SkeletonUpdateBatch::add(AnimationState *state, Skeleton *skeleton, float delta) {
+	assert(!_running);
+	assert(skeleton);
+	Item item;
+	item.state = state;
+	item.skeleton = skeleton;
+	item.delta = delta;
+	_items.add(item);
+}
+
+void SkeletonUpdateBatch::clear() {
+	assert(!_running);
+	_items.clear();
+}
+
+size_t SkeletonUpdateBatch::size() {
+	return _items.size();
+}
+
+void SkeletonUpdateBatch::setDelta(size_t index, float delta) {
+	_items[index].delta = delta;
+}
+
+void SkeletonUpdateBatch::begin() {
+	assert(!_running);
+	for (size_t i = 0, n = _items.size(); i < n; i++) {
+		AnimationState *state = _items[i].state;
+		if (!state) continue;
+		state->disableQueue();
+
+		// Animations loaded on demand must be loaded before they may be applied from multiple threads.
+		Vector<TrackEntry *> &tracks = state->getTracks();
+		for (size_t ii = 0, nn = tracks.size(); ii < nn; ii++) {
+			if (!tracks[ii]) continue;
+			for (TrackEntry *entry = tracks[ii]; entry; entry = entry->getMixingFrom())
+				entry->getAnimation()->load();
+			for (TrackEntry *entry = tracks[ii]->getNext(); entry; entry = entry->getNext())
+				entry->getAnimation()->load();
+		}
+	}
+	_next = 0;
+	_running = true;
+}
+
+void SkeletonUpdateBatch::run() {
+	assert(_running);
+	size_t count = _items.size();
+	while (true) {
+		size_t start = (size_t) SP_ATOMIC_ADD(&_next, (long) _chunkSize);
+		if (start >= count) break;
+		runRange(start, MathUtil::min(start + _chunkSize, count));
+	}
+}
+
+void SkeletonUpdateBatch::runRange(size_t start, size_t end) {
+	assert(_running);
+	assert(end <= _items.size());
+	for (size_t i = start; i < end; i++) {
+		Item &item = _items[i];
+		if (item.state) {
+			item.state->update(item.delta);
+			item.state->apply(*item.skeleton);
+		}
+		item.skeleton->updateWorldTransform();
+	}
+}
+
+void SkeletonUpdateBatch::end() {
+	assert(_running);
+	_running = false;
+	for (size_t i = 0, n = _items.size(); i < n; i++) {
+		AnimationState *state = _items[i].state;
+		if (!state) continue;
+		state->enableQueue();
+		state->_queue->drain();
+	}
+}
+
+void SkeletonUpdateBatch::update() {
+	begin();
+	run();
+	end();
+}
+
+size_t SkeletonUpdateBatch::getChunkSize() {
+	return _chunkSize;
+}
+
+void SkeletonUpdateBatch::setChunkSize(size_t inValue) {
+	assert(!_running);
+	assert(inValue > 0);
+	_chunkSize = inValue;
+}
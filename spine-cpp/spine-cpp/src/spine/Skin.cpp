@@ -54,38 +54,44 @@ static void disposeAttachment(Attachment* attachment) {
 }
 
 void Skin::AttachmentMap::put(size_t slotIndex, const String &attachmentName, Attachment *attachment) {
-	if (slotIndex >= _buckets.size())
+	if (slotIndex >= _buckets.size()) {
 		_buckets.setSize(slotIndex + 1, Vector<Entry>());
+		_indices.setSize(slotIndex + 1, HashMap<String, int>());
+	}
 	Vector<Entry> &bucket = _buckets[slotIndex];
-	int existing = findInBucket(bucket, attachmentName);
+	int existing = findInBucket(slotIndex, attachmentName);
 	attachment->reference();
 	if (existing >= 0) {
 		disposeAttachment(bucket[existing]._attachment);
 		bucket[existing]._attachment = attachment;
 	} else {
 		bucket.add(Entry(slotIndex, attachmentName, attachment));
+		_indices[slotIndex].put(attachmentName, (int) bucket.size() - 1);
 	}
 }
 
 Attachment *Skin::AttachmentMap::get(size_t slotIndex, const String &attachmentName) {
-	if (slotIndex >= _buckets.size()) return NULL;
-	int existing = findInBucket(_buckets[slotIndex], attachmentName);
+	int existing = findInBucket(slotIndex, attachmentName);
 	return existing >= 0 ? _buckets[slotIndex][existing]._attachment : NULL;
 }
 
 void Skin::AttachmentMap::remove(size_t slotIndex, const String &attachmentName) {
-	if (slotIndex >= _buckets.size()) return;
-	int existing = findInBucket(_buckets[slotIndex], attachmentName);
+	int existing = findInBucket(slotIndex, attachmentName);
 	if (existing >= 0) {
-		disposeAttachment(_buckets[slotIndex][existing]._attachment);
-		_buckets[slotIndex].removeAt(existing);
+		Vector<Entry> &bucket = _buckets[slotIndex];
+		HashMap<String, int> &index = _indices[slotIndex];
+		index.remove(attachmentName);
+		disposeAttachment(bucket[existing]._attachment);
+		bucket.removeAt(existing);
+		for (size_t i = existing, n = bucket.size(); i < n; i++)
+			index.put(bucket[i]._name, (int) i);
 	}
 }
 
-int Skin::AttachmentMap::findInBucket(Vector<Entry> &bucket, const String &attachmentName) {
-	for (size_t i = 0; i < bucket.size(); i++)
-		if (bucket[i]._name == attachmentName) return i;
-	return -1;
+int Skin::AttachmentMap::findInBucket(size_t slotIndex, const String &attachmentName) {
+	if (slotIndex >= _indices.size()) return -1;
+	int *index = _indices[slotIndex].get(attachmentName);
+	return index ? *index : -1;
 }
 
 Skin::AttachmentMap::Entries Skin::AttachmentMap::getEntries() {
@@ -45,4 +45,9 @@ Timeline::Timeline() {
 Timeline::~Timeline() {
 }
 
+void Timeline::sample(Pose &pose, float time) {
+	SP_UNUSED(pose);
+	SP_UNUSED(time);
+}
+
 }
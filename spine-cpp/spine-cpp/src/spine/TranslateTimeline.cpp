@@ -40,6 +40,8 @@
 #include <spine/SlotData.h>
 #include <spine/Bone.h>
 #include <spine/BoneData.h>
+#include <spine/Pose.h>
+#include <spine/SkeletonData.h>
 
 using namespace spine;
 
@@ -67,11 +69,19 @@ void TranslateTimeline::apply(Skeleton &skeleton, float lastTime, float time, Ve
 	SP_UNUSED(pEvents);
 	SP_UNUSED(direction);
 
+	if (isQuantized())
+		applyFrames(_quantizedFrames, skeleton, time, alpha, blend);
+	else
+		applyFrames(_frames, skeleton, time, alpha, blend);
+}
+
+template<typename T>
+void TranslateTimeline::applyFrames(T &frames, Skeleton &skeleton, float time, float alpha, MixBlend blend) {
 	Bone *boneP = skeleton._bones[_boneIndex];
 	Bone &bone = *boneP;
 	if (!bone._active) return;
 
-	if (time < _frames[0]) {
+	if (time < frames[0]) {
 		switch (blend) {
 		case MixBlend_Setup:
 			bone._x = bone._data._x;
@@ -86,21 +96,21 @@ void TranslateTimeline::apply(Skeleton &skeleton, float lastTime, float time, Ve
 	}
 
 	float x, y;
-	if (time >= _frames[_frames.size() - ENTRIES]) {
+	if (time >= frames[frames.size() - ENTRIES]) {
 		// Time is after last frame.
-		x = _frames[_frames.size() + PREV_X];
-		y = _frames[_frames.size() + PREV_Y];
+		x = frames[frames.size() + PREV_X];
+		y = frames[frames.size() + PREV_Y];
 	} else {
 		// Interpolate between the previous frame and the current frame.
-		int frame = Animation::binarySearch(_frames, time, ENTRIES);
-		x = _frames[frame + PREV_X];
-		y = _frames[frame + PREV_Y];
-		float frameTime = _frames[frame];
+		int frame = Animation::binarySearch(frames, time, ENTRIES);
+		x = frames[frame + PREV_X];
+		y = frames[frame + PREV_Y];
+		float frameTime = frames[frame];
 		float percent = getCurvePercent(frame / ENTRIES - 1,
-			1 - (time - frameTime) / (_frames[frame + PREV_TIME] - frameTime));
+			1 - (time - frameTime) / (frames[frame + PREV_TIME] - frameTime));
 
-		x += (_frames[frame + X] - x) * percent;
-		y += (_frames[frame + Y] - y) * percent;
+		x += (frames[frame + X] - x) * percent;
+		y += (frames[frame + Y] - y) * percent;
 	}
 
 	switch (blend) {
@@ -119,6 +129,48 @@ void TranslateTimeline::apply(Skeleton &skeleton, float lastTime, float time, Ve
 	}
 }
 
+void TranslateTimeline::sample(Pose &pose, float time) {
+	float x, y;
+	if (!getValues(time, x, y)) return;
+	BoneData *data = pose.getSkeletonData().getBones()[_boneIndex];
+	float *values = pose.getBoneTransform(_boneIndex);
+	values[Pose::X] = data->_x + x;
+	values[Pose::Y] = data->_y + y;
+}
+
+bool TranslateTimeline::getValues(float time, float &x, float &y) {
+	if (isQuantized()) return getValues(_quantizedFrames, time, x, y);
+	return getValues(_frames, time, x, y);
+}
+
+template<typename T>
+bool TranslateTimeline::getValues(T &frames, float time, float &x, float &y) {
+	if (time < frames[0]) return false;
+
+	if (time >= frames[frames.size() - ENTRIES]) {
+		// Time is after last frame.
+		x = frames[frames.size() + PREV_X];
+		y = frames[frames.size() + PREV_Y];
+		return true;
+	}
+
+	// Interpolate between the previous frame and the current frame.
+	int frame = Animation::binarySearch(frames, time, ENTRIES);
+	x = frames[frame + PREV_X];
+	y = frames[frame + PREV_Y];
+	float frameTime = frames[frame];
+	float percent = getCurvePercent(frame / ENTRIES - 1,
+		1 - (time - frameTime) / (frames[frame + PREV_TIME] - frameTime));
+
+	x += (frames[frame + X] - x) * percent;
+	y += (frames[frame + Y] - y) * percent;
+	return true;
+}
+
+size_t TranslateTimeline::quantize(float tolerance, CurveTable &curveTable) {
+	return quantizeFrames(_frames, ENTRIES, tolerance, curveTable);
+}
+
 int TranslateTimeline::getPropertyId() {
 	return ((int) TimelineType_Translate << 24) + _boneIndex;
 }
@@ -129,3 +181,11 @@ void TranslateTimeline::setFrame(int frameIndex, float time, float x, float y) {
 	_frames[frameIndex + X] = x;
 	_frames[frameIndex + Y] = y;
 }
+
+int TranslateTimeline::getBoneIndex() {
+	return _boneIndex;
+}
+
+void TranslateTimeline::setBoneIndex(int inValue) {
+	_boneIndex = inValue;
+}
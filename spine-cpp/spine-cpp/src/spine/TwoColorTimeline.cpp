@@ -38,6 +38,7 @@
 
 #include <spine/Animation.h>
 #include <spine/Bone.h>
+#include <spine/Pose.h>
 #include <spine/TimelineType.h>
 #include <spine/Slot.h>
 #include <spine/SlotData.h>
@@ -104,39 +105,10 @@ void TwoColorTimeline::apply(Skeleton &skeleton, float lastTime, float time, Vec
 		}
 	}
 
-	float r, g, b, a, r2, g2, b2;
-	if (time >= _frames[_frames.size() - ENTRIES]) {
-		// Time is after last frame.
-		size_t i = _frames.size();
-		r = _frames[i + PREV_R];
-		g = _frames[i + PREV_G];
-		b = _frames[i + PREV_B];
-		a = _frames[i + PREV_A];
-		r2 = _frames[i + PREV_R2];
-		g2 = _frames[i + PREV_G2];
-		b2 = _frames[i + PREV_B2];
-	} else {
-		// Interpolate between the previous frame and the current frame.
-		size_t frame = (size_t)Animation::binarySearch(_frames, time, ENTRIES);
-		r = _frames[frame + PREV_R];
-		g = _frames[frame + PREV_G];
-		b = _frames[frame + PREV_B];
-		a = _frames[frame + PREV_A];
-		r2 = _frames[frame + PREV_R2];
-		g2 = _frames[frame + PREV_G2];
-		b2 = _frames[frame + PREV_B2];
-		float frameTime = _frames[frame];
-		float percent = getCurvePercent(frame / ENTRIES - 1,
-										1 - (time - frameTime) / (_frames[frame + PREV_TIME] - frameTime));
-
-		r += (_frames[frame + R] - r) * percent;
-		g += (_frames[frame + G] - g) * percent;
-		b += (_frames[frame + B] - b) * percent;
-		a += (_frames[frame + A] - a) * percent;
-		r2 += (_frames[frame + R2] - r2) * percent;
-		g2 += (_frames[frame + G2] - g2) * percent;
-		b2 += (_frames[frame + B2] - b2) * percent;
-	}
+	Color lightValue, darkValue;
+	getValues(time, lightValue, darkValue);
+	float r = lightValue.r, g = lightValue.g, b = lightValue.b, a = lightValue.a;
+	float r2 = darkValue.r, g2 = darkValue.g, b2 = darkValue.b;
 
 	if (alpha == 1) {
 		Color &color = slot.getColor();
@@ -156,6 +128,40 @@ void TwoColorTimeline::apply(Skeleton &skeleton, float lastTime, float time, Vec
 	}
 }
 
+void TwoColorTimeline::sample(Pose &pose, float time) {
+	// The dark color is not part of a pose.
+	if (time < _frames[0]) return;
+	Color darkColor;
+	getValues(time, pose.getColor(_slotIndex), darkColor);
+}
+
+void TwoColorTimeline::getValues(float time, Color &light, Color &dark) {
+	if (time >= _frames[_frames.size() - ENTRIES]) {
+		// Time is after last frame.
+		size_t i = _frames.size();
+		light.set(_frames[i + PREV_R], _frames[i + PREV_G], _frames[i + PREV_B], _frames[i + PREV_A]);
+		dark.set(_frames[i + PREV_R2], _frames[i + PREV_G2], _frames[i + PREV_B2], 1);
+		return;
+	}
+
+	// Interpolate between the previous frame and the current frame.
+	size_t frame = (size_t)Animation::binarySearch(_frames, time, ENTRIES);
+	float r = _frames[frame + PREV_R];
+	float g = _frames[frame + PREV_G];
+	float b = _frames[frame + PREV_B];
+	float a = _frames[frame + PREV_A];
+	float r2 = _frames[frame + PREV_R2];
+	float g2 = _frames[frame + PREV_G2];
+	float b2 = _frames[frame + PREV_B2];
+	float frameTime = _frames[frame];
+	float percent = getCurvePercent(frame / ENTRIES - 1, 1 - (time - frameTime) / (_frames[frame + PREV_TIME] - frameTime));
+
+	light.set(r + (_frames[frame + R] - r) * percent, g + (_frames[frame + G] - g) * percent,
+		b + (_frames[frame + B] - b) * percent, a + (_frames[frame + A] - a) * percent);
+	dark.set(r2 + (_frames[frame + R2] - r2) * percent, g2 + (_frames[frame + G2] - g2) * percent,
+		b2 + (_frames[frame + B2] - b2) * percent, 1);
+}
+
 int TwoColorTimeline::getPropertyId() {
 	return ((int) TimelineType_TwoColor << 24) + _slotIndex;
 }
@@ -38,10 +38,139 @@
 #include <spine/Bone.h>
 #include <spine/Skeleton.h>
 
+#if !defined(SPINE_NO_SIMD)
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define SPINE_SIMD_SSE2
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define SPINE_SIMD_NEON
+#include <arm_neon.h>
+#endif
+#endif
+
 using namespace spine;
 
 RTTI_IMPL(VertexAttachment, Attachment)
 
+#if defined(SPINE_SIMD_SSE2) || defined(SPINE_SIMD_NEON)
+bool VertexAttachment::_simdEnabled = true;
+
+namespace {
+	enum {
+		Matrix_A, Matrix_B, Matrix_C, Matrix_D, Matrix_X, Matrix_Y, Matrix_Count
+	};
+
+	enum {
+		Lane_Vx, Lane_Vy, Lane_Weight, Lane_A, Lane_B, Lane_C, Lane_D, Lane_X, Lane_Y, Lane_Count
+	};
+
+	/// Transforms weighted vertices using bone world matrices stored as arrays, 4 vertices at a time. Each lane accumulates
+	/// the influences of one vertex in the same order as the scalar path. Lanes with fewer influences are padded with zeros,
+	/// which adds +0 to the sum and leaves it unchanged.
+	void computeWeightedSimd(const size_t *bones, const float *vertices, const float *deform, size_t v, size_t b, size_t f,
+		float **matrices, float *worldVertices, size_t w, size_t end, size_t stride
+	) {
+		const float *ma = matrices[Matrix_A], *mb = matrices[Matrix_B], *mc = matrices[Matrix_C];
+		const float *md = matrices[Matrix_D], *mx = matrices[Matrix_X], *my = matrices[Matrix_Y];
+		float lanes[Lane_Count][4];
+		float out[2][4];
+
+		for (; w + 3 * stride < end; w += stride << 2) {
+			size_t counts[4], vs[4], bs[4], fs[4], maxCount = 0;
+			for (int l = 0; l < 4; l++) {
+				counts[l] = bones[v];
+				vs[l] = v + 1;
+				bs[l] = b;
+				fs[l] = f;
+				v += counts[l] + 1;
+				b += counts[l] * 3;
+				f += counts[l] << 1;
+				if (counts[l] > maxCount) maxCount = counts[l];
+			}
+
+#ifdef SPINE_SIMD_SSE2
+			__m128 wx = _mm_setzero_ps(), wy = _mm_setzero_ps();
+#else
+			float32x4_t wx = vdupq_n_f32(0), wy = vdupq_n_f32(0);
+#endif
+			for (size_t k = 0; k < maxCount; k++) {
+				for (int l = 0; l < 4; l++) {
+					if (k < counts[l]) {
+						size_t bone = bones[vs[l] + k], bb = bs[l] + k * 3;
+						if (deform) {
+							size_t ff = fs[l] + (k << 1);
+							lanes[Lane_Vx][l] = vertices[bb] + deform[ff];
+							lanes[Lane_Vy][l] = vertices[bb + 1] + deform[ff + 1];
+						} else {
+							lanes[Lane_Vx][l] = vertices[bb];
+							lanes[Lane_Vy][l] = vertices[bb + 1];
+						}
+						lanes[Lane_Weight][l] = vertices[bb + 2];
+						lanes[Lane_A][l] = ma[bone];
+						lanes[Lane_B][l] = mb[bone];
+						lanes[Lane_C][l] = mc[bone];
+						lanes[Lane_D][l] = md[bone];
+						lanes[Lane_X][l] = mx[bone];
+						lanes[Lane_Y][l] = my[bone];
+					} else {
+						for (int i = 0; i < Lane_Count; i++)
+							lanes[i][l] = 0;
+					}
+				}
+#ifdef SPINE_SIMD_SSE2
+				__m128 vx = _mm_loadu_ps(lanes[Lane_Vx]), vy = _mm_loadu_ps(lanes[Lane_Vy]);
+				__m128 weight = _mm_loadu_ps(lanes[Lane_Weight]);
+				__m128 tx = _mm_add_ps(_mm_add_ps(_mm_mul_ps(vx, _mm_loadu_ps(lanes[Lane_A])), _mm_mul_ps(vy, _mm_loadu_ps(lanes[Lane_B]))), _mm_loadu_ps(lanes[Lane_X]));
+				__m128 ty = _mm_add_ps(_mm_add_ps(_mm_mul_ps(vx, _mm_loadu_ps(lanes[Lane_C])), _mm_mul_ps(vy, _mm_loadu_ps(lanes[Lane_D]))), _mm_loadu_ps(lanes[Lane_Y]));
+				wx = _mm_add_ps(wx, _mm_mul_ps(tx, weight));
+				wy = _mm_add_ps(wy, _mm_mul_ps(ty, weight));
+#else
+				float32x4_t vx = vld1q_f32(lanes[Lane_Vx]), vy = vld1q_f32(lanes[Lane_Vy]);
+				float32x4_t weight = vld1q_f32(lanes[Lane_Weight]);
+				float32x4_t tx = vaddq_f32(vaddq_f32(vmulq_f32(vx, vld1q_f32(lanes[Lane_A])), vmulq_f32(vy, vld1q_f32(lanes[Lane_B]))), vld1q_f32(lanes[Lane_X]));
+				float32x4_t ty = vaddq_f32(vaddq_f32(vmulq_f32(vx, vld1q_f32(lanes[Lane_C])), vmulq_f32(vy, vld1q_f32(lanes[Lane_D]))), vld1q_f32(lanes[Lane_Y]));
+				wx = vaddq_f32(wx, vmulq_f32(tx, weight));
+				wy = vaddq_f32(wy, vmulq_f32(ty, weight));
+#endif
+			}
+#ifdef SPINE_SIMD_SSE2
+			_mm_storeu_ps(out[0], wx);
+			_mm_storeu_ps(out[1], wy);
+#else
+			vst1q_f32(out[0], wx);
+			vst1q_f32(out[1], wy);
+#endif
+			for (int l = 0; l < 4; l++) {
+				worldVertices[w + l * stride] = out[0][l];
+				worldVertices[w + l * stride + 1] = out[1][l];
+			}
+		}
+
+		// Remaining vertices.
+		for (; w < end; w += stride) {
+			float wx = 0, wy = 0;
+			size_t n = bones[v++];
+			n += v;
+			for (; v < n; v++, b += 3, f += 2) {
+				size_t bone = bones[v];
+				float vx = vertices[b], vy = vertices[b + 1];
+				if (deform) {
+					vx += deform[f];
+					vy += deform[f + 1];
+				}
+				float weight = vertices[b + 2];
+				wx += (vx * ma[bone] + vy * mb[bone] + mx[bone]) * weight;
+				wy += (vx * mc[bone] + vy * md[bone] + my[bone]) * weight;
+			}
+			worldVertices[w] = wx;
+			worldVertices[w + 1] = wy;
+		}
+	}
+}
+#else
+bool VertexAttachment::_simdEnabled = false;
+#endif
+
 VertexAttachment::VertexAttachment(const String &name) : Attachment(name), _worldVerticesLength(0), _deformAttachment(this), _id(getNextID()) {
 }
 
@@ -90,6 +219,31 @@ void VertexAttachment::computeWorldVertices(Slot &slot, size_t start, size_t cou
 	}
 
 	Vector<Bone *> &skeletonBones = skeleton.getBones();
+#if defined(SPINE_SIMD_SSE2) || defined(SPINE_SIMD_NEON)
+	// Gather the bone world matrices into arrays once when there are at least as many influences as bones. Bones may have
+	// been changed since Skeleton::updateWorldTransform, so they are always read from the bones themselves.
+	if (_simdEnabled && bones.size() >= skeletonBones.size() * 2) {
+		float *matrices[6];
+		size_t boneCount = skeletonBones.size();
+		Vector<float> &boneMatrices = slot._boneMatrices;
+		if (boneMatrices.size() < boneCount * 6) boneMatrices.setSize(boneCount * 6, 0);
+		for (int i = 0; i < 6; i++)
+			matrices[i] = boneMatrices.buffer() + boneCount * i;
+		for (size_t i = 0; i < boneCount; i++) {
+			Bone &bone = *skeletonBones[i];
+			matrices[0][i] = bone._a;
+			matrices[1][i] = bone._b;
+			matrices[2][i] = bone._c;
+			matrices[3][i] = bone._d;
+			matrices[4][i] = bone._worldX;
+			matrices[5][i] = bone._worldY;
+		}
+		computeWeightedSimd(bones.buffer(), vertices->buffer(), deformArray->size() > 0 ? deformArray->buffer() : NULL, v,
+			skip * 3, skip << 1, matrices, worldVertices, offset, count, stride);
+		return;
+	}
+#endif
+
 	if (deformArray->size() == 0) {
 		for (size_t w = offset, b = skip * 3; w < count; w += stride) {
 			float wx = 0, wy = 0;
@@ -155,10 +309,23 @@ void VertexAttachment::setDeformAttachment(VertexAttachment* attachment) {
 	_deformAttachment = attachment;
 }
 
-int VertexAttachment::getNextID() {
-	static int nextID = 0;
+void VertexAttachment::setSimdEnabled(bool inValue) {
+#if defined(SPINE_SIMD_SSE2) || defined(SPINE_SIMD_NEON)
+	_simdEnabled = inValue;
+#else
+	SP_UNUSED(inValue);
+#endif
+}
 
-	return (nextID++ & 65535) << 11;
+bool VertexAttachment::isSimdEnabled() {
+	return _simdEnabled;
+}
+
+static volatile long nextID = 0;
+
+int VertexAttachment::getNextID() {
+	// Attachments may be created on multiple threads by a parallel SkeletonBinary.
+	return (int) ((SP_ATOMIC_ADD(&nextID, 1) & 65535) << 11);
 }
 
 void VertexAttachment::copyTo(VertexAttachment* other) {